@@ -139,6 +139,8 @@ void BackendCommandTarget::getAllCommands(Array<CommandID>& commands)
 		MenuToolsConvertSfzToSampleMaps,
 		MenuToolsEnableAutoSaving,
 		MenuToolsEnableDebugLogging,
+		MenuToolsUseSampleAccurateControllers,
+		MenuToolsBenchmarkControllerEvents,
 		MenuToolsCreateRSAKeys,
 		MenuToolsCreateDummyLicenceFile,
 		MenuViewReset,
@@ -408,6 +410,12 @@ void BackendCommandTarget::getCommandInfo(CommandID commandID, ApplicationComman
 	case MenuToolsEnableDebugLogging:
 		setCommandTarget(result, "Enable Debug Logger", true, bpe->owner->getDebugLogger().isLogging(), 'X', false);
 		break;
+	case MenuToolsUseSampleAccurateControllers:
+		setCommandTarget(result, "Sample accurate controller events", true, bpe->owner->isUsingSampleAccurateControllers(), 'X', false);
+		break;
+	case MenuToolsBenchmarkControllerEvents:
+		setCommandTarget(result, "Benchmark controller event density", true, false, 'X', false);
+		break;
 	case MenuToolsCreateRSAKeys:
 		setCommandTarget(result, "Create RSA Key pair", true, false, 'X', false);
 		break;
@@ -551,6 +559,8 @@ bool BackendCommandTarget::perform(const InvocationInfo &info)
 	case MenuToolsCheckAllSampleMaps:	Actions::checkAllSamplemaps(bpe); return true;
 	case MenuToolsEnableAutoSaving:		bpe->owner->getAutoSaver().toggleAutoSaving(); updateCommands(); return true;
 	case MenuToolsEnableDebugLogging:	bpe->owner->getDebugLogger().toggleLogging(), updateCommands(); return true;
+	case MenuToolsUseSampleAccurateControllers: bpe->owner->setUseSampleAccurateControllers(!bpe->owner->isUsingSampleAccurateControllers()); updateCommands(); return true;
+	case MenuToolsBenchmarkControllerEvents: Actions::benchmarkControllerEvents(bpe); return true;
     case MenuViewFullscreen:            Actions::toggleFullscreen(bpe); updateCommands(); return true;
 	case MenuViewBack:					bpe->mainEditor->getViewUndoManager()->undo(); updateCommands(); return true;
 	case MenuViewReset:				    bpe->resetInterface(); updateCommands(); return true;
@@ -805,6 +815,10 @@ PopupMenu BackendCommandTarget::getMenuForIndex(int topLevelMenuIndex, const Str
 		ADD_DESKTOP_ONLY(MenuToolsEnableAutoSaving);
 		ADD_DESKTOP_ONLY(MenuToolsEnableDebugLogging);
 		p.addSeparator();
+		p.addSectionHeader("Performance");
+		ADD_DESKTOP_ONLY(MenuToolsUseSampleAccurateControllers);
+		ADD_DESKTOP_ONLY(MenuToolsBenchmarkControllerEvents);
+		p.addSeparator();
 		p.addSectionHeader("License Management");
 		ADD_DESKTOP_ONLY(MenuToolsCreateDummyLicenceFile);
 		ADD_DESKTOP_ONLY(MenuToolsCreateRSAKeys);
@@ -1968,6 +1982,83 @@ void BackendCommandTarget::Actions::validateUserPresets(BackendRootWindow * bpe)
 	}
 }
 
+void BackendCommandTarget::Actions::benchmarkControllerEvents(BackendRootWindow * bpe)
+{
+	MainController* mc = bpe->getBackendProcessor();
+	ModulatorSynthChain* chain = mc->getMainSynthChain();
+
+	const int blockSize = chain->getBlockSize();
+
+	if (blockSize <= 0 || chain->getSampleRate() <= 0.0)
+	{
+		PresetHandler::showMessageWindow("Audio not initialised", "Start the audio device before running the benchmark.", PresetHandler::IconType::Error);
+		return;
+	}
+
+	const bool wasUsingSampleAccurateControllers = mc->isUsingSampleAccurateControllers();
+	const int numBlocks = 500;
+	const int densities[] = { 0, 4, 16, 64, 256 };
+
+	AudioSampleBuffer buffer(chain->getMatrix().getNumSourceChannels(), blockSize);
+	HiseEventBuffer events;
+	MainController::EventIdHandler idHandler(events);
+
+	debugToConsole(chain, "Benchmarking " + String(numBlocks) + " blocks with " + String(blockSize) + " samples per controller density");
+
+	{
+		// The audio callback will output silence while the benchmark runs
+		MainController::ScopedSuspender ss(mc, MainController::ScopedSuspender::LockType::Lock);
+
+		for (auto density : densities)
+		{
+			double milliseconds[2];
+
+			for (int mode = 0; mode < 2; mode++)
+			{
+				mc->setUseSampleAccurateControllers(mode == 1);
+
+				int64 ticks = 0;
+
+				for (int block = 0; block < numBlocks; block++)
+				{
+					events.clear();
+
+					if (block == 0)
+					{
+						for (int i = 0; i < 4; i++)
+							events.addEvent(HiseEvent(HiseEvent::Type::NoteOn, (uint8)(48 + i * 7), 100, 1));
+					}
+
+					for (int i = 0; i < density; i++)
+					{
+						HiseEvent cc(HiseEvent::Type::Controller, 1, (uint8)((block + i) % 128), 1);
+						cc.setTimeStamp((uint16)(i * blockSize / density));
+						events.addEvent(cc);
+					}
+
+					if (block == numBlocks - 1)
+						events.addEvent(HiseEvent(HiseEvent::Type::AllNotesOff, 0, 0, 1));
+
+					idHandler.handleEventIds();
+					buffer.clear();
+
+					const int64 start = Time::getHighResolutionTicks();
+
+					chain->renderNextBlockWithModulators(buffer, events);
+
+					ticks += Time::getHighResolutionTicks() - start;
+				}
+
+				milliseconds[mode] = Time::highResolutionTicksToSeconds(ticks) * 1000.0 / (double)numBlocks;
+			}
+
+			debugToConsole(chain, String(density) + " CC events: splitting " + String(milliseconds[0], 3) + " ms, sample accurate " + String(milliseconds[1], 3) + " ms per block");
+		}
+
+		mc->setUseSampleAccurateControllers(wasUsingSampleAccurateControllers);
+	}
+}
+
 
 
 #undef ADD_ALL_PLATFORMS
@@ -174,6 +174,8 @@ public:
 		MenuToolsCreateDummyLicenceFile,
 		MenuToolsEnableAutoSaving,
 		MenuToolsEnableDebugLogging,
+		MenuToolsUseSampleAccurateControllers,
+		MenuToolsBenchmarkControllerEvents,
 		MenuHelpShowAboutPage,
         MenuHelpCheckVersion,
 		numCommands
@@ -307,6 +309,7 @@ public:
 		static void convertSfzFilesToSampleMaps(BackendRootWindow * bpe);
 		static void checkAllSamplemaps(BackendRootWindow * bpe);
 		static void validateUserPresets(BackendRootWindow * bpe);
+		static void benchmarkControllerEvents(BackendRootWindow * bpe);
 		static void createBase64State(CopyPasteTarget* target);
 		static void createUserInterface(BackendRootWindow * bpe);
 	};
@@ -170,7 +170,9 @@ ValueTree BaseExporter::collectAllSampleMapsInDirectory()
 		if (xml != nullptr)
 		{
 			ValueTree sampleMap = ValueTree::fromXml(*xml);
-			sampleMaps.addChild(sampleMap, -1, nullptr);
+
+			// The compiled plugin reads the sound records directly from the flat data
+			sampleMaps.addChild(FlatSampleMap::createEmbeddedSampleMap(sampleMap), -1, nullptr);
 		}
 	}
 
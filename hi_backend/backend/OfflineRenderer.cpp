@@ -0,0 +1,373 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+OfflineRenderer::ErrorCodes OfflineRenderer::renderFromCommandLine(const String& commandLine)
+{
+	const String options = commandLine.fromFirstOccurrenceOf("render", false, false);
+
+	StringArray args = StringArray::fromTokens(options, true);
+	args.removeEmptyStrings();
+
+	if (args.size() == 0)
+		return MissingArguments;
+
+	Settings settings;
+
+	const String sampleRate = getArgument(args, "-sr:");
+	const String blockSize = getArgument(args, "-bs:");
+	const String tail = getArgument(args, "-tail:");
+	const String numJobs = getArgument(args, "-j:");
+
+	if (sampleRate.isNotEmpty()) settings.sampleRate = jmax<double>(8000.0, sampleRate.getDoubleValue());
+	if (blockSize.isNotEmpty()) settings.blockSize = jlimit<int>(16, 8192, blockSize.getIntValue());
+	if (tail.isNotEmpty()) settings.tailSeconds = jmax<double>(0.0, tail.getDoubleValue());
+	if (numJobs.isNotEmpty()) settings.numParallelJobs = jmax<int>(1, numJobs.getIntValue());
+
+	const File jobList = getFileArgument(args, "-l:");
+
+	if (jobList != File())
+	{
+		if (!jobList.existsAsFile())
+			return JobListIsInvalid;
+
+		StringArray lines;
+		jobList.readLines(lines);
+
+		Array<Job> jobs;
+
+		for (auto line : lines)
+		{
+			if (line.trim().isEmpty() || line.trim().startsWith("#"))
+				continue;
+
+			StringArray tokens = StringArray::fromTokens(line, ";", "\"");
+
+			if (tokens.size() != 3)
+				return JobListIsInvalid;
+
+			Job job;
+			job.presetFile = jobList.getParentDirectory().getChildFile(tokens[0].trim().unquoted());
+			job.midiFile = jobList.getParentDirectory().getChildFile(tokens[1].trim().unquoted());
+			job.outputFile = jobList.getParentDirectory().getChildFile(tokens[2].trim().unquoted());
+
+			jobs.add(job);
+		}
+
+		return renderJobsInChildProcesses(jobs, settings);
+	}
+
+	Job job;
+
+	job.presetFile = File::getCurrentWorkingDirectory().getChildFile(args[0].unquoted());
+	job.midiFile = getFileArgument(args, "-m:");
+	job.outputFile = getFileArgument(args, "-o:");
+
+	if (job.midiFile == File() || job.outputFile == File())
+		return MissingArguments;
+
+	return renderJob(job, settings);
+}
+
+OfflineRenderer::ErrorCodes OfflineRenderer::renderJob(const Job& job, const Settings& settings)
+{
+	if (!job.presetFile.existsAsFile() || job.presetFile.getFileExtension() != ".hip")
+		return PresetIsInvalid;
+
+	MidiMessageSequence sequence;
+
+	if (!loadMidiFile(job.midiFile, sequence))
+		return MidiFileIsInvalid;
+
+	FileInputStream fis(job.presetFile);
+
+	ValueTree v = ValueTree::readFromStream(fis);
+
+	if (!v.isValid())
+		return PresetIsInvalid;
+
+	job.outputFile.deleteFile();
+
+	ScopedPointer<AudioFormatWriter> writer = createWriter(job.outputFile, settings.sampleRate);
+
+	if (writer == nullptr)
+		return OutputFileIsInvalid;
+
+	// Suppresses the popups
+	CompileExporter::setExportingFromCommandLine();
+
+	std::cout << "Rendering " << job.presetFile.getFileName() << " with " << job.midiFile.getFileName() << "...";
+
+	const int64 startTime = Time::getHighResolutionTicks();
+
+	AudioSampleBuffer output;
+
+	{
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+
+		ScopedWorkingProject swp(bp->getMainSynthChain(), job.presetFile.getParentDirectory().getParentDirectory());
+
+		bp->setNonRealtime(true);
+		bp->prepareToPlay(settings.sampleRate, settings.blockSize);
+		bp->loadPreset(v);
+
+		renderSequence(bp, sequence, settings, output);
+	}
+
+	writer->writeFromAudioSampleBuffer(output, 0, output.getNumSamples());
+	writer = nullptr;
+
+	const double lengthSeconds = (double)output.getNumSamples() / settings.sampleRate;
+	const double renderSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startTime);
+
+	std::cout << "DONE (" << String(renderSeconds, 2) << "s for " << String(lengthSeconds, 2) << "s of audio)" << std::endl;
+
+	return OK;
+}
+
+void OfflineRenderer::renderSequence(BackendProcessor* bp, const MidiMessageSequence& sequence, const Settings& settings, AudioSampleBuffer& output)
+{
+	const double lengthSeconds = sequence.getEndTime() + settings.tailSeconds;
+	const int numSamplesToRender = (int)(lengthSeconds * settings.sampleRate);
+
+	output.setSize(2, numSamplesToRender);
+	output.clear();
+
+	AudioSampleBuffer buffer(2, settings.blockSize);
+	MidiBuffer midiBuffer;
+
+	int eventIndex = 0;
+
+	for (int blockStart = 0; blockStart < numSamplesToRender; blockStart += settings.blockSize)
+	{
+		const int blockEnd = blockStart + settings.blockSize;
+
+		midiBuffer.clear();
+
+		while (eventIndex < sequence.getNumEvents())
+		{
+			const MidiMessage& m = sequence.getEventPointer(eventIndex)->message;
+			const int samplePosition = (int)(m.getTimeStamp() * settings.sampleRate);
+
+			if (samplePosition >= blockEnd)
+				break;
+
+			if (isRenderableMessage(m))
+				midiBuffer.addEvent(m, jmax<int>(0, samplePosition - blockStart));
+
+			eventIndex++;
+		}
+
+		buffer.clear();
+
+		bp->processBlock(buffer, midiBuffer);
+
+		const int numToCopy = jmin<int>(settings.blockSize, numSamplesToRender - blockStart);
+
+		output.copyFrom(0, blockStart, buffer, 0, 0, numToCopy);
+		output.copyFrom(1, blockStart, buffer, 1, 0, numToCopy);
+	}
+}
+
+OfflineRenderer::ScopedWorkingProject::ScopedWorkingProject(ModulatorSynthChain* chain_, const File& projectDirectory) :
+	chain(chain_),
+	previousProjectDirectory(GET_PROJECT_HANDLER(chain_).getWorkDirectory()),
+	switchBack(previousProjectDirectory != projectDirectory)
+{
+	if (switchBack)
+		GET_PROJECT_HANDLER(chain).setWorkingProject(projectDirectory, nullptr);
+}
+
+OfflineRenderer::ScopedWorkingProject::~ScopedWorkingProject()
+{
+	if (switchBack)
+		GET_PROJECT_HANDLER(chain).setWorkingProject(previousProjectDirectory, nullptr);
+}
+
+OfflineRenderer::ErrorCodes OfflineRenderer::renderJobsInChildProcesses(const Array<Job>& jobs, const Settings& settings)
+{
+	const String executable = File::getSpecialLocation(File::currentExecutableFile).getFullPathName();
+
+	OwnedArray<ChildProcess> runningProcesses;
+	ErrorCodes result = OK;
+
+	int nextJob = 0;
+
+	while (nextJob < jobs.size() || runningProcesses.size() != 0)
+	{
+		for (int i = runningProcesses.size(); --i >= 0;)
+		{
+			if (!runningProcesses[i]->isRunning())
+			{
+				std::cout << runningProcesses[i]->readAllProcessOutput();
+
+				if (runningProcesses[i]->getExitCode() != 0)
+					result = ChildProcessFailed;
+
+				runningProcesses.remove(i);
+			}
+		}
+
+		while (nextJob < jobs.size() && runningProcesses.size() < settings.numParallelJobs)
+		{
+			const Job& job = jobs.getReference(nextJob++);
+
+			StringArray args;
+
+			args.add(executable);
+			args.add("render");
+			args.add(job.presetFile.getFullPathName());
+			args.add("-m:" + job.midiFile.getFullPathName());
+			args.add("-o:" + job.outputFile.getFullPathName());
+			args.add("-sr:" + String(settings.sampleRate));
+			args.add("-bs:" + String(settings.blockSize));
+			args.add("-tail:" + String(settings.tailSeconds));
+
+			ScopedPointer<ChildProcess> process = new ChildProcess();
+
+			if (!process->start(args))
+			{
+				result = ChildProcessFailed;
+				continue;
+			}
+
+			runningProcesses.add(process.release());
+		}
+
+		Thread::sleep(50);
+	}
+
+	return result;
+}
+
+String OfflineRenderer::getArgument(const StringArray& args, const String& prefix)
+{
+	for (auto arg : args)
+	{
+		const String a = arg.unquoted();
+
+		if (a.startsWith(prefix))
+			return a.fromFirstOccurrenceOf(prefix, false, false).unquoted();
+	}
+
+	return String();
+}
+
+File OfflineRenderer::getFileArgument(const StringArray& args, const String& prefix)
+{
+	const String path = getArgument(args, prefix);
+
+	return path.isEmpty() ? File() : File::getCurrentWorkingDirectory().getChildFile(path);
+}
+
+bool OfflineRenderer::loadMidiFile(const File& midiFile, MidiMessageSequence& sequence)
+{
+	if (!midiFile.existsAsFile())
+		return false;
+
+	FileInputStream fis(midiFile);
+	MidiFile file;
+
+	if (!file.readFrom(fis))
+		return false;
+
+	file.convertTimestampTicksToSeconds();
+
+	for (int i = 0; i < file.getNumTracks(); i++)
+		sequence.addSequence(*file.getTrack(i), 0.0);
+
+	sequence.updateMatchedPairs();
+
+	return true;
+}
+
+AudioFormatWriter* OfflineRenderer::createWriter(const File& outputFile, double sampleRate)
+{
+	if (!outputFile.getParentDirectory().createDirectory())
+		return nullptr;
+
+	FileOutputStream* output = new FileOutputStream(outputFile);
+
+	if (output->failedToOpen())
+	{
+		delete output;
+		return nullptr;
+	}
+
+	StringPairArray empty;
+
+	if (outputFile.getFileExtension() == ".hlac")
+	{
+		hlac::HiseLosslessAudioFormat hlac;
+
+		AudioFormatWriter* writer = hlac.createWriterFor(output, sampleRate, 2, 16, empty, 5);
+
+		if (writer == nullptr)
+			delete output;
+
+		return writer;
+	}
+
+	WavAudioFormat wav;
+
+	AudioFormatWriter* writer = wav.createWriterFor(output, sampleRate, 2, 24, empty, 0);
+
+	if (writer == nullptr)
+		delete output;
+
+	return writer;
+}
+
+bool OfflineRenderer::isRenderableMessage(const MidiMessage& m)
+{
+	// HiseEvent only supports these types
+	return m.isNoteOnOrOff() || m.isController() || m.isPitchWheel() || m.isChannelPressure() || 
+		   m.isAftertouch() || m.isAllNotesOff() || m.isAllSoundOff();
+}
+
+String OfflineRenderer::getErrorMessage(ErrorCodes result)
+{
+	switch (result)
+	{
+	case OfflineRenderer::OK: return "OK";
+	case OfflineRenderer::MissingArguments: return "Missing arguments";
+	case OfflineRenderer::PresetIsInvalid: return "Preset file not found or invalid";
+	case OfflineRenderer::MidiFileIsInvalid: return "MIDI file not found or invalid";
+	case OfflineRenderer::OutputFileIsInvalid: return "Output file can't be written";
+	case OfflineRenderer::JobListIsInvalid: return "Job list not found or invalid";
+	case OfflineRenderer::ChildProcessFailed: return "At least one render process failed";
+	case OfflineRenderer::numErrorCodes: return "OK";
+	default:
+		break;
+	}
+
+	return "OK";
+}
@@ -0,0 +1,129 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef OFFLINERENDERER_H_INCLUDED
+#define OFFLINERENDERER_H_INCLUDED
+
+/** Renders presets with a MIDI file into audio files without an audio device and as fast as the CPU allows.
+*
+*	Every job creates its own BackendProcessor, loads the preset and feeds the MIDI file through the 
+*	usual processBlock() call. The processor is set to non realtime mode, so the disk streaming waits 
+*	for the sample data instead of dropping samples.
+*
+*	You can use it from the command line:
+*
+*		HISE render "Preset.hip" -m:"Input.mid" -o:"Output.wav" [-sr:44100] [-bs:512] [-tail:2.0]
+*		HISE render -l:"JobList.txt" [-j:4] [-sr:44100] [-bs:512] [-tail:2.0]
+*
+*	A job list contains one job per line as `Preset.hip;Input.mid;Output.wav`. The jobs are rendered in
+*	parallel child processes (one process per job, so that the presets don't share any global state).
+*	If the output file ends with `.hlac`, it will be written with the HISE lossless format.
+*/
+class OfflineRenderer
+{
+public:
+
+	enum ErrorCodes
+	{
+		OK = 0,
+		MissingArguments,
+		PresetIsInvalid,
+		MidiFileIsInvalid,
+		OutputFileIsInvalid,
+		JobListIsInvalid,
+		ChildProcessFailed,
+		numErrorCodes
+	};
+
+	struct Job
+	{
+		File presetFile;
+		File midiFile;
+		File outputFile;
+	};
+
+	struct Settings
+	{
+		double sampleRate = 44100.0;
+		int blockSize = 512;
+		double tailSeconds = 2.0;
+		int numParallelJobs = 1;
+	};
+
+	/** Parses the command line (everything after `render`) and renders the job(s). */
+	static ErrorCodes renderFromCommandLine(const String& commandLine);
+
+	/** Switches the working project for the lifetime of this object and restores the previous one afterwards. */
+	class ScopedWorkingProject
+	{
+	public:
+
+		ScopedWorkingProject(ModulatorSynthChain* chain_, const File& projectDirectory);
+
+		~ScopedWorkingProject();
+
+	private:
+
+		ModulatorSynthChain* chain;
+		File previousProjectDirectory;
+		bool switchBack;
+	};
+
+	/** Loads the preset into a new BackendProcessor and renders the MIDI file into the output file. */
+	static ErrorCodes renderJob(const Job& job, const Settings& settings);
+
+	/** Renders the sequence (with the timestamps in seconds) through the processor into the buffer.
+	*
+	*	The processor must already be prepared with the sample rate and block size of the settings. 
+	*	The buffer will be resized to the length of the sequence plus the tail.
+	*/
+	static void renderSequence(BackendProcessor* bp, const MidiMessageSequence& sequence, const Settings& settings, AudioSampleBuffer& output);
+
+	static String getErrorMessage(ErrorCodes result);
+
+private:
+
+	static ErrorCodes renderJobsInChildProcesses(const Array<Job>& jobs, const Settings& settings);
+
+	static String getArgument(const StringArray& args, const String& prefix);
+
+	static File getFileArgument(const StringArray& args, const String& prefix);
+
+	/** Reads all tracks of the MIDI file into one sequence with the timestamps in seconds. */
+	static bool loadMidiFile(const File& midiFile, MidiMessageSequence& sequence);
+
+	static AudioFormatWriter* createWriter(const File& outputFile, double sampleRate);
+
+	static bool isRenderableMessage(const MidiMessage& m);
+};
+
+#endif  // OFFLINERENDERER_H_INCLUDED
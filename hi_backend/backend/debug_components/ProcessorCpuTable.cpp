@@ -0,0 +1,168 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+ProcessorCpuTable::ProcessorCpuTable(BackendRootWindow* rootWindow) :
+	mc(rootWindow->getBackendProcessor()),
+	sortColumnId(Average),
+	sortForwards(false),
+	font(GLOBAL_FONT())
+{
+	addAndMakeVisible(table);
+	table.setModel(this);
+
+	laf = new TableHeaderLookAndFeel();
+
+	table.getHeader().setLookAndFeel(laf);
+	table.getHeader().setSize(getWidth(), 22);
+
+	table.setColour(ListBox::outlineColourId, Colours::black.withAlpha(0.5f));
+	table.setColour(ListBox::backgroundColourId, HiseColourScheme::getColour(HiseColourScheme::ColourIds::DebugAreaBackgroundColourId));
+
+	table.setOutlineThickness(0);
+
+	table.getViewport()->setScrollBarsShown(true, false, false, false);
+
+	table.getHeader().setInterceptsMouseClicks(true, true);
+
+	table.getHeader().addColumn("Processor", ProcessorId, 200);
+	table.getHeader().addColumn("Type", Type, 150);
+	table.getHeader().addColumn("Average %", Average, 70);
+	table.getHeader().addColumn("Peak %", Peak, 70);
+
+	table.getHeader().setSortColumnId(sortColumnId, sortForwards);
+
+	rebuildList();
+
+	startTimer(500);
+}
+
+ProcessorCpuTable::~ProcessorCpuTable()
+{
+	stopTimer();
+}
+
+void ProcessorCpuTable::timerCallback()
+{
+	rebuildList();
+}
+
+void ProcessorCpuTable::rebuildList()
+{
+	list.clearQuick();
+
+	Processor::collectCpuUsage(mc->getMainSynthChain(), list);
+
+	Sorter sorter(sortColumnId, sortForwards);
+	list.sort(sorter, true);
+
+	setName(getHeadline());
+
+	table.updateContent();
+	table.repaint();
+}
+
+int ProcessorCpuTable::getNumRows()
+{
+	return list.size();
+}
+
+void ProcessorCpuTable::paintRowBackground(Graphics& g, int rowNumber, int /*width*/, int /*height*/, bool rowIsSelected)
+{
+	if (rowNumber % 2) g.fillAll(Colours::white.withAlpha(0.05f));
+
+	if (rowIsSelected)
+		g.fillAll(Colour(0x44000000));
+}
+
+void ProcessorCpuTable::paintCell(Graphics& g, int rowNumber, int columnId, int width, int height, bool /*rowIsSelected*/)
+{
+	if (rowNumber >= list.size())
+		return;
+
+	const Processor::CpuUsageInfo& info = list.getReference(rowNumber);
+
+	g.setColour(Colours::white.withAlpha(info.average > 0.0f ? 0.8f : 0.4f));
+	g.setFont(font);
+
+	String text;
+
+	switch (columnId)
+	{
+	case ProcessorId:	text = info.id; break;
+	case Type:			text = info.type; break;
+	case Average:		text = String(info.average, 2); break;
+	case Peak:			text = String(info.peak, 2); break;
+	}
+
+	g.drawText(text, 2, 0, width - 4, height, Justification::centredLeft, true);
+}
+
+void ProcessorCpuTable::sortOrderChanged(int newSortColumnId, bool isForwards)
+{
+	sortColumnId = newSortColumnId;
+	sortForwards = isForwards;
+
+	rebuildList();
+}
+
+String ProcessorCpuTable::getHeadline() const
+{
+	String x;
+
+	x << "Processor CPU Usage - " << String(mc->getCpuUsage(), 1) << "% total";
+	return x;
+}
+
+void ProcessorCpuTable::resized()
+{
+	table.setBounds(getLocalBounds());
+
+	table.getHeader().setColumnWidth(ProcessorId, getWidth() - 290);
+	table.getHeader().setColumnWidth(Type, 150);
+	table.getHeader().setColumnWidth(Average, 70);
+	table.getHeader().setColumnWidth(Peak, 70);
+}
+
+int ProcessorCpuTable::Sorter::compareElements(const Processor::CpuUsageInfo& first, const Processor::CpuUsageInfo& second) const
+{
+	int result = 0;
+
+	switch (columnId)
+	{
+	case ProcessorId:	result = first.id.compareNatural(second.id); break;
+	case Type:			result = first.type.compareNatural(second.type); break;
+	case Average:		result = first.average < second.average ? -1 : (first.average > second.average ? 1 : 0); break;
+	case Peak:			result = first.peak < second.peak ? -1 : (first.peak > second.peak ? 1 : 0); break;
+	}
+
+	return forwards ? result : -result;
+}
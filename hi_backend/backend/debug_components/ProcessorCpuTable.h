@@ -0,0 +1,106 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef PROCESSORCPUTABLE_H_INCLUDED
+#define PROCESSORCPUTABLE_H_INCLUDED
+
+/** A table component showing the CPU usage of every Processor in the patch.
+*	@ingroup debugComponents
+*
+*	The values are measured on the audio thread (see Processor::addCpuTicks()) and polled with a timer, 
+*	so keeping this open has no impact on the audio rendering. Click on a column header to change the sort order.
+*/
+class ProcessorCpuTable : public Component,
+						  public TableListBoxModel,
+						  public Timer
+{
+public:
+
+	enum ColumnId
+	{
+		ProcessorId = 1,
+		Type,
+		Average,
+		Peak,
+		numColumns
+	};
+
+	ProcessorCpuTable(BackendRootWindow *rootWindow);
+
+	SET_GENERIC_PANEL_ID("ProcessorCpuTable");
+
+	~ProcessorCpuTable();
+
+	void timerCallback() override;
+
+	int getNumRows() override;
+
+	void paintRowBackground(Graphics& g, int rowNumber, int /*width*/, int /*height*/, bool rowIsSelected) override;
+
+	void paintCell(Graphics& g, int rowNumber, int columnId, int width, int height, bool /*rowIsSelected*/) override;
+
+	void sortOrderChanged(int newSortColumnId, bool isForwards) override;
+
+	String getHeadline() const;
+
+	void resized() override;
+
+private:
+
+	struct Sorter
+	{
+		Sorter(int columnId_, bool forwards_) : columnId(columnId_), forwards(forwards_) {};
+
+		int compareElements(const Processor::CpuUsageInfo& first, const Processor::CpuUsageInfo& second) const;
+
+		const int columnId;
+		const bool forwards;
+	};
+
+	void rebuildList();
+
+	MainController* mc;
+
+	Array<Processor::CpuUsageInfo> list;
+
+	int sortColumnId;
+	bool sortForwards;
+
+	TableListBox table;
+	Font font;
+
+	ScopedPointer<TableHeaderLookAndFeel> laf;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProcessorCpuTable)
+};
+
+#endif  // PROCESSORCPUTABLE_H_INCLUDED
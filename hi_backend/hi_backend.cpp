@@ -37,6 +37,7 @@
 #include "backend/BackendCommandIcons.cpp"
 
 #include "backend/debug_components/SamplePoolTable.cpp"
+#include "backend/debug_components/ProcessorCpuTable.cpp"
 #include "backend/debug_components/MacroEditTable.cpp"
 #include "backend/debug_components/ScriptWatchTable.cpp"
 #include "backend/debug_components/ProcessorCollection.cpp"
@@ -60,5 +61,6 @@
 #include "backend/StandaloneProjectTemplate.cpp"
 
 #include "backend/CompileExporter.cpp"
+#include "backend/OfflineRenderer.cpp"
 #include "backend/HisePlayerExporter.cpp"
 
@@ -59,6 +59,7 @@ using namespace juce;
 #include "backend/BackendBinaryData.h"
 
 #include "backend/debug_components/SamplePoolTable.h"
+#include "backend/debug_components/ProcessorCpuTable.h"
 #include "backend/debug_components/MacroEditTable.h"
 #include "backend/debug_components/ScriptWatchTable.h"
 #include "backend/debug_components/ProcessorCollection.h"
@@ -77,6 +78,7 @@ using namespace juce;
 #include "backend/BackendEditor.h"
 #include "backend/BackendRootWindow.h"
 #include "backend/CompileExporter.h"
+#include "backend/OfflineRenderer.h"
 #include "backend/HisePlayerExporter.h"
 
 
@@ -18,7 +18,7 @@
 
 	AudioAnalysisBase::AudioAnalysisBase()
 	{
-#if USE_IPP
+#if USE_IPP || USE_PORTABLE_FFT
 		realFloatFFTs = new FFTProcessor((int)IppFFT::DataType::RealFloat);
 		realDoubleFFTs = new FFTProcessor((int)IppFFT::DataType::RealDouble);
 		complexFloatFFTs = new FFTProcessor((int)IppFFT::DataType::ComplexFloat);
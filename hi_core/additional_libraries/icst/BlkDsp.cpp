@@ -25,7 +25,7 @@
 
 FFTProcessor::FFTProcessor(int fftDataType)
 {
-#if USE_IPP
+#if USE_IPP || USE_PORTABLE_FFT
 	fftData = new IppFFT((IppFFT::DataType)fftDataType);
 #else
 	ignoreUnused(fftDataType);
@@ -36,7 +36,7 @@ FFTProcessor::FFTProcessor(int fftDataType)
 
 IppFFT * FFTProcessor::getFFTObject()
 {
-#if USE_IPP
+#if USE_IPP || USE_PORTABLE_FFT
 	return fftData.get();
 #else
 	jassertfalse;
@@ -51,7 +51,7 @@ IppFFT * FFTProcessor::getFFTObject()
 // d[] = re[0],im[0],..,re[size-1],im[size-1].
 void FFTProcessor::fft(float* d, int size)
 {
-#ifdef ICSTLIB_USE_IPP
+#if defined(ICSTLIB_USE_IPP) || USE_PORTABLE_FFT
 
 	fftData->complexFFTInplace(d, size);
 
@@ -74,7 +74,7 @@ void FFTProcessor::fft(float* d, int size)
 
 void FFTProcessor::fft(double* d, int size)
 {
-#ifdef ICSTLIB_USE_IPP
+#if defined(ICSTLIB_USE_IPP) || USE_PORTABLE_FFT
 
 	fftData->complexFFTInplace(d, size);
 
@@ -99,7 +99,7 @@ void FFTProcessor::fft(double* d, int size)
 // d[] = re[0],im[0],..,re[size-1],im[size-1].
 void FFTProcessor::ifft(float* d, int size)
 {
-#ifdef ICSTLIB_USE_IPP
+#if defined(ICSTLIB_USE_IPP) || USE_PORTABLE_FFT
 
 	fftData->complexFFTInverseInplace(d, size);
 
@@ -122,7 +122,7 @@ void FFTProcessor::ifft(float* d, int size)
 
 void FFTProcessor::ifft(double* d, int size)
 {
-#ifdef ICSTLIB_USE_IPP
+#if defined(ICSTLIB_USE_IPP) || USE_PORTABLE_FFT
 
 	fftData->complexFFTInverseInplace(d, size);
 
@@ -149,7 +149,7 @@ void FFTProcessor::ifft(double* d, int size)
 // out: d[] = re[0],*re[size/2]*,re[1],im[1],..,re[size/2-1],im[size/2-1].
 void FFTProcessor::realfft(float* d, int size)
 {
-#ifdef ICSTLIB_USE_IPP
+#if defined(ICSTLIB_USE_IPP) || USE_PORTABLE_FFT
 
 	fftData->realFFTInplace(d, size);
 
@@ -173,7 +173,7 @@ void FFTProcessor::realfft(float* d, int size)
 
 void FFTProcessor::realfft(double* d, int size)
 {
-#ifdef ICSTLIB_USE_IPP
+#if defined(ICSTLIB_USE_IPP) || USE_PORTABLE_FFT
 
 	fftData->realFFTInplace(d, size);
 
@@ -199,7 +199,7 @@ void FFTProcessor::realfft(double* d, int size)
 // out: d[] = re[0],re[1],..,re[size-1].
 void FFTProcessor::realifft(float* d, int size)
 {
-#ifdef ICSTLIB_USE_IPP
+#if defined(ICSTLIB_USE_IPP) || USE_PORTABLE_FFT
 
 	fftData->realFFTInverseInplace(d, size);
 
@@ -224,7 +224,7 @@ void FFTProcessor::realifft(float* d, int size)
 
 void FFTProcessor::realifft(double* d, int size)
 {
-#ifdef ICSTLIB_USE_IPP
+#if defined(ICSTLIB_USE_IPP) || USE_PORTABLE_FFT
 
 	fftData->realFFTInverseInplace(d, size);
 
@@ -57,7 +57,7 @@ public:
 
 private:
 
-#if USE_IPP
+#if USE_IPP || USE_PORTABLE_FFT
 	ScopedPointer<IppFFT> fftData;
 #endif
 
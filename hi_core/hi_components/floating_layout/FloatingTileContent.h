@@ -334,6 +334,7 @@ public:
 			ImageTable,
 			AudioFileTable,
 			SamplePoolTable,
+			ProcessorCpuTable,
 			Matrix2x2,
 			ThreeColumns,
 			ThreeRows,
@@ -50,6 +50,7 @@ void FloatingTileContent::Factory::registerAllPanelTypes()
 	registerType<GenericPanel<PatchBrowser>>(PopupMenuOptions::PatchBrowser);
 	registerType<GenericPanel<FileBrowser>>(PopupMenuOptions::FileBrowser);
 	registerType<GenericPanel<SamplePoolTable>>(PopupMenuOptions::SamplePoolTable);
+	registerType<GenericPanel<ProcessorCpuTable>>(PopupMenuOptions::ProcessorCpuTable);
 	registerType<GenericPanel<PoolTableSubTypes::ImageFilePoolTable>>(PopupMenuOptions::ImageTable);
 	registerType<GenericPanel<PoolTableSubTypes::AudioFilePoolTable>>(PopupMenuOptions::AudioFileTable);
 	registerType<MainTopBar>(PopupMenuOptions::MenuCommandOffset);
@@ -424,6 +425,11 @@ Path FloatingTileContent::Factory::getPath(PopupMenuOptions type)
 		BACKEND_ONLY(path.loadPathFromData(BackendBinaryData::ToolbarIcons::sampleTable, sizeof(BackendBinaryData::ToolbarIcons::sampleTable)));
 		break;
 	}
+	case PopupMenuOptions::ProcessorCpuTable:
+	{
+		BACKEND_ONLY(path.loadPathFromData(BackendBinaryData::ToolbarIcons::debugPanel, sizeof(BackendBinaryData::ToolbarIcons::debugPanel)));
+		break;
+	}
 	case PopupMenuOptions::AudioFileTable:
 	{
 		BACKEND_ONLY(path.loadPathFromData(BackendBinaryData::ToolbarIcons::fileTable, sizeof(BackendBinaryData::ToolbarIcons::fileTable)));
@@ -542,6 +548,7 @@ void FloatingTileContent::Factory::handlePopupMenu(PopupMenu& m, FloatingTile* p
 		addToPopupMenu(m, PopupMenuOptions::Note, "Note");
 		addToPopupMenu(m, PopupMenuOptions::AudioFileTable, "Audio File Pool Table");
 		addToPopupMenu(m, PopupMenuOptions::ImageTable, "Image Pool Table");
+		addToPopupMenu(m, PopupMenuOptions::ProcessorCpuTable, "Processor CPU Usage");
 
 		m.addSeparator();
 
@@ -603,6 +610,7 @@ void FloatingTileContent::Factory::handlePopupMenu(PopupMenu& m, FloatingTile* p
 	case PopupMenuOptions::SamplePoolTable:		parent->setNewContent(GET_PANEL_NAME(GenericPanel<SamplePoolTable>)); break;
 	case PopupMenuOptions::AudioFileTable:		parent->setNewContent(GET_PANEL_NAME(GenericPanel<PoolTableSubTypes::AudioFilePoolTable>)); break;
 	case PopupMenuOptions::ImageTable:			parent->setNewContent(GET_PANEL_NAME(GenericPanel<PoolTableSubTypes::ImageFilePoolTable>)); break;
+	case PopupMenuOptions::ProcessorCpuTable:	parent->setNewContent(GET_PANEL_NAME(GenericPanel<ProcessorCpuTable>)); break;
 	case PopupMenuOptions::ScriptWatchTable:		parent->setNewContent(GET_PANEL_NAME(GenericPanel<ScriptWatchTable>)); break;
 	case PopupMenuOptions::toggleGlobalLayoutMode:    parent->getRootComponent()->setLayoutModeEnabled(!parent->isLayoutModeEnabled()); break;
 	case PopupMenuOptions::exportAsJSON:		SystemClipboard::copyTextToClipboard(parent->exportAsJSON()); break;
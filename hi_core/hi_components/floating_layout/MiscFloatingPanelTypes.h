@@ -498,7 +498,8 @@ class ProcessorPeakMeter : public Component,
 public:
 
 	ProcessorPeakMeter(Processor* p) :
-		processor(p)
+		processor(p),
+		peakMeterSubscription(p)
 	{
 		addAndMakeVisible(vuMeter = new VuMeter());
 
@@ -537,7 +538,7 @@ public:
 	{
 		if (processor.get())
 		{
-			const auto& values = processor->getDisplayValues();
+			const auto values = processor->updateAndGetDisplayValues();
 
 			vuMeter->setPeak(values.outL, values.outR);
 		}
@@ -549,6 +550,8 @@ private:
 
 	WeakReference<Processor> processor;
 
+	Processor::PeakMeterSubscription peakMeterSubscription;
+
 };
 
 
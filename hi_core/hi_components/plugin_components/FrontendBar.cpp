@@ -31,12 +31,21 @@
 */
 
 
+/** Wraps the peak meter subscription so that the header doesn't need the Processor declaration. */
+struct DefaultFrontendBar::MeterSubscription
+{
+	MeterSubscription(Processor* p) : subscription(p) {};
+
+	Processor::PeakMeterSubscription subscription;
+};
+
 DefaultFrontendBar::DefaultFrontendBar(MainController *mc_) : mc(mc_),
 												height(32),
 												overlaying(false)
 {
 	
 	addAndMakeVisible (outMeter = new VuMeter (0.0, 0.0, VuMeter::StereoVertical));
+	meterSubscription = new MeterSubscription(mc->getMainSynthChain());
     outMeter->setName ("new component");
 
 	Colour dark(0xFF333333);
@@ -291,10 +300,9 @@ void DefaultFrontendBar::sliderValueChanged(Slider* slider)
 
 void DefaultFrontendBar::timerCallback()
 {
-	const float l = mc->getMainSynthChain()->getDisplayValues().outL;
-	const float r = mc->getMainSynthChain()->getDisplayValues().outR;
+	const Processor::DisplayValues values = mc->getMainSynthChain()->updateAndGetDisplayValues();
 
-	outMeter->setPeak(l, r);
+	outMeter->setPeak(values.outL, values.outR);
 
 	if (cpuUpdater.shouldUpdate())
 	{
@@ -116,6 +116,9 @@ private:
 
 	ScopedPointer<VuMeter> outMeter;
 
+	struct MeterSubscription;
+	ScopedPointer<MeterSubscription> meterSubscription;
+
 	ScopedPointer<ShapeButton> deviceSettingsButton;
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DefaultFrontendBar)
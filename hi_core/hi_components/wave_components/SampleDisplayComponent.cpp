@@ -55,6 +55,8 @@ SamplerSoundWaveform::SamplerSoundWaveform(const ModulatorSampler *ownerSampler)
 	areas[SampleStartArea]->leftEdge->setVisible(false);
 	areas[LoopCrossfadeArea]->rightEdge->setVisible(false);
 
+	peakCache->addChangeListener(this);
+
 	setOpaque(true);
 
 #ifdef JUCE_DEBUG
@@ -72,7 +74,7 @@ SamplerSoundWaveform::SamplerSoundWaveform(const ModulatorSampler *ownerSampler)
 
 SamplerSoundWaveform::~SamplerSoundWaveform()
 {
-	
+	peakCache->removeChangeListener(this);
 }
 
 void SamplerSoundWaveform::timerCallback() 
@@ -135,9 +137,9 @@ void SamplerSoundWaveform::toggleRangeEnabled(AreaTypes type)
 
 void AudioDisplayComponent::drawWaveForm(Graphics &g)
 {
-    
-    
-	if(preview->getTotalLength() == 0.0) return; // Nothing to draw
+	const int64 totalSamples = getTotalSampleAmount();
+
+	if(totalSamples == 0) return; // Nothing to draw
 
 	g.setGradientFill (ColourGradient (Colour (0xaaffffff),
 							0.0f, 0.0f,
@@ -145,43 +147,80 @@ void AudioDisplayComponent::drawWaveForm(Graphics &g)
 							0.0f, (float) getHeight(),
 							false));
 
-	const double totalSamples = getTotalSampleAmount();
-
 	const float normalizedGain = getNormalizedPeak();
 
+	const int64 playStart = areas[0]->getSampleRange().getStart();
+	const int64 playEnd = areas[0]->getSampleRange().getEnd();
+
 	// Draw the pre part
 
-	const double prePart = areas[0]->getSampleRange().getStart() / totalSamples;
-	const double preSeconds = prePart * preview->getTotalLength();
+	const double prePart = (double)playStart / (double)totalSamples;
 
 	const Rectangle<int> preArea = Rectangle<int>(0, 0, (int)(prePart * getWidth()), getHeight());
 
-	
-
 	g.setColour(Colours::white.withAlpha(0.3f));
 
-	preview->drawChannels(g, preArea, 0.0, preSeconds, normalizedGain);
+	drawWaveformPart(g, preArea, 0, playStart, normalizedGain);
 
 	// Draw the play part
 
-	const double playPart = areas[0]->getSampleRange().getLength() / totalSamples;
-	const double playSeconds = playPart * preview->getTotalLength();
+	const double playPart = (double)(playEnd - playStart) / (double)totalSamples;
 
 	const Rectangle<int> playArea = Rectangle<int>(preArea.getRight(), 0, (int)(playPart * getWidth()), getHeight());
 
 	g.setColour(Colours::white.withAlpha(0.8f));
 
-	preview->drawChannels(g, playArea, preSeconds, preSeconds + playSeconds, normalizedGain);
+	drawWaveformPart(g, playArea, playStart, playEnd, normalizedGain);
 
 	// Draw the post part
 
-	const double postPart = (totalSamples - areas[0]->getSampleRange().getEnd()) / totalSamples;
+	const double postPart = (double)(totalSamples - playEnd) / (double)totalSamples;
 
 	const Rectangle<int> postArea = Rectangle<int>(playArea.getRight(), 0, (int)(postPart * getWidth()), getHeight());
 
 	g.setColour(Colours::white.withAlpha(0.3f));
 
-	preview->drawChannels(g, postArea, preSeconds + playSeconds, preview->getTotalLength(), normalizedGain);
+	drawWaveformPart(g, postArea, playEnd, totalSamples, normalizedGain);
+}
+
+void AudioDisplayComponent::drawWaveformPart(Graphics &g, const Rectangle<int> &area, int64 startSample, int64 endSample, float gain)
+{
+	const double secondsPerSample = preview->getTotalLength() / (double)getTotalSampleAmount();
+
+	preview->drawChannels(g, area, (double)startSample * secondsPerSample, (double)endSample * secondsPerSample, gain);
+}
+
+void SamplerSoundWaveform::drawWaveformPart(Graphics &g, const Rectangle<int> &area, int64 startSample, int64 endSample, float gain)
+{
+	if (peakFile != nullptr)
+	{
+		peakFile->drawChannels(g, area, startSample, endSample, gain);
+	}
+	else
+	{
+		AudioDisplayComponent::drawWaveformPart(g, area, startSample, endSample, gain);
+	}
+}
+
+int SamplerSoundWaveform::getTotalSampleAmount() const
+{
+	if (peakFile != nullptr) return (int)peakFile->getLengthInSamples();
+
+	return AudioDisplayComponent::getTotalSampleAmount();
+}
+
+void SamplerSoundWaveform::changeListenerCallback(SafeChangeBroadcaster * /*b*/)
+{
+	if (currentSound != nullptr && peakFile == nullptr && !currentSound->isMissing() && !currentSound->isPurged())
+	{
+		peakFile = peakCache->getPeakFile(currentSound->getReferenceToSound());
+
+		if (peakFile != nullptr)
+		{
+			preview->clear();
+			repaint();
+		}
+	}
 }
 
 double SamplerSoundWaveform::getSampleRate() const
@@ -248,6 +287,18 @@ void SamplerSoundWaveform::setSoundToDisplay(const ModulatorSamplerSound *s)
 
 		StreamingSamplerSound::Ptr sound = s->getReferenceToSound(); // The first sample is enough
 
+		peakFile = peakCache->getPeakFile(sound);
+
+		if (peakFile != nullptr)
+		{
+			// The peak file has all the information, so the audio file doesn't need to be read
+			numSamplesInCurrentSample = (int)peakFile->getLengthInSamples();
+			preview->clear();
+
+			updateRanges();
+			return;
+		}
+
 		ScopedPointer<AudioFormatReader> afr;
 
 		if (sound->isMonolithic())
@@ -275,6 +326,7 @@ void SamplerSoundWaveform::setSoundToDisplay(const ModulatorSamplerSound *s)
 	else
 	{
 		currentSound = nullptr;
+		peakFile = nullptr;
 
 		for(int i = 0; i < areas.size(); i++)
 		{
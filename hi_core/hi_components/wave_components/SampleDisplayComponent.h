@@ -36,6 +36,8 @@
 
 class ModulatorSampler;
 class ModulatorSamplerSound;
+class WaveformPeakFile;
+class WaveformPeakCache;
 
 class AudioDisplayComponent;
 
@@ -302,14 +304,14 @@ public:
 		g.setColour(Colours::lightgrey.withAlpha(0.1f));
 		g.drawRect(getLocalBounds(), 1);
 
-		if(preview->getTotalLength() == 0.0) return;
+		if(getTotalSampleAmount() == 0) return;
 
 		drawWaveForm(g);
 
 		drawPlaybackBar(g);
 	}
 
-	int getTotalSampleAmount() const
+	virtual int getTotalSampleAmount() const
 	{
 		return (int)(preview->getTotalLength() * getSampleRate());
 	}
@@ -328,6 +330,12 @@ public:
 
 protected:
 
+	/** Draws the given sample range of the waveform into the area. 
+	*
+	*	The default implementation uses the AudioThumbnail, overwrite this if you have a faster source for the waveform data.
+	*/
+	virtual void drawWaveformPart(Graphics &g, const Rectangle<int> &area, int64 startSample, int64 endSample, float gain);
+
 	OwnedArray<SampleArea> areas;
 
 	AudioFormatManager afm;
@@ -355,7 +363,8 @@ private:
 *	It uses a timer to display the current playbar.
 */
 class SamplerSoundWaveform: public AudioDisplayComponent,
-							public Timer
+							public Timer,
+							public SafeChangeListener
 {
 public:
 
@@ -410,11 +419,25 @@ public:
 
 	float getNormalizedPeak() override;
 
+	int getTotalSampleAmount() const override;
+
+	/** Called by the WaveformPeakCache when a peak file was created. */
+	void changeListenerCallback(SafeChangeBroadcaster *b) override;
+
+protected:
+
+	void drawWaveformPart(Graphics &g, const Rectangle<int> &area, int64 startSample, int64 endSample, float gain) override;
+
 private:
 
 	const ModulatorSampler *sampler;
 	WeakReference<ModulatorSamplerSound> currentSound;
 
+	SharedResourcePointer<WaveformPeakCache> peakCache;
+
+	/** The peak file of the current sound. If it isn't created yet, the AudioThumbnail is used. */
+	ReferenceCountedObjectPtr<WaveformPeakFile> peakFile;
+
 	int numSamplesInCurrentSample;
 
 	
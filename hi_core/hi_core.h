@@ -115,6 +115,14 @@ Use the Intel Performance Primitives Library for the convolution reverb.
 #define USE_VDSP_FFT 0
 #endif
 
+/** Config: USE_PORTABLE_FFT
+*
+* Use the built in FFT engine as backend for the IppFFT class. This is enabled by default if USE_IPP is disabled.
+*/
+#ifndef USE_PORTABLE_FFT
+#define USE_PORTABLE_FFT !USE_IPP
+#endif
+
 /** Config: FRONTEND_IS_PLUGIN
 
 If set to 1, the compiled plugin will be a effect (stereo in / out). */
@@ -212,6 +220,23 @@ Set this to 0 to deactivate the CPU peak meter.
 #define ENABLE_CPU_MEASUREMENT 1
 #endif
 
+/** Config: ENABLE_PROCESSOR_CPU_COUNTERS
+
+Set this to 1 to measure the CPU usage of every module (enabled in the backend only by default, because it reads the timer for every module and voice).
+*/
+#ifndef ENABLE_PROCESSOR_CPU_COUNTERS
+#define ENABLE_PROCESSOR_CPU_COUNTERS USE_BACKEND
+#endif
+
+/** Config: HISE_SAMPLE_ACCURATE_CONTROLLERS
+
+Set this to 1 to render controller events as sample accurate modulation instead of splitting the 
+audio block at every event (only note events will split the block). This can be changed at runtime.
+*/
+#ifndef HISE_SAMPLE_ACCURATE_CONTROLLERS
+#define HISE_SAMPLE_ACCURATE_CONTROLLERS 0
+#endif
+
 
 #ifndef ENABLE_APPLE_SANDBOX
 #define ENABLE_APPLE_SANDBOX 0
@@ -0,0 +1,260 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+class BackgroundTaskPool::Job : public ThreadPoolJob
+{
+public:
+
+	Job(BackgroundTaskPool& parent_, Task* t_) :
+		ThreadPoolJob(t_->getName()),
+		parent(parent_),
+		t(t_)
+	{}
+
+	~Job()
+	{
+		// The job was removed from the pool before it could run...
+		if (!executed)
+		{
+			t->signalTaskShouldExit();
+			parent.taskFinished(t);
+		}
+	}
+
+	JobStatus runJob() override
+	{
+		executed = true;
+
+		if (!t->shouldExit())
+		{
+			t->running.store(true);
+			t->runOnWorkerThread();
+			t->running.store(false);
+		}
+
+		parent.taskFinished(t);
+
+		return jobHasFinished;
+	}
+
+private:
+
+	BackgroundTaskPool& parent;
+	Task* t;
+	bool executed = false;
+};
+
+BackgroundTaskPool::Task::Task(const String& name_, CallbackThread callbackThread_) :
+	pending(false),
+	running(false),
+	shouldStop(false),
+	callbackThread(callbackThread_),
+	name(name_)
+{
+
+}
+
+void BackgroundTaskPool::FinishedTaskStack::push(Task* t) noexcept
+{
+	Task* oldHead = head.load();
+
+	do
+	{
+		t->nextInQueue = oldHead;
+	} 
+	while (!head.compare_exchange_weak(oldHead, t));
+}
+
+BackgroundTaskPool::Task* BackgroundTaskPool::FinishedTaskStack::popAll() noexcept
+{
+	Task* t = head.exchange(nullptr);
+
+	// Reverse the list so that the tasks are handled in the order they have finished
+	Task* reversed = nullptr;
+
+	while (t != nullptr)
+	{
+		Task* next = t->nextInQueue;
+		t->nextInQueue = reversed;
+		reversed = t;
+		t = next;
+	}
+
+	return reversed;
+}
+
+BackgroundTaskPool::BackgroundTaskPool(int numThreads) :
+	audioThreadTasksHandled(false),
+	numPendingTasks(0),
+	pool(numThreads > 0 ? numThreads : jlimit<int>(1, 8, SystemStats::getNumCpus() - 2))
+{
+	startTimer(50);
+}
+
+BackgroundTaskPool::~BackgroundTaskPool()
+{
+	stopTimer();
+
+	// The jobs still reference this object, so this must wait until every running task has returned
+	cancelAllTasks(-1);
+
+	cancelPendingUpdate();
+
+	// Don't call any result handlers during teardown, just release the remaining tasks
+	releaseAllTasks(finishedAudioThreadTasks);
+	releaseAllTasks(handledAudioThreadTasks);
+	releaseAllTasks(finishedMessageThreadTasks);
+
+	jassert(numPendingTasks.load() == 0);
+}
+
+bool BackgroundTaskPool::addTask(Task* taskToAdd)
+{
+	jassert(taskToAdd != nullptr);
+
+	if (taskToAdd->isPending())
+		return false;
+
+	taskToAdd->shouldStop.store(false);
+	taskToAdd->pending.store(true);
+
+	// The pool keeps a reference until the result was handled
+	taskToAdd->incReferenceCount();
+
+	++numPendingTasks;
+
+	{
+		ScopedLock sl(activeTaskLock);
+		activeTasks.add(taskToAdd);
+	}
+
+	pool.addJob(new Job(*this, taskToAdd), true);
+
+	return true;
+}
+
+void BackgroundTaskPool::cancelAllTasks(int timeOutMilliseconds)
+{
+	{
+		ScopedLock sl(activeTaskLock);
+
+		// This also discards the results of tasks that are finished but not yet handled
+		for (int i = 0; i < activeTasks.size(); i++)
+			activeTasks[i]->signalTaskShouldExit();
+	}
+
+	pool.removeAllJobs(true, timeOutMilliseconds);
+}
+
+void BackgroundTaskPool::handleAudioThreadResults()
+{
+	Task* t = finishedAudioThreadTasks.popAll();
+
+	if (t == nullptr)
+		return;
+
+	while (t != nullptr)
+	{
+		Task* next = t->nextInQueue;
+
+		if (!t->shouldExit())
+			t->handleResult();
+
+		// Releasing the task might deallocate it, so this is deferred to the message thread
+		handledAudioThreadTasks.push(t);
+
+		t = next;
+	}
+
+	audioThreadTasksHandled.store(true);
+}
+
+void BackgroundTaskPool::handleAsyncUpdate()
+{
+	Task* t = finishedMessageThreadTasks.popAll();
+
+	while (t != nullptr)
+	{
+		Task* next = t->nextInQueue;
+
+		if (!t->shouldExit())
+			t->handleResult();
+
+		releaseTask(t);
+		t = next;
+	}
+
+	releaseAllTasks(handledAudioThreadTasks);
+}
+
+void BackgroundTaskPool::timerCallback()
+{
+	if (audioThreadTasksHandled.exchange(false))
+		releaseAllTasks(handledAudioThreadTasks);
+}
+
+void BackgroundTaskPool::taskFinished(Task* t)
+{
+	if (t->getCallbackThread() == CallbackThread::AudioThread && !t->shouldExit())
+	{
+		finishedAudioThreadTasks.push(t);
+	}
+	else
+	{
+		finishedMessageThreadTasks.push(t);
+		triggerAsyncUpdate();
+	}
+}
+
+void BackgroundTaskPool::releaseTask(Task* t)
+{
+	{
+		ScopedLock sl(activeTaskLock);
+		activeTasks.removeFirstMatchingValue(t);
+	}
+
+	t->pending.store(false);
+	--numPendingTasks;
+	t->decReferenceCount();
+}
+
+void BackgroundTaskPool::releaseAllTasks(FinishedTaskStack& stack)
+{
+	Task* t = stack.popAll();
+
+	while (t != nullptr)
+	{
+		Task* next = t->nextInQueue;
+		releaseTask(t);
+		t = next;
+	}
+}
@@ -0,0 +1,195 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef BACKGROUNDTASKPOOL_H_INCLUDED
+#define BACKGROUNDTASKPOOL_H_INCLUDED
+
+/** A thread pool for heavy non realtime operations that would otherwise block the audio or the message thread.
+*	@ingroup core
+*
+*	You can add a Task which will be executed on one of the worker threads. As soon as the task has finished,
+*	it will be handed back to either the message thread or the audio thread (using a lock free queue) where 
+*	its handleResult() method will be called.
+*
+*	Every MainController owns one instance of this class which can be accessed with MainController::getBackgroundTaskPool().
+*/
+class BackgroundTaskPool : public AsyncUpdater,
+						   public Timer
+{
+public:
+
+	/** The thread that will call the Task::handleResult() method. */
+	enum class CallbackThread
+	{
+		MessageThread = 0,
+		AudioThread,
+		numCallbackThreads
+	};
+
+	/** A task that can be added to the BackgroundTaskPool.
+	*
+	*	Subclass this, do the work in runOnWorkerThread() and store the result in a member variable which you
+	*	can then use in handleResult().
+	*/
+	class Task : public ReferenceCountedObject
+	{
+	public:
+
+		typedef ReferenceCountedObjectPtr<Task> Ptr;
+
+		Task(const String& name_, CallbackThread callbackThread_ = CallbackThread::MessageThread);
+
+		virtual ~Task() {};
+
+		/** Overwrite this method and do the heavy lifting. It will be called on a worker thread. */
+		virtual void runOnWorkerThread() = 0;
+
+		/** Overwrite this method and use the result. It will be called on the thread specified in the constructor. 
+		*
+		*	If the callback thread is the audio thread, this will be called at the start of the next audio block,
+		*	so you must not allocate / lock in there.
+		*/
+		virtual void handleResult() = 0;
+
+		/** Check this regularly in your runOnWorkerThread() method and return as soon as possible if it returns true. */
+		bool shouldExit() const noexcept { return shouldStop.load(); }
+
+		/** Signals the task that it should stop. The handleResult() method will not be called afterwards. */
+		void signalTaskShouldExit() noexcept { shouldStop.store(true); }
+
+		/** Returns true if the task is queued or currently executed. */
+		bool isPending() const noexcept { return pending.load(); }
+
+		/** Returns true if the task is currently executed by a worker thread. */
+		bool isRunning() const noexcept { return running.load(); }
+
+		CallbackThread getCallbackThread() const noexcept { return callbackThread; }
+
+		const String& getName() const noexcept { return name; }
+
+	private:
+
+		friend class BackgroundTaskPool;
+
+		Task* nextInQueue = nullptr;
+
+		std::atomic<bool> pending;
+		std::atomic<bool> running;
+		std::atomic<bool> shouldStop;
+
+		const CallbackThread callbackThread;
+		const String name;
+
+		JUCE_DECLARE_NON_COPYABLE(Task);
+	};
+
+	/** Creates a pool. If numThreads is -1, it will use all but two CPU cores (but at least one and not more than 8). */
+	BackgroundTaskPool(int numThreads=-1);
+
+	~BackgroundTaskPool();
+
+	/** Adds a task to the pool. 
+	*
+	*	This allocates, so don't call it from the audio thread. Returns false if the task is already pending.
+	*/
+	bool addTask(Task* taskToAdd);
+
+	/** Stops all tasks and waits until the worker threads are idle. 
+	*
+	*	Every pending task will be signalled to exit, so neither the running tasks nor the tasks that have already 
+	*	finished will get their handleResult() callback. Pass -1 to wait until every running task has returned.
+	*/
+	void cancelAllTasks(int timeOutMilliseconds=1000);
+
+	/** Returns the number of tasks that are queued, running or waiting for their result callback. */
+	int getNumPendingTasks() const noexcept { return numPendingTasks.load(); }
+
+	/** Calls handleResult() for all finished tasks that are supposed to be handled on the audio thread.
+	*
+	*	This is called by the MainController at the beginning of each audio block.
+	*/
+	void handleAudioThreadResults();
+
+	/** \internal Calls handleResult() for all finished message thread tasks and releases the handled audio thread tasks. */
+	void handleAsyncUpdate() override;
+
+	/** \internal Polls the flag that is set by handleAudioThreadResults() (the audio thread can't post a message). */
+	void timerCallback() override;
+
+private:
+
+	class Job;
+
+	/** A simple lock free LIFO that can be fed from multiple worker threads and is emptied by a single consumer. */
+	class FinishedTaskStack
+	{
+	public:
+
+		FinishedTaskStack() : head(nullptr) {};
+
+		/** Pushes the task. Can be called from multiple threads at once. */
+		void push(Task* t) noexcept;
+
+		/** Removes all tasks and returns them in the order they were pushed. */
+		Task* popAll() noexcept;
+
+	private:
+
+		std::atomic<Task*> head;
+	};
+
+	void taskFinished(Task* t);
+
+	void releaseTask(Task* t);
+
+	/** Releases all tasks of the stack without calling their handleResult() method. */
+	void releaseAllTasks(FinishedTaskStack& stack);
+
+	/** All tasks between addTask() and releaseTask() so that cancelAllTasks() can signal them. */
+	CriticalSection activeTaskLock;
+	Array<Task*> activeTasks;
+
+	FinishedTaskStack finishedMessageThreadTasks;
+	FinishedTaskStack finishedAudioThreadTasks;
+	FinishedTaskStack handledAudioThreadTasks;
+
+	std::atomic<bool> audioThreadTasksHandled;
+
+	std::atomic<int> numPendingTasks;
+
+	// The running jobs call taskFinished(), so the pool must be destroyed before the other members
+	ThreadPool pool;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BackgroundTaskPool);
+};
+
+#endif  // BACKGROUNDTASKPOOL_H_INCLUDED
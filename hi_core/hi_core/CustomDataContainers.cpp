@@ -128,6 +128,98 @@ int UnorderedStack<ElementType>::size() const
 	return (int)position;
 }
 
+template <typename ElementType>
+LockfreeQueue<ElementType>::LockfreeQueue(int capacity) :
+	cells((size_t)nextPowerOfTwo(jmax<int>(2, capacity))),
+	mask(cells.size() - 1),
+	enqueuePosition(0),
+	dequeuePosition(0)
+{
+	for (size_t i = 0; i < cells.size(); i++)
+		cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+
+template <typename ElementType>
+bool LockfreeQueue<ElementType>::push(ElementType&& elementToPush) noexcept
+{
+	size_t position = enqueuePosition.load(std::memory_order_relaxed);
+	Cell* cell;
+
+	for (;;)
+	{
+		cell = &cells[position & mask];
+
+		const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+		const intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+		if (difference == 0)
+		{
+			if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (difference < 0)
+		{
+			return false; // full...
+		}
+		else
+		{
+			position = enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	cell->data = std::move(elementToPush);
+	cell->sequence.store(position + 1, std::memory_order_release);
+
+	return true;
+}
+
+
+template <typename ElementType>
+bool LockfreeQueue<ElementType>::pop(ElementType& poppedElement) noexcept
+{
+	size_t position = dequeuePosition.load(std::memory_order_relaxed);
+	Cell* cell;
+
+	for (;;)
+	{
+		cell = &cells[position & mask];
+
+		const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+		const intptr_t difference = (intptr_t)sequence - (intptr_t)(position + 1);
+
+		if (difference == 0)
+		{
+			if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (difference < 0)
+		{
+			return false; // empty...
+		}
+		else
+		{
+			position = dequeuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	poppedElement = std::move(cell->data);
+	cell->data = ElementType();
+	cell->sequence.store(position + mask + 1, std::memory_order_release);
+
+	return true;
+}
+
+
+template <typename ElementType>
+int LockfreeQueue<ElementType>::size() const noexcept
+{
+	const size_t numPushed = enqueuePosition.load(std::memory_order_relaxed);
+	const size_t numPopped = dequeuePosition.load(std::memory_order_relaxed);
+
+	return numPushed > numPopped ? (int)(numPushed - numPopped) : 0;
+}
+
 /** ============================================================================================================================== UNIT TEST */
 
 class UnorderedStackTest : public UnitTest
@@ -266,3 +358,123 @@ public:
 
 static UnorderedStackTest unorderedStackTest;
 
+class LockfreeQueueTest : public UnitTest
+{
+public:
+
+	LockfreeQueueTest() :
+		UnitTest("Testing lockfree queue")
+	{
+
+	}
+
+	class Producer : public Thread
+	{
+	public:
+
+		Producer(LockfreeQueue<int>& queue_, int offset_) :
+			Thread("Producer"),
+			queue(queue_),
+			offset(offset_)
+		{};
+
+		void run() override
+		{
+			for (int i = 0; i < numValuesPerThread; i++)
+			{
+				while (!queue.push(offset + i))
+					Thread::sleep(1);
+			}
+		}
+
+		static const int numValuesPerThread = 10000;
+
+	private:
+
+		LockfreeQueue<int>& queue;
+		const int offset;
+	};
+
+	void runTest() override
+	{
+		beginTest("Testing single thread");
+
+		LockfreeQueue<int> queue(5);
+
+		expectEquals<int>(queue.getCapacity(), 8, "Capacity is power of two");
+
+		for (int i = 0; i < 8; i++)
+			expect(queue.push(int(i)), "Push");
+
+		expect(!queue.push(9), "Push into full queue");
+		expectEquals<int>(queue.size(), 8, "Size");
+
+		int value = -1;
+
+		for (int i = 0; i < 8; i++)
+		{
+			expect(queue.pop(value), "Pop");
+			expectEquals<int>(value, i, "FIFO order");
+		}
+
+		expect(!queue.pop(value), "Pop from empty queue");
+		expect(queue.isEmpty(), "Empty");
+
+		beginTest("Testing std::function elements");
+
+		LockfreeQueue<std::function<void()>> functionQueue(4);
+
+		int counter = 0;
+
+		functionQueue.push([&counter]() { counter++; });
+		functionQueue.push([&counter]() { counter += 10; });
+
+		std::function<void()> f;
+
+		while (functionQueue.pop(f))
+			f();
+
+		expectEquals<int>(counter, 11, "Executed functions");
+
+		beginTest("Testing multiple producers");
+
+		LockfreeQueue<int> mpQueue(256);
+		
+		OwnedArray<Producer> producers;
+
+		for (int i = 0; i < 4; i++)
+			producers.add(new Producer(mpQueue, i * Producer::numValuesPerThread));
+
+		for (auto p : producers)
+			p->startThread();
+
+		BigInteger receivedValues;
+		int numReceived = 0;
+		const int numExpected = 4 * Producer::numValuesPerThread;
+		
+		const uint32 startTime = Time::getMillisecondCounter();
+
+		while (numReceived < numExpected && Time::getMillisecondCounter() - startTime < 10000)
+		{
+			if (mpQueue.pop(value))
+			{
+				receivedValues.setBit(value);
+				numReceived++;
+			}
+			else
+			{
+				Thread::yield();
+			}
+		}
+
+		for (auto p : producers)
+			p->stopThread(1000);
+
+		expectEquals<int>(numReceived, numExpected, "Number of received values");
+		expectEquals<int>(receivedValues.countNumberOfSetBits(), numExpected, "No duplicates");
+	}
+
+};
+
+
+static LockfreeQueueTest lockfreeQueueTest;
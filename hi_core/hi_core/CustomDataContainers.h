@@ -33,6 +33,9 @@
 #ifndef CUSTOMDATACONTAINERS_H_INCLUDED
 #define CUSTOMDATACONTAINERS_H_INCLUDED
 
+#include <atomic>
+#include <vector>
+
 #define UNORDERED_STACK_SIZE NUM_POLYPHONIC_VOICES
 
 
@@ -101,4 +104,55 @@ private:
 
 
 
+/** A lock free queue with a fixed capacity that can be used from multiple threads.
+*
+*	Features:
+*
+*	- no allocation after construction (the capacity will be rounded up to the next power of two)
+*	- wait free for the consumer and lock free for multiple producers
+*	- the elements are moved in and out, so you can use it with std::function or other non trivial objects.
+*	  However make sure that the objects are destroyed on a thread where this is allowed.
+*
+*	The implementation is based on Dmitry Vyukov's bounded MPMC queue.
+*/
+template <typename ElementType> class LockfreeQueue
+{
+public:
+
+	/** Creates a queue. The capacity will be rounded up to the next power of two. */
+	LockfreeQueue(int capacity);
+
+	/** Moves the element into the queue. Returns false if the queue is full. */
+	bool push(ElementType&& elementToPush) noexcept;
+
+	/** Moves the next element out of the queue. Returns false if the queue is empty. */
+	bool pop(ElementType& poppedElement) noexcept;
+
+	/** Returns an approximation of the number of elements in the queue. */
+	int size() const noexcept;
+
+	bool isEmpty() const noexcept { return size() == 0; }
+
+	int getCapacity() const noexcept { return (int)(mask + 1); }
+
+private:
+
+	struct Cell
+	{
+		Cell() : sequence(0) {};
+
+		std::atomic<size_t> sequence;
+		ElementType data;
+	};
+
+	std::vector<Cell> cells;
+	const size_t mask;
+
+	std::atomic<size_t> enqueuePosition;
+	std::atomic<size_t> dequeuePosition;
+
+	JUCE_DECLARE_NON_COPYABLE(LockfreeQueue);
+};
+
+
 #endif  // CUSTOMDATACONTAINERS_H_INCLUDED
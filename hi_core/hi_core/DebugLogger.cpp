@@ -269,19 +269,192 @@ struct DebugLogger::Failure : public DebugLogger::Message
 };
 
 
+class DebugLogger::TraceRing
+{
+public:
+
+	enum
+	{
+		RingSize = 2048,
+		ReclaimTimeoutMs = 2000
+	};
+
+	TraceRing()
+	{
+		data.calloc(RingSize);
+	}
+
+	/** Called by the owning thread. Drops the event if the drain thread can't keep up. */
+	bool push(const TraceEvent& e) noexcept
+	{
+		const uint32 w = writeIndex.get();
+
+		if (w - readIndex.get() >= (uint32)RingSize)
+		{
+			++numDropped;
+			return false;
+		}
+
+		data[w & (RingSize - 1)] = e;
+		writeIndex.set(w + 1);
+		lastWriteTime.set((int)(e.timestamp * 1000.0));
+
+		return true;
+	}
+
+	/** Called by the owning thread before it pushes. Returns false if another thread has reclaimed the ring in the meantime. */
+	bool beginWrite(Thread::ThreadID thisThread) noexcept
+	{
+		writing.set(1);
+
+		if (ownerThread.get() == thisThread)
+			return true;
+
+		writing.set(0);
+		return false;
+	}
+
+	void endWrite() noexcept
+	{
+		writing.set(0);
+	}
+
+	/** Hands over a ring that has been drained and wasn't written to for a while. This is how the rings of threads that have exited are reused. */
+	bool reclaim(Thread::ThreadID newOwner, int now) noexcept
+	{
+		const Thread::ThreadID previousOwner = ownerThread.get();
+
+		if (readIndex.get() != writeIndex.get() || now - lastWriteTime.get() < ReclaimTimeoutMs)
+			return false;
+
+		if (!ownerThread.compareAndSetBool(newOwner, previousOwner))
+			return false;
+
+		// The previous owner might still be alive and in the middle of a push
+		while (writing.get() != 0)
+			;
+
+		lastWriteTime.set(now);
+		++generation;
+
+		return true;
+	}
+
+	/** Called by the drain thread. */
+	void popAll(Array<TraceEvent>& destination)
+	{
+		const uint32 w = writeIndex.get();
+		uint32 r = readIndex.get();
+
+		while (r != w)
+		{
+			destination.add(data[r & (RingSize - 1)]);
+			r++;
+		}
+
+		readIndex.set(r);
+	}
+
+	/** Discards the events that were written after the last session was stopped. */
+	void skipAll()
+	{
+		readIndex.set(writeIndex.get());
+		numDropped.set(0);
+		lastWriteTime.set(0);
+	}
+
+	Atomic<int> numDropped;
+
+	/** The thread that writes into this ring. It keeps the ring between logging sessions until another thread reclaims it. */
+	Atomic<Thread::ThreadID> ownerThread;
+
+	/** The time stamp of the last push in milliseconds since the logging started. */
+	Atomic<int> lastWriteTime;
+
+	/** Increased whenever the ring is reclaimed, so that every owner gets its own lane in the trace file. */
+	Atomic<int> generation;
+
+	// Only used by the drain thread to name the thread in the trace file
+	bool isAudioThread = false;
+	bool isLoadingThread = false;
+	int drainedGeneration = 0;
+
+private:
+
+	HeapBlock<TraceEvent> data;
+
+	Atomic<uint32> writeIndex;
+	Atomic<uint32> readIndex;
+	Atomic<int> writing;
+};
+
+class DebugLogger::TraceDrainThread : public Thread
+{
+public:
+
+	TraceDrainThread(DebugLogger& logger_) :
+		Thread("Debug Logger Trace"),
+		logger(logger_)
+	{}
+
+	void run() override
+	{
+		while (!threadShouldExit())
+		{
+			logger.drainTraceRings();
+			wait(20);
+		}
+
+		logger.drainTraceRings();
+	}
+
+private:
+
+	DebugLogger& logger;
+};
+
+class DebugLogger::ProcessorNameUpdater : public MainController::ProcessorChangeHandler::Listener
+{
+public:
+
+	ProcessorNameUpdater(DebugLogger& logger_) :
+		logger(logger_)
+	{
+		logger.mc->getProcessorChangeHandler().addProcessorChangeListener(this);
+	}
+
+	~ProcessorNameUpdater()
+	{
+		logger.mc->getProcessorChangeHandler().removeProcessorChangeListener(this);
+	}
+
+	void moduleListChanged(Processor* /*processorThatWasChanged*/, MainController::ProcessorChangeHandler::EventType type) override
+	{
+		typedef MainController::ProcessorChangeHandler::EventType EventType;
+
+		if (type == EventType::ProcessorColourChange || type == EventType::ProcessorBypassed)
+			return;
+
+		if (logger.isLogging())
+			logger.updateProcessorNames();
+	}
+
+private:
+
+	DebugLogger& logger;
+};
+
 DebugLogger::DebugLogger(MainController* mc_):
 	mc(mc_)
 {
-	pendingEvents.ensureStorageAllocated(NUM_MESSAGE_SLOTS);
-	pendingFailures.ensureStorageAllocated(NUM_MESSAGE_SLOTS);
-	pendingPerformanceWarnings.ensureStorageAllocated(NUM_MESSAGE_SLOTS);
 	pendingStringMessages.ensureStorageAllocated(NUM_MESSAGE_SLOTS);
-	pendingAudioChanges.ensureStorageAllocated(16);
+	pendingParameterChanges.ensureStorageAllocated(NUM_MESSAGE_SLOTS);
 }
 
 DebugLogger::~DebugLogger()
 {
-
+	if (currentlyLogging)
+		stopLogging();
 }
 
 double DebugLogger::getCurrentTimeStamp() const
@@ -289,30 +462,138 @@ double DebugLogger::getCurrentTimeStamp() const
 	return 0.001 * (Time::getMillisecondCounterHiRes() - uptime);
 }
 
-void DebugLogger::addFailure(const DebugLogger::Failure& f)
+DebugLogger::TraceEvent DebugLogger::createTraceEvent(TraceType type, int location, const Processor* p)
 {
-	ScopedLock sl(debugLock);
-	pendingFailures.add(f);
+	TraceEvent e = TraceEvent();
+
+	e.type = type;
+	e.location = location;
+	e.p = p;
+	e.callbackIndex = callbackIndex;
+	e.messageIndex = ++messageIndex;
+	e.timestamp = getCurrentTimeStamp();
+
+	return e;
 }
 
-void DebugLogger::addPerformanceWarning(const PerformanceWarning& f)
+DebugLogger::TraceRing* DebugLogger::getTraceRingForThisThread(Thread::ThreadID thisThread)
 {
-	ScopedLock sl(debugLock);
-	pendingPerformanceWarnings.add(f);
+	const int numRings = jmin<int>(numUsedTraceRings.get(), traceRings.size());
+
+	for (int i = 0; i < numRings; i++)
+	{
+		if (traceRings.getUnchecked(i)->ownerThread.get() == thisThread)
+			return traceRings.getUnchecked(i);
+	}
+
+	// Claims the next free ring without allocating, so this also works on the audio thread.
+	for (;;)
+	{
+		const int index = numUsedTraceRings.get();
+
+		if (index >= traceRings.size())
+			break;
+
+		if (numUsedTraceRings.compareAndSetBool(index + 1, index))
+		{
+			TraceRing* ring = traceRings.getUnchecked(index);
+
+			// Fails if another thread has reclaimed the ring before the owner was set
+			if (ring->ownerThread.compareAndSetBool(thisThread, nullptr))
+			{
+				ring->lastWriteTime.set((int)(getCurrentTimeStamp() * 1000.0));
+				return ring;
+			}
+		}
+	}
+
+	// All rings are claimed, so take over the ring of a thread that has stopped logging (most likely because it has exited).
+	const int now = (int)(getCurrentTimeStamp() * 1000.0);
+
+	for (int i = 0; i < traceRings.size(); i++)
+	{
+		if (traceRings.getUnchecked(i)->reclaim(thisThread, now))
+			return traceRings.getUnchecked(i);
+	}
+
+	return nullptr;
 }
 
+void DebugLogger::addTraceEvent(TraceEvent& e)
+{
+	if (traceRings.isEmpty())
+		return;
+
+	const Thread::ThreadID thisThread = Thread::getCurrentThreadId();
 
-void DebugLogger::addStreamingFailure(double voiceUptime)
+	TraceRing* ring = getTraceRingForThisThread(thisThread);
+
+	if (ring != nullptr && ring->beginWrite(thisThread))
+	{
+		ring->push(e);
+		ring->endWrite();
+	}
+	else
+	{
+		++numEventsWithoutTraceRing;
+	}
+}
+
+void DebugLogger::traceScope(bool isBegin, const Processor* p, int location)
+{
+	TraceEvent e = createTraceEvent(isBegin ? TraceType::ScopeBegin : TraceType::ScopeEnd, location, p);
+	addTraceEvent(e);
+}
+
+void DebugLogger::traceVoice(bool isStart, const Processor* p, int voiceIndex, int noteNumber)
+{
+	if (!isLogging())
+		return;
+
+	TraceEvent e = createTraceEvent(isStart ? TraceType::VoiceStart : TraceType::VoiceStop, (int)Location::SynthVoiceRendering, p);
+	e.intValue = voiceIndex;
+	e.values[0] = (double)noteNumber;
+
+	addTraceEvent(e);
+}
+
+void DebugLogger::traceDiskRead(bool isBegin)
 {
-	Failure f = Failure(messageIndex++, callbackIndex, Location::SampleRendering, FailureType::StreamingFailure, nullptr, getCurrentTimeStamp(), voiceUptime);
+	TraceEvent e = createTraceEvent(isBegin ? TraceType::DiskReadBegin : TraceType::DiskReadEnd, (int)Location::SampleLoaderReadOperation, nullptr);
+	addTraceEvent(e);
+}
+
+void DebugLogger::addFailure(Location location, FailureType type, const Processor* p, double extraValue, const Identifier& id, int callbackIndexToUse)
+{
+	TraceEvent e = createTraceEvent(TraceType::Failure, (int)location, p);
+	e.intValue = (int)type;
+	e.values[0] = extraValue;
+	e.id = id.isNull() ? nullptr : id.getCharPointer().getAddress();
+
+	if (callbackIndexToUse != -1)
+		e.callbackIndex = callbackIndexToUse;
 
-	addFailure(f);
+	addTraceEvent(e);
+}
+
+void DebugLogger::addStreamingFailure(double voiceUptime)
+{
+	addFailure(Location::SampleRendering, FailureType::StreamingFailure, nullptr, voiceUptime);
 }
 
 void DebugLogger::logEvents(const HiseEventBuffer& masterBuffer)
 {
+	const int numResizes = HiseEventBuffer::getNumResizeOperations();
+	const int numDropped = HiseEventBuffer::getNumDroppedEvents();
+
 	if (isLogging())
 	{
+		if (numResizes != lastNumEventBufferResizes)
+			addFailure(Location::MainRenderCallback, FailureType::EventBufferResize, nullptr, (double)(numResizes - lastNumEventBufferResizes));
+
+		if (numDropped != lastNumDroppedEvents)
+			addFailure(Location::MainRenderCallback, FailureType::EventBufferOverflow, nullptr, (double)(numDropped - lastNumDroppedEvents));
+
 		HiseEventBuffer::Iterator iter(masterBuffer);
 
 		while (auto e = iter.getNextConstEventPointer())
@@ -320,20 +601,22 @@ void DebugLogger::logEvents(const HiseEventBuffer& masterBuffer)
 			if (e->isAftertouch())
 				continue;
 
-			ScopedLock sl(debugLock);
-
-			Event e2(messageIndex++, callbackIndex, *e);
+			TraceEvent t = createTraceEvent(TraceType::Event, (int)Location::MainRenderCallback, nullptr);
+			t.e = *e;
 
-			pendingEvents.add(e2);
+			addTraceEvent(t);
 		}
 	}
+
+	lastNumEventBufferResizes = numResizes;
+	lastNumDroppedEvents = numDropped;
 }
 
 void DebugLogger::logMessage(const String& errorMessage)
 {
 	ScopedLock sl(messageLock);
 
-	StringMessage m(messageIndex++, callbackIndex, errorMessage, getCurrentTimeStamp());
+	StringMessage m(++messageIndex, callbackIndex, errorMessage, getCurrentTimeStamp());
 
 	pendingStringMessages.add(m);
 }
@@ -343,10 +626,13 @@ void DebugLogger::logPerformanceWarning(const PerformanceData& logData)
 	if (!isLogging())
 		return;
 
-	const int voiceAmount = logData.p->getMainController()->getNumActiveVoices();
+	TraceEvent e = createTraceEvent(TraceType::PerformanceWarning, logData.location, logData.p);
+	e.intValue = logData.p->getMainController()->getNumActiveVoices();
+	e.values[0] = (double)logData.thisPercentage;
+	e.values[1] = (double)logData.averagePercentage;
+	e.values[2] = (double)logData.limit;
 
-	PerformanceWarning f(messageIndex++, callbackIndex, logData, getCurrentTimeStamp(), voiceAmount);
-	addPerformanceWarning(f);
+	addTraceEvent(e);
 }
 
 
@@ -362,9 +648,9 @@ void DebugLogger::logParameterChange(JavascriptProcessor* p, ReferenceCountedObj
 
 				Identifier id = c->getName();
 
-				DebugLogger::ParameterChange pc(messageIndex++, callbackIndex, getCurrentTimeStamp(), id, newValue);
+				DebugLogger::ParameterChange pc(++messageIndex, callbackIndex, getCurrentTimeStamp(), id, newValue);
 
-				ScopedLock sl(debugLock);
+				ScopedLock sl(messageLock);
 
 				if (pendingParameterChanges.getLast().id == id)
 				{
@@ -454,8 +740,7 @@ bool DebugLogger::checkSampleData(Processor* p, Location location, bool isLeftCh
 			failureType = isLeftChannel ? FailureType::BurstLeft : FailureType::BurstRight;
 		}
 
-		Failure f(messageIndex++, callbackIndex, location, failureType, p, getCurrentTimeStamp(), errorValue, id);
-		addFailure(f);
+		addFailure(location, failureType, p, errorValue, id);
 
 		return false;
 	}
@@ -469,8 +754,7 @@ void DebugLogger::checkAssertion(Processor* p, Location location, bool result, d
 
 	if (!result)
 	{
-		Failure f(messageIndex++, callbackIndex, location, FailureType::Assertion, p, getCurrentTimeStamp(), extraData);
-		addFailure(f);
+		addFailure(location, FailureType::Assertion, p, extraData);
 	}
 }
 
@@ -484,11 +768,9 @@ void DebugLogger::checkPriorityInversion(const CriticalSection& lockToCheck)
 
 	if (!sl.isLocked())
 	{
-		Failure f(messageIndex++, callbackIndex - 1, Location::MainRenderCallback, FailureType::PriorityInversion, nullptr, getCurrentTimeStamp(), 0.0);
-
 		actualBackTrace = messageCallbackStackBacktrace;
 
-		addFailure(f);
+		addFailure(Location::MainRenderCallback, FailureType::PriorityInversion, nullptr, 0.0, Identifier(), callbackIndex - 1);
 	}
 }
 
@@ -503,8 +785,7 @@ void DebugLogger::checkPriorityInversion(const SpinLock& spinLockToCheck, Locati
 		spinLockToCheck.exit();
 	else
 	{
-		Failure f(messageIndex++, callbackIndex, l, FailureType::PriorityInversion, p, getCurrentTimeStamp(), 0.0, id);
-		addFailure(f);
+		addFailure(l, FailureType::PriorityInversion, p, 0.0, id);
 	}
 }
 
@@ -512,16 +793,29 @@ void DebugLogger::addAudioDeviceChange(FailureType changeType, double oldValue,
 {
 	if (isLogging())
 	{
-		AudioSettingChange f(messageIndex++, callbackIndex, getCurrentTimeStamp(), changeType, oldValue, newValue);
-		{
-			ScopedLock sl(debugLock);
-			pendingAudioChanges.add(f);
-		}
+		TraceEvent e = createTraceEvent(TraceType::AudioSettingChange, (int)Location::MainRenderCallback, nullptr);
+		e.intValue = (int)changeType;
+		e.values[0] = oldValue;
+		e.values[1] = newValue;
+
+		addTraceEvent(e);
 	}
 }
 
 void DebugLogger::startLogging()
 {
+	if (traceRings.isEmpty())
+	{
+		for (int i = 0; i < MaxTraceThreads; i++)
+			traceRings.add(new TraceRing());
+	}
+
+	for (int i = 0; i < traceRings.size(); i++)
+		traceRings[i]->skipAll();
+
+	numEventsWithoutTraceRing.set(0);
+	lastNumEventsWithoutTraceRing = 0;
+
 	currentLogFile = getLogFile();
 	currentlyLogging = true;
 	currentLogFile.create();
@@ -538,9 +832,19 @@ void DebugLogger::startLogging()
 
 	fos << getHeader();
 	fos << getSystemSpecs();
-	
 
-	pendingFailures.ensureStorageAllocated(200);
+	getCurrentTraceFile().deleteFile();
+	traceStream = new FileOutputStream(getCurrentTraceFile());
+	*traceStream << "{\"traceEvents\":[\n";
+	firstTraceEventWritten = false;
+
+	updateProcessorNames();
+
+	if (processorNameUpdater == nullptr)
+		processorNameUpdater = new ProcessorNameUpdater(*this);
+
+	drainThread = new TraceDrainThread(*this);
+	drainThread->startThread(4);
 
 	startTimer(200);
 
@@ -568,72 +872,293 @@ struct MessageComparator
 };
 
 
-void DebugLogger::timerCallback()
+void DebugLogger::updateProcessorNames()
 {
-	Array<Failure> failureCopy;
-	Array<StringMessage> messageCopy;
-	Array<PerformanceWarning> warningCopy;
-	Array<Event> eventCopy;
-	Array<AudioSettingChange> audioCopy;
-	Array<ParameterChange> parameterCopy;
+	liveProcessors.clear();
+
+	ScopedLock sl(drainLock);
+
+	processorNames.clear();
 
+	Processor::Iterator<Processor> iter(mc->getMainSynthChain());
+
+	while (auto p = iter.getNextProcessor())
 	{
-		if (pendingFailures.size() != 0)
-		{
-			failureCopy.ensureStorageAllocated(pendingFailures.size());
+		processorNames.set(p, p->getId());
+		liveProcessors.set(p, p);
+	}
+}
 
-			ScopedLock sl(debugLock);
-			failureCopy.addArray(pendingFailures);
-			pendingFailures.clearQuick();
-		}
+Processor* DebugLogger::getLiveProcessor(const Processor* p) const
+{
+	if (p != nullptr)
+		return liveProcessors[p].get();
+
+	return nullptr;
+}
+
+int DebugLogger::getTraceLane(int ringIndex, int generation)
+{
+	return ringIndex + generation * (int)MaxTraceThreads;
+}
+
+void DebugLogger::writeThreadName(OutputStream& out, const TraceRing& ring, int lane, int numDropped)
+{
+	DynamicObject::Ptr args = new DynamicObject();
+
+	String threadName;
+
+	if (ring.isAudioThread)
+		threadName << "Audio Thread";
+	else if (ring.isLoadingThread)
+		threadName << "Sample Loading Thread";
+	else
+		threadName << "Thread " << String(lane + 1);
+
+	if (numDropped != 0)
+		threadName << " (" << String(numDropped) << " dropped events)";
+
+	args->setProperty("name", threadName);
+
+	DynamicObject::Ptr obj = new DynamicObject();
+	obj->setProperty("name", "thread_name");
+	obj->setProperty("ph", "M");
+	obj->setProperty("pid", 1);
+	obj->setProperty("tid", lane);
+	obj->setProperty("args", var(args));
 
-		if (pendingStringMessages.size() != 0)
+	if (firstTraceEventWritten)
+		out << ",\n";
+
+	out << JSON::toString(var(obj), true);
+	firstTraceEventWritten = true;
+}
+
+void DebugLogger::drainTraceRings()
+{
+	const int numRings = jmin<int>(numUsedTraceRings.get(), traceRings.size());
+
+	for (int i = 0; i < numRings; i++)
+	{
+		TraceRing* ring = traceRings[i];
+
+		drainedEvents.clearQuick();
+		ring->popAll(drainedEvents);
+
+		if (drainedEvents.isEmpty())
+			continue;
+
+		const int generation = ring->generation.get();
+
+		if (generation != ring->drainedGeneration)
 		{
-			messageCopy.ensureStorageAllocated(pendingStringMessages.size());
+			// The ring was reclaimed after it was drained, so these events belong to the new owner.
+			if (traceStream != nullptr)
+				writeThreadName(*traceStream, *ring, getTraceLane(i, ring->drainedGeneration), ring->numDropped.exchange(0));
 
-			ScopedLock sl(messageLock);
-			messageCopy.addArray(pendingStringMessages);
-			pendingStringMessages.clearQuick();
+			ring->isAudioThread = false;
+			ring->isLoadingThread = false;
+			ring->drainedGeneration = generation;
 		}
 
-		if (pendingEvents.size() != 0)
+		for (int j = 0; j < drainedEvents.size(); j++)
 		{
-			eventCopy.ensureStorageAllocated(pendingEvents.size());
+			TraceEvent& e = drainedEvents.getReference(j);
 
-			ScopedLock sl(debugLock);
-			eventCopy.addArray(pendingEvents);
-			pendingEvents.clearQuick();
+			e.threadIndex = getTraceLane(i, ring->drainedGeneration);
+
+			if (e.type == TraceType::ScopeBegin && e.location == (int)Location::MainRenderCallback)
+				ring->isAudioThread = true;
+
+			if (e.type == TraceType::DiskReadBegin)
+				ring->isLoadingThread = true;
+
+			if (traceStream != nullptr)
+				writeTraceEvent(*traceStream, e);
 		}
 
-		if (pendingPerformanceWarnings.size() != 0)
+		ScopedLock sl(drainLock);
+
+		for (int j = 0; j < drainedEvents.size(); j++)
 		{
-			warningCopy.ensureStorageAllocated(pendingPerformanceWarnings.size());
+			const TraceEvent& e = drainedEvents.getReference(j);
 
-			ScopedLock sl(debugLock);
-			warningCopy.addArray(pendingPerformanceWarnings);
-			pendingPerformanceWarnings.clearQuick();
+			const bool isLogMessage = e.type == TraceType::Failure ||
+									  e.type == TraceType::PerformanceWarning ||
+									  e.type == TraceType::Event ||
+									  e.type == TraceType::AudioSettingChange;
+
+			if (isLogMessage)
+				pendingTraceMessages.add(e);
 		}
+	}
 
-		if (pendingAudioChanges.size() != 0)
-		{
-			audioCopy.ensureStorageAllocated(pendingAudioChanges.size());
+	if (traceStream != nullptr)
+		traceStream->flush();
+}
 
-			ScopedLock sl(debugLock);
-			audioCopy.addArray(pendingAudioChanges);
-			pendingAudioChanges.clearQuick();
+void DebugLogger::writeTraceEvent(OutputStream& out, const TraceEvent& e)
+{
+	DynamicObject::Ptr args = new DynamicObject();
+
+	String name;
+	String category;
+	String phase = "i";
+
+	switch (e.type)
+	{
+	case TraceType::ScopeBegin:
+	case TraceType::ScopeEnd:
+		name = getNameForLocation((Location)e.location);
+		category = "scope";
+		phase = e.type == TraceType::ScopeBegin ? "B" : "E";
+		break;
+	case TraceType::VoiceStart:
+	case TraceType::VoiceStop:
+		name = e.type == TraceType::VoiceStart ? "VoiceStart" : "VoiceStop";
+		category = "voice";
+		args->setProperty("voice", e.intValue);
+		args->setProperty("note", (int)e.values[0]);
+		break;
+	case TraceType::DiskReadBegin:
+	case TraceType::DiskReadEnd:
+		name = "DiskRead";
+		category = "disk";
+		phase = e.type == TraceType::DiskReadBegin ? "B" : "E";
+		break;
+	case TraceType::Failure:
+		name = getNameForFailure((FailureType)e.intValue);
+		category = "failure";
+		args->setProperty("location", getNameForLocation((Location)e.location));
+		args->setProperty("value", e.values[0]);
+		break;
+	case TraceType::PerformanceWarning:
+		name = "PerformanceWarning";
+		category = "failure";
+		args->setProperty("location", getNameForLocation((Location)e.location));
+		args->setProperty("peak", e.values[0]);
+		args->setProperty("average", e.values[1]);
+		args->setProperty("limit", 100.0 * e.values[2]);
+		args->setProperty("voices", e.intValue);
+		break;
+	case TraceType::Event:
+		name = e.e.getTypeAsString();
+		category = "event";
+		args->setProperty("id", (int)e.e.getEventId());
+		args->setProperty("number", e.e.getNoteNumber());
+		args->setProperty("value", e.e.getVelocity());
+		args->setProperty("channel", e.e.getChannel());
+		break;
+	case TraceType::AudioSettingChange:
+		name = getNameForFailure((FailureType)e.intValue);
+		category = "settings";
+		args->setProperty("old", e.values[0]);
+		args->setProperty("new", e.values[1]);
+		break;
+	case TraceType::Empty:
+	case TraceType::numTraceTypes:
+		return;
+	}
+
+	if (e.p != nullptr)
+	{
+		ScopedLock sl(drainLock);
+
+		const String processorName = processorNames[e.p];
+		args->setProperty("processor", processorName.isNotEmpty() ? processorName : String("Unknown"));
+	}
+
+	if (e.id != nullptr)
+		args->setProperty("id", String(CharPointer_UTF8(e.id)));
+
+	args->setProperty("callback", e.callbackIndex);
+
+	DynamicObject::Ptr obj = new DynamicObject();
+
+	obj->setProperty("name", name);
+	obj->setProperty("cat", category);
+	obj->setProperty("ph", phase);
+	obj->setProperty("ts", e.timestamp * 1000000.0);
+	obj->setProperty("pid", 1);
+	obj->setProperty("tid", e.threadIndex);
+
+	if (phase == "i")
+		obj->setProperty("s", (category == "failure" || category == "settings") ? "g" : "t");
+
+	obj->setProperty("args", var(args));
+
+	if (firstTraceEventWritten)
+		out << ",\n";
+
+	out << JSON::toString(var(obj), true);
+	firstTraceEventWritten = true;
+}
+
+void DebugLogger::timerCallback()
+{
+	Array<Failure> failureCopy;
+	Array<StringMessage> messageCopy;
+	Array<PerformanceWarning> warningCopy;
+	Array<Event> eventCopy;
+	Array<AudioSettingChange> audioCopy;
+	Array<ParameterChange> parameterCopy;
+
+	const int numWithoutTraceRing = numEventsWithoutTraceRing.get();
+
+	if (numWithoutTraceRing != lastNumEventsWithoutTraceRing)
+	{
+		logMessage(String(numWithoutTraceRing - lastNumEventsWithoutTraceRing) + " events were dropped because more than " + String((int)MaxTraceThreads) + " threads were logging at the same time.");
+		lastNumEventsWithoutTraceRing = numWithoutTraceRing;
+	}
+
+	{
+		Array<TraceEvent> traceCopy;
+
+		{
+			ScopedLock sl(drainLock);
+			traceCopy.swapWith(pendingTraceMessages);
 		}
 
-		if (pendingParameterChanges.size() != 0)
+		for (int i = 0; i < traceCopy.size(); i++)
 		{
-			parameterCopy.ensureStorageAllocated(pendingParameterChanges.size());
+			const TraceEvent& t = traceCopy.getReference(i);
 
-			ScopedLock sl(debugLock);
-			parameterCopy.addArray(pendingParameterChanges);
-			pendingParameterChanges.clearQuick();
+			switch (t.type)
+			{
+			case TraceType::Failure:
+			{
+				const Identifier id = t.id != nullptr ? Identifier(t.id) : Identifier();
+				failureCopy.add(Failure(t.messageIndex, t.callbackIndex, (Location)t.location, (FailureType)t.intValue, getLiveProcessor(t.p), t.timestamp, t.values[0], id));
+				break;
+			}
+			case TraceType::PerformanceWarning:
+			{
+				PerformanceData d(t.location, (float)t.values[0], (float)t.values[1], getLiveProcessor(t.p));
+				d.limit = (float)t.values[2];
+
+				warningCopy.add(PerformanceWarning(t.messageIndex, t.callbackIndex, d, t.timestamp, t.intValue));
+				break;
+			}
+			case TraceType::Event:
+			{
+				Event e(t.messageIndex, t.callbackIndex, t.e);
+				e.timestamp = t.timestamp;
+				eventCopy.add(e);
+				break;
+			}
+			case TraceType::AudioSettingChange:
+				audioCopy.add(AudioSettingChange(t.messageIndex, t.callbackIndex, t.timestamp, (FailureType)t.intValue, t.values[0], t.values[1]));
+				break;
+			default:
+				break;
+			}
 		}
-	}
 
-	messageIndex = 0;
+		ScopedLock sl(messageLock);
+
+		messageCopy.swapWith(pendingStringMessages);
+		parameterCopy.swapWith(pendingParameterChanges);
+	}
 
 	Array<Message*> messages;
 
@@ -797,6 +1322,26 @@ void DebugLogger::stopLogging()
 	currentlyLogging = false;
 	stopTimer();
 
+	if (drainThread != nullptr)
+	{
+		drainThread->stopThread(2000);
+		drainThread = nullptr;
+	}
+
+	if (traceStream != nullptr)
+	{
+		const int numRings = jmin<int>(numUsedTraceRings.get(), traceRings.size());
+
+		for (int i = 0; i < numRings; i++)
+		{
+			TraceRing* ring = traceRings[i];
+			writeThreadName(*traceStream, *ring, getTraceLane(i, ring->drainedGeneration), ring->numDropped.get());
+		}
+
+		*traceStream << "\n],\n\"displayTimeUnit\":\"ms\"}\n";
+		traceStream = nullptr;
+	}
+
 	for (int i = 0; i < listeners.size(); i++)
 	{
 		if (listeners[i].get() != nullptr)
@@ -907,6 +1452,8 @@ String DebugLogger::getNameForFailure(FailureType f)
 		RETURN_CASE_STRING_FAILURE(PriorityInversion);
 		RETURN_CASE_STRING_FAILURE(SampleLoadingError);
 		RETURN_CASE_STRING_FAILURE(StreamingFailure);
+		RETURN_CASE_STRING_FAILURE(EventBufferResize);
+		RETURN_CASE_STRING_FAILURE(EventBufferOverflow);
         RETURN_CASE_STRING_FAILURE(numFailureTypes);
 	}
 
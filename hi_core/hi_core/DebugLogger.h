@@ -66,6 +66,8 @@ public:
 		PriorityInversion, //< when the audio thread lock is locked by another thread
 		SampleLoadingError,
 		StreamingFailure,
+		EventBufferResize, //< a event buffer had to grow on the audio thread
+		EventBufferOverflow, //< events were dropped because a event buffer was full
 		numFailureTypes
 	};
 
@@ -146,6 +148,42 @@ public:
 
 	struct AudioSettingChange;
 
+	/** The types of records in the trace ring. */
+	enum class TraceType
+	{
+		Empty = 0,
+		ScopeBegin, //< the start of a ADD_GLITCH_DETECTOR scope
+		ScopeEnd, //< the end of a ADD_GLITCH_DETECTOR scope
+		VoiceStart,
+		VoiceStop,
+		DiskReadBegin,
+		DiskReadEnd,
+		Failure,
+		PerformanceWarning,
+		Event,
+		AudioSettingChange,
+		numTraceTypes
+	};
+
+	/** A single record of the trace ring.
+	*
+	*	It only contains plain data so that it can be written from the audio thread without locking or allocating.
+	*/
+	struct TraceEvent
+	{
+		TraceType type;
+		int threadIndex; //< the index of the ring that recorded the event
+		int location; //< the DebugLogger::Location
+		int intValue; //< the FailureType, the voice index or the voice amount
+		int callbackIndex;
+		int messageIndex;
+		double timestamp;
+		double values[3];
+		const Processor* p;
+		const char* id; //< the (pooled) character data of an Identifier
+		HiseEvent e;
+	};
+
 	struct Listener
 	{
 		virtual ~Listener() { masterReference.clear(); };
@@ -162,10 +200,6 @@ public:
 
 	double getCurrentTimeStamp() const;
 
-	void addFailure(const Failure& f);
-
-	void addPerformanceWarning(const PerformanceWarning& f);
-
 	void addStreamingFailure(double voiceUptime);
 
 	void logEvents(const HiseEventBuffer& masterBuffer);
@@ -176,6 +210,24 @@ public:
 
 	void logParameterChange(JavascriptProcessor* p, ReferenceCountedObject* control, const var& newValue);
 
+	/** Records the begin or end of a ADD_GLITCH_DETECTOR scope. */
+	void traceScope(bool isBegin, const Processor* p, int location);
+
+	/** Records the start or stop of a voice. */
+	void traceVoice(bool isStart, const Processor* p, int voiceIndex, int noteNumber);
+
+	/** Records the begin or end of a disk read operation of the sample loader. */
+	void traceDiskRead(bool isBegin);
+
+	/** Returns the file that contains the trace of the current (or last) logging session in the Chrome trace event format. 
+	*
+	*	You can open it with chrome://tracing or https://ui.perfetto.dev.
+	*/
+	File getCurrentTraceFile() const
+	{
+		return currentLogFile.withFileExtension("json");
+	}
+
 	void checkAudioCallbackProperties(double sampleRate, int samplesPerBlock);
 
 	bool checkSampleData(Processor* p, Location location, bool isLeftChannel, const float* data, int numSamples, const Identifier& id=Identifier());
@@ -247,10 +299,14 @@ private:
 
 	int numErrorsSinceLogStart = 0;
 	int callbackIndex = 0;
-	int messageIndex = 0;
+
+	// Increased by every thread that logs, so it only wraps around after a very long session
+	Atomic<int> messageIndex;
 
 	void addAudioDeviceChange(FailureType changeType, double oldValue, double newValue);
 
+	void addFailure(Location location, FailureType type, const Processor* p, double extraValue, const Identifier& id = Identifier(), int callbackIndexToUse = -1);
+
 	double lastSampleRate = -1.0;
 	int lastSamplesPerBlock = -1;
 
@@ -265,16 +321,70 @@ private:
 
 #define NUM_MESSAGE_SLOTS 256
 
-	Array<Failure> pendingFailures;
+	class TraceRing;
+	class TraceDrainThread;
+	class ProcessorNameUpdater;
+
+	enum
+	{
+		MaxTraceThreads = 16
+	};
+
+	/** Writes the event to the ring of the current thread. This is lock-free and can be called from any thread. */
+	void addTraceEvent(TraceEvent& e);
+
+	/** Returns the ring of the given thread. If the thread has none yet, it claims a free ring or reclaims the idle ring of a thread that has exited. */
+	TraceRing* getTraceRingForThisThread(Thread::ThreadID thisThread);
+
+	/** Returns the tid in the trace file. A reclaimed ring writes into a new lane so the events of two threads don't get mixed. */
+	static int getTraceLane(int ringIndex, int generation);
+
+	void writeThreadName(OutputStream& out, const TraceRing& ring, int lane, int numDropped);
+
+	/** Called by the drain thread. Empties the rings, writes the trace file and passes the log messages to the timer callback. */
+	void drainTraceRings();
+
+	TraceEvent createTraceEvent(TraceType type, int location, const Processor* p);
+
+	void writeTraceEvent(OutputStream& out, const TraceEvent& e);
+
+	/** Returns the processor if it still exists. Call this on the message thread only. */
+	Processor* getLiveProcessor(const Processor* p) const;
+
+	/** Called when the logging starts and whenever the module tree changes. */
+	void updateProcessorNames();
+
+	/** The rings for every thread that has written a trace event. They are created when the logging starts. */
+	OwnedArray<TraceRing> traceRings;
+	Atomic<int> numUsedTraceRings;
+
+	/** Counts the events of threads that found no free or idle ring. */
+	Atomic<int> numEventsWithoutTraceRing;
+	int lastNumEventsWithoutTraceRing = 0;
+
+	// The last values of the global event buffer counters (only accessed in logEvents())
+	int lastNumEventBufferResizes = 0;
+	int lastNumDroppedEvents = 0;
+
+	ScopedPointer<TraceDrainThread> drainThread;
+	ScopedPointer<FileOutputStream> traceStream;
+	bool firstTraceEventWritten = false;
+	Array<TraceEvent> drainedEvents;
+
+	/** Used between the drain thread and the message thread only. */
+	CriticalSection drainLock;
+	Array<TraceEvent> pendingTraceMessages;
+	HashMap<const Processor*, String> processorNames;
+
+	/** Used on the message thread only. The references are cleared if a processor is deleted before the next update. */
+	HashMap<const Processor*, WeakReference<Processor>> liveProcessors;
+	ScopedPointer<ProcessorNameUpdater> processorNameUpdater;
+
 	Array<StringMessage> pendingStringMessages;
 	Array<ParameterChange> pendingParameterChanges;
-	Array<PerformanceWarning> pendingPerformanceWarnings;
-	Array<AudioSettingChange> pendingAudioChanges;
-	Array<Event> pendingEvents;
 	
 	Array<WeakReference<Listener>> listeners;
 
-	CriticalSection debugLock;
 	CriticalSection messageLock;
 
 	File currentLogFile;
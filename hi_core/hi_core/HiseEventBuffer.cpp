@@ -51,6 +51,10 @@ HiseEvent::HiseEvent(const MidiMessage& message)
 	
 	number = data[1];
 	value = data[2];
+
+	// Channel pressure messages have only one data byte
+	if (message.isChannelPressure())
+		value = (uint8)message.getChannelPressureValue();
 }
 
 String HiseEvent::getTypeAsString() const noexcept
@@ -70,6 +74,7 @@ String HiseEvent::getTypeAsString() const noexcept
 	case HiseEvent::Type::VolumeFade: return "VolumeFade";
 	case HiseEvent::Type::PitchFade: return "PitchFade";
 	case HiseEvent::Type::TimerEvent: return "TimerEvent";
+	case HiseEvent::Type::NoteExpression: return "NoteExpression";
 	case HiseEvent::Type::numTypes: jassertfalse;
 	default: jassertfalse;
 	}
@@ -88,10 +93,29 @@ double HiseEvent::getPitchFactorForEvent() const
 	return (double)Modulation::PitchConverters::octaveRangeToPitchFactor(detuneFactor);
 }
 
+Atomic<int> HiseEventBuffer::numResizeOperations;
+Atomic<int> HiseEventBuffer::numDroppedEvents;
+
 HiseEventBuffer::HiseEventBuffer()
 {
-	numUsed = HISE_EVENT_BUFFER_SIZE;
-	clear();
+	setCapacity(HISE_EVENT_BUFFER_SIZE);
+}
+
+HiseEventBuffer::HiseEventBuffer(const HiseEventBuffer& other)
+{
+	setCapacity(jmax<int>(HISE_EVENT_BUFFER_SIZE, other.capacity));
+	copyFrom(other);
+}
+
+HiseEventBuffer& HiseEventBuffer::operator=(const HiseEventBuffer& other)
+{
+	if (this != &other)
+	{
+		ensureAllocated(other.numUsed);
+		copyFrom(other);
+	}
+
+	return *this;
 }
 
 void HiseEventBuffer::clear()
@@ -104,38 +128,84 @@ void HiseEventBuffer::clear()
 	}
 }
 
-void HiseEventBuffer::addEvent(const HiseEvent& hiseEvent)
+void HiseEventBuffer::ensureAllocated(int numEventsToHold)
 {
-	if (numUsed >= HISE_EVENT_BUFFER_SIZE)
+	if (numEventsToHold > capacity)
+		setCapacity(jmin<int>(numEventsToHold, HISE_EVENT_BUFFER_MAX_SIZE));
+}
+
+void HiseEventBuffer::setCapacity(int newCapacity)
+{
+	jassert(newCapacity >= numUsed);
+
+	buffer.realloc(newCapacity);
+
+	HiseEvent::clear(buffer + numUsed, newCapacity - numUsed);
+
+	capacity = newCapacity;
+}
+
+int HiseEventBuffer::makeRoomFor(int numEventsToAdd)
+{
+	const int numNeeded = numUsed + numEventsToAdd;
+
+	if (numNeeded <= capacity)
+		return numEventsToAdd;
+
+	int newCapacity = jmax<int>(capacity, 16);
+
+	while (newCapacity < numNeeded)
+		newCapacity *= 2;
+
+	newCapacity = jmin<int>(newCapacity, HISE_EVENT_BUFFER_MAX_SIZE);
+
+	if (newCapacity > capacity)
 	{
-		// Buffer full..
-		jassertfalse;
-		return;
+		// This allocates on the audio thread, so the DebugLogger reports it
+		++numResizeOperations;
+		setCapacity(newCapacity);
 	}
 
-	if (numUsed == 0)
+	const int numToAdd = jmin<int>(numEventsToAdd, capacity - numUsed);
+
+	if (numToAdd < numEventsToAdd)
 	{
-		insertEventAtPosition(hiseEvent, 0);
-		return;
+		// Buffer full..
+		jassertfalse;
+		numDroppedEvents += numEventsToAdd - numToAdd;
 	}
 
-	jassert(numUsed < HISE_EVENT_BUFFER_SIZE);
+	return numToAdd;
+}
 
-    const int numToLookFor = jmin<int>(numUsed, HISE_EVENT_BUFFER_SIZE);
-    
-	for (int i = 0; i < numToLookFor; i++)
+int HiseEventBuffer::getInsertPosition(uint32 timestamp) const noexcept
+{
+	// Most events are added in order, so check the end first
+	if (numUsed == 0 || buffer[numUsed - 1].getTimeStamp() <= timestamp)
+		return numUsed;
+
+	int low = 0;
+	int high = numUsed;
+
+	while (low < high)
 	{
-		const int timestampInBuffer = buffer[i].getTimeStamp();
-		const int messageTimestamp = hiseEvent.getTimeStamp();
+		const int mid = (low + high) / 2;
 
-		if (timestampInBuffer > messageTimestamp)
-		{
-			insertEventAtPosition(hiseEvent, i);
-			return;
-		}
+		if (buffer[mid].getTimeStamp() > timestamp)
+			high = mid;
+		else
+			low = mid + 1;
 	}
 
-	insertEventAtPosition(hiseEvent, numUsed);
+	return low;
+}
+
+void HiseEventBuffer::addEvent(const HiseEvent& hiseEvent)
+{
+	if (makeRoomFor(1) == 0)
+		return;
+
+	insertEventAtPosition(hiseEvent, getInsertPosition(hiseEvent.getTimeStamp()));
 }
 
 void HiseEventBuffer::addEvent(const MidiMessage& midiMessage, int sampleNumber)
@@ -153,49 +223,79 @@ void HiseEventBuffer::addEvents(const MidiBuffer& otherBuffer)
 	MidiMessage m;
 	int samplePos;
 
-	int index = 0;
-
 	MidiBuffer::Iterator it(otherBuffer);
 
 	while (it.getNextEvent(m, samplePos))
 	{
-		jassert(index < HISE_EVENT_BUFFER_SIZE);
-
 		HiseEvent e(m);
 
 		if (e.isEmpty()) continue;
 
-		e.swapWith(buffer[index]);
+		if (makeRoomFor(1) == 0)
+			return;
+
+		e.swapWith(buffer[numUsed]);
 
-		buffer[index].setTimeStamp((uint16)samplePos);
+		buffer[numUsed].setTimeStamp((uint16)samplePos);
 
 		numUsed++;
+	}
+}
 
-		if (numUsed >= HISE_EVENT_BUFFER_SIZE)
+
+void HiseEventBuffer::addEvents(const HiseEventBuffer &otherBuffer)
+{
+	jassert(&otherBuffer != this);
+
+	mergeEvents(otherBuffer.buffer, otherBuffer.numUsed);
+}
+
+void HiseEventBuffer::mergeEvents(const HiseEvent* events, int numEvents)
+{
+	if (numEvents <= 0) return;
+
+	for (int i = 1; i < numEvents; i++)
+	{
+		if (events[i].getTimeStamp() < events[i - 1].getTimeStamp())
 		{
-			// Buffer full..
-			jassertfalse;
+			// The timestamps were changed after insertion, so the events must be sorted one by one
+			for (int j = 0; j < numEvents; j++)
+				addEvent(events[j]);
+
 			return;
 		}
-
-		index++;
 	}
-}
 
+	const int numToAdd = makeRoomFor(numEvents);
 
-void HiseEventBuffer::addEvents(const HiseEventBuffer &otherBuffer)
-{
-	Iterator iter(otherBuffer);
+	if (numToAdd == 0) return;
 
-	while (HiseEvent* e = iter.getNextEventPointer(false, false))
+	if (numUsed == 0 || buffer[numUsed - 1].getTimeStamp() <= events[0].getTimeStamp())
 	{
-		addEvent(*e);
+		CopyHelpers::copyEvents(buffer + numUsed, events, numToAdd);
+		numUsed += numToAdd;
+		return;
 	}
+
+	// Merge from the back so that every event is moved only once
+	int thisIndex = numUsed - 1;
+	int otherIndex = numToAdd - 1;
+	int targetIndex = numUsed + numToAdd - 1;
+
+	while (otherIndex >= 0)
+	{
+		if (thisIndex >= 0 && buffer[thisIndex].getTimeStamp() > events[otherIndex].getTimeStamp())
+			buffer[targetIndex--] = buffer[thisIndex--];
+		else
+			buffer[targetIndex--] = events[otherIndex--];
+	}
+
+	numUsed += numToAdd;
 }
 
 HiseEvent HiseEventBuffer::getEvent(int index) const
 {
-	if (index >= 0 && index < HISE_EVENT_BUFFER_SIZE)
+	if (index >= 0 && index < capacity)
 	{
 		return buffer[index];
 	}
@@ -217,29 +317,21 @@ void HiseEventBuffer::moveEventsBelow(HiseEventBuffer& targetBuffer, int highest
 {
 	if (numUsed == 0) return;
 
-	HiseEventBuffer::Iterator iter(*this);
+	int numToMove = 0;
 
-	int numCopied = 0;
+	while (numToMove < numUsed && buffer[numToMove].getTimeStamp() < (uint32)highestTimestamp)
+		numToMove++;
 
-	while (HiseEvent* e = iter.getNextEventPointer())
-	{
-		if (e->getTimeStamp() < (uint32)highestTimestamp)
-		{
-			targetBuffer.addEvent(*e);
-			numCopied++;
-		}
-		else
-		{
-			break;
-		}
-	}
+	if (numToMove == 0) return;
+
+	targetBuffer.mergeEvents(buffer, numToMove);
 
-	const int numRemaining = numUsed - numCopied;
+	const int numRemaining = numUsed - numToMove;
 
-	for (int i = 0; i < numRemaining; i++)
-		buffer[i] = buffer[i + numCopied];
+	// HiseEvent is plain data (see the copy constructor), so it can be moved with memmove
+	memmove((void*)buffer, (const void*)(buffer + numToMove), sizeof(HiseEvent) * numRemaining);
 
-	HiseEvent::clear(buffer + numRemaining, numCopied);
+	HiseEvent::clear(buffer + numRemaining, numToMove);
 
 	numUsed = numRemaining;
 }
@@ -249,23 +341,11 @@ void HiseEventBuffer::moveEventsAbove(HiseEventBuffer& targetBuffer, int lowestT
 	if (numUsed == 0 || (buffer[numUsed - 1].getTimeStamp() < (uint32)lowestTimestamp)) 
 		return; // Skip the work if no events with bigger timestamps
 
-	int indexOfFirstElementToMove = -1;
+	const int indexOfFirstElementToMove = lowestTimestamp > 0 ? getInsertPosition((uint32)(lowestTimestamp - 1)) : 0;
 
-	for (int i = 0; i < numUsed; i++)
-	{
-		if (buffer[i].getTimeStamp() >= (uint32)lowestTimestamp)
-		{
-			indexOfFirstElementToMove = i;
-			break;
-		}
-	}
-
-	if (indexOfFirstElementToMove == -1) return;
+	if (indexOfFirstElementToMove == numUsed) return;
 
-	for (int i = indexOfFirstElementToMove; i < numUsed; i++)
-	{
-		targetBuffer.addEvent(buffer[i]);
-	}
+	targetBuffer.mergeEvents(buffer + indexOfFirstElementToMove, numUsed - indexOfFirstElementToMove);
 
 	HiseEvent::clear(buffer + indexOfFirstElementToMove, numUsed - indexOfFirstElementToMove);
 
@@ -274,13 +354,13 @@ void HiseEventBuffer::moveEventsAbove(HiseEventBuffer& targetBuffer, int lowestT
 
 void HiseEventBuffer::copyFrom(const HiseEventBuffer& otherBuffer)
 {
-    const int eventsToCopy = jmin<int>(otherBuffer.numUsed, HISE_EVENT_BUFFER_SIZE);
-    
-	memcpy(buffer, otherBuffer.buffer, sizeof(HiseEvent) * eventsToCopy);
+	numUsed = 0;
 
-	jassert(otherBuffer.numUsed < HISE_EVENT_BUFFER_SIZE);
+	const int eventsToCopy = makeRoomFor(otherBuffer.numUsed);
+    
+	CopyHelpers::copyEvents(buffer, otherBuffer.buffer, eventsToCopy);
 
-	numUsed = otherBuffer.numUsed;
+	numUsed = eventsToCopy;
 }
 
 
@@ -298,7 +378,7 @@ bool HiseEventBuffer::Iterator::getNextEvent(HiseEvent& b, int &samplePosition,
 		  (skipIgnoredEvents && buffer->buffer[index].isIgnored())))
 	{
 		index++;
-		jassert(index < HISE_EVENT_BUFFER_SIZE);
+		jassert(index <= buffer->numUsed);
 	}
 		
 	if (index < buffer->numUsed)
@@ -329,7 +409,7 @@ const HiseEvent* HiseEventBuffer::Iterator::getNextConstEventPointer(bool skipIg
 		  (skipIgnoredEvents && buffer->buffer[index].isIgnored())))
 	{
 		index++;
-		jassert(index < HISE_EVENT_BUFFER_SIZE);
+		jassert(index <= buffer->numUsed);
 	}
 
 	if (index < buffer->numUsed)
@@ -345,32 +425,12 @@ const HiseEvent* HiseEventBuffer::Iterator::getNextConstEventPointer(bool skipIg
 
 void HiseEventBuffer::insertEventAtPosition(const HiseEvent& e, int positionInBuffer)
 {
-	if (numUsed == 0)
-	{
-		buffer[0] = HiseEvent(e);
+	jassert(numUsed < capacity);
+	jassert(positionInBuffer <= numUsed);
 
-		numUsed = 1;
-
-		return;
-	}
-
-	if (numUsed > positionInBuffer)
-	{
-		for (int i = jmin<int>(numUsed-1, HISE_EVENT_BUFFER_SIZE-2); i >= positionInBuffer; i--)
-		{
-			jassert(i + 1 < HISE_EVENT_BUFFER_SIZE);
-
-			buffer[i + 1] = buffer[i];
-		}
-	}
+	if (positionInBuffer < numUsed)
+		memmove((void*)(buffer + positionInBuffer + 1), (const void*)(buffer + positionInBuffer), sizeof(HiseEvent) * (numUsed - positionInBuffer));
 
-    if(positionInBuffer < HISE_EVENT_BUFFER_SIZE)
-    {
-        buffer[positionInBuffer] = HiseEvent(e);
-        numUsed++;
-    }
-    else
-    {
-        jassertfalse;
-    }
+	buffer[positionInBuffer] = HiseEvent(e);
+	numUsed++;
 }
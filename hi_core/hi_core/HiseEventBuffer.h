@@ -55,9 +55,19 @@ public:
 		VolumeFade,
 		PitchFade,
 		TimerEvent,
+		NoteExpression,
 		numTypes
 	};
 
+	/** The per-note dimensions of a NoteExpression event (like the MPE per-note controllers). */
+	enum class ExpressionType : uint8
+	{
+		PitchBend = 0, ///< the per-note pitch bend (bipolar)
+		Pressure, ///< the per-note pressure
+		Timbre, ///< the per-note timbre (CC74 in MPE)
+		numExpressionTypes
+	};
+
 	/** Creates an empty Hise event. */
 	HiseEvent() {};
 
@@ -86,6 +96,8 @@ public:
 		data[1] = otherData[1];
 	}
 
+	HiseEvent& operator=(const HiseEvent &other) noexcept = default;
+
 	
 
 	bool operator==(const HiseEvent &other) const
@@ -187,6 +199,21 @@ public:
 		return e;
 	}
 
+	/** Creates a per-note expression event for the note with the given event ID. 
+	*
+	*	The value is a 14bit value (like the pitch wheel), so 8192 is the center of the pitch bend. 
+	*/
+	static HiseEvent createNoteExpression(uint16 eventId, ExpressionType expressionType, int value, int channel=1)
+	{
+		HiseEvent e(Type::NoteExpression, 0, 0, (uint8)channel);
+
+		e.setEventId(eventId);
+		e.setExpressionType(expressionType);
+		e.setExpressionValue(value);
+
+		return e;
+	}
+
 	static HiseEvent createTimerEvent(uint8 timerIndex, uint16 offset)
 	{
 		HiseEvent e(Type::TimerEvent, 0, 0, timerIndex);
@@ -205,6 +232,24 @@ public:
 	bool isTimerEvent() const noexcept { return type == Type::TimerEvent; };
 	int getTimerIndex() const noexcept { return channel; }	
 
+	bool isNoteExpression() const noexcept { return type == Type::NoteExpression; }
+
+	ExpressionType getExpressionType() const noexcept { return (ExpressionType)expressionType; }
+	void setExpressionType(ExpressionType t) noexcept { expressionType = (uint8)t; }
+
+	/** Returns the 14bit value of a NoteExpression event. */
+	int getExpressionValue() const noexcept { return getPitchWheelValue(); }
+	void setExpressionValue(int newValue) noexcept { setPitchWheelValue(jlimit<int>(0, 16383, newValue)); }
+
+	/** Returns the value of a NoteExpression event as -1...1 for the pitch bend and 0...1 for the other types. */
+	float getNormalisedExpressionValue() const noexcept
+	{
+		if (getExpressionType() == ExpressionType::PitchBend)
+			return jlimit<float>(-1.0f, 1.0f, (float)(getExpressionValue() - 8192) / 8191.0f);
+
+		return (float)getExpressionValue() / 16383.0f;
+	}
+
 	// ========================================================================================================================== MIDI Message methods
 
 	uint16 getTimeStamp() const noexcept{ return timeStamp; };
@@ -346,7 +391,7 @@ private:
 	uint16 eventId = 0;
 	uint16 timeStamp = 0;
 
-	uint8 unused1 = 0;
+	uint8 expressionType = 0;
 	uint8 unused2 = 0;
 
 	bool ignored = false;
@@ -355,7 +400,19 @@ private:
 	
 };
 
+/** The number of events that a HiseEventBuffer preallocates. 
+*
+*	If a buffer runs full, it grows on the audio thread (which is reported by the DebugLogger), so increase this
+*	value if your project creates very dense event streams (eg. MPE controllers or scripted strumming).
+*/
+#ifndef HISE_EVENT_BUFFER_SIZE
 #define HISE_EVENT_BUFFER_SIZE 256
+#endif
+
+/** The maximum number of events that a HiseEventBuffer can hold. Events beyond this limit are dropped. */
+#ifndef HISE_EVENT_BUFFER_MAX_SIZE
+#define HISE_EVENT_BUFFER_MAX_SIZE 16384
+#endif
 
 class HiseEventBuffer
 {
@@ -466,6 +523,10 @@ public:
 
 	HiseEventBuffer();
 
+	HiseEventBuffer(const HiseEventBuffer& other);
+
+	HiseEventBuffer& operator=(const HiseEventBuffer& other);
+
 	bool operator==(const HiseEventBuffer& other)
 	{
 		if (other.getNumUsed() != numUsed) return false;
@@ -494,6 +555,24 @@ public:
 	bool isEmpty() const noexcept{ return numUsed == 0; };
 	int getNumUsed() const { return numUsed; }
 
+	/** Returns the number of events that fit into the buffer without growing it. */
+	int getCapacity() const noexcept { return capacity; }
+
+	/** Preallocates the buffer so that it can hold the given amount of events without allocating. 
+	*
+	*	Call this outside the audio thread (eg. in prepareToPlay()) if you know that you'll need more than HISE_EVENT_BUFFER_SIZE events.
+	*/
+	void ensureAllocated(int numEventsToHold);
+
+	/** Returns the number of times a buffer had to grow while adding events. 
+	*
+	*	This is a global counter for all buffers, so the DebugLogger can report it.
+	*/
+	static int getNumResizeOperations() noexcept { return numResizeOperations.get(); }
+
+	/** Returns the number of events that were dropped because a buffer reached HISE_EVENT_BUFFER_MAX_SIZE. */
+	static int getNumDroppedEvents() noexcept { return numDroppedEvents.get(); }
+
 	HiseEvent getEvent(int index) const;
 
 	void subtractFromTimeStamps(int delta);
@@ -504,8 +583,18 @@ public:
 
 	void addEvent(const HiseEvent& hiseEvent);
 	void addEvent(const MidiMessage& midiMessage, int sampleNumber);
+
+	/** Clears this buffer and fills it with the events of the MidiBuffer. 
+	*
+	*	The MidiBuffer is already sorted, so the events are copied in order without searching the insert position.
+	*/
 	void addEvents(const MidiBuffer& otherBuffer);
 
+	/** Merges the events of the other buffer into this buffer. 
+	*
+	*	Both buffers are sorted, so this merges them in one pass instead of inserting every event separately.
+	*	Events with the same timestamp are inserted after the existing events (like addEvent()).
+	*/
 	void addEvents(const HiseEventBuffer &otherBuffer);
 
 	
@@ -518,6 +607,8 @@ public:
 
 		static void copyEvents(HiseEventBuffer &destination, int offsetInDestination, const HiseEventBuffer& source, int offsetInSource, int numElements)
 		{
+			jassert(offsetInDestination + numElements <= destination.capacity);
+
 			memcpy(destination.buffer + offsetInDestination, source.buffer + offsetInSource, sizeof(HiseEvent) * numElements);
 		}
 	};
@@ -557,10 +648,26 @@ private:
 
 	void insertEventAtPosition(const HiseEvent& e, int positionInBuffer);
 
-	HiseEvent buffer[HISE_EVENT_BUFFER_SIZE];
+	/** Returns the index after the last event with a timestamp that is not bigger than the given one. */
+	int getInsertPosition(uint32 timestamp) const noexcept;
+
+	/** Merges a sorted array of events into the buffer. */
+	void mergeEvents(const HiseEvent* events, int numEvents);
+
+	/** Grows the buffer if the events don't fit and returns the number of events that can be added. */
+	int makeRoomFor(int numEventsToAdd);
+
+	void setCapacity(int newCapacity);
+
+	HeapBlock<HiseEvent> buffer;
+
+	int capacity = 0;
 
 	int numUsed = 0;
 
+	static Atomic<int> numResizeOperations;
+	static Atomic<int> numDroppedEvents;
+
 	
 };
 
@@ -54,7 +54,10 @@ public:
 		testMidiBufferCopyMethods();
 		testMidiBufferIterators();
 		testEventBufferMoveOperations();
+		testEventBufferGrowAndMerge();
+		testEventBufferUnsortedMerge();
 		testEventHandler();
+		testNoteExpression();
 		testEventBufferStack();
 		
 	}
@@ -515,6 +518,9 @@ private:
 			mb.addEvent(generateRandomMidiMessage(), r.nextInt(4096));
 		}
 
+		// The old content must be replaced, not merged
+		b1.addEvent(HiseEvent(HiseEvent::Type::NoteOn, 64, 127, 1));
+
 		b1.addEvents(mb);
 
 		MidiBuffer::Iterator mbIterator(mb);
@@ -629,6 +635,96 @@ private:
 
 
 
+	}
+
+	void testEventBufferGrowAndMerge()
+	{
+		beginTest("Testing HiseEventBuffer growing and merging");
+
+		HiseEventBuffer b1;
+		HiseEventBuffer b2;
+		HiseEventBuffer expected;
+
+		const int numResizesBefore = HiseEventBuffer::getNumResizeOperations();
+
+		const int numToFill = HISE_EVENT_BUFFER_SIZE * 4;
+
+		for (int i = 0; i < numToFill; i++)
+		{
+			HiseEvent e1 = generateRandomHiseEvent();
+			HiseEvent e2 = generateRandomHiseEvent();
+
+			b1.addEvent(e1);
+			b2.addEvent(e2);
+
+			expected.addEvent(e1);
+		}
+
+		expectEquals<int>(b1.getNumUsed(), numToFill, "No events dropped");
+		expect(b1.getCapacity() >= numToFill, "Capacity grown");
+		expect(HiseEventBuffer::getNumResizeOperations() > numResizesBefore, "Resize operations are counted");
+
+		HiseEventBuffer::Iterator iter2(b2);
+
+		while (const HiseEvent* e = iter2.getNextConstEventPointer())
+			expected.addEvent(*e);
+
+		b1.addEvents(b2);
+
+		expectEquals<int>(b1.getNumUsed(), numToFill * 2, "Merged size");
+		expect(b1 == expected, "Merging is equal to inserting every event");
+
+		HiseEventBuffer copy(b1);
+
+		expect(copy == b1, "Copy constructor");
+	}
+
+	void testEventBufferUnsortedMerge()
+	{
+		beginTest("Testing HiseEventBuffer merging with changed timestamps");
+
+		HiseEventBuffer b1;
+		HiseEventBuffer b2;
+		HiseEventBuffer expected;
+
+		for (int i = 0; i < 64; i++)
+		{
+			HiseEvent e = generateRandomHiseEvent();
+
+			b1.addEvent(e);
+			expected.addEvent(e);
+
+			b2.addEvent(generateRandomHiseEvent());
+		}
+
+		// Changing the timestamps after the insertion leaves the other buffer unsorted
+		HiseEventBuffer::Iterator iter(b2);
+
+		while (HiseEvent* e = iter.getNextEventPointer())
+			e->setTimeStamp((uint16)r.nextInt(1024));
+
+		HiseEventBuffer::Iterator iter2(b2);
+
+		while (const HiseEvent* e = iter2.getNextConstEventPointer())
+			expected.addEvent(*e);
+
+		b1.addEvents(b2);
+
+		expectEquals<int>(b1.getNumUsed(), 128, "Merged size");
+		expect(b1 == expected, "Unsorted merging is equal to inserting every event");
+
+		HiseEventBuffer::Iterator iter3(b1);
+
+		uint16 lastTimestamp = 0;
+		bool isSorted = true;
+
+		while (const HiseEvent* e = iter3.getNextConstEventPointer())
+		{
+			isSorted &= e->getTimeStamp() >= lastTimestamp;
+			lastTimestamp = e->getTimeStamp();
+		}
+
+		expect(isSorted, "Merged buffer is sorted");
 	}
 
 	MidiMessage generateRandomMidiMessage()
@@ -737,6 +833,56 @@ private:
 		
 	}
 
+	void testNoteExpression()
+	{
+		beginTest("Testing per-channel notes and note expression");
+
+		HiseEventBuffer b;
+
+		MainController::EventIdHandler handler(b);
+		handler.setMpeEnabled(true);
+
+		b.addEvent(HiseEvent(HiseEvent::Type::NoteOn, 60, 100, 2));
+		b.addEvent(HiseEvent(HiseEvent::Type::NoteOn, 60, 100, 3));
+
+		handler.handleEventIds();
+
+		const uint16 firstId = b.getEvent(0).getEventId();
+		const uint16 secondId = b.getEvent(1).getEventId();
+
+		expect(!b.getEvent(1).isIgnored(), "Same note on another channel is valid");
+		expect(firstId != secondId, "Distinct event IDs");
+
+		b.clear();
+
+		HiseEvent bend(HiseEvent::Type::PitchBend, 0, 0, 3);
+		bend.setPitchWheelValue(16383);
+		bend.setTimeStamp(12);
+		b.addEvent(bend);
+		b.addEvent(HiseEvent(HiseEvent::Type::PitchBend, 0, 64, 5));
+
+		handler.handleEventIds();
+
+		const HiseEvent e = b.getEvent(0);
+
+		expect(e.isNoteExpression(), "Converted to NoteExpression");
+		expect(e.getExpressionType() == HiseEvent::ExpressionType::PitchBend, "Expression type");
+		expectEquals<int>(e.getEventId(), secondId, "Expression event ID");
+		expectEquals<int>(e.getTimeStamp(), 12, "Expression timestamp");
+		expectEquals<float>(e.getNormalisedExpressionValue(), 1.0f, "Expression value");
+		expect(b.getEvent(1).isIgnored(), "Expression without note is ignored");
+
+		b.clear();
+
+		b.addEvent(HiseEvent(HiseEvent::Type::NoteOff, 60, 0, 2));
+		b.addEvent(HiseEvent(HiseEvent::Type::NoteOff, 60, 0, 3));
+
+		handler.handleEventIds();
+
+		expectEquals<int>(b.getEvent(0).getEventId(), firstId, "First note off");
+		expectEquals<int>(b.getEvent(1).getEventId(), secondId, "Second note off");
+	}
+
 	Random r;
 };
 
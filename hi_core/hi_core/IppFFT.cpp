@@ -30,6 +30,240 @@
 *   ===========================================================================
 */
 
+int IppFFT::getPowerOfTwo(int size) const
+{
+	if (!isPowerOfTwo(size)) return -1;
+
+	const int N = (int)(log(size) / log(2));
+
+	if (isPositiveAndBelow(N, maxOrder))
+	{
+		return N;
+	}
+	else
+	{
+		jassertfalse;
+	}
+
+	return -1;
+}
+
+#if USE_PORTABLE_FFT
+
+IppFFT::IppFFT(DataType typeToUse, int maxPowerOfTwo /*= IPP_FFT_MAX_POWER_OF_TWO*/, const int flagToUse /*= IPP_FFT_NODIV_BY_ANY*/) :
+type(typeToUse),
+maxOrder(jmin<int>(maxPowerOfTwo, IPP_FFT_MAX_POWER_OF_TWO)),
+flag(flagToUse)
+{
+	// The IPP wrapper supports the orders 1 ... maxOrder - 1
+	const int portableOrder = jmax<int>(1, maxOrder - 1);
+
+	if (type == DataType::ComplexFloat || type == DataType::RealFloat)
+		floatFFT = new PortableFFT<float>(portableOrder);
+	else
+		doubleFFT = new PortableFFT<double>(portableOrder);
+}
+
+IppFFT::~IppFFT()
+{
+	floatFFT = nullptr;
+	doubleFFT = nullptr;
+}
+
+template <typename FloatType>
+void IppFFT::applyScaling(FloatType* data, int numValues, int size, bool inverse) const
+{
+	FloatType gain = FloatType(1);
+
+	if (flag & IPP_FFT_DIV_BY_SQRTN)
+		gain = FloatType(1.0 / sqrt((double)size));
+	else if ((flag & IPP_FFT_DIV_FWD_BY_N) && !inverse)
+		gain = FloatType(1.0 / (double)size);
+	else if ((flag & IPP_FFT_DIV_INV_BY_N) && inverse)
+		gain = FloatType(1.0 / (double)size);
+	else
+		return;
+
+	for (int i = 0; i < numValues; i++)
+		data[i] *= gain;
+}
+
+void IppFFT::realFFTInplace(float *data, int size) const
+{
+	jassert(type == DataType::RealFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		floatFFT->realFFT(data, N);
+		applyScaling(data, size, size, false);
+	}
+}
+
+void IppFFT::realFFTInplace(double *data, int size) const
+{
+	jassert(type == DataType::RealDouble);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		doubleFFT->realFFT(data, N);
+		applyScaling(data, size, size, false);
+	}
+}
+
+void IppFFT::realFFTInverseInplace(float *data, int size) const
+{
+	jassert(type == DataType::RealFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		floatFFT->realFFTInverse(data, N);
+		applyScaling(data, size, size, true);
+	}
+}
+
+void IppFFT::realFFTInverseInplace(double *data, int size) const
+{
+	jassert(type == DataType::RealDouble);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		doubleFFT->realFFTInverse(data, N);
+		applyScaling(data, size, size, true);
+	}
+}
+
+void IppFFT::complexFFTInplace(float *data, int size) const
+{
+	jassert(type == DataType::ComplexFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		floatFFT->complexFFT(data, N, false);
+		applyScaling(data, 2 * size, size, false);
+	}
+}
+
+void IppFFT::complexFFTInplace(double *data, int size) const
+{
+	jassert(type == DataType::ComplexDouble);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		doubleFFT->complexFFT(data, N, false);
+		applyScaling(data, 2 * size, size, false);
+	}
+}
+
+void IppFFT::complexFFTInverseInplace(float *data, int size) const
+{
+	jassert(type == DataType::ComplexFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		floatFFT->complexFFT(data, N, true);
+		applyScaling(data, 2 * size, size, true);
+	}
+}
+
+void IppFFT::complexFFTInverseInplace(double *data, int size) const
+{
+	jassert(type == DataType::ComplexDouble);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		doubleFFT->complexFFT(data, N, true);
+		applyScaling(data, 2 * size, size, true);
+	}
+}
+
+void IppFFT::realFFT(const float *in, float* out, int size) const
+{
+	jassert(type == DataType::RealFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		if (in != out)
+			FloatVectorOperations::copy(out, in, size);
+
+		realFFTInplace(out, size);
+
+		// Perm -> CCS (the output buffer must have size + 2 elements)
+		out[size] = out[1];
+		out[size + 1] = 0.0f;
+		out[1] = 0.0f;
+	}
+}
+
+void IppFFT::realFFTInverse(const float *in, float* out, int size) const
+{
+	jassert(type == DataType::RealFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		// CCS -> Perm
+		const float nyquist = in[size];
+
+		if (in != out)
+			FloatVectorOperations::copy(out, in, size);
+
+		out[1] = nyquist;
+
+		realFFTInverseInplace(out, size);
+	}
+}
+
+void IppFFT::complexFFT(const float *in, float* out, int size) const
+{
+	jassert(type == DataType::ComplexFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		if (in != out)
+			FloatVectorOperations::copy(out, in, 2 * size);
+
+		complexFFTInplace(out, size);
+	}
+}
+
+void IppFFT::complexFFTInverse(const float* in, float *out, int size) const
+{
+	jassert(type == DataType::ComplexFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		if (in != out)
+			FloatVectorOperations::copy(out, in, 2 * size);
+
+		complexFFTInverseInplace(out, size);
+	}
+}
+
+#else
+
 IppFFT::IppFFT(DataType typeToUse, int maxPowerOfTwo /*= IPP_FFT_MAX_POWER_OF_TWO*/, const int flagToUse /*= IPP_FFT_NODIV_BY_ANY*/) :
 type(typeToUse),
 maxOrder(jmin<int>(maxPowerOfTwo, IPP_FFT_MAX_POWER_OF_TWO)),
@@ -233,24 +467,6 @@ void IppFFT::complexFFTInverse(const float* in, float *out, int size) const
 	}
 }
 
-int IppFFT::getPowerOfTwo(int size) const
-{
-	if (!isPowerOfTwo(size)) return -1;
-
-	const int N = (int)(log(size) / log(2));
-
-	if (isPositiveAndBelow(N, maxOrder))
-	{
-		return N;
-	}
-	else
-	{
-		jassertfalse;
-	}
-
-	return -1;
-}
-
 
 void IppFFT::initFFT(int N)
 {
@@ -340,3 +556,5 @@ void IppFFT::Buffer::setSize(uint32 len)
 		data = nullptr;
 	}
 }
+
+#endif
@@ -34,8 +34,18 @@
 
 #define IPP_FFT_MAX_POWER_OF_TWO 16
 
+#if !USE_IPP
+#define IPP_FFT_DIV_FWD_BY_N 1
+#define IPP_FFT_DIV_INV_BY_N 2
+#define IPP_FFT_DIV_BY_SQRTN 4
+#define IPP_FFT_NODIV_BY_ANY 8
+#endif
+
 /** A wrapper around the Intel IPP FFT routines.
 *
+*	If USE_PORTABLE_FFT is enabled (which is the default if USE_IPP is disabled), it uses the PortableFFT class
+*	as backend, so the FFT routines are available on every platform with the same data layout and scaling.
+*
 *	It uses RAII to manage all required buffers & datas. In order to use it, create an instance once and then call the routines:
 *
 *	IppFFT fft(IppFFT:DataType::ComplexFloat);
@@ -116,13 +126,32 @@ public:
 	/** Complex inverse inplace FFT (input is aligned Complex<double> array, size is power of two.) */
 	void complexFFTInverseInplace(double *data, int size) const;
 
+#if !USE_PORTABLE_FFT
 	float *getAdditionalWorkBuffer()
 	{
 		return (float*)additionalWorkingBuffer->getData();
 	}
+#endif
 
 private:
 
+	/** @internal */
+	int getPowerOfTwo(int size) const;
+
+	const DataType type;
+	const int maxOrder;
+	const int flag;
+
+#if USE_PORTABLE_FFT
+
+	/** @internal */
+	template <typename FloatType> void applyScaling(FloatType* data, int numValues, int size, bool inverse) const;
+
+	ScopedPointer<PortableFFT<float>> floatFFT;
+	ScopedPointer<PortableFFT<double>> doubleFFT;
+
+#else
+
 	// =============================================================================================================================
 
 	class Buffer
@@ -156,8 +185,6 @@ private:
 
 	// =============================================================================================================================
 
-	/** @internal */
-	int getPowerOfTwo(int size) const;
 	/** @internal */
 	void initSpec(int N, Ipp8u *specData, Ipp8u *initData);
 	/** @internal */
@@ -165,10 +192,6 @@ private:
 	/** @internal */
 	void getSizes(int FFTOrder, int &sizeSpec, int &sizeInit, int &sizeBuffer);
 
-	const DataType type;
-	const int maxOrder;
-	const int flag;
-
 	IppsFFTSpec_C_32fc *complexFloatSpecs[IPP_FFT_MAX_POWER_OF_TWO];
 	IppsFFTSpec_C_64fc *complexDoubleSpecs[IPP_FFT_MAX_POWER_OF_TWO];
 	IppsFFTSpec_R_32f *realFloatSpecs[IPP_FFT_MAX_POWER_OF_TWO];
@@ -179,6 +202,8 @@ private:
 
 	ScopedPointer<Buffer> additionalWorkingBuffer;
 
+#endif
+
 	// =============================================================================================================================
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(IppFFT)
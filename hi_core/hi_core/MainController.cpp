@@ -63,6 +63,8 @@ MainController::MainController():
 	presetLoadRampFlag(0),
 	suspendIndex(0),
 	controlUndoManager(new UndoManager()),
+	backgroundTaskPool(new BackgroundTaskPool()),
+	commandQueue(this),
     globalCodeFontSize(17.0f)
 {
 	BACKEND_ONLY(popupConsole = nullptr);
@@ -72,6 +74,8 @@ MainController::MainController():
 	BACKEND_ONLY(shownComponents.setBit(BackendCommandTarget::Macros, 0));
 
 	TempoSyncer::initTempoData();
+
+	sampleAccurateControllers.store(HISE_SAMPLE_ACCURATE_CONTROLLERS != 0);
     
 	globalVariableArray.insertMultiple(0, var::undefined(), NUM_GLOBAL_VARIABLES);
 	globalVariableObject = new DynamicObject();
@@ -96,6 +100,8 @@ MainController::MainController():
 
 MainController::~MainController()
 {
+	backgroundTaskPool = nullptr;
+
 	Logger::setCurrentLogger(nullptr);
 	logger = nullptr;
 	masterReference.clear();
@@ -220,6 +226,7 @@ void MainController::loadPreset(ValueTree &v, Component* /*mainEditor*/)
 void MainController::startCpuBenchmark(int bufferSize_)
 {
 	bufferSize.set(bufferSize_);
+	++cpuBlockIndex;
 	temp_usage = (Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks()));
 }
 
@@ -436,6 +443,8 @@ void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &m
 
 	getDebugLogger().checkPriorityInversion(processLock);
 
+	// Some operations (eg. loading a sample map or a preset) still hold the lock for a long time, so the block
+	// is dropped instead of waiting. This can be removed once they all go through the AudioThreadCommandQueue.
 	ScopedTryLock sl(processLock);
 
 	if (!sl.isLocked())
@@ -445,6 +454,13 @@ void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &m
 		return;
 	}
 
+	commandQueue.executePendingCommands();
+
+	backgroundTaskPool->handleAudioThreadResults();
+
+	// Offline bounces wait for the streaming thread instead of dropping samples
+	getSampleManager().getGlobalSampleThreadPool()->setWaitForPendingJobs(thisAsProcessor->isNonRealtime());
+
 	ModulatorSynthChain *synthChain = getMainSynthChain();
 
 	if (buffer.getNumSamples() != bufferSize.get())
@@ -618,6 +634,56 @@ void MainController::prepareToPlay(double sampleRate_, int samplesPerBlock)
     getMainSynthChain()->prepareToPlay(sampleRate, samplesPerBlock);
 
 	getMainSynthChain()->setIsOnAir(true);
+
+	// The host expects the latency to be set in prepareToPlay(), so this doesn't wait for the message thread
+	latencyUpdater.cancelPendingUpdate();
+	setLatencyFromProcessors();
+}
+
+void MainController::updateLatency()
+{
+	latencyUpdater.triggerAsyncUpdate();
+}
+
+/** Returns the latency of the effect chain plus the biggest latency of the child synths (which are rendered in parallel).
+*
+*	The child synths with a smaller latency are delayed so that they line up with the slowest one.
+*/
+static int updateLatencyOfSynth(ModulatorSynth* synth)
+{
+	if (synth == nullptr || synth->isBypassed()) return 0;
+
+	int childLatency = 0;
+
+	if (dynamic_cast<ModulatorSynthChain*>(synth) != nullptr)
+	{
+		Array<int> childLatencies;
+
+		for (int i = ModulatorSynth::numInternalChains; i < synth->getNumChildProcessors(); i++)
+		{
+			childLatencies.add(updateLatencyOfSynth(dynamic_cast<ModulatorSynth*>(synth->getChildProcessor(i))));
+			childLatency = jmax<int>(childLatency, childLatencies.getLast());
+		}
+
+		for (int i = 0; i < childLatencies.size(); i++)
+		{
+			ModulatorSynth* child = dynamic_cast<ModulatorSynth*>(synth->getChildProcessor(ModulatorSynth::numInternalChains + i));
+
+			if (child != nullptr)
+				child->setLatencyCompensation(childLatency - childLatencies[i]);
+		}
+	}
+
+	const EffectProcessorChain *fxChain = dynamic_cast<const EffectProcessorChain*>(synth->getChildProcessor(ModulatorSynth::EffectChain));
+
+	return childLatency + (fxChain != nullptr ? fxChain->getLatencySamples() : 0);
+}
+
+void MainController::setLatencyFromProcessors()
+{
+	if (thisAsProcessor == nullptr) return;
+
+	thisAsProcessor->setLatencySamples(delayedRenderer.getLatencySamples() + updateLatencyOfSynth(getMainSynthChain()));
 }
 
 void MainController::setBpm(double bpm_)
@@ -630,29 +696,39 @@ void MainController::setBpm(double bpm_)
 
 		for(int i = 0; i < tempoListeners.size(); i++)
 		{
-			if(tempoListeners[i].get() != nullptr)
-			{
-				tempoListeners[i].get()->tempoChanged(bpm);
-			}
-			else
-			{
-				// delete it with removeTempoListener!
-				jassertfalse;
-			}
+			tempoListeners.getUnchecked(i)->tempoChanged(bpm);
 		}
 	}
 };
 
 void MainController::addTempoListener(TempoListener *t)
 {
-	ScopedLock sl(getLock());
-	tempoListeners.addIfNotAlreadyThere(t);
+	ScopedLock sl(tempoListenerRegistrationLock);
+
+	if (registeredTempoListeners.addIfNotAlreadyThere(t))
+		updateAudioThreadTempoListeners(false);
 }
 
 void MainController::removeTempoListener(TempoListener *t)
 {
-	ScopedLock sl(getLock());
-	tempoListeners.removeAllInstancesOf(t);
+	ScopedLock sl(tempoListenerRegistrationLock);
+
+	if (registeredTempoListeners.removeAllInstancesOf(t) != 0)
+		updateAudioThreadTempoListeners(true);
+}
+
+void MainController::updateAudioThreadTempoListeners(bool waitForAudioThread)
+{
+	// The list is allocated here and swapped on the audio thread, so the old list will be deallocated on the message thread
+	auto newList = std::make_shared<Array<TempoListener*>>(registeredTempoListeners);
+
+	auto swapList = [this, newList]()
+	{
+		tempoListeners.swapWith(*newList);
+	};
+
+	if (waitForAudioThread) commandQueue.postCommandAndWait(swapList);
+	else					commandQueue.postCommand(swapList);
 }
 
 juce::Typeface* MainController::getFont(const String &fontName) const
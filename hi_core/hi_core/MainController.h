@@ -216,19 +216,43 @@ public:
 		/** Adds a CC remapping configuration. If this is enabled, the CC numbers will be swapped. If you pass in the same numbers, it will be deactivated. */
 		void addCCRemap(int firstCC_, int secondCC_);;
 
+		/** Enables the MPE mode (lower zone with the member channels 2-16).
+		*
+		*	If this is enabled, pitch bend, channel pressure and CC74 messages on the member channels are 
+		*	converted to NoteExpression events for the last note that was started on that channel.
+		*/
+		void setMpeEnabled(bool shouldBeEnabled) noexcept { mpeEnabled.store(shouldBeEnabled); }
+
+		bool isMpeEnabled() const noexcept { return mpeEnabled.load(); }
+
+		/** Sets the per-note pitch bend range in semitones (the MPE default is 48). */
+		void setMpePitchBendRange(int numSemitones) noexcept { mpePitchBendRange.store(jlimit<int>(0, 96, numSemitones)); }
+
+		int getMpePitchBendRange() const noexcept { return mpePitchBendRange.load(); }
+
 		// ===========================================================================================================
 
 	private:
 
+		/** Converts the channel message to a NoteExpression event (or ignores it if there is no note on the channel). */
+		void convertToNoteExpression(HiseEvent& m) const noexcept;
+
+		static int getChannelIndex(const HiseEvent& e) noexcept { return (e.getChannel() - 1) & 15; }
+
         std::atomic<int> firstCC;
         std::atomic<int> secondCC;
 
 		const HiseEventBuffer &masterBuffer;
 		HeapBlock<HiseEvent> artificialEvents;
 		uint16 lastArtificialEventIds[128];
-		HiseEvent realNoteOnEvents[128];
+		HiseEvent realNoteOnEvents[16][128];
+		uint16 lastEventIdForChannel[16];
+		bool channelHasNote[16]; // the event id wraps around, so 0 can't be used as "no note" value
 		uint16 currentEventId;
 
+		std::atomic<bool> mpeEnabled;
+		std::atomic<int> mpePitchBendRange;
+
 		int transposeValue = 0;
 
 		// ===========================================================================================================
@@ -259,6 +283,13 @@ public:
 		void timerCallback();
 		void loadUserPreset(const ValueTree& presetToLoad);
 
+		/** Changes an attribute of the processor (this is used by the scripting API).
+		*
+		*	While a preset is applied, the changes of the control callbacks are collected and applied together 
+		*	at the next block boundary, so the voices keep playing and never render a half applied preset.
+		*/
+		void setProcessorAttribute(Processor* p, int parameterIndex, float newValue);
+
 		File getCurrentlyLoadedFile() const { return currentlyLoadedFile; };
 
 		void setCurrentlyLoadedFile(const File& f) { currentlyLoadedFile = f; };
@@ -267,12 +298,26 @@ public:
 
 	private:
 
+		struct AttributeChange
+		{
+			WeakReference<Processor> processor;
+			int parameterIndex;
+			float newValue;
+		};
+
 		void loadPresetInternal();
 
+		/** Posts the collected attribute changes to the AudioThreadCommandQueue. */
+		void postAttributeChanges();
+
+		ValueTree getPresetDataFor(const String& processorId) const;
 		
 		MainController* mc;
 		ValueTree currentPreset;
 
+		bool applyingPreset = false;
+		std::vector<AttributeChange> attributeChanges;
+
 		File currentlyLoadedFile;
 
 		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(UserPresetHandler)
@@ -446,6 +491,15 @@ public:
 	DelayedRenderer& getDelayedRenderer() { return delayedRenderer; };
 	const DelayedRenderer& getDelayedRenderer() const { return delayedRenderer; };
 
+	/** Reports the latency of the DelayedRenderer and the effects to the host.
+	*
+	*	Child synths with a smaller latency than their siblings are delayed so that they line up with the slowest one 
+	*	(see ModulatorSynth::setLatencyCompensation()).
+	*	This can be called from any thread whenever an effect changes its latency (eg. if the oversampling factor changes or
+	*	the effect is bypassed). The latency is reported asynchronously on the message thread. prepareToPlay() reports it directly.
+	*/
+	void updateLatency();
+
 	UserPresetHandler& getUserPresetHandler() { return userPresetHandler; };
 	const UserPresetHandler& getUserPresetHandler() const { return userPresetHandler; };
 
@@ -455,6 +509,13 @@ public:
 	ProcessorChangeHandler& getProcessorChangeHandler() { return processorChangeHandler; }
 	const ProcessorChangeHandler& getProcessorChangeHandler() const { return processorChangeHandler; }
 
+	/** Returns the queue that transfers state changes to the audio thread without locking. */
+	AudioThreadCommandQueue& getCommandQueue() { return commandQueue; }
+
+	/** Returns the thread pool for heavy operations that should not be executed on the audio or message thread. */
+	BackgroundTaskPool& getBackgroundTaskPool() { return *backgroundTaskPool; }
+	const BackgroundTaskPool& getBackgroundTaskPool() const { return *backgroundTaskPool; }
+
 #if USE_BACKEND
 	/** Writes to the console. */
 	void writeToConsole(const String &message, int warningLevel, const Processor *p=nullptr, Colour c=Colours::transparentBlack);
@@ -510,8 +571,11 @@ public:
 	/** adds a TempoListener to the main controller that will receive a callback whenever the host changes the tempo. */
 	void addTempoListener(TempoListener *t);
 
-	/** removes a TempoListener. */
-	void removeTempoListener(TempoListener *t);;
+	/** removes a TempoListener. 
+	*
+	*	This waits until the audio thread has acknowledged the removal, so it's safe to call this in the destructor of the listener.
+	*/
+	void removeTempoListener(TempoListener *t);
 
 	ApplicationCommandManager *getCommandManager() { return mainCommandManager; };
 
@@ -575,6 +639,23 @@ public:
 	/** Returns the time that the plugin spends in its processBlock method. */
 	float getCpuUsage() const {return usagePercent.load();};
 
+	/** Returns the index of the current audio block. 
+	*
+	*	This is incremented with every CPU benchmark and used by the per-processor counters to detect the block boundary.
+	*/
+	int getCpuBlockIndex() const noexcept { return cpuBlockIndex.get(); }
+
+	/** Converts the given high resolution ticks into the percentage of the time that is available for one buffer. */
+	float getCpuUsageForTicks(int64 ticks) const noexcept
+	{
+		const int numSamples = bufferSize.get();
+
+		if (numSamples <= 0)
+			return 0.0f;
+
+		return 100.0f * (float)(Time::highResolutionTicksToSeconds(ticks) * sampleRate / (double)numSamples);
+	}
+
 	/** Returns the amount of playing voices. */
 	int getNumActiveVoices() const;;
 
@@ -661,15 +742,24 @@ public:
 
 	EventIdHandler& getEventHandler() { return eventIdHandler; }
 
+	/** If enabled, controller events don't split the audio block, but are rendered sample accurate into the modulation buffers. */
+	void setUseSampleAccurateControllers(bool shouldBeEnabled) noexcept { sampleAccurateControllers.store(shouldBeEnabled); }
+
+	bool isUsingSampleAccurateControllers() const noexcept { return sampleAccurateControllers.load(); }
+
 	bool shouldSkipCompiling() const
 	{
 		return skipCompilingAtPresetLoad;
 	}
 
+	/** Loads the user preset.
+	*
+	*	Only the controls that differ from the current state are restored. If the preset doesn't change
+	*	any control, the audio playback is not interrupted. Otherwise all notes are killed and the output is
+	*	faded out before the preset is applied and faded in after it (or after the last background task it started).
+	*/
 	void loadUserPresetAsync(const ValueTree& v)
 	{
-		allNotesOff();
-		presetLoadRampFlag.set(-1);
 		userPresetHandler.loadUserPreset(v);
 	}
 
@@ -825,7 +915,9 @@ protected:
 		if (shouldSuspend)
 		{
 			if (suspendIndex == 0)
+			{
 				getAsAudioProcessor()->suspendProcessing(true);
+			}
 
 			++suspendIndex;
 		}
@@ -834,7 +926,9 @@ protected:
 			--suspendIndex;
 
 			if (suspendIndex == 0)
+			{
 				getAsAudioProcessor()->suspendProcessing(false);
+			}
 
 			jassert(suspendIndex >= 0);
 
@@ -862,6 +956,8 @@ private:
 
 	bool replaceBufferContent = true;
 
+	std::atomic<bool> sampleAccurateControllers;
+
 	HiseEventBuffer masterEventBuffer;
 	EventIdHandler eventIdHandler;
 	UserPresetHandler userPresetHandler;
@@ -892,10 +988,16 @@ private:
 	ScopedPointer<SampleManager> sampleManager;
 	MacroManager macroManager;
 
+	ScopedPointer<BackgroundTaskPool> backgroundTaskPool;
+
+	AudioThreadCommandQueue commandQueue;
+
 	Component::SafePointer<Plotter> plotter;
 
 	Atomic<int> bufferSize;
 
+	Atomic<int> cpuBlockIndex;
+
 	Atomic<int> presetLoadRampFlag;
 
 	AudioPlayHead::CurrentPositionInfo lastPosInfo;
@@ -934,9 +1036,34 @@ private:
 
 #endif
 
-    AudioProcessor* thisAsProcessor;
+    AudioProcessor* thisAsProcessor = nullptr;
+
+	class LatencyUpdater : public AsyncUpdater
+	{
+	public:
+
+		LatencyUpdater(MainController& mc_) : mc(mc_) {}
+
+		void handleAsyncUpdate() override { mc.setLatencyFromProcessors(); }
+
+	private:
+
+		MainController& mc;
+	};
+
+	void setLatencyFromProcessors();
+
+	LatencyUpdater latencyUpdater { *this };
     
-	Array<WeakReference<TempoListener>> tempoListeners;
+	/** The list that is used by the audio thread. It is only changed by swapping in a new list with the command queue. */
+	Array<TempoListener*> tempoListeners;
+
+	/** The list of registered listeners. This is only accessed by the threads that add / remove listeners. */
+	CriticalSection tempoListenerRegistrationLock;
+	Array<TempoListener*> registeredTempoListeners;
+
+	/** Posts a copy of the registered listeners to the audio thread. */
+	void updateAudioThreadTempoListeners(bool waitForAudioThread);
 
     std::atomic<float> usagePercent;
 
@@ -329,7 +329,8 @@ public:
 
 DelayedRenderer::DelayedRenderer(MainController* mc_) :
 	pimpl(new Pimpl()),
-	mc(mc_)
+	mc(mc_),
+	fullBlockSize(0)
 {
 }
 
@@ -343,6 +344,11 @@ bool DelayedRenderer::shouldDelayRendering() const
 	return pimpl->shouldDelayRendering();
 }
 
+int DelayedRenderer::getLatencySamples() const
+{
+	return shouldDelayRendering() ? fullBlockSize : 0;
+}
+
 void DelayedRenderer::processWrapped(AudioSampleBuffer& buffer, MidiBuffer& midiMessages)
 {
 	if (shouldDelayRendering())
@@ -425,8 +431,6 @@ void DelayedRenderer::prepareToPlayWrapped(double sampleRate, int samplesPerBloc
 
 		sampleIndex = 0;
 
-		dynamic_cast<AudioProcessor*>(mc)->setLatencySamples(fullBlockSize);
-
 		mc->prepareToPlay(sampleRate, fullBlockSize);
 	}
 	else
@@ -434,3 +438,155 @@ void DelayedRenderer::prepareToPlayWrapped(double sampleRate, int samplesPerBloc
 		mc->prepareToPlay(sampleRate, samplesPerBlock);
 	}
 }
+
+AudioThreadCommandQueue::AudioThreadCommandQueue(MainController* mc_) :
+	mc(mc_),
+	lastCallbackTime(0),
+	pendingCommands(1024),
+	executedCommands(2048)
+{
+
+}
+
+AudioThreadCommandQueue::~AudioThreadCommandQueue()
+{
+	cancelPendingUpdate();
+
+	Command c;
+
+	while (pendingCommands.pop(c))
+	{
+		if (c.messageThreadCleanup)
+			c.messageThreadCleanup();
+	}
+
+	handleAsyncUpdate();
+}
+
+void AudioThreadCommandQueue::postCommand(const Function& audioThreadFunction, const Function& messageThreadCleanup)
+{
+	Command c;
+	c.audioThreadFunction = audioThreadFunction;
+	c.messageThreadCleanup = messageThreadCleanup;
+
+	if (!isAudioCallbackActive())
+	{
+		executeSynchronously(c);
+		return;
+	}
+
+	if (!pendingCommands.push(std::move(c)))
+	{
+		// The queue is full, so we need to fall back to the lock...
+		executeSynchronously(c);
+	}
+}
+
+void AudioThreadCommandQueue::postCommandAndWait(const Function& audioThreadFunction)
+{
+	const CriticalSection& lock = mc->getLock();
+
+	if (lock.tryEnter())
+	{
+		// The audio thread is not inside the callback, so the command can be executed right away
+		executeQueuedCommands();
+		audioThreadFunction();
+
+		lock.exit();
+		return;
+	}
+
+	auto executed = std::make_shared<WaitableEvent>();
+
+	postCommand([audioThreadFunction, executed]()
+	{
+		audioThreadFunction();
+		executed->signal();
+	});
+
+	while (!executed->wait(100))
+	{
+		// The audio callback might have stopped before it could execute the command
+		if (lock.tryEnter())
+		{
+			executeQueuedCommands();
+			lock.exit();
+		}
+	}
+}
+
+void AudioThreadCommandQueue::executePendingCommands()
+{
+	lastCallbackTime.store(Time::getMillisecondCounter());
+
+	executeQueuedCommands();
+}
+
+void AudioThreadCommandQueue::executeQueuedCommands()
+{
+	Command c;
+	bool somethingExecuted = false;
+
+	while (pendingCommands.pop(c))
+	{
+		c.audioThreadFunction();
+
+		// The command might hold references that deallocate, so it will be destroyed on the message thread
+		if (!executedCommands.push(std::move(c)))
+		{
+			jassertfalse;
+
+			if (c.messageThreadCleanup)
+				c.messageThreadCleanup();
+		}
+
+		somethingExecuted = true;
+	}
+
+	if (somethingExecuted)
+		triggerAsyncUpdate();
+}
+
+void AudioThreadCommandQueue::handleAsyncUpdate()
+{
+	Command c;
+
+	while (executedCommands.pop(c))
+	{
+		if (c.messageThreadCleanup)
+			c.messageThreadCleanup();
+	}
+}
+
+bool AudioThreadCommandQueue::isAudioCallbackActive() const
+{
+	const uint32 timeSinceLastCallback = Time::getMillisecondCounter() - lastCallbackTime.load();
+
+	return lastCallbackTime.load() != 0 && timeSinceLastCallback < 500;
+}
+
+void AudioThreadCommandQueue::executeSynchronously(Command& c)
+{
+	{
+		ScopedLock sl(mc->getLock());
+
+		// Execute the pending commands first to keep the order
+		executeQueuedCommands();
+
+		c.audioThreadFunction();
+	}
+
+	if (c.messageThreadCleanup)
+	{
+		if (MessageManager::getInstance()->isThisTheMessageThread())
+		{
+			handleAsyncUpdate();
+			c.messageThreadCleanup();
+		}
+		else
+		{
+			executedCommands.push(std::move(c));
+			triggerAsyncUpdate();
+		}
+	}
+}
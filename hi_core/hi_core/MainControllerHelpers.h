@@ -288,6 +288,9 @@ public:
 	/** Calls prepareToPlay with either 256 samples or a smaller buffer size (if the block size is smaller). It correctly reports the latency to the host. */
 	void prepareToPlayWrapped(double sampleRate, int samplesPerBlock);
 
+	/** Returns the latency that is caused by the delayed rendering. */
+	int getLatencySamples() const;
+
 private:
 
 	class Pimpl;
@@ -310,5 +313,70 @@ private:
 };
 
 
+/** A lock free queue that transfers state changes from other threads to the audio thread.
+*
+*	Instead of locking the audio thread while you change something that is used in the audio callback, you can post
+*	a command here which will be executed by the audio thread at the beginning of the next block. After it was executed,
+*	the (optional) cleanup function will be called on the message thread, where you can safely deallocate objects and 
+*	send update messages.
+*
+*	If the audio callback is not running, the commands will be executed synchronously (with the main lock held).
+*/
+class AudioThreadCommandQueue : public AsyncUpdater
+{
+public:
+
+	typedef std::function<void()> Function;
+
+	AudioThreadCommandQueue(MainController* mc);
+
+	~AudioThreadCommandQueue();
+
+	/** Posts a command that will be executed on the audio thread at the beginning of the next block.
+	*
+	*	@param audioThreadFunction this will be executed on the audio thread, so don't allocate / lock in there.
+	*	@param messageThreadCleanup this will be executed on the message thread after the audio thread function was executed.
+	*/
+	void postCommand(const Function& audioThreadFunction, const Function& messageThreadCleanup=Function());
+
+	/** Posts a command and waits until the audio thread has executed it. 
+	*
+	*	Use this if the caller relies on the audio thread not using something anymore after this method returns
+	*	(eg. when a listener unregisters itself in its destructor). If the audio callback is not running, the command
+	*	is executed directly on the calling thread. Never call this from the audio thread.
+	*/
+	void postCommandAndWait(const Function& audioThreadFunction);
+
+	/** Executes all pending commands. This is called by the MainController at the beginning of each block. */
+	void executePendingCommands();
+
+	/** \internal Calls the cleanup functions of the executed commands. */
+	void handleAsyncUpdate() override;
+
+private:
+
+	struct Command
+	{
+		Function audioThreadFunction;
+		Function messageThreadCleanup;
+	};
+
+	bool isAudioCallbackActive() const;
+
+	void executeQueuedCommands();
+
+	void executeSynchronously(Command& c);
+
+	MainController* mc;
+
+	std::atomic<uint32> lastCallbackTime;
+
+	LockfreeQueue<Command> pendingCommands;
+	LockfreeQueue<Command> executedCommands;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioThreadCommandQueue);
+};
+
+
 
 #endif  // MAINCONTROLLERHELPERS_H_INCLUDED
@@ -267,51 +267,103 @@ void MainController::UserPresetHandler::lastTaskRemoved()
 {
 	jassert(mc->presetLoadRampFlag.get() != 1);
 
-	mc->presetLoadRampFlag.set(1);
+	if (mc->presetLoadRampFlag.get() != RampFlags::Active)
+		mc->presetLoadRampFlag.set(RampFlags::FadeIn);
 }
 
 
 void MainController::UserPresetHandler::timerCallback()
 {
-	loadPresetInternal();
 	stopTimer();
+
+#if USE_BACKEND
+	if (!GET_PROJECT_HANDLER(mc->getMainSynthChain()).isActive()) return;
+#endif
+
+	loadPresetInternal();
 }
 
 void MainController::UserPresetHandler::loadUserPreset(const ValueTree& presetToLoad)
 {
 	currentPreset = presetToLoad;
+
 	startTimer(50);
 }
 
-void MainController::UserPresetHandler::loadPresetInternal()
+void MainController::UserPresetHandler::setProcessorAttribute(Processor* p, int parameterIndex, float newValue)
 {
-#if USE_BACKEND
-	if (!GET_PROJECT_HANDLER(mc->getMainSynthChain()).isActive()) return;
-#endif
+	if (applyingPreset && MessageManager::getInstance()->isThisTheMessageThread())
+	{
+		AttributeChange change = { p, parameterIndex, newValue };
+		attributeChanges.push_back(change);
+	}
+	else
+	{
+		p->setAttribute(parameterIndex, newValue, sendNotification);
+	}
+}
+
+void MainController::UserPresetHandler::postAttributeChanges()
+{
+	if (attributeChanges.empty())
+		return;
+
+	auto changes = std::make_shared<std::vector<AttributeChange>>();
+	changes->swap(attributeChanges);
+
+	mc->getCommandQueue().postCommand([changes]()
+	{
+		for (const auto& c : *changes)
+		{
+			if (c.processor.get() != nullptr)
+				c.processor.get()->setAttribute(c.parameterIndex, c.newValue, dontSendNotification);
+		}
+	},
+	[changes]()
+	{
+		for (const auto& c : *changes)
+		{
+			if (c.processor.get() != nullptr)
+				c.processor.get()->sendChangeMessage();
+		}
+	});
+}
+
+ValueTree MainController::UserPresetHandler::getPresetDataFor(const String& processorId) const
+{
+	for (int i = 0; i < currentPreset.getNumChildren(); i++)
+	{
+		if (currentPreset.getChild(i).getProperty("Processor") == processorId)
+			return currentPreset.getChild(i);
+	}
 
+	return ValueTree();
+}
+
+void MainController::UserPresetHandler::loadPresetInternal()
+{
 	Processor::Iterator<JavascriptMidiProcessor> iter(mc->getMainSynthChain());
 
+	// Only the controls that differ from the preset execute their callbacks. Their module changes are
+	// applied at the same block boundary while the voices keep playing (see setProcessorAttribute()).
+	applyingPreset = true;
+
 	while (JavascriptMidiProcessor *sp = iter.getNextProcessor())
 	{
 		if (!sp->isFront()) continue;
 
-		ValueTree v;
-
-		for (int i = 0; i < currentPreset.getNumChildren(); i++)
-		{
-			if (currentPreset.getChild(i).getProperty("Processor") == sp->getId())
-			{
-				v = currentPreset.getChild(i);
-				break;
-			}
-		}
+		ValueTree v = getPresetDataFor(sp->getId());
 
 		if (v.isValid())
 		{
-			sp->getScriptingContent()->restoreAllControlsFromPreset(v);
+			sp->getScriptingContent()->restoreChangedControlsFromPreset(v);
 		}
 	}
 
+	applyingPreset = false;
+
+	postAttributeChanges();
+
 	ValueTree autoData = currentPreset.getChildWithName("MidiAutomation");
 
 	if (autoData.isValid())
@@ -319,9 +371,10 @@ void MainController::UserPresetHandler::loadPresetInternal()
 
 	auto h = dynamic_cast<ThreadWithQuasiModalProgressWindow::Holder*>(mc);
 
-	if(!h->isBusy())
+	// If a background task was started, lastTaskRemoved() will fade in again
+	if (!h->isBusy() && mc->presetLoadRampFlag.get() != RampFlags::Active)
 	{
-		mc->presetLoadRampFlag.set(1);
+		mc->presetLoadRampFlag.set(RampFlags::FadeIn);
 	}
 }
 
@@ -430,11 +483,13 @@ MainController::EventIdHandler::EventIdHandler(HiseEventBuffer& masterBuffer_) :
 {
     firstCC.store(-1);
     secondCC.store(-1);
-    
-	//for (int i = 0; i < 128; i++)
-		//realNoteOnEvents[i] = HiseEvent();
 
-	memset(realNoteOnEvents, 0, sizeof(HiseEvent) * 128);
+	mpeEnabled.store(false);
+	mpePitchBendRange.store(48);
+    
+	memset(realNoteOnEvents, 0, sizeof(realNoteOnEvents));
+	memset(lastEventIdForChannel, 0, sizeof(lastEventIdForChannel));
+	memset(channelHasNote, 0, sizeof(channelHasNote));
 
 	artificialEvents.calloc(HISE_EVENT_ID_ARRAY_SIZE, sizeof(HiseEvent));
 }
@@ -473,15 +528,23 @@ void MainController::EventIdHandler::handleEventIds()
 
 		if (m->isAllNotesOff())
 		{
-			memset(realNoteOnEvents, 0, sizeof(HiseEvent) * 128);
+			memset(realNoteOnEvents, 0, sizeof(realNoteOnEvents));
+			memset(lastEventIdForChannel, 0, sizeof(lastEventIdForChannel));
+			memset(channelHasNote, 0, sizeof(channelHasNote));
 		}
 
+		const int channelIndex = getChannelIndex(*m);
+
 		if (m->isNoteOn())
 		{
-			if (realNoteOnEvents[m->getNoteNumber()].isEmpty())
+			HiseEvent& on = realNoteOnEvents[channelIndex][m->getNoteNumber()];
+
+			if (on.isEmpty())
 			{
 				m->setEventId(currentEventId);
-				realNoteOnEvents[m->getNoteNumber()] = HiseEvent(*m);
+				on = HiseEvent(*m);
+				lastEventIdForChannel[channelIndex] = currentEventId;
+				channelHasNote[channelIndex] = true;
 				currentEventId++;
 			}
 			else
@@ -492,14 +555,17 @@ void MainController::EventIdHandler::handleEventIds()
 		}
 		else if (m->isNoteOff())
 		{
-			if (!realNoteOnEvents[m->getNoteNumber()].isEmpty())
+			if (!realNoteOnEvents[channelIndex][m->getNoteNumber()].isEmpty())
 			{
-                HiseEvent* on = &realNoteOnEvents[m->getNoteNumber()];
+                HiseEvent* on = &realNoteOnEvents[channelIndex][m->getNoteNumber()];
                 
 				uint16 id = on->getEventId();
 				m->setEventId(id);
                 m->setTransposeAmount(on->getTransposeAmount());
                 *on = HiseEvent();
+
+				if (channelHasNote[channelIndex] && lastEventIdForChannel[channelIndex] == id)
+					channelHasNote[channelIndex] = false;
 			}
 			else
 			{
@@ -507,6 +573,10 @@ void MainController::EventIdHandler::handleEventIds()
 				m->ignoreEvent(true);
 			}
 		}
+		else if (mpeEnabled && channelIndex != 0 && (m->isPitchWheel() || m->isChannelPressure() || (m->isController() && m->getControllerNumber() == 74)))
+		{
+			convertToNoteExpression(*m);
+		}
 		else if (firstCC != -1 && m->isController())
 		{
 			const int ccNumber = m->getControllerNumber();
@@ -523,6 +593,32 @@ void MainController::EventIdHandler::handleEventIds()
 	}
 }
 
+void MainController::EventIdHandler::convertToNoteExpression(HiseEvent& m) const noexcept
+{
+	const int channelIndex = getChannelIndex(m);
+
+	if (!channelHasNote[channelIndex])
+	{
+		// No active note on this member channel
+		m.ignoreEvent(true);
+		return;
+	}
+
+	const uint16 eventId = lastEventIdForChannel[channelIndex];
+
+	const int channel = m.getChannel();
+	const uint16 timestamp = m.getTimeStamp();
+
+	if (m.isPitchWheel())
+		m = HiseEvent::createNoteExpression(eventId, HiseEvent::ExpressionType::PitchBend, m.getPitchWheelValue(), channel);
+	else if (m.isChannelPressure())
+		m = HiseEvent::createNoteExpression(eventId, HiseEvent::ExpressionType::Pressure, m.getChannelPressureValue() << 7, channel);
+	else
+		m = HiseEvent::createNoteExpression(eventId, HiseEvent::ExpressionType::Timbre, m.getControllerValue() << 7, channel);
+
+	m.setTimeStamp(timestamp);
+}
+
 uint16 MainController::EventIdHandler::getEventIdForNoteOff(const HiseEvent &noteOffEvent)
 {
 	jassert(noteOffEvent.isNoteOff());
@@ -531,11 +627,7 @@ uint16 MainController::EventIdHandler::getEventIdForNoteOff(const HiseEvent &not
 
 	if (!noteOffEvent.isArtificial())
 	{
-		const HiseEvent* e = realNoteOnEvents + noteNumber;
-
-		return e->getEventId();
-
-		//return realNoteOnEvents +noteNumber.getEventId();
+		return realNoteOnEvents[getChannelIndex(noteOffEvent)][noteNumber].getEventId();
 	}
 	else
 	{
@@ -579,7 +671,7 @@ HiseEvent MainController::EventIdHandler::peekNoteOn(const HiseEvent& noteOffEve
 	}
 	else
 	{
-		return realNoteOnEvents[noteOffEvent.getNoteNumber()];
+		return realNoteOnEvents[getChannelIndex(noteOffEvent)][noteOffEvent.getNoteNumber()];
 	}
 }
 
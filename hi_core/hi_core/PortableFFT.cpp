@@ -0,0 +1,622 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#if JUCE_INTEL && !JUCE_IOS
+#define HI_PORTABLE_FFT_USE_SSE 1
+#include <xmmintrin.h>
+#else
+#define HI_PORTABLE_FFT_USE_SSE 0
+#endif
+
+namespace PortableFFTHelpers
+{
+
+/** The first pass for odd orders (the butterflies of two adjacent values don't need twiddle factors). */
+template <typename T> static void radix2Pass(T* d, int numComplex)
+{
+	for (int i = 0; i < 2 * numComplex; i += 4)
+	{
+		T* a = d + i;
+
+		const T br = a[2];
+		const T bi = a[3];
+
+		a[2] = a[0] - br;
+		a[3] = a[1] - bi;
+		a[0] += br;
+		a[1] += bi;
+	}
+}
+
+/** Combines two radix-2 stages: four transforms of the size m are merged into one transform of the size 4m. */
+template <typename T, bool inverse> static void radix4PassScalar(T* d, int numComplex, int m, const T* tw)
+{
+	for (int k = 0; k < numComplex; k += 4 * m)
+	{
+		T* x0 = d + 2 * k;
+		T* x1 = x0 + 2 * m;
+		T* x2 = x1 + 2 * m;
+		T* x3 = x2 + 2 * m;
+
+		for (int j = 0; j < m; j++)
+		{
+			const T* w = tw + 4 * j;
+
+			const T w1r = w[0];
+			const T w1i = inverse ? -w[1] : w[1];
+			const T w2r = w[2];
+			const T w2i = inverse ? -w[3] : w[3];
+
+			const int o = 2 * j;
+
+			const T b1r = x1[o] * w2r - x1[o + 1] * w2i;
+			const T b1i = x1[o] * w2i + x1[o + 1] * w2r;
+			const T b3r = x3[o] * w2r - x3[o + 1] * w2i;
+			const T b3i = x3[o] * w2i + x3[o + 1] * w2r;
+
+			const T s0r = x0[o] + b1r;
+			const T s0i = x0[o + 1] + b1i;
+			const T d0r = x0[o] - b1r;
+			const T d0i = x0[o + 1] - b1i;
+
+			const T ur = x2[o] + b3r;
+			const T ui = x2[o + 1] + b3i;
+			const T vr = x2[o] - b3r;
+			const T vi = x2[o + 1] - b3i;
+
+			const T s1r = ur * w1r - ui * w1i;
+			const T s1i = ur * w1i + ui * w1r;
+			const T d1r = vr * w1r - vi * w1i;
+			const T d1i = vr * w1i + vi * w1r;
+
+			// multiply with -i (forward) or i (inverse)
+			const T e1r = inverse ? -d1i : d1i;
+			const T e1i = inverse ? d1r : -d1r;
+
+			x0[o] = s0r + s1r;
+			x0[o + 1] = s0i + s1i;
+			x2[o] = s0r - s1r;
+			x2[o + 1] = s0i - s1i;
+			x1[o] = d0r + e1r;
+			x1[o + 1] = d0i + e1i;
+			x3[o] = d0r - e1r;
+			x3[o + 1] = d0i - e1i;
+		}
+	}
+}
+
+#if HI_PORTABLE_FFT_USE_SSE
+
+/** Same as radix4PassScalar, but calculates two butterflies at once. m must be at least 2. */
+template <bool inverse> static void radix4PassSSE(float* d, int numComplex, int m, const float* tw)
+{
+	const __m128 conjSign = inverse ? _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f) : _mm_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f);
+	const __m128 rotationSign = inverse ? _mm_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f) : _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f);
+
+	for (int k = 0; k < numComplex; k += 4 * m)
+	{
+		float* x0 = d + 2 * k;
+		float* x1 = x0 + 2 * m;
+		float* x2 = x1 + 2 * m;
+		float* x3 = x2 + 2 * m;
+
+		for (int j = 0; j < m; j += 2)
+		{
+			const __m128 lo = _mm_loadu_ps(tw + 4 * j);
+			const __m128 hi = _mm_loadu_ps(tw + 4 * j + 4);
+
+			const __m128 w1 = _mm_movelh_ps(lo, hi);
+			const __m128 w2 = _mm_movehl_ps(hi, lo);
+
+			const __m128 w1r = _mm_shuffle_ps(w1, w1, _MM_SHUFFLE(2, 2, 0, 0));
+			const __m128 w1i = _mm_mul_ps(_mm_shuffle_ps(w1, w1, _MM_SHUFFLE(3, 3, 1, 1)), conjSign);
+			const __m128 w2r = _mm_shuffle_ps(w2, w2, _MM_SHUFFLE(2, 2, 0, 0));
+			const __m128 w2i = _mm_mul_ps(_mm_shuffle_ps(w2, w2, _MM_SHUFFLE(3, 3, 1, 1)), conjSign);
+
+			const int o = 2 * j;
+
+			const __m128 a0 = _mm_loadu_ps(x0 + o);
+			const __m128 a1 = _mm_loadu_ps(x1 + o);
+			const __m128 a2 = _mm_loadu_ps(x2 + o);
+			const __m128 a3 = _mm_loadu_ps(x3 + o);
+
+#define COMPLEX_MUL(a, wr, wi) _mm_add_ps(_mm_mul_ps(a, wr), _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), wi))
+
+			const __m128 b1 = COMPLEX_MUL(a1, w2r, w2i);
+			const __m128 b3 = COMPLEX_MUL(a3, w2r, w2i);
+
+			const __m128 s0 = _mm_add_ps(a0, b1);
+			const __m128 d0 = _mm_sub_ps(a0, b1);
+			const __m128 u = _mm_add_ps(a2, b3);
+			const __m128 v = _mm_sub_ps(a2, b3);
+
+			const __m128 s1 = COMPLEX_MUL(u, w1r, w1i);
+			const __m128 d1 = COMPLEX_MUL(v, w1r, w1i);
+
+#undef COMPLEX_MUL
+
+			const __m128 e1 = _mm_mul_ps(_mm_shuffle_ps(d1, d1, _MM_SHUFFLE(2, 3, 0, 1)), rotationSign);
+
+			_mm_storeu_ps(x0 + o, _mm_add_ps(s0, s1));
+			_mm_storeu_ps(x2 + o, _mm_sub_ps(s0, s1));
+			_mm_storeu_ps(x1 + o, _mm_add_ps(d0, e1));
+			_mm_storeu_ps(x3 + o, _mm_sub_ps(d0, e1));
+		}
+	}
+}
+
+#endif
+
+template <bool inverse> static void radix4Pass(float* d, int numComplex, int m, const float* tw)
+{
+#if HI_PORTABLE_FFT_USE_SSE
+	if (m >= 2)
+	{
+		radix4PassSSE<inverse>(d, numComplex, m, tw);
+		return;
+	}
+#endif
+
+	radix4PassScalar<float, inverse>(d, numComplex, m, tw);
+}
+
+template <bool inverse> static void radix4Pass(double* d, int numComplex, int m, const double* tw)
+{
+	radix4PassScalar<double, inverse>(d, numComplex, m, tw);
+}
+
+} // namespace PortableFFTHelpers
+
+template <typename FloatType>
+PortableFFT<FloatType>::PortableFFT(int maxOrder_) :
+	maxOrder(jlimit<int>(1, 30, maxOrder_))
+{
+	const int maxSize = 1 << maxOrder;
+
+	bitReverseTable.malloc(maxSize);
+
+	for (int i = 0; i < maxSize; i++)
+	{
+		uint32 reversed = 0;
+		uint32 v = (uint32)i;
+
+		for (int b = 0; b < maxOrder; b++)
+		{
+			reversed = (reversed << 1) | (v & 1);
+			v >>= 1;
+		}
+
+		bitReverseTable[i] = reversed;
+	}
+
+	const int maxQuarterSize = jmax<int>(1, maxSize / 4);
+
+	stageTwiddles.malloc(4 * (2 * maxQuarterSize - 1));
+
+	for (int m = 1; m <= maxQuarterSize; m *= 2)
+	{
+		FloatType* tw = stageTwiddles + 4 * (m - 1);
+
+		for (int j = 0; j < m; j++)
+		{
+			const double phase = -2.0 * double_Pi * (double)j / (double)(4 * m);
+
+			tw[4 * j] = (FloatType)cos(phase);
+			tw[4 * j + 1] = (FloatType)sin(phase);
+			tw[4 * j + 2] = (FloatType)cos(2.0 * phase);
+			tw[4 * j + 3] = (FloatType)sin(2.0 * phase);
+		}
+	}
+
+	const int numRealTwiddles = maxSize / 4 + 1;
+
+	realTwiddles.malloc(2 * numRealTwiddles);
+
+	for (int k = 0; k < numRealTwiddles; k++)
+	{
+		const double phase = -2.0 * double_Pi * (double)k / (double)maxSize;
+
+		realTwiddles[2 * k] = (FloatType)cos(phase);
+		realTwiddles[2 * k + 1] = (FloatType)sin(phase);
+	}
+}
+
+template <typename FloatType>
+void PortableFFT<FloatType>::bitReverse(FloatType* data, int order) const
+{
+	const int size = 1 << order;
+	const int shift = maxOrder - order;
+
+	for (int i = 0; i < size; i++)
+	{
+		const int r = (int)(bitReverseTable[i] >> shift);
+
+		if (r > i)
+		{
+			std::swap(data[2 * i], data[2 * r]);
+			std::swap(data[2 * i + 1], data[2 * r + 1]);
+		}
+	}
+}
+
+template <typename FloatType>
+void PortableFFT<FloatType>::complexFFT(FloatType* data, int order, bool inverse) const
+{
+	jassert(isPositiveAndNotGreaterThan(order, maxOrder));
+
+	if (order <= 0)
+		return;
+
+	const int size = 1 << order;
+
+	bitReverse(data, order);
+
+	int m = 1;
+
+	if (order % 2 != 0)
+	{
+		PortableFFTHelpers::radix2Pass(data, size);
+		m = 2;
+	}
+
+	for (; 4 * m <= size; m *= 4)
+	{
+		const FloatType* tw = stageTwiddles + 4 * (m - 1);
+
+		if (inverse)
+			PortableFFTHelpers::radix4Pass<true>(data, size, m, tw);
+		else
+			PortableFFTHelpers::radix4Pass<false>(data, size, m, tw);
+	}
+}
+
+template <typename FloatType>
+void PortableFFT<FloatType>::realFFT(FloatType* data, int order) const
+{
+	jassert(isPositiveAndNotGreaterThan(order, maxOrder));
+
+	if (order <= 0)
+		return;
+
+	const int size = 1 << order;
+	const int halfSize = size / 2;
+	const int shift = maxOrder - order;
+
+	// The even and odd samples are treated as real and imaginary part of a half sized complex signal
+	complexFFT(data, order - 1, false);
+
+	const FloatType z0r = data[0];
+	const FloatType z0i = data[1];
+
+	data[0] = z0r + z0i;
+	data[1] = z0r - z0i;
+
+	for (int k = 1; k <= size / 4; k++)
+	{
+		FloatType* a = data + 2 * k;
+		FloatType* b = data + 2 * (halfSize - k);
+
+		const FloatType wr = realTwiddles[2 * (k << shift)];
+		const FloatType wi = realTwiddles[2 * (k << shift) + 1];
+
+		// even part: (Z[k] + conj(Z[N/2-k])) / 2, odd part: -i * (Z[k] - conj(Z[N/2-k])) / 2
+		const FloatType er = (a[0] + b[0]) * FloatType(0.5);
+		const FloatType ei = (a[1] - b[1]) * FloatType(0.5);
+		const FloatType or_ = (a[1] + b[1]) * FloatType(0.5);
+		const FloatType oi = (b[0] - a[0]) * FloatType(0.5);
+
+		const FloatType tr = wr * or_ - wi * oi;
+		const FloatType ti = wr * oi + wi * or_;
+
+		a[0] = er + tr;
+		a[1] = ei + ti;
+		b[0] = er - tr;
+		b[1] = ti - ei;
+	}
+}
+
+template <typename FloatType>
+void PortableFFT<FloatType>::realFFTInverse(FloatType* data, int order) const
+{
+	jassert(isPositiveAndNotGreaterThan(order, maxOrder));
+
+	if (order <= 0)
+		return;
+
+	const int size = 1 << order;
+	const int halfSize = size / 2;
+	const int shift = maxOrder - order;
+
+	const FloatType x0 = data[0];
+	const FloatType xn = data[1];
+
+	data[0] = x0 + xn;
+	data[1] = x0 - xn;
+
+	for (int k = 1; k <= size / 4; k++)
+	{
+		FloatType* a = data + 2 * k;
+		FloatType* b = data + 2 * (halfSize - k);
+
+		const FloatType wr = realTwiddles[2 * (k << shift)];
+		const FloatType wi = realTwiddles[2 * (k << shift) + 1];
+
+		const FloatType er = a[0] + b[0];
+		const FloatType ei = a[1] - b[1];
+		const FloatType dr = a[0] - b[0];
+		const FloatType di = a[1] + b[1];
+
+		// odd part: (X[k] - conj(X[N/2-k])) * conj(W^k)
+		const FloatType or_ = dr * wr + di * wi;
+		const FloatType oi = di * wr - dr * wi;
+
+		a[0] = er - oi;
+		a[1] = ei + or_;
+		b[0] = er + oi;
+		b[1] = or_ - ei;
+	}
+
+	complexFFT(data, order - 1, true);
+}
+
+template class PortableFFT<float>;
+template class PortableFFT<double>;
+
+
+class PortableFFTTest : public UnitTest
+{
+public:
+
+	PortableFFTTest() :
+		UnitTest("Testing portable FFT")
+	{
+
+	}
+
+	void runTest() override
+	{
+		beginTest("Testing complex FFT against DFT");
+
+		for (int order = 1; order <= 9; order++)
+		{
+			testComplexFFT<float>(order, 1e-5);
+			testComplexFFT<double>(order, 1e-12);
+		}
+
+		beginTest("Testing real FFT against DFT");
+
+		for (int order = 1; order <= 9; order++)
+		{
+			testRealFFT<float>(order, 1e-5);
+			testRealFFT<double>(order, 1e-12);
+		}
+
+		beginTest("Testing real FFT against Ooura");
+
+		testAgainstOoura();
+
+		beginTest("Benchmarking against Ooura");
+
+		benchmark();
+	}
+
+private:
+
+	template <typename T> static double dftError(const T* input, const T* output, int size, bool isReal)
+	{
+		double maxError = 0.0;
+
+		// Only the values that are stored in the Perm format are checked for real input
+		const int numBins = isReal ? size / 2 + 1 : size;
+
+		for (int k = 0; k < numBins; k++)
+		{
+			double re = 0.0;
+			double im = 0.0;
+
+			for (int n = 0; n < size; n++)
+			{
+				const int index = (int)(((int64)k * (int64)n) % size);
+				const double phase = -2.0 * double_Pi * (double)index / (double)size;
+
+				const double xr = isReal ? (double)input[n] : (double)input[2 * n];
+				const double xi = isReal ? 0.0 : (double)input[2 * n + 1];
+
+				re += xr * cos(phase) - xi * sin(phase);
+				im += xr * sin(phase) + xi * cos(phase);
+			}
+
+			double actualRe, actualIm;
+
+			if (!isReal)
+			{
+				actualRe = output[2 * k];
+				actualIm = output[2 * k + 1];
+			}
+			else if (k == 0)
+			{
+				actualRe = output[0];
+				actualIm = 0.0;
+			}
+			else if (k == size / 2)
+			{
+				actualRe = output[1];
+				actualIm = 0.0;
+			}
+			else
+			{
+				actualRe = output[2 * k];
+				actualIm = output[2 * k + 1];
+			}
+
+			maxError = jmax<double>(maxError, fabs(re - actualRe), fabs(im - actualIm));
+		}
+
+		return maxError / (double)size;
+	}
+
+	template <typename T> void fillWithNoise(T* data, int numValues)
+	{
+		Random r((int64)numValues);
+
+		for (int i = 0; i < numValues; i++)
+			data[i] = (T)(r.nextDouble() * 2.0 - 1.0);
+	}
+
+	static void scale(float* data, float gain, int numValues)
+	{
+		for (int i = 0; i < numValues; i++)
+			data[i] *= gain;
+	}
+
+	template <typename T> void testComplexFFT(int order, double tolerance)
+	{
+		const int size = 1 << order;
+
+		PortableFFT<T> fft(order + 1);
+
+		HeapBlock<T> input(2 * size);
+		HeapBlock<T> data(2 * size);
+
+		fillWithNoise(input.getData(), 2 * size);
+		memcpy(data, input, sizeof(T) * 2 * size);
+
+		fft.complexFFT(data, order, false);
+
+		expect(dftError<T>(input, data, size, false) < tolerance, "Complex FFT mismatch at size " + String(size));
+
+		fft.complexFFT(data, order, true);
+
+		double maxError = 0.0;
+
+		for (int i = 0; i < 2 * size; i++)
+			maxError = jmax<double>(maxError, fabs((double)data[i] / (double)size - (double)input[i]));
+
+		expect(maxError < tolerance, "Complex roundtrip mismatch at size " + String(size));
+	}
+
+	template <typename T> void testRealFFT(int order, double tolerance)
+	{
+		const int size = 1 << order;
+
+		PortableFFT<T> fft(order + 1);
+
+		HeapBlock<T> input(size);
+		HeapBlock<T> data(size);
+
+		fillWithNoise(input.getData(), size);
+		memcpy(data, input, sizeof(T) * size);
+
+		fft.realFFT(data, order);
+
+		expect(dftError<T>(input, data, size, true) < tolerance, "Real FFT mismatch at size " + String(size));
+
+		fft.realFFTInverse(data, order);
+
+		double maxError = 0.0;
+
+		for (int i = 0; i < size; i++)
+			maxError = jmax<double>(maxError, fabs((double)data[i] / (double)size - (double)input[i]));
+
+		expect(maxError < tolerance, "Real roundtrip mismatch at size " + String(size));
+	}
+
+	void testAgainstOoura()
+	{
+		const int order = 12;
+		const int size = 1 << order;
+
+		PortableFFT<float> fft(order);
+
+		HeapBlock<float> portable(size);
+		HeapBlock<float> ooura(size);
+
+		fillWithNoise(portable.getData(), size);
+		memcpy(ooura, portable, sizeof(float) * size);
+
+		fft.realFFT(portable, order);
+		icstdsp::rdft(size, 1, ooura);
+
+		// Ooura's rdft uses exp(+i...) for the forward transform
+		float maxError = fabsf(portable[0] - ooura[0]) + fabsf(portable[1] - ooura[1]);
+
+		for (int i = 2; i < size; i += 2)
+		{
+			maxError = jmax<float>(maxError, fabsf(portable[i] - ooura[i]), fabsf(portable[i + 1] + ooura[i + 1]));
+		}
+
+		expect(maxError < 1e-2f, "Mismatch against Ooura: " + String(maxError));
+	}
+
+	void benchmark()
+	{
+		PortableFFT<float> fft(16);
+
+		for (int order = 6; order <= 16; order++)
+		{
+			const int size = 1 << order;
+			const int numIterations = jmax<int>(8, (1 << 20) / size);
+
+			HeapBlock<float> data(size);
+			fillWithNoise(data.getData(), size);
+
+			const int64 startPortable = Time::getHighResolutionTicks();
+
+			for (int i = 0; i < numIterations; i++)
+			{
+				fft.realFFT(data, order);
+				fft.realFFTInverse(data, order);
+				scale(data, 1.0f / (float)size, size);
+			}
+
+			const double portableSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startPortable);
+
+			const int64 startOoura = Time::getHighResolutionTicks();
+
+			for (int i = 0; i < numIterations; i++)
+			{
+				icstdsp::rdft(size, 1, data);
+				icstdsp::rdft(size, -1, data);
+				scale(data, 2.0f / (float)size, size);
+			}
+
+			const double oouraSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startOoura);
+
+			const double usPortable = portableSeconds * 1000000.0 / (double)numIterations;
+			const double usOoura = oouraSeconds * 1000000.0 / (double)numIterations;
+
+			logMessage("Size " + String(size) + ": PortableFFT " + String(usPortable, 2) + "us, Ooura " + String(usOoura, 2) + "us (" + String(usOoura / jmax<double>(usPortable, 0.001), 2) + "x)");
+		}
+	}
+};
+
+static PortableFFTTest portableFFTTest;
@@ -0,0 +1,89 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef PORTABLEFFT_H_INCLUDED
+#define PORTABLEFFT_H_INCLUDED
+
+/** A self contained FFT engine that is used as backend for the IppFFT class if the IPP library is not available.
+*	@ingroup core
+*
+*	It implements an iterative radix-2^2 decimation in time FFT (so there are only log2(N) / 2 passes over the data)
+*	with SSE2 butterflies for single precision data. Real FFTs are calculated with a complex FFT of half the size and a
+*	post processing step. The tables are created once in the constructor (the twiddle factors of each stage do not
+*	depend on the FFT size, so they are shared between all sizes).
+*
+*	The transforms are not scaled and use the same conventions as the IPP routines:
+*
+*	- forward transforms use exp(-i...), inverse transforms exp(+i...)
+*	- real transforms use the Perm format: re[0], re[N/2], re[1], im[1], ..., re[N/2-1], im[N/2-1]
+*/
+template <typename FloatType> class PortableFFT
+{
+public:
+
+	/** Creates the tables for all FFT sizes up to 2^maxOrder. */
+	PortableFFT(int maxOrder);
+
+	/** Returns the maximum order that was passed into the constructor. */
+	int getMaxOrder() const noexcept { return maxOrder; }
+
+	/** Complex FFT of 2^order interleaved complex values. */
+	void complexFFT(FloatType* data, int order, bool inverse) const;
+
+	/** Real forward FFT of 2^order values. The result is stored in the Perm format. */
+	void realFFT(FloatType* data, int order) const;
+
+	/** Real inverse FFT of 2^order values from the Perm format. */
+	void realFFTInverse(FloatType* data, int order) const;
+
+private:
+
+	void bitReverse(FloatType* data, int order) const;
+
+	const int maxOrder;
+
+	/** The bit reversed indexes for the biggest size. Smaller sizes use the shifted values. */
+	HeapBlock<uint32> bitReverseTable;
+
+	/** For every radix-4 stage with the quarter size m, this contains m entries of (W^j, W^2j) with W = exp(-2*pi*i / 4m). 
+	*
+	*	The stages are stored one after another, so the table of the stage m starts at 4 * (m - 1).
+	*/
+	HeapBlock<FloatType> stageTwiddles;
+
+	/** exp(-2*pi*i*k / N) for k = 0...N/4 of the biggest real FFT size, used by the real FFT post processing. */
+	HeapBlock<FloatType> realTwiddles;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PortableFFT)
+};
+
+#endif  // PORTABLEFFT_H_INCLUDED
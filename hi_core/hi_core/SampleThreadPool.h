@@ -50,6 +50,8 @@ public:
 		diskUsage(0.0),
 		counter(0)
 	{
+		waitForPendingJobs.store(false);
+
 		startThread(9);
 		
 	}
@@ -115,6 +117,11 @@ public:
 		return diskUsage.load();
 	}
 
+	/** If enabled, the streaming voices wait for pending jobs instead of dropping samples. Use this for non realtime rendering. */
+	void setWaitForPendingJobs(bool shouldWait) noexcept { waitForPendingJobs.store(shouldWait); }
+
+	bool isWaitingForPendingJobs() const noexcept { return waitForPendingJobs.load(); }
+
 	void addJob(Job* jobToAdd, bool unused)
 	{
 		++counter;
@@ -206,6 +213,8 @@ public:
 
 	std::atomic<Job*> currentlyExecutedJob;
 
+	std::atomic<bool> waitForPendingJobs;
+
 	static const String errorMessage;
 };
 
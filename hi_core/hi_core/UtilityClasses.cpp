@@ -63,12 +63,23 @@ ScopedGlitchDetector::ScopedGlitchDetector(Processor* const processor, int locat
 		// Resets the identifier if a GlitchDetector is recreated...
 		lastPositiveId = 0;
 	}
+
+	if (startTime != 0.0)
+	{
+		processor->getMainController()->getDebugLogger().traceScope(true, processor, location);
+	}
 }
 
 ScopedGlitchDetector::~ScopedGlitchDetector() 
 {
 	DebugLogger& logger = p->getMainController()->getDebugLogger();
 
+	// Always close the scope so that the trace stays balanced
+	if (startTime != 0.0)
+	{
+		logger.traceScope(false, p, location);
+	}
+
 	if (logger.isLogging())
 	{
 		const double stopTime = Time::getMillisecondCounterHiRes();
@@ -241,6 +241,8 @@ private:
 *       #define USE_GLITCH_DETECTION 0
 *
 *   This macro can be only used once per function scope, but this should be OK...
+*
+*	While the DebugLogger is running, every scope is also written to its trace file (see DebugLogger::getCurrentTraceFile()).
 */
 class ScopedGlitchDetector
 {
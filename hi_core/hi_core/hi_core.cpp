@@ -50,7 +50,9 @@ namespace juce
 
 #include "CustomDataContainers.cpp"
 
-#if USE_IPP
+#include "PortableFFT.cpp"
+
+#if USE_IPP || USE_PORTABLE_FFT
 #include "IppFFT.cpp"
 #endif
 
@@ -61,6 +63,7 @@ namespace juce
 #include "Tables.cpp"
 #include "ExternalFilePool.cpp"
 #include "SampleThreadPool.cpp"
+#include "BackgroundTaskPool.cpp"
 #include "GlobalScriptCompileBroadcaster.cpp"
 #include "MainControllerHelpers.cpp"
 #include "MainController.cpp"
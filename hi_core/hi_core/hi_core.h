@@ -34,7 +34,9 @@
 #define HI_CORE_H_INCLUDED
 
 
-#if USE_IPP
+#include "PortableFFT.h"
+
+#if USE_IPP || USE_PORTABLE_FFT
 #include "IppFFT.h"
 #endif
 
@@ -75,6 +77,7 @@ namespace juce
 #include "BackgroundThreads.h"
 #include "SettingsWindows.h"
 #include "SampleThreadPool.h"
+#include "BackgroundTaskPool.h"
 #include "PresetHandler.h"
 #include "GlobalScriptCompileBroadcaster.h"
 #include "MainControllerHelpers.h"
@@ -113,6 +113,238 @@ void Processor::setIsOnAir(bool isBeingProcessedInAudioThread)
 	}
 }
 
+Processor::DisplayValues Processor::updateAndGetDisplayValues()
+{
+	PeakMeterRing::Levels levels;
+
+	if (peakMeterRing != nullptr && peakMeterRing->drain(levels))
+	{
+		currentValues.outL = levels.peakL;
+		currentValues.outR = levels.peakR;
+		currentValues.rmsL = levels.rmsL;
+		currentValues.rmsR = levels.rmsR;
+	}
+
+	return currentValues;
+}
+
+Processor::PeakMeterSubscription::PeakMeterSubscription(Processor* p) :
+	processor(p)
+{
+	if (p != nullptr)
+	{
+		static SpinLock ringCreationLock;
+
+		{
+			SpinLock::ScopedLockType sl(ringCreationLock);
+
+			if (p->peakMeterRing == nullptr)
+			{
+				p->peakMeterRing = new PeakMeterRing();
+			}
+		}
+
+		p->numPeakMeterSubscribers.fetch_add(1, std::memory_order_release);
+	}
+}
+
+Processor::PeakMeterSubscription::~PeakMeterSubscription()
+{
+	if (processor.get() != nullptr)
+	{
+		processor->numPeakMeterSubscribers.fetch_sub(1, std::memory_order_release);
+	}
+}
+
+void Processor::addCpuTicks(int64 ticks) noexcept
+{
+	const int thisBlock = getMainController()->getCpuBlockIndex();
+	const int lastBlock = cpuBlockIndex.load(std::memory_order_relaxed);
+
+	if (thisBlock != lastBlock)
+	{
+		if (lastBlock != -1)
+		{
+			const float usage = getMainController()->getCpuUsageForTicks(cpuTicksThisBlock);
+
+			cpuUsage.store(cpuUsage.load(std::memory_order_relaxed) * 0.95f + usage * 0.05f, std::memory_order_relaxed);
+			peakCpuUsage.store(jmax<float>(usage, peakCpuUsage.load(std::memory_order_relaxed) * 0.99f), std::memory_order_relaxed);
+		}
+
+		cpuTicksThisBlock = 0;
+		cpuBlockIndex.store(thisBlock, std::memory_order_relaxed);
+	}
+
+	cpuTicksThisBlock += ticks;
+}
+
+float Processor::getCpuUsage() const noexcept
+{
+	const int lastBlock = cpuBlockIndex.load(std::memory_order_relaxed);
+
+	// Processors that haven't been rendered for a while (bypassed or without voices) don't use the CPU
+	if (lastBlock == -1 || getMainController()->getCpuBlockIndex() - lastBlock > 100)
+		return 0.0f;
+
+	return cpuUsage.load(std::memory_order_relaxed);
+}
+
+float Processor::getPeakCpuUsage() const noexcept
+{
+	const int lastBlock = cpuBlockIndex.load(std::memory_order_relaxed);
+
+	if (lastBlock == -1 || getMainController()->getCpuBlockIndex() - lastBlock > 100)
+		return 0.0f;
+
+	return peakCpuUsage.load(std::memory_order_relaxed);
+}
+
+void Processor::collectCpuUsage(Processor* root, Array<CpuUsageInfo>& list)
+{
+	if (root == nullptr)
+		return;
+
+	Processor::Iterator<Processor> iter(root, false);
+
+	while (Processor* p = iter.getNextProcessor())
+	{
+		CpuUsageInfo info;
+
+		info.processor = p;
+		info.id = p->getId();
+		info.type = p->getName();
+		info.average = p->getCpuUsage();
+		info.peak = p->getPeakCpuUsage();
+
+		list.add(info);
+	}
+}
+
+PeakMeterRing::PeakMeterRing() :
+	writeIndex(0),
+	readIndex(0)
+{
+	for (int i = 0; i < RingSize; i++)
+	{
+		entries[i].clear();
+	}
+
+	pendingEntry.clear();
+}
+
+void PeakMeterRing::addBlock(const float* l, const float* r, int numSamples, float gainL, float gainR)
+{
+	if (numSamples <= 0) return;
+
+	Entry e;
+
+	const Range<float> rangeL = FloatVectorOperations::findMinAndMax(l, numSamples);
+	const Range<float> rangeR = FloatVectorOperations::findMinAndMax(r, numSamples);
+
+	e.peakL = gainL * jmax<float>(-rangeL.getStart(), rangeL.getEnd());
+	e.peakR = gainR * jmax<float>(-rangeR.getStart(), rangeR.getEnd());
+
+	float sumL = 0.0f;
+	float sumR = 0.0f;
+
+	for (int i = 0; i < numSamples; i++)
+	{
+		sumL += l[i] * l[i];
+		sumR += r[i] * r[i];
+	}
+
+	e.sumSquaresL = gainL * gainL * sumL;
+	e.sumSquaresR = gainR * gainR * sumR;
+	e.numSamples = numSamples;
+
+	addEntry(e);
+}
+
+void PeakMeterRing::addPeakValues(float peakL, float peakR, int numSamples)
+{
+	Entry e;
+
+	e.peakL = peakL;
+	e.peakR = peakR;
+	e.numSamples = jmax<int>(1, numSamples);
+	e.sumSquaresL = peakL * peakL * (float)e.numSamples;
+	e.sumSquaresR = peakR * peakR * (float)e.numSamples;
+
+	addEntry(e);
+}
+
+void PeakMeterRing::addEntry(const Entry& e)
+{
+	const int w = writeIndex.load(std::memory_order_relaxed);
+	const int r = readIndex.load(std::memory_order_acquire);
+
+	if (w - r >= RingSize)
+	{
+		// The interface didn't drain the queue in time, so keep the levels until there is space again
+		pendingEntry.merge(e);
+		return;
+	}
+
+	Entry& target = entries[w & RingMask];
+
+	target = e;
+
+	if (pendingEntry.numSamples != 0)
+	{
+		target.merge(pendingEntry);
+		pendingEntry.clear();
+	}
+
+	writeIndex.store(w + 1, std::memory_order_release);
+}
+
+bool PeakMeterRing::drain(Levels& levels)
+{
+	SpinLock::ScopedLockType sl(drainLock);
+
+	const int r = readIndex.load(std::memory_order_relaxed);
+	const int w = writeIndex.load(std::memory_order_acquire);
+
+	if (r == w) return false;
+
+	Entry sum;
+	sum.clear();
+
+	for (int i = r; i != w; i++)
+	{
+		sum.merge(entries[i & RingMask]);
+	}
+
+	readIndex.store(w, std::memory_order_release);
+
+	const float numSamples = (float)jmax<int>(1, sum.numSamples);
+
+	levels.peakL = sum.peakL;
+	levels.peakR = sum.peakR;
+	levels.rmsL = sqrtf(sum.sumSquaresL / numSamples);
+	levels.rmsR = sqrtf(sum.sumSquaresR / numSamples);
+
+	return true;
+}
+
+void PeakMeterRing::Entry::clear() noexcept
+{
+	peakL = 0.0f;
+	peakR = 0.0f;
+	sumSquaresL = 0.0f;
+	sumSquaresR = 0.0f;
+	numSamples = 0;
+}
+
+void PeakMeterRing::Entry::merge(const Entry& other) noexcept
+{
+	peakL = jmax<float>(peakL, other.peakL);
+	peakR = jmax<float>(peakR, other.peakR);
+	sumSquaresL += other.sumSquaresL;
+	sumSquaresR += other.sumSquaresR;
+	numSamples += other.numSamples;
+}
+
 
 bool Chain::restoreChain(const ValueTree &v)
 {
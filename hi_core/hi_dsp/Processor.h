@@ -45,6 +45,72 @@ class BaseConstrainer
 
 };
 
+/** A lock free queue that transports the peak and RMS levels of a Processor from the audio thread to the interface.
+*
+*	The audio thread adds one entry per block and the interface drains all pending entries at frame rate, so no peak 
+*	between two repaints gets lost. If the queue is full, the audio thread merges the levels into a pending entry 
+*	that is added as soon as there is space again.
+*/
+class PeakMeterRing
+{
+public:
+
+	struct Levels
+	{
+		float peakL = 0.0f;
+		float peakR = 0.0f;
+		float rmsL = 0.0f;
+		float rmsR = 0.0f;
+	};
+
+	PeakMeterRing();
+
+	/** Calculates the levels of the block and adds them to the queue. Call this from the audio thread only. */
+	void addBlock(const float* l, const float* r, int numSamples, float gainL=1.0f, float gainR=1.0f);
+
+	/** Adds precalculated peak values (which are also used as RMS values). Call this from the audio thread only. */
+	void addPeakValues(float peakL, float peakR, int numSamples);
+
+	/** Removes all pending entries and writes the combined levels into the given struct. 
+	*
+	*	Returns false if nothing was added since the last call. Never call this from the audio thread.
+	*/
+	bool drain(Levels& levels);
+
+private:
+
+	struct Entry
+	{
+		void clear() noexcept;
+		void merge(const Entry& other) noexcept;
+
+		float peakL;
+		float peakR;
+		float sumSquaresL;
+		float sumSquaresR;
+		int numSamples;
+	};
+
+	void addEntry(const Entry& e);
+
+	enum
+	{
+		RingSize = 64,
+		RingMask = RingSize - 1
+	};
+
+	Entry entries[RingSize];
+
+	std::atomic<int> writeIndex;
+	std::atomic<int> readIndex;
+
+	Entry pendingEntry;
+
+	SpinLock drainLock;
+
+	JUCE_DECLARE_NON_COPYABLE(PeakMeterRing);
+};
+
 #define loadAttribute(name, nameAsString) (setAttribute(name, (float)v.getProperty(nameAsString, false), sendNotification))
 #define saveAttribute(name, nameAsString) (v.setProperty(nameAsString, getAttribute(name), nullptr))
 
@@ -56,6 +122,13 @@ class BaseConstrainer
 						  static Identifier getClassType() {return Identifier(type);} \
 						  const Identifier getType() const override {return getClassType();}
 
+// Adds the time of the current scope to the CPU counter of the given Processor (removed if ENABLE_PROCESSOR_CPU_COUNTERS or ENABLE_CPU_MEASUREMENT is disabled)
+#if ENABLE_CPU_MEASUREMENT && ENABLE_PROCESSOR_CPU_COUNTERS
+#define ADD_CPU_COUNTER(processor) Processor::ScopedCpuCounter scopedCpuCounter(processor);
+#else
+#define ADD_CPU_COUNTER(processor)
+#endif
+
 
 
 /** The base class for all modules.
@@ -96,7 +169,12 @@ public:
 		inputValue(0.0f),
 		outputValue(0.0f),
 		editorState(0),
-		symbol(Path())
+		symbol(Path()),
+		numPeakMeterSubscribers(0),
+		cpuTicksThisBlock(0),
+		cpuBlockIndex(-1),
+		cpuUsage(0.0f),
+		peakCpuUsage(0.0f)
 	{
 		editorStateIdentifiers.add("Folded");
 		editorStateIdentifiers.add("BodyShown");
@@ -518,10 +596,102 @@ public:
 		float outL;
 		float inR;
 		float outR;
+
+		float rmsL = 0.0f;
+		float rmsR = 0.0f;
 	};
 
 	DisplayValues getDisplayValues() const { return currentValues;};
 
+	// ================================================================================================================ Peak meters
+
+	/** Keeps the level calculation of a Processor alive as long as it exists. 
+	*
+	*	Create one of these in every component (or script object) that displays the levels of a Processor.
+	*/
+	class PeakMeterSubscription
+	{
+	public:
+
+		PeakMeterSubscription(Processor* p);
+		~PeakMeterSubscription();
+
+	private:
+
+		WeakReference<Processor> processor;
+
+		JUCE_DECLARE_NON_COPYABLE(PeakMeterSubscription);
+	};
+
+	/** Returns true if something displays the levels of this Processor. 
+	*
+	*	Check this before calculating any levels on the audio thread, so that Processors without a visible meter don't pay for it.
+	*/
+	bool hasPeakMeterSubscribers() const noexcept { return numPeakMeterSubscribers.load(std::memory_order_acquire) > 0; }
+
+	/** Drains the levels that were calculated since the last call into the display values and returns them. 
+	*
+	*	Call this from the interface at frame rate. If nothing was rendered since the last call, the last values are returned.
+	*/
+	DisplayValues updateAndGetDisplayValues();
+
+	// ================================================================================================================ CPU accounting
+
+	/** Measures the time of its scope and adds it to the CPU counter of the Processor. 
+	*
+	*	Use the ADD_CPU_COUNTER macro instead of creating this directly so it can be removed with ENABLE_PROCESSOR_CPU_COUNTERS.
+	*/
+	class ScopedCpuCounter
+	{
+	public:
+
+		ScopedCpuCounter(Processor* p_) noexcept:
+			p(p_),
+			start(Time::getHighResolutionTicks())
+		{}
+
+		~ScopedCpuCounter()
+		{
+			p->addCpuTicks(Time::getHighResolutionTicks() - start);
+		}
+
+	private:
+
+		Processor* p;
+		const int64 start;
+
+		JUCE_DECLARE_NON_COPYABLE(ScopedCpuCounter);
+	};
+
+	/** A snapshot of the CPU usage of a Processor. */
+	struct CpuUsageInfo
+	{
+		WeakReference<Processor> processor;
+		String id;
+		String type;
+		float average;
+		float peak;
+	};
+
+	/** Adds the measured time to the counter of the current audio block. Call this from the audio thread. 
+	*
+	*	The time of the last block is published as soon as the first measurement of the next block arrives, so there is no 
+	*	extra work at the end of a block and Processors that are not rendered don't cost anything.
+	*/
+	void addCpuTicks(int64 ticks) noexcept;
+
+	/** Returns the averaged CPU usage of this Processor in percent of the available buffer time. 
+	*
+	*	The time includes the child processors that are rendered within this Processor (eg. the modulators of a sound generator).
+	*/
+	float getCpuUsage() const noexcept;
+
+	/** Returns the decaying peak of the CPU usage in percent of the available buffer time. */
+	float getPeakCpuUsage() const noexcept;
+
+	/** Collects the CPU usage of the given Processor and all its children. Call this from the message thread. */
+	static void collectCpuUsage(Processor* root, Array<CpuUsageInfo>& list);
+
 	/** A iterator over all child processors. 
 	*
 	*	You don't have to use a inherited class of Processor for the template argument, it works with all classes.
@@ -769,6 +939,18 @@ protected:
 
 	DisplayValues currentValues;
 
+	/** Adds the levels of the rendered block to the peak meter queue if there is a subscriber. Call this from the audio thread. */
+	void addPeakMeterBlock(const float* l, const float* r, int numSamples, float gainL=1.0f, float gainR=1.0f)
+	{
+		if (hasPeakMeterSubscribers()) peakMeterRing->addBlock(l, r, numSamples, gainL, gainR);
+	}
+
+	/** Adds precalculated peak values to the peak meter queue if there is a subscriber. Call this from the audio thread. */
+	void addPeakMeterValues(float peakL, float peakR, int numSamples)
+	{
+		if (hasPeakMeterSubscribers()) peakMeterRing->addPeakValues(peakL, peakR, numSamples);
+	}
+
 	/** Call this from the baseclass whenever you want its editor to display a value change. */
 	void setOutputValue(float newValue)
 	{
@@ -823,6 +1005,17 @@ private:
 	WeakReference<Processor>::Master masterReference;
     friend class WeakReference<Processor>;
 
+	// Created with the first subscription and never deleted before the Processor, so the audio thread can't access a deleted queue
+	ScopedPointer<PeakMeterRing> peakMeterRing;
+	std::atomic<int> numPeakMeterSubscribers;
+
+	// Only accessed by the audio thread
+	int64 cpuTicksThisBlock;
+
+	std::atomic<int> cpuBlockIndex;
+	std::atomic<float> cpuUsage;
+	std::atomic<float> peakCpuUsage;
+
 	Array<bool> editorStateAsBoolList;
 
 	BigInteger editorState;
@@ -45,6 +45,9 @@ ProcessorEditorHeader::ProcessorEditorHeader(ProcessorEditor *p) :
 	valueMeter->setColour (VuMeter::backgroundColour, Colour (0xFF333333));
 	valueMeter->setColour (VuMeter::ledColour, Colours::lightgrey);
 	valueMeter->setColour (VuMeter::outlineColour, isHeaderOfModulatorSynth() ? Colour (0x45000000) : Colour (0x45ffffff));
+
+	if (!isHeaderOfModulator())
+		peakMeterSubscription = new Processor::PeakMeterSubscription(getProcessor());
 	
 	#if JUCE_DEBUG
 	startTimer(150);
@@ -1055,8 +1058,9 @@ void ProcessorEditorHeader::timerCallback()
 		}
 		else
 		{
-			valueMeter->setPeak(getProcessor()->getDisplayValues().outL,
-				getProcessor()->getDisplayValues().outR);
+			const Processor::DisplayValues values = getProcessor()->updateAndGetDisplayValues();
+
+			valueMeter->setPeak(values.outL, values.outR);
 		}
 
 		bypassButton->refresh();
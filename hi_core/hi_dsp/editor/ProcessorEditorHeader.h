@@ -158,6 +158,7 @@ private:
 	ScopedPointer<ChainIcon> chainIcon;
 
     ScopedPointer<VuMeter> valueMeter;
+	ScopedPointer<Processor::PeakMeterSubscription> peakMeterSubscription;
     ScopedPointer<Label> idLabel;
     ScopedPointer<Label> typeLabel;
     ScopedPointer<TextButton> debugButton;
@@ -148,9 +148,9 @@ class ProcessorEditor;
 */
 
 
+#include "modules/DspCoreModules.h"
 #include "modules/ModulatorSynth.h"
 #include "modules/ModulatorSynthChain.h"
-#include "modules/DspCoreModules.h"
 
 // Plugin Parameters
 
@@ -0,0 +1,715 @@
+/*
+  ==============================================================================
+
+    DspCoreModules.cpp
+    Created: 10 Jul 2016 1:00:04pm
+    Author:  Christoph
+
+  ==============================================================================
+*/
+
+ModulatedDelayLine::ModulatedDelayLine(int maxDelayInSamples) :
+	sampleRate(44100.0),
+	mask(0),
+	writeIndex(0),
+	currentDelayTime(1),
+	oldDelayTime(1),
+	lastIgnoredDelayTime(0),
+	fadeCounter(-1),
+	fadeTimeSamples(1024)
+{
+	setMaxDelaySamples(maxDelayInSamples);
+}
+
+void ModulatedDelayLine::setMaxDelaySamples(int maxDelayInSamples)
+{
+	// The interpolator needs two samples on each side of the read position
+	const int size = nextPowerOfTwo(jmax<int>(16, maxDelayInSamples + 4));
+
+	delayBuffer.allocate(size, true);
+	mask = size - 1;
+	writeIndex = 0;
+
+	currentDelayTime = jlimit<int>(1, getMaxDelaySamples(), currentDelayTime);
+	fadeCounter = -1;
+}
+
+void ModulatedDelayLine::prepareToPlay(double sampleRate_)
+{
+	SpinLock::ScopedLockType sl(processLock);
+
+	sampleRate = sampleRate_;
+}
+
+void ModulatedDelayLine::clear()
+{
+	SpinLock::ScopedLockType sl(processLock);
+
+	FloatVectorOperations::clear(delayBuffer, mask + 1);
+
+	fadeCounter = -1;
+	lastIgnoredDelayTime = 0;
+}
+
+void ModulatedDelayLine::setDelayTimeSeconds(double delayInSeconds)
+{
+	setDelayTimeSamples((int)(delayInSeconds * sampleRate));
+}
+
+void ModulatedDelayLine::setDelayTimeSamples(int delayInSamples)
+{
+	SpinLock::ScopedLockType sl(processLock);
+
+	setInternalDelayTime(delayInSamples);
+}
+
+void ModulatedDelayLine::setFadeTimeSamples(int newFadeTimeInSamples)
+{
+	SpinLock::ScopedLockType sl(processLock);
+
+	fadeTimeSamples = jmax<int>(1, newFadeTimeInSamples);
+}
+
+void ModulatedDelayLine::setInternalDelayTime(int delayInSamples)
+{
+	// The block processing reads the delayed block before it writes the input, so the delay must be at least one sample.
+	delayInSamples = jlimit<int>(1, getMaxDelaySamples(), delayInSamples);
+
+	if (fadeCounter != -1)
+	{
+		lastIgnoredDelayTime = delayInSamples;
+		return;
+	}
+
+	lastIgnoredDelayTime = 0;
+
+	if (delayInSamples == currentDelayTime)
+		return;
+
+	oldDelayTime = currentDelayTime;
+	currentDelayTime = delayInSamples;
+	fadeCounter = 0;
+}
+
+void ModulatedDelayLine::readInteger(float* output, int delayInSamples, int numSamples) const
+{
+	const int readIndex = (writeIndex - delayInSamples) & mask;
+	const int numBeforeWrap = jmin<int>(numSamples, mask + 1 - readIndex);
+
+	FloatVectorOperations::copy(output, delayBuffer + readIndex, numBeforeWrap);
+
+	if (numBeforeWrap < numSamples)
+	{
+		FloatVectorOperations::copy(output + numBeforeWrap, delayBuffer, numSamples - numBeforeWrap);
+	}
+}
+
+void ModulatedDelayLine::write(const float* input, int numSamples, const float* feedbackSignal, float feedback)
+{
+	int numLeft = numSamples;
+
+	while (numLeft > 0)
+	{
+		const int numThisTime = jmin<int>(numLeft, mask + 1 - writeIndex);
+
+		float* d = delayBuffer + writeIndex;
+
+		FloatVectorOperations::copy(d, input, numThisTime);
+
+		if (feedbackSignal != nullptr)
+		{
+			FloatVectorOperations::addWithMultiply(d, feedbackSignal, feedback, numThisTime);
+			feedbackSignal += numThisTime;
+		}
+
+		input += numThisTime;
+		numLeft -= numThisTime;
+		writeIndex = (writeIndex + numThisTime) & mask;
+	}
+}
+
+void ModulatedDelayLine::processWithFeedback(const float* input, float* delayedOutput, int numSamples, float feedback)
+{
+	SpinLock::ScopedLockType sl(processLock);
+
+	while (numSamples > 0)
+	{
+		// The output of the chunk must not depend on the input of the same chunk
+		const int minDelay = fadeCounter < 0 ? currentDelayTime : jmin<int>(currentDelayTime, oldDelayTime);
+
+		int numThisTime = jmin<int>(numSamples, minDelay);
+
+		if (fadeCounter >= 0)
+		{
+			numThisTime = jmin<int>(numThisTime, fadeTimeSamples - fadeCounter);
+
+			readInteger(delayedOutput, currentDelayTime, numThisTime);
+
+			const float fadeDelta = 1.0f / (float)fadeTimeSamples;
+
+			const int oldReadIndex = (writeIndex - oldDelayTime) & mask;
+
+			for (int i = 0; i < numThisTime; i++)
+			{
+				const float oldValue = delayBuffer[(oldReadIndex + i) & mask];
+				const float fadeValue = (float)(fadeCounter + i) * fadeDelta;
+
+				delayedOutput[i] = delayedOutput[i] * fadeValue + oldValue * (1.0f - fadeValue);
+			}
+
+			fadeCounter += numThisTime;
+
+			if (fadeCounter >= fadeTimeSamples)
+			{
+				fadeCounter = -1;
+
+				if (lastIgnoredDelayTime != 0)
+				{
+					setInternalDelayTime(lastIgnoredDelayTime);
+				}
+			}
+		}
+		else
+		{
+			readInteger(delayedOutput, currentDelayTime, numThisTime);
+		}
+
+		write(input, numThisTime, delayedOutput, feedback);
+
+		input += numThisTime;
+		delayedOutput += numThisTime;
+		numSamples -= numThisTime;
+	}
+}
+
+void ModulatedDelayLine::readFractional(float* output, const float* delayTimes, int numSamples) const
+{
+	const float* d = delayBuffer;
+
+	for (int i = 0; i < numSamples; i++)
+	{
+		jassert(delayTimes[i] >= (float)(i + 2) && delayTimes[i] <= (float)getMaxDelaySamples());
+
+		const float delayTime = delayTimes[i];
+		const int delayInt = (int)delayTime;
+		const float f = delayTime - (float)delayInt;
+
+		// The index of the sample with the delay time delayInt - 1 (the newest of the four samples)
+		const int index = writeIndex + i - delayInt + 1;
+
+		const float x0 = d[index & mask];
+		const float x1 = d[(index - 1) & mask];
+		const float x2 = d[(index - 2) & mask];
+		const float x3 = d[(index - 3) & mask];
+
+		// Third order Lagrange interpolation at the points -1, 0, 1, 2
+		const float fm1 = f - 1.0f;
+		const float fm2 = f - 2.0f;
+		const float fp1 = f + 1.0f;
+
+		const float h0 = -f * fm1 * fm2 * (1.0f / 6.0f);
+		const float h1 = fp1 * fm1 * fm2 * 0.5f;
+		const float h2 = -fp1 * f * fm2 * 0.5f;
+		const float h3 = fp1 * f * fm1 * (1.0f / 6.0f);
+
+		output[i] = h0 * x0 + h1 * x1 + h2 * x2 + h3 * x3;
+	}
+}
+
+namespace OversamplerHelpers
+{
+	/** Designs a Kaiser windowed halfband filter with 4 * m + 3 taps and stores the 2 * m + 2 taps with an even index. */
+	static void designHalfbandFir(float* evenTaps, int m, double beta)
+	{
+		auto besselI0 = [](double x)
+		{
+			double sum = 1.0;
+			double term = 1.0;
+
+			for (int k = 1; k < 32; k++)
+			{
+				term *= (x / (2.0 * (double)k)) * (x / (2.0 * (double)k));
+				sum += term;
+			}
+
+			return sum;
+		};
+
+		const int numTaps = 4 * m + 3;
+		const double centre = (double)(numTaps - 1) * 0.5;
+		const double denominator = besselI0(beta);
+
+		double sum = 0.0;
+
+		for (int j = 0; j < 2 * m + 2; j++)
+		{
+			const double x = (double)(2 * j) - centre;
+			const double sinc = sin(double_Pi * x * 0.5) / (double_Pi * x);
+			const double r = x / centre;
+			const double window = besselI0(beta * sqrt(jmax<double>(0.0, 1.0 - r * r))) / denominator;
+
+			evenTaps[j] = (float)(sinc * window);
+			sum += sinc * window;
+		}
+
+		// Every polyphase branch must have a DC gain of 0.5
+		for (int j = 0; j < 2 * m + 2; j++)
+		{
+			evenTaps[j] = (float)((double)evenTaps[j] * 0.5 / sum);
+		}
+	}
+
+	/** Calculates the allpass coefficients of a polyphase IIR halfband filter with the given transition bandwidth (relative to the oversampled rate). 
+	*
+	*	This is the elliptic filter design from Laurent de Soras' HIIR library.
+	*/
+	static void designHalfbandIir(float* coefficients, int numCoefficients, double transition)
+	{
+		double k = tan((1.0 - transition * 2.0) * double_Pi / 4.0);
+		k *= k;
+
+		const double kksqrt = pow(1.0 - k * k, 0.25);
+		const double e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+		const double e4 = e * e * e * e;
+		const double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+		const int order = numCoefficients * 2 + 1;
+
+		for (int index = 0; index < numCoefficients; index++)
+		{
+			const double c = (double)(index + 1);
+
+			double numerator = 0.0;
+			double sign = 1.0;
+
+			for (int i = 0; i < 32; i++)
+			{
+				numerator += pow(q, (double)(i * (i + 1))) * sin((double)(i * 2 + 1) * c * double_Pi / (double)order) * sign;
+				sign = -sign;
+			}
+
+			double denominator = 0.0;
+			sign = -1.0;
+
+			for (int i = 1; i < 32; i++)
+			{
+				denominator += pow(q, (double)(i * i)) * cos((double)(i * 2) * c * double_Pi / (double)order) * sign;
+				sign = -sign;
+			}
+
+			const double ww = numerator * pow(q, 0.25) / (denominator + 0.5);
+			const double wwsq = ww * ww;
+			const double x = sqrt((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+
+			coefficients[index] = (float)((1.0 - x) / (1.0 + x));
+		}
+	}
+
+	/** The filters for the first 2x stage need a steep transition, the following stages can use much cheaper filters
+	*	because the signal is already bandlimited to a quarter of their input rate. 
+	*/
+	struct FilterTables
+	{
+		enum
+		{
+			FirstFirM = 15,
+			NextFirM = 5,
+			FirstIirOrder = 8,
+			NextIirOrder = 4
+		};
+
+		FilterTables()
+		{
+			designHalfbandFir(firstFir, FirstFirM, 8.0);
+			designHalfbandFir(nextFir, NextFirM, 8.0);
+			designHalfbandIir(firstIir, FirstIirOrder, 0.0375);
+			designHalfbandIir(nextIir, NextIirOrder, 0.2);
+		}
+
+		/** Returns the latency of the up- and downsampling filters of one stage in samples of the stage's input rate. */
+		double getStageLatency(bool isFirstStage, Oversampler::FilterType type) const
+		{
+			if (type == Oversampler::LinearPhase)
+			{
+				return (double)(2 * (isFirstStage ? FirstFirM : NextFirM) + 1);
+			}
+
+			// The combined response of both polyphase branches is the cascade of all allpass sections at the input rate,
+			// so the latency is the sum of their group delays at DC.
+			const float* c = isFirstStage ? firstIir : nextIir;
+			const int numCoefficients = isFirstStage ? FirstIirOrder : NextIirOrder;
+
+			double latency = 0.0;
+
+			for (int i = 0; i < numCoefficients; i++)
+			{
+				latency += (1.0 - (double)c[i]) / (1.0 + (double)c[i]);
+			}
+
+			return latency;
+		}
+
+		float firstFir[2 * FirstFirM + 2];
+		float nextFir[2 * NextFirM + 2];
+		float firstIir[FirstIirOrder];
+		float nextIir[NextIirOrder];
+	};
+
+	static const FilterTables& getFilterTables()
+	{
+		static const FilterTables tables;
+		return tables;
+	}
+}
+
+Oversampler::Oversampler() :
+	pendingFactor(1),
+	pendingFilterType((int)LinearPhase),
+	resetRequested(0),
+	factor(1),
+	filterType(LinearPhase),
+	numStages(0),
+	maxBlockSize(0)
+{
+	const OversamplerHelpers::FilterTables& tables = OversamplerHelpers::getFilterTables();
+
+	for (int i = 0; i < NumStages; i++)
+	{
+		const bool isFirstStage = i == 0;
+
+		firStages[i].taps = isFirstStage ? tables.firstFir : tables.nextFir;
+		firStages[i].centreDelay = isFirstStage ? OversamplerHelpers::FilterTables::FirstFirM : OversamplerHelpers::FilterTables::NextFirM;
+		firStages[i].numTaps = 2 * firStages[i].centreDelay + 2;
+
+		iirStages[i].coefficients = isFirstStage ? tables.firstIir : tables.nextIir;
+		iirStages[i].numCoefficients = isFirstStage ? OversamplerHelpers::FilterTables::FirstIirOrder : OversamplerHelpers::FilterTables::NextIirOrder;
+	}
+
+	reset();
+}
+
+void Oversampler::setFactor(int newFactor)
+{
+	const int validFactor = getValidFactor(newFactor);
+
+	// The user of this class might skip the oversampler while the factor is 1, so every change must reset the filter state
+	if (pendingFactor.exchange(validFactor) != validFactor)
+		resetRequested.set(1);
+}
+
+void Oversampler::setFilterType(FilterType newType)
+{
+	if (pendingFilterType.exchange((int)newType) != (int)newType)
+		resetRequested.set(1);
+}
+
+void Oversampler::prepareToPlay(double /*sampleRate*/, int newMaxBlockSize)
+{
+	if (newMaxBlockSize > maxBlockSize)
+	{
+		maxBlockSize = newMaxBlockSize;
+
+		oversampledBuffer.setSize(NumChannels, maxBlockSize * MaxFactor);
+		workBuffer.setSize(NumChannels, maxBlockSize * MaxFactor);
+
+		// The biggest stage input has MaxFactor / 2 * maxBlockSize samples and two scratch arrays are needed for downsampling
+		scratch.allocate(2 * (32 + maxBlockSize * MaxFactor / 2), true);
+	}
+
+	reset();
+}
+
+void Oversampler::reset()
+{
+	for (int i = 0; i < NumStages; i++)
+	{
+		firStages[i].reset();
+		iirStages[i].reset();
+	}
+}
+
+int Oversampler::getLatencySamples() const
+{
+	return getLatencySamples(pendingFactor.get(), (FilterType)pendingFilterType.get());
+}
+
+int Oversampler::getLatencySamples(int factorToUse, FilterType type)
+{
+	const OversamplerHelpers::FilterTables& tables = OversamplerHelpers::getFilterTables();
+
+	double latency = 0.0;
+	double stageRate = 1.0;
+
+	for (int i = 0; (1 << (i + 1)) <= factorToUse; i++)
+	{
+		latency += tables.getStageLatency(i == 0, type) / stageRate;
+		stageRate *= 2.0;
+	}
+
+	return roundToInt(latency);
+}
+
+void Oversampler::updateSettings()
+{
+	if (resetRequested.compareAndSetBool(0, 1))
+	{
+		factor = pendingFactor.get();
+		filterType = (FilterType)pendingFilterType.get();
+		numStages = factor == 8 ? 3 : (factor == 4 ? 2 : (factor == 2 ? 1 : 0));
+
+		reset();
+	}
+}
+
+AudioSampleBuffer& Oversampler::upsample(const AudioSampleBuffer& input, int startSample, int numSamples)
+{
+	jassert(numSamples <= maxBlockSize);
+
+	updateSettings();
+
+	// The stages alternate between the two buffers, so start with the one that ends up in oversampledBuffer
+	AudioSampleBuffer* buffers[2] = { &oversampledBuffer, &workBuffer };
+
+	float* source[NumChannels] = { const_cast<float*>(input.getReadPointer(0, startSample)), 
+								   const_cast<float*>(input.getReadPointer(jmin<int>(1, input.getNumChannels() - 1), startSample)) };
+
+	if (numStages == 0)
+	{
+		for (int c = 0; c < NumChannels; c++)
+		{
+			FloatVectorOperations::copy(oversampledBuffer.getWritePointer(c, 0), source[c], numSamples);
+		}
+
+		return oversampledBuffer;
+	}
+
+	int numStageSamples = numSamples;
+
+	for (int i = 0; i < numStages; i++)
+	{
+		AudioSampleBuffer* destinationBuffer = buffers[(numStages - 1 - i) & 1];
+
+		float* destination[NumChannels] = { destinationBuffer->getWritePointer(0), destinationBuffer->getWritePointer(1) };
+
+		if (filterType == LinearPhase)	firStages[i].upsample(source, destination, scratch, numStageSamples);
+		else							iirStages[i].upsample(source, destination, numStageSamples);
+
+		source[0] = destination[0];
+		source[1] = destination[1];
+
+		numStageSamples *= 2;
+	}
+
+	return oversampledBuffer;
+}
+
+void Oversampler::downsample(AudioSampleBuffer& output, int startSample, int numSamples)
+{
+	float* destination[NumChannels] = { output.getWritePointer(0, startSample), 
+										output.getWritePointer(jmin<int>(1, output.getNumChannels() - 1), startSample) };
+
+	if (numStages == 0)
+	{
+		for (int c = 0; c < jmin<int>(NumChannels, output.getNumChannels()); c++)
+		{
+			FloatVectorOperations::copy(destination[c], oversampledBuffer.getReadPointer(c, 0), numSamples);
+		}
+
+		return;
+	}
+
+	AudioSampleBuffer* buffers[2] = { &oversampledBuffer, &workBuffer };
+
+	float* source[NumChannels] = { oversampledBuffer.getWritePointer(0), oversampledBuffer.getWritePointer(1) };
+
+	int numStageSamples = numSamples << numStages;
+
+	for (int i = numStages - 1; i >= 0; i--)
+	{
+		float* stageDestination[NumChannels];
+
+		if (i == 0)
+		{
+			stageDestination[0] = destination[0];
+			stageDestination[1] = destination[1];
+		}
+		else
+		{
+			AudioSampleBuffer* destinationBuffer = buffers[(numStages - i) & 1];
+
+			stageDestination[0] = destinationBuffer->getWritePointer(0);
+			stageDestination[1] = destinationBuffer->getWritePointer(1);
+		}
+
+		if (filterType == LinearPhase)	firStages[i].downsample(source, stageDestination, scratch, numStageSamples);
+		else							iirStages[i].downsample(source, stageDestination, numStageSamples);
+
+		source[0] = stageDestination[0];
+		source[1] = stageDestination[1];
+
+		numStageSamples /= 2;
+	}
+}
+
+void Oversampler::FirStage::reset()
+{
+	memset(upHistory, 0, sizeof(upHistory));
+	memset(evenHistory, 0, sizeof(evenHistory));
+	memset(oddHistory, 0, sizeof(oddHistory));
+}
+
+void Oversampler::FirStage::upsample(float* const* input, float* const* output, float* s, int numSamples)
+{
+	const int m = centreDelay;
+	const int last = 2 * m + 1;
+
+	for (int c = 0; c < NumChannels; c++)
+	{
+		memcpy(s, upHistory[c], sizeof(float) * numTaps);
+		memcpy(s + numTaps, input[c], sizeof(float) * numSamples);
+
+		float* out = output[c];
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const float* p = s + numTaps + i;
+
+			float sum = 0.0f;
+
+			// The taps are symmetric, so fold the two halves of the delay line
+			for (int j = 0; j <= m; j++)
+			{
+				sum += taps[j] * (p[-j] + p[j - last]);
+			}
+
+			out[2 * i] = 2.0f * sum;
+			out[2 * i + 1] = p[-m];
+		}
+
+		memcpy(upHistory[c], s + numSamples, sizeof(float) * numTaps);
+	}
+}
+
+void Oversampler::FirStage::downsample(float* const* input, float* const* output, float* s, int numSamples)
+{
+	const int m = centreDelay;
+	const int last = 2 * m + 1;
+	const int numOutputSamples = numSamples / 2;
+
+	float* even = s;
+	float* odd = s + numTaps + numOutputSamples;
+
+	for (int c = 0; c < NumChannels; c++)
+	{
+		memcpy(even, evenHistory[c], sizeof(float) * numTaps);
+		memcpy(odd, oddHistory[c], sizeof(float) * numTaps);
+
+		const float* in = input[c];
+
+		for (int i = 0; i < numOutputSamples; i++)
+		{
+			even[numTaps + i] = in[2 * i];
+			odd[numTaps + i] = in[2 * i + 1];
+		}
+
+		float* out = output[c];
+
+		for (int i = 0; i < numOutputSamples; i++)
+		{
+			const float* p = even + numTaps + i;
+
+			float sum = 0.0f;
+
+			for (int j = 0; j <= m; j++)
+			{
+				sum += taps[j] * (p[-j] + p[j - last]);
+			}
+
+			out[i] = sum + 0.5f * odd[numTaps + i - m - 1];
+		}
+
+		memcpy(evenHistory[c], even + numOutputSamples, sizeof(float) * numTaps);
+		memcpy(oddHistory[c], odd + numOutputSamples, sizeof(float) * numTaps);
+	}
+}
+
+void Oversampler::IirStage::reset()
+{
+	memset(upX, 0, sizeof(upX));
+	memset(upY, 0, sizeof(upY));
+	memset(downX, 0, sizeof(downX));
+	memset(downY, 0, sizeof(downY));
+}
+
+void Oversampler::IirStage::upsample(float* const* input, float* const* output, int numSamples)
+{
+	const float* a = coefficients;
+
+	for (int c = 0; c < NumChannels; c++)
+	{
+		float* x = upX[c];
+		float* y = upY[c];
+
+		const float* in = input[c];
+		float* out = output[c];
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			// The even coefficients are the allpass chain of the first branch, the odd coefficients the second branch
+			float branch0 = in[i];
+			float branch1 = in[i];
+
+			for (int k = 0; k < numCoefficients; k += 2)
+			{
+				const float x0 = x[k];
+				x[k] = branch0;
+				branch0 = (branch0 - y[k]) * a[k] + x0;
+				y[k] = branch0;
+
+				const float x1 = x[k + 1];
+				x[k + 1] = branch1;
+				branch1 = (branch1 - y[k + 1]) * a[k + 1] + x1;
+				y[k + 1] = branch1;
+			}
+
+			out[2 * i] = branch0;
+			out[2 * i + 1] = branch1;
+		}
+	}
+}
+
+void Oversampler::IirStage::downsample(float* const* input, float* const* output, int numSamples)
+{
+	const float* a = coefficients;
+	const int numOutputSamples = numSamples / 2;
+
+	for (int c = 0; c < NumChannels; c++)
+	{
+		float* x = downX[c];
+		float* y = downY[c];
+
+		const float* in = input[c];
+		float* out = output[c];
+
+		for (int i = 0; i < numOutputSamples; i++)
+		{
+			float branch0 = in[2 * i + 1];
+			float branch1 = in[2 * i];
+
+			for (int k = 0; k < numCoefficients; k += 2)
+			{
+				const float x0 = x[k];
+				x[k] = branch0;
+				branch0 = (branch0 - y[k]) * a[k] + x0;
+				y[k] = branch0;
+
+				const float x1 = x[k + 1];
+				x[k + 1] = branch1;
+				branch1 = (branch1 - y[k + 1]) * a[k + 1] + x1;
+				y[k + 1] = branch1;
+			}
+
+			out[i] = 0.5f * (branch0 + branch1);
+		}
+	}
+}
@@ -146,5 +146,209 @@ private:
 };
 
 
+/** A ring buffer delay line that is processed in blocks.
+*
+*	Unlike DelayLine, this copies whole blocks into and out of the ring buffer (in two segments when the ring buffer wraps around)
+*	and mixes the feedback with vector operations. Changing the delay time crossfades between the old and the new read position
+*	just like DelayLine. For modulated effects, readFractional() reads arbitrary per sample delay times with a third order 
+*	Lagrange interpolator.
+*
+*	The buffer is allocated in the constructor or setMaxDelaySamples(), so nothing in the processing methods allocates memory.
+*/
+class ModulatedDelayLine
+{
+public:
+
+	ModulatedDelayLine(int maxDelayInSamples=DELAY_BUFFER_SIZE - 4);
+
+	/** Reallocates and clears the ring buffer. Don't call this from the audio thread. */
+	void setMaxDelaySamples(int maxDelayInSamples);
+
+	int getMaxDelaySamples() const { return mask - 3; }
+
+	void prepareToPlay(double sampleRate_);
+
+	/** Clears the ring buffer and stops a pending crossfade. */
+	void clear();
+
+	void setDelayTimeSeconds(double delayInSeconds);
+
+	/** Sets the delay time. If the delay line is currently crossfading, the new time is applied after the fade. */
+	void setDelayTimeSamples(int delayInSamples);
+
+	void setFadeTimeSamples(int newFadeTimeInSamples);
+
+	/** Delays the input and adds the delayed signal multiplied with the feedback to the ring buffer.
+	*
+	*	This splits the block into chunks that are shorter than the delay time, so it works with any block size.
+	*/
+	void processWithFeedback(const float* input, float* delayedOutput, int numSamples, float feedback);
+
+	/** Reads the delayed values for the next block without advancing the write position.
+	*
+	*	delayTimes contains the delay time in samples for every sample of the block. Because the block is not written yet, 
+	*	the delay time of the sample with the index i must be at least i + 2 (and not bigger than getMaxDelaySamples()).
+	*/
+	void readFractional(float* output, const float* delayTimes, int numSamples) const;
+
+	/** Writes the block into the ring buffer and advances the write position. 
+	*
+	*	If feedbackSignal is not nullptr, it is multiplied with the feedback and added to the input.
+	*/
+	void write(const float* input, int numSamples, const float* feedbackSignal=nullptr, float feedback=0.0f);
+
+private:
+
+	void readInteger(float* output, int delayInSamples, int numSamples) const;
+
+	void setInternalDelayTime(int delayInSamples);
+
+	SpinLock processLock;
+
+	HeapBlock<float> delayBuffer;
+
+	double sampleRate;
+
+	int mask;
+	int writeIndex;
+
+	int currentDelayTime;
+	int oldDelayTime;
+	int lastIgnoredDelayTime;
+
+	int fadeCounter;
+	int fadeTimeSamples;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModulatedDelayLine);
+};
+
+
+/** A polyphase up- and downsampler for nonlinear processing stages.
+*
+*	It oversamples a stereo signal by 2x, 4x or 8x with a cascade of halfband filters. LinearPhase uses symmetric 
+*	FIR halfband filters (only every other tap is non-zero, so the polyphase implementation needs half the multiplications), 
+*	MinimumPhase uses polyphase IIR halfband filters made of first order allpass sections, which have a much smaller latency
+*	but a nonlinear phase response.
+*
+*	Wrap the nonlinear part of the effect with upsample() and downsample():
+*
+*		AudioSampleBuffer& os = oversampler.upsample(buffer, startSample, numSamples);
+*		processNonlinearStage(os, 0, numSamples * oversampler.getFactor());
+*		oversampler.downsample(buffer, startSample, numSamples);
+*
+*	and report getLatencySamples() in the effect's EffectProcessor::getLatencySamples().
+*	The factor and the filter type can be changed from any thread, the change is picked up in the next upsample() call. 
+*/
+class Oversampler
+{
+public:
+
+	enum FilterType
+	{
+		LinearPhase = 0,
+		MinimumPhase,
+		numFilterTypes
+	};
+
+	enum
+	{
+		MaxFactor = 8,
+		NumChannels = 2,
+		NumStages = 3
+	};
+
+	Oversampler();
+
+	/** Sets the oversampling factor (1, 2, 4 or 8). */
+	void setFactor(int newFactor);
+
+	/** Rounds the factor down to the next supported factor. */
+	static int getValidFactor(int factor) noexcept { return factor >= 8 ? 8 : (factor >= 4 ? 4 : (factor >= 2 ? 2 : 1)); }
+
+	/** Returns the factor that is used for the current block. */
+	int getFactor() const noexcept { return factor; }
+
+	void setFilterType(FilterType newType);
+
+	FilterType getFilterType() const noexcept { return (FilterType)pendingFilterType.get(); }
+
+	/** Allocates the buffers for the biggest factor, so changing the factor doesn't allocate memory. */
+	void prepareToPlay(double sampleRate, int maxBlockSize);
+
+	/** Clears the filter states. */
+	void reset();
+
+	/** Returns the latency of the up- and downsampling filters in samples of the original rate. */
+	int getLatencySamples() const;
+
+	/** Returns the latency that a factor and filter type would add. */
+	static int getLatencySamples(int factor, FilterType type);
+
+	/** Upsamples the first two channels of the input and returns the oversampled buffer. 
+	*
+	*	The oversampled signal starts at sample 0 and has numSamples * getFactor() samples.
+	*/
+	AudioSampleBuffer& upsample(const AudioSampleBuffer& input, int startSample, int numSamples);
+
+	/** Downsamples the oversampled buffer of the last upsample() call and writes the result to the first two channels of output. */
+	void downsample(AudioSampleBuffer& output, int startSample, int numSamples);
+
+private:
+
+	struct FirStage
+	{
+		void reset();
+
+		void upsample(float* const* input, float* const* output, float* scratch, int numSamples);
+		void downsample(float* const* input, float* const* output, float* scratch, int numSamples);
+
+		const float* taps = nullptr;
+		int numTaps = 0;
+		int centreDelay = 0;
+
+		float upHistory[NumChannels][32];
+		float evenHistory[NumChannels][32];
+		float oddHistory[NumChannels][32];
+	};
+
+	struct IirStage
+	{
+		void reset();
+
+		void upsample(float* const* input, float* const* output, int numSamples);
+		void downsample(float* const* input, float* const* output, int numSamples);
+
+		const float* coefficients = nullptr;
+		int numCoefficients = 0;
+
+		float upX[NumChannels][8];
+		float upY[NumChannels][8];
+		float downX[NumChannels][8];
+		float downY[NumChannels][8];
+	};
+
+	void updateSettings();
+
+	Atomic<int> pendingFactor;
+	Atomic<int> pendingFilterType;
+	Atomic<int> resetRequested;
+
+	int factor;
+	FilterType filterType;
+	int numStages;
+
+	int maxBlockSize;
+
+	FirStage firStages[NumStages];
+	IirStage iirStages[NumStages];
+
+	AudioSampleBuffer oversampledBuffer;
+	AudioSampleBuffer workBuffer;
+
+	HeapBlock<float> scratch;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Oversampler);
+};
+
 
 #endif  // DSPCOREMODULES_H_INCLUDED
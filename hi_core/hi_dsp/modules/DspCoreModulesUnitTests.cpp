@@ -0,0 +1,422 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#include "JuceHeader.h"
+
+class DspCoreModulesTest : public UnitTest
+{
+public:
+
+	DspCoreModulesTest() :
+		UnitTest("Testing DSP core modules")
+	{
+
+	}
+
+	void runTest() override
+	{
+		beginTest("Testing ModulatedDelayLine impulse response with feedback");
+
+		testImpulseWithFeedback(100, 0.5f, 1);
+		testImpulseWithFeedback(100, 0.5f, 17);
+		testImpulseWithFeedback(100, 0.5f, 100);
+		testImpulseWithFeedback(100, -0.8f, 512);
+		testImpulseWithFeedback(7, 0.9f, 1024);
+
+		beginTest("Testing ModulatedDelayLine block sizes");
+
+		Random r = getRandom();
+
+		const int delayTimes[] = { 1, 2, 31, 256, 1000 };
+		const int blockSizes[] = { 1, 16, 64, 255, 1024, 4096 };
+
+		for (auto delayTime : delayTimes)
+		{
+			for (auto blockSize : blockSizes)
+				compareWithReference(r, delayTime, blockSize);
+		}
+
+		beginTest("Testing ModulatedDelayLine fractional reading");
+
+		testFractionalRead(r);
+
+		const Oversampler::FilterType filterTypes[] = { Oversampler::LinearPhase, Oversampler::MinimumPhase };
+
+		for (auto type : filterTypes)
+		{
+			const String typeName = type == Oversampler::LinearPhase ? "linear phase" : "minimum phase";
+
+			beginTest("Testing Oversampler latency with " + typeName + " filters");
+
+			for (int factor = 2; factor <= Oversampler::MaxFactor; factor *= 2)
+				testOversamplerLatency(factor, type);
+
+			beginTest("Testing Oversampler passband with " + typeName + " filters");
+
+			for (int factor = 2; factor <= Oversampler::MaxFactor; factor *= 2)
+				testOversamplerPassband(factor, type);
+
+			beginTest("Testing Oversampler aliasing with " + typeName + " filters");
+
+			testOversamplerAliasing(type);
+		}
+	}
+
+private:
+
+	/** Creates a delay line that starts with the given delay time (without the crossfade from the default time). */
+	static void initialise(ModulatedDelayLine& d, int delayTime)
+	{
+		d.setDelayTimeSamples(delayTime);
+		d.clear();
+	}
+
+	void testImpulseWithFeedback(int delayTime, float feedback, int blockSize)
+	{
+		ModulatedDelayLine d(4096);
+		initialise(d, delayTime);
+
+		const int numSamples = delayTime * 12;
+
+		HeapBlock<float> input(numSamples, true);
+		HeapBlock<float> output(numSamples, true);
+
+		input[0] = 1.0f;
+
+		for (int i = 0; i < numSamples; i += blockSize)
+		{
+			d.processWithFeedback(input + i, output + i, jmin<int>(blockSize, numSamples - i), feedback);
+		}
+
+		// The echoes are spaced by the delay time and decay by the feedback factor
+		for (int i = 0; i < numSamples; i++)
+		{
+			const bool isEcho = i != 0 && i % delayTime == 0;
+			const float expected = isEcho ? std::pow(feedback, (float)(i / delayTime - 1)) : 0.0f;
+
+			if (std::abs(output[i] - expected) > 1.0e-6f)
+			{
+				expect(false, "Delay " + String(delayTime) + ", block size " + String(blockSize) + ": sample " + String(i) + 
+					   " is " + String(output[i]) + ", expected " + String(expected));
+				return;
+			}
+		}
+	}
+
+	/** Compares the block processing with a per sample feedback delay. */
+	void compareWithReference(Random& r, int delayTime, int blockSize)
+	{
+		ModulatedDelayLine d(4096);
+		initialise(d, delayTime);
+
+		const float feedback = 0.7f;
+		const int numSamples = 8192;
+
+		HeapBlock<float> input(numSamples);
+		HeapBlock<float> output(numSamples);
+		HeapBlock<float> written(numSamples);
+
+		for (int i = 0; i < numSamples; i++)
+			input[i] = r.nextFloat() * 2.0f - 1.0f;
+
+		for (int i = 0; i < numSamples; i += blockSize)
+		{
+			d.processWithFeedback(input + i, output + i, jmin<int>(blockSize, numSamples - i), feedback);
+		}
+
+		float maxError = 0.0f;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const float expected = i >= delayTime ? written[i - delayTime] : 0.0f;
+
+			written[i] = input[i] + feedback * expected;
+
+			maxError = jmax<float>(maxError, std::abs(output[i] - expected));
+		}
+
+		expect(maxError < 1.0e-5f, "Delay " + String(delayTime) + ", block size " + String(blockSize) + ": error " + String(maxError));
+	}
+
+	/** The third order Lagrange interpolator must reproduce a cubic polynomial exactly and match the textbook weights. */
+	void testFractionalRead(Random& r)
+	{
+		ModulatedDelayLine d(1024);
+
+		auto polynomial = [](double t) { t *= 0.01; return 0.3 - 0.5 * t + 0.2 * t * t - 0.01 * t * t * t; };
+
+		const int numWritten = 600;
+
+		HeapBlock<float> signal(numWritten);
+
+		for (int i = 0; i < numWritten; i++)
+			signal[i] = (float)polynomial((double)i);
+
+		d.write(signal, numWritten);
+
+		const int numSamples = 64;
+
+		HeapBlock<float> delayTimes(numSamples);
+		HeapBlock<float> output(numSamples);
+
+		for (int i = 0; i < numSamples; i++)
+			delayTimes[i] = (float)(i + 2) + r.nextFloat() * 400.0f;
+
+		// Some delay times with an exact fractional part
+		delayTimes[0] = 10.0f;
+		delayTimes[1] = 10.5f;
+		delayTimes[2] = 10.25f;
+
+		d.readFractional(output, delayTimes, numSamples);
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			// The sample with the index i of the next block would be written at the position numWritten + i
+			const double position = (double)(numWritten + i) - (double)delayTimes[i];
+
+			expectWithinAbsoluteError<float>(output[i], (float)polynomial(position), 1.0e-5f, "Polynomial at delay " + String(delayTimes[i]));
+
+			// Lagrange weights for the points -1, 0, 1, 2 (relative to the integer delay time)
+			const int delayInt = (int)delayTimes[i];
+			const double f = (double)delayTimes[i] - (double)delayInt;
+			const double points[4] = { -1.0, 0.0, 1.0, 2.0 };
+
+			double expected = 0.0;
+
+			for (int j = 0; j < 4; j++)
+			{
+				double weight = 1.0;
+
+				for (int k = 0; k < 4; k++)
+				{
+					if (k != j) weight *= (f - points[k]) / (points[j] - points[k]);
+				}
+
+				expected += weight * (double)signal[numWritten + i - delayInt - (int)points[j]];
+			}
+
+			expectWithinAbsoluteError<float>(output[i], (float)expected, 1.0e-6f, "Lagrange weights at delay " + String(delayTimes[i]));
+		}
+
+		expectWithinAbsoluteError<float>(output[0], signal[numWritten - 10], 1.0e-7f, "Integer delay time must not interpolate");
+	}
+
+	enum
+	{
+		OversamplerSampleRate = 44100,
+		OversamplerBlockSize = 64
+	};
+
+	/** Runs the buffer through the oversampler in small blocks and applies tanh(drive * x) to the oversampled signal if drive is not zero. */
+	static void processOversampled(Oversampler& os, AudioSampleBuffer& buffer, float drive)
+	{
+		for (int startSample = 0; startSample < buffer.getNumSamples(); startSample += OversamplerBlockSize)
+		{
+			const int numThisTime = jmin<int>(OversamplerBlockSize, buffer.getNumSamples() - startSample);
+
+			AudioSampleBuffer& oversampled = os.upsample(buffer, startSample, numThisTime);
+
+			if (drive != 0.0f)
+			{
+				for (int c = 0; c < 2; c++)
+				{
+					float* d = oversampled.getWritePointer(c, 0);
+
+					for (int i = 0; i < numThisTime * os.getFactor(); i++)
+						d[i] = std::tanh(drive * d[i]);
+				}
+			}
+
+			os.downsample(buffer, startSample, numThisTime);
+		}
+	}
+
+	static void initialise(Oversampler& os, int factor, Oversampler::FilterType type)
+	{
+		os.prepareToPlay(OversamplerSampleRate, OversamplerBlockSize);
+		os.setFactor(factor);
+		os.setFilterType(type);
+		os.reset();
+	}
+
+	/** Fits a sine with the given frequency (which must have an integer number of periods in the data) and 
+	*	returns the energy of the remaining signal relative to the total energy. 
+	*/
+	static double fitSine(const float* data, int numSamples, double frequency, double& amplitude)
+	{
+		const double omega = 2.0 * double_Pi * frequency / (double)OversamplerSampleRate;
+
+		double sinPart = 0.0;
+		double cosPart = 0.0;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			sinPart += (double)data[i] * std::sin(omega * (double)i);
+			cosPart += (double)data[i] * std::cos(omega * (double)i);
+		}
+
+		sinPart *= 2.0 / (double)numSamples;
+		cosPart *= 2.0 / (double)numSamples;
+
+		amplitude = std::sqrt(sinPart * sinPart + cosPart * cosPart);
+
+		double total = 0.0;
+		double residual = 0.0;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const double r = (double)data[i] - sinPart * std::sin(omega * (double)i) - cosPart * std::cos(omega * (double)i);
+
+			total += (double)data[i] * (double)data[i];
+			residual += r * r;
+		}
+
+		return residual / total;
+	}
+
+	/** Renders a sine through the oversampler and returns the fitted amplitude and the relative energy of everything else in dB. */
+	static double renderSine(int factor, Oversampler::FilterType type, double frequency, float drive, double& amplitude)
+	{
+		Oversampler os;
+		initialise(os, factor, type);
+
+		// One second has an integer number of periods for every integer frequency
+		const int settleTime = 2048;
+		const int numSamples = settleTime + OversamplerSampleRate;
+
+		AudioSampleBuffer buffer(2, numSamples);
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const float value = (float)std::sin(2.0 * double_Pi * frequency * (double)i / (double)OversamplerSampleRate);
+
+			buffer.setSample(0, i, value);
+			buffer.setSample(1, i, value);
+		}
+
+		processOversampled(os, buffer, drive);
+
+		const double residual = fitSine(buffer.getReadPointer(0, settleTime), OversamplerSampleRate, frequency, amplitude);
+
+		return 10.0 * std::log10(residual);
+	}
+
+	/** Measures the group delay of the impulse response (its centroid) and compares it with the reported latency. */
+	void testOversamplerLatency(int factor, Oversampler::FilterType type)
+	{
+		Oversampler os;
+		initialise(os, factor, type);
+
+		const int reportedLatency = os.getLatencySamples();
+
+		expectEquals(reportedLatency, Oversampler::getLatencySamples(factor, type), "Latency of the instance");
+
+		const int impulsePosition = 100;
+		const int numSamples = 2048;
+
+		AudioSampleBuffer buffer(2, numSamples);
+		buffer.clear();
+		buffer.setSample(0, impulsePosition, 1.0f);
+		buffer.setSample(1, impulsePosition, 1.0f);
+
+		processOversampled(os, buffer, 0.0f);
+
+		double sum = 0.0;
+		double weightedSum = 0.0;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			sum += buffer.getSample(0, i);
+			weightedSum += (double)buffer.getSample(0, i) * (double)(i - impulsePosition);
+		}
+
+		const String message = String(factor) + "x: reported " + String(reportedLatency) + " samples";
+
+		expectWithinAbsoluteError<double>(sum, 1.0, 1.0e-3, message + ", DC gain");
+		expectWithinAbsoluteError<double>(weightedSum / sum, (double)reportedLatency, 1.0, message + ", measured group delay");
+
+		for (int i = 0; i < numSamples; i++)
+			expectWithinAbsoluteError<float>(buffer.getSample(1, i), buffer.getSample(0, i), 0.0f, "The channels must be processed identically");
+
+		// The latency figures of the current filter designs
+		if (type == Oversampler::LinearPhase)
+		{
+			const int expectedLatency = factor == 2 ? 31 : (factor == 4 ? 36 : 39);
+			expectEquals(reportedLatency, expectedLatency, String(factor) + "x linear phase latency");
+		}
+		else
+		{
+			expect(reportedLatency >= 3 && reportedLatency <= 5, message + " (minimum phase should be 3 to 5 samples)");
+		}
+	}
+
+	void testOversamplerPassband(int factor, Oversampler::FilterType type)
+	{
+		const double frequencies[] = { 100.0, 1000.0, 10000.0, 18000.0 };
+
+		for (auto f : frequencies)
+		{
+			double amplitude;
+			renderSine(factor, type, f, 0.0f, amplitude);
+
+			const double deviation = std::abs(Decibels::gainToDecibels(amplitude));
+
+			expect(deviation < 0.01, String(factor) + "x, " + String(f) + "Hz: passband deviation " + String(deviation, 4) + "dB");
+		}
+	}
+
+	/** Drives a 15kHz sine into tanh(4x) and measures everything except the fundamental (the only harmonic below Nyquist). */
+	void testOversamplerAliasing(Oversampler::FilterType type)
+	{
+		double amplitude;
+
+		// Measured: -10.8dB, -18dB, -38.2dB and -78.7dB
+		const double maxAliasing[] = { -8.0, -15.0, -35.0, -70.0 };
+
+		double lastAliasing = 0.0;
+		int index = 0;
+
+		for (int factor = 1; factor <= Oversampler::MaxFactor; factor *= 2)
+		{
+			const double aliasing = renderSine(factor, type, 15000.0, 4.0f, amplitude);
+
+			expect(aliasing < maxAliasing[index], String(factor) + "x: aliasing " + String(aliasing, 1) + "dB");
+			expect(aliasing < lastAliasing, String(factor) + "x: aliasing " + String(aliasing, 1) + "dB must be lower than " + String(lastAliasing, 1) + "dB");
+
+			lastAliasing = aliasing;
+			index++;
+		}
+	}
+};
+
+static DspCoreModulesTest dspCoreModulesTestInstance;
@@ -30,19 +30,30 @@
 *   ===========================================================================
 */
 
-void EffectProcessor::checkTailing(AudioSampleBuffer &b, int startSample, int numSamples)
+void EffectProcessor::checkTailing(AudioSampleBuffer &b, int startSample, int numSamples, float inputLevel)
 {
 	// Call this only on effects that produce a tail!
 	jassert(hasTail());
 
-	const float maxInL = FloatVectorOperations::findMaximum(tailCheck.getReadPointer(0, startSample), numSamples);
-	const float maxInR = FloatVectorOperations::findMaximum(tailCheck.getReadPointer(1, startSample), numSamples);
+	const float out = b.getMagnitude(startSample, numSamples);
+		
+	isTailing = (inputLevel == 0.0f && out >= 0.01f);
+}
 
-	const float maxL = FloatVectorOperations::findMaximum(b.getReadPointer(0, startSample), numSamples);
-	const float maxR = FloatVectorOperations::findMaximum(b.getReadPointer(1, startSample), numSamples);
+void EffectProcessor::updateSleepState(float inputLevel, float outputLevel, int numSamples)
+{
+	const double tailLength = getTailLengthInSeconds();
 
-	const float in = maxInL + maxInR;
-	const float out = maxL + maxR;
-		
-	isTailing = (in == 0.0f && out >= 0.01f);
+	if (tailLength < 0.0 || inputLevel >= EFFECT_SLEEP_THRESHOLD || outputLevel >= EFFECT_SLEEP_THRESHOLD)
+	{
+		resetSleepState();
+		return;
+	}
+
+	// Wait at least one block so that effects with latency are also silent
+	const int samplesUntilSleep = jmax<int>(numSamples, (int)(tailLength * getSampleRate()));
+
+	numSilentSamples = jmin<int>(numSilentSamples + numSamples, samplesUntilSleep);
+
+	sleeping = numSilentSamples >= samplesUntilSleep;
 }
\ No newline at end of file
@@ -35,6 +35,9 @@
 
 #define EFFECT_PROCESSOR_COLOUR 0xff3a6666
 
+/** The level (-100dB) below which a signal is treated as silence by the sleep detection of the effects. */
+#define EFFECT_SLEEP_THRESHOLD 0.00001f
+
 /** Base class for all Processors that applies a audio effect on the audio data. 
 *	@ingroup effect
 *
@@ -46,9 +49,10 @@ public:
 	EffectProcessor(MainController *mc, const String &uid): 
 		Processor(mc, uid),	
 		isTailing(false),
-		useStepSize(true) 
+		useStepSize(true),
+		sleeping(false),
+		numSilentSamples(0)
 	{
-		tailCheck = AudioSampleBuffer(2, 0);
 		emptyBuffer = AudioSampleBuffer(1, 0);
 	};
 
@@ -59,10 +63,7 @@ public:
 	{
 		Processor::prepareToPlay(sampleRate, samplesPerBlock);
 
-		if (samplesPerBlock > 0)
-		{
-			ProcessorHelpers::increaseBufferIfNeeded(tailCheck, samplesPerBlock);	
-		}
+		resetSleepState();
 
 		for(int i = 0; i < getNumChildProcessors(); i++)
 		{
@@ -93,6 +94,33 @@ public:
 	/** Checks if the effect is tailing off. This simply returns the calculated value, but the EffectChain overwrites this. */
 	virtual bool isTailingOff() const {	return isTailing; };
 
+	/** Overwrite this method and return the time after which the effect is guaranteed to be silent if it doesn't get any input.
+	*
+	*	If the input and the output stay silent for this time, the effect goes to sleep and is not processed until the input
+	*	gets loud again. The default returns -1.0, which means the effect never goes to sleep (eg. if it produces sound without input).
+	*/
+	virtual double getTailLengthInSeconds() const { return -1.0; }
+
+	/** Overwrite this method if the effect delays the signal (eg. because it oversamples the signal with linear phase filters).
+	*
+	*	The latency of the effects in the main container is reported to the host (see MainController::updateLatency()).
+	*/
+	virtual int getLatencySamples() const { return 0; }
+
+	/** Bypasses the effect and reports the changed latency to the host if the effect has latency. */
+	void setBypassed(bool shouldBeBypassed, NotificationType notifyChangeHandler=dontSendNotification) noexcept override
+	{
+		const bool latencyChanged = shouldBeBypassed != isBypassed() && getLatencySamples() != 0;
+
+		Processor::setBypassed(shouldBeBypassed, notifyChangeHandler);
+
+		if (latencyChanged)
+			getMainController()->updateLatency();
+	}
+
+	/** Returns true if the effect was sent to sleep because it doesn't receive any signal. */
+	bool isSleeping() const noexcept { return sleeping; }
+
 	/** Renders the next block and applies the effect to the buffer. */
 	virtual void renderNextBlock(AudioSampleBuffer &buffer, int startSample, int numSamples) = 0;
 
@@ -112,15 +140,38 @@ protected:
 	*/
 	virtual AudioSampleBuffer &getBufferForChain(int /*chainIndex*/) { return emptyBuffer; };
 
-	/** Takes a copy of the buffer before it is processed to check if a tail was added after processing. */
-	void saveBufferForTailCheck(AudioSampleBuffer &b, int startSample, int numSamples)
+	/** If your effect produces a tail, you have to call this method after your processing with the level of the unprocessed input. */
+	void checkTailing(AudioSampleBuffer &b, int startSample, int numSamples, float inputLevel);
+
+	/** Updates the sleep state after the effect was processed. 
+	*
+	*	Call this with the level of the unprocessed input. If the input and output stay below EFFECT_SLEEP_THRESHOLD 
+	*	for longer than the tail length, the effect goes to sleep. It wakes up as soon as this is called with a louder input.
+	*/
+	void updateSleepState(float inputLevel, float outputLevel, int numSamples);
+
+	/** Returns the time until the signal in a feedback loop has decayed below EFFECT_SLEEP_THRESHOLD.
+	*
+	*	Use this to calculate the tail length of delay based effects. It returns -1.0 if the loop doesn't decay.
+	*/
+	static double getFeedbackTailLength(double loopTimeSeconds, double feedbackGain)
 	{
-		tailCheck.copyFrom(0, startSample, b.getReadPointer(0, startSample), numSamples);
-		tailCheck.copyFrom(1, startSample, b.getReadPointer(1, startSample), numSamples);
+		const double absGain = std::abs(feedbackGain);
+
+		if (absGain >= 1.0) return -1.0;
+		if (absGain <= (double)EFFECT_SLEEP_THRESHOLD) return loopTimeSeconds;
+
+		const double numLoops = std::ceil(std::log((double)EFFECT_SLEEP_THRESHOLD) / std::log(absGain));
+
+		return loopTimeSeconds * (1.0 + numLoops);
 	}
 
-	/** If your effect produces a tail, you have to call this method after your processing. */
-	void checkTailing(AudioSampleBuffer &b, int startSample, int numSamples);
+	/** Wakes up the effect and resets the silence counter. */
+	void resetSleepState() noexcept
+	{
+		sleeping = false;
+		numSilentSamples = 0;
+	}
 
 	virtual const float *getModulationValuesForStepsizeCalculation(int /*chainIndex*/, int /*voiceIndex*/) { jassertfalse; return nullptr; };
 
@@ -186,13 +237,15 @@ protected:
 
 
 private:
-	AudioSampleBuffer tailCheck;
 
 	AudioSampleBuffer emptyBuffer;
 
 	bool isTailing;
 
 	bool useStepSize;
+
+	bool sleeping;
+	int numSilentSamples;
 };
 
 /** A MasterEffectProcessor renders a effect on a block of audio samples. 
@@ -305,6 +358,27 @@ public:
 	*/
 	virtual void applyEffect(AudioSampleBuffer &b, int startSample, int numSamples) = 0;
 
+	/** Checks if the effect can be sent to sleep.
+	*
+	*	This is the case if it reports a tail length and none of its internal chains contains a modulator.
+	*	A modulated effect keeps running so that the modulation is applied to its internal state (eg. smoothers).
+	*/
+	bool canSleep() const
+	{
+		if (getTailLengthInSeconds() < 0.0)
+			return false;
+
+		for (int i = 0; i < getNumInternalChains(); i++)
+		{
+			const ModulatorChain *mc = dynamic_cast<const ModulatorChain*>(getChildProcessor(i));
+
+			if (mc != nullptr && !mc->isBypassed() && mc->getNumChildProcessors() != 0)
+				return false;
+		}
+
+		return true;
+	}
+
 	/** This only renders the modulatorChains. */
 	virtual void renderNextBlock(AudioSampleBuffer &/*buffer*/, int startSample, int numSamples) final override
 	{
@@ -332,12 +406,36 @@ public:
 
 			AudioSampleBuffer stereoBuffer(samples, 2, buffer.getNumSamples());
 
-			applyEffect(stereoBuffer, 0, samplesToUse);
+			const bool sleepDetection = canSleep();
+
+			if (!sleepDetection)
+				resetSleepState();
+
+			const float inputLevel = sleepDetection ? stereoBuffer.getMagnitude(0, samplesToUse) : 0.0f;
+
+			if (isSleeping() && inputLevel < EFFECT_SLEEP_THRESHOLD)
+			{
+#if ENABLE_ALL_PEAK_METERS
+				addPeakMeterValues(0.0f, 0.0f, samplesToUse);
+#endif
+			}
+			else
+			{
+				applyEffect(stereoBuffer, 0, samplesToUse);
+
+				if (sleepDetection || ENABLE_ALL_PEAK_METERS)
+				{
+					const float outL = stereoBuffer.getMagnitude(0, 0, samplesToUse);
+					const float outR = stereoBuffer.getMagnitude(1, 0, samplesToUse);
+
+					if (sleepDetection)
+						updateSleepState(inputLevel, jmax<float>(outL, outR), samplesToUse);
 
 #if ENABLE_ALL_PEAK_METERS
-			currentValues.outL = stereoBuffer.getMagnitude(0, 0, samplesToUse);
-			currentValues.outR = stereoBuffer.getMagnitude(1, 0, samplesToUse);
+					addPeakMeterValues(outL, outR, samplesToUse);
 #endif
+				}
+			}
 
 			if (getMatrix().isEditorShown())
 			{
@@ -488,8 +586,7 @@ public:
 		}
 
 #if ENABLE_ALL_PEAK_METERS
-		currentValues.outL = buffer.getMagnitude(0, startSample, numSamples);
-		currentValues.outR = buffer.getMagnitude(1, startSample, numSamples);
+		addPeakMeterBlock(buffer.getReadPointer(0, startSample), buffer.getReadPointer(1, startSample), numSamples);
 #endif
 	}
 };
@@ -577,7 +674,7 @@ public:
 	{
 		jassert(isOnAir());
 
-		if(hasTail()) saveBufferForTailCheck(b, startSample, numSamples);
+		const float inputLevel = hasTail() ? b.getMagnitude(startSample, numSamples) : 0.0f;
 
 		const int startIndex = startSample;
 		const int samplesToCheck = numSamples;
@@ -599,7 +696,7 @@ public:
 			applyEffect(voiceIndex, b, startSample, numSamples);
 		}
 
-		if(hasTail()) checkTailing(b, startIndex, samplesToCheck);
+		if(hasTail()) checkTailing(b, startIndex, samplesToCheck, inputLevel);
 
 		return;
 	}
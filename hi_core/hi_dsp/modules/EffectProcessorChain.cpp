@@ -65,6 +65,7 @@ void EffectProcessorChainFactoryType::fillTypeNameList()
 	ADD_NAME_TO_TYPELIST(CurveEq);
 	ADD_NAME_TO_TYPELIST(StereoEffect);
 	ADD_NAME_TO_TYPELIST(SimpleReverbEffect);
+	ADD_NAME_TO_TYPELIST(FdnReverbEffect);
 	ADD_NAME_TO_TYPELIST(GainEffect);
 	ADD_NAME_TO_TYPELIST(ConvolutionEffect);
 	ADD_NAME_TO_TYPELIST(DelayEffect);
@@ -93,6 +94,7 @@ Processor* EffectProcessorChainFactoryType::createProcessor	(int typeIndex, cons
 	case stereoEffect:					return new StereoEffect(m, id, numVoices);
 	case convolution:					return new ConvolutionEffect(m, id);
 	case simpleReverb:					return new SimpleReverbEffect(m, id);
+	case fdnReverb:						return new FdnReverbEffect(m, id);
 	case simpleGain:					return new GainEffect(m, id);
 	case delay:							return new DelayEffect(m, id);
 	case limiter:						return new MdaLimiterEffect(m, id);
@@ -106,7 +106,14 @@ public:
 
         ADD_GLITCH_DETECTOR(parentProcessor, DebugLogger::Location::VoiceEffectRendering);
         
-		FOR_EACH_VOICE_EFFECT(renderVoice(voiceIndex, b, startSample, numSamples)); 
+		for (int i = 0; i < voiceEffects.size(); ++i)
+		{
+			if (!voiceEffects[i]->isBypassed())
+			{
+				ADD_CPU_COUNTER(voiceEffects[i]);
+				voiceEffects[i]->renderVoice(voiceIndex, b, startSample, numSamples);
+			}
+		}
 	};
 
 	void renderNextBlock(AudioSampleBuffer &buffer, int startSample, int numSamples) override
@@ -128,6 +135,19 @@ public:
 		return false;
 	};
 
+	/** Returns the sum of the latencies of all active effects. */
+	int getLatencySamples() const override
+	{
+		int latency = 0;
+
+		for (int i = 0; i < allEffects.size(); i++)
+		{
+			if (!allEffects[i]->isBypassed()) latency += allEffects[i]->getLatencySamples();
+		}
+
+		return latency;
+	}
+
 	bool isTailingOff() const override
 	{
 		for(int i = 0; i < allEffects.size(); i++)
@@ -144,11 +164,17 @@ public:
 
 		ADD_GLITCH_DETECTOR(parentProcessor, DebugLogger::Location::MasterEffectRendering);
         
-		FOR_EACH_MASTER_EFFECT(renderWholeBuffer(b));
+		for (int i = 0; i < masterEffects.size(); ++i)
+		{
+			if (!masterEffects[i]->isBypassed())
+			{
+				ADD_CPU_COUNTER(masterEffects[i]);
+				masterEffects[i]->renderWholeBuffer(b);
+			}
+		}
 
 #if ENABLE_ALL_PEAK_METERS
-		currentValues.outL = (b.getMagnitude(0, 0, b.getNumSamples()));
-		currentValues.outR = (b.getMagnitude(1, 0, b.getNumSamples()));
+		addPeakMeterBlock(b.getReadPointer(0), b.getReadPointer(1), b.getNumSamples());
 #endif
 
 	}
@@ -211,18 +237,24 @@ public:
 
 		void remove(Processor *processorToBeRemoved) override
 		{
-			ScopedLock sl(chain->getMainController()->getLock());
-
 			jassert(dynamic_cast<EffectProcessor*>(processorToBeRemoved) != nullptr);
-			
-			chain->allEffects.removeAllInstancesOf(dynamic_cast<EffectProcessor*>(processorToBeRemoved));
 
-			if(VoiceEffectProcessor* vep = dynamic_cast<VoiceEffectProcessor*>(processorToBeRemoved)) chain->voiceEffects.removeObject(vep);
-			else if (MasterEffectProcessor* mep = dynamic_cast<MasterEffectProcessor*>(processorToBeRemoved)) chain->masterEffects.removeObject(mep);
-			else if (MonophonicEffectProcessor* moep = dynamic_cast<MonophonicEffectProcessor*>(processorToBeRemoved)) chain->monoEffects.removeObject(moep);
-			else jassertfalse;
+			EffectProcessor* ep = dynamic_cast<EffectProcessor*>(processorToBeRemoved);
+
+			// The storage for the new effect lists is allocated here, so the audio thread doesn't need to (re)allocate
+			EffectLists spareLists(*chain);
+
+			// The effect is removed from the chain on the audio thread. This waits for it, so the caller 
+			// (eg. a script that sends a rebuild message afterwards) sees the new list when this returns.
+			chain->getMainController()->getCommandQueue().postCommandAndWait([this, ep, &spareLists]()
+			{
+				spareLists.swapWithListsWithoutEffect(*chain, ep);
+
+				jassert(chain->allEffects.size() == (chain->masterEffects.size() + chain->voiceEffects.size() + chain->monoEffects.size()));
+			});
 
-			jassert(chain->allEffects.size() == (chain->masterEffects.size() + chain->voiceEffects.size() + chain->monoEffects.size()));
+			if (spareLists.effectWasRemoved)
+				delete ep;
 
 			sendChangeMessage();
 		}
@@ -241,10 +273,18 @@ public:
 
 				if (indexOfProcessor != indexOfSwapProcessor)
 				{
-					ScopedLock sl(chain->getMainController()->getLock());
+					WeakReference<Processor> chainReference(chain);
+
+					chain->getMainController()->getCommandQueue().postCommand([chainReference, indexOfProcessor, indexOfSwapProcessor, indexOfProcessorInAllEffects, indexOfSwapProcessorInAllEfects]()
+					{
+						EffectProcessorChain* c = static_cast<EffectProcessorChain*>(chainReference.get());
+
+						if (c == nullptr)
+							return;
 
-					chain->masterEffects.swap(indexOfProcessor, indexOfSwapProcessor);
-					chain->allEffects.swap(indexOfProcessorInAllEffects, indexOfSwapProcessorInAllEfects);
+						c->masterEffects.swap(indexOfProcessor, indexOfSwapProcessor);
+						c->allEffects.swap(indexOfProcessorInAllEffects, indexOfSwapProcessorInAllEfects);
+					});
 				}
 			}
 		}
@@ -311,10 +351,15 @@ public:
 
 		void clear() override
 		{
-			chain->voiceEffects.clear();
-			chain->masterEffects.clear();
-			chain->monoEffects.clear();
-			chain->allEffects.clear();
+			EffectLists emptyLists;
+
+			// The effects are removed on the audio thread and deleted here afterwards
+			chain->getMainController()->getCommandQueue().postCommandAndWait([this, &emptyLists]()
+			{
+				emptyLists.swapWith(*chain);
+			});
+
+			emptyLists.deleteEffects();
 
 			sendChangeMessage();
 		}
@@ -330,6 +375,90 @@ public:
 
 private:
 
+	/** A set of effect lists that is used to remove an effect on the audio thread without (de)allocating.
+	*
+	*	The storage is allocated on the message thread. The audio thread copies the remaining effects into these lists 
+	*	and swaps them with the lists of the chain, so the old lists will be released on the message thread.
+	*/
+	struct EffectLists
+	{
+		EffectLists() {};
+
+		EffectLists(const EffectProcessorChain& c)
+		{
+			voiceEffects.ensureStorageAllocated(c.voiceEffects.size() + extraCapacity);
+			masterEffects.ensureStorageAllocated(c.masterEffects.size() + extraCapacity);
+			monoEffects.ensureStorageAllocated(c.monoEffects.size() + extraCapacity);
+			allEffects.ensureStorageAllocated(c.allEffects.size() + extraCapacity);
+		}
+
+		~EffectLists()
+		{
+			// The effects are owned by the chain or deleted separately
+			voiceEffects.clear(false);
+			masterEffects.clear(false);
+			monoEffects.clear(false);
+		}
+
+		/** Call this on the audio thread. */
+		void swapWithListsWithoutEffect(EffectProcessorChain& c, EffectProcessor* effectToRemove)
+		{
+			effectWasRemoved = copyWithoutEffect(c.allEffects, allEffects, effectToRemove);
+
+			copyWithoutEffect(c.voiceEffects, voiceEffects, effectToRemove);
+			copyWithoutEffect(c.masterEffects, masterEffects, effectToRemove);
+			copyWithoutEffect(c.monoEffects, monoEffects, effectToRemove);
+
+			swapWith(c);
+		}
+
+		/** Call this on the audio thread. */
+		void swapWith(EffectProcessorChain& c)
+		{
+			c.allEffects.swapWith(allEffects);
+			c.voiceEffects.swapWith(voiceEffects);
+			c.masterEffects.swapWith(masterEffects);
+			c.monoEffects.swapWith(monoEffects);
+		}
+
+		/** Deletes the effects that were swapped out of the chain. */
+		void deleteEffects()
+		{
+			allEffects.clear();
+			voiceEffects.clear(true);
+			masterEffects.clear(true);
+			monoEffects.clear(true);
+		}
+
+		template <class ListType> static bool copyWithoutEffect(const ListType& source, ListType& destination, EffectProcessor* effectToSkip)
+		{
+			bool found = false;
+
+			for (int i = 0; i < source.size(); i++)
+			{
+				if (static_cast<EffectProcessor*>(source.getUnchecked(i)) == effectToSkip)
+				{
+					found = true;
+					continue;
+				}
+
+				destination.add(source.getUnchecked(i));
+			}
+
+			return found;
+		}
+
+		/** Leaves some room for effects that are added before the removal is executed. */
+		static const int extraCapacity = 8;
+
+		OwnedArray<VoiceEffectProcessor> voiceEffects;
+		OwnedArray<MasterEffectProcessor> masterEffects;
+		OwnedArray<MonophonicEffectProcessor> monoEffects;
+		Array<EffectProcessor*> allEffects;
+
+		bool effectWasRemoved = false;
+	};
+
 	// This is used for getBufferForChain
 	AudioSampleBuffer emptyBuffer;
 
@@ -360,6 +489,7 @@ public:
 		curveEq,
 		stereoEffect,
 		simpleReverb,
+		fdnReverb,
 		simpleGain,
 		convolution,
 		delay,
@@ -81,6 +81,11 @@ void ModulatorChain::handleHiseEvent(const HiseEvent &m)
 	for(int i = 0; i < variantModulators.size(); i++) variantModulators[i]->handleHiseEvent(m);
 };
 
+void ModulatorChain::handleNoteExpression(int voiceIndex, const HiseEvent& e)
+{
+	for (int i = 0; i < envelopeModulators.size(); i++) envelopeModulators[i]->handleNoteExpression(voiceIndex, e);
+}
+
 
 float ModulatorChain::getConstantVoiceValue(int voiceIndex) const
 {
@@ -272,20 +277,20 @@ void ModulatorChain::ModulatorChainHandler::add(Processor *newProcessor, Process
 
 	jassert(dynamic_cast<Modulator*>(newProcessor) != nullptr);
 
-	dynamic_cast<AudioProcessor*>(chain->getMainController())->suspendProcessing(true);
+	{
+		MainController::ScopedSuspender ss(chain->getMainController());
 
-	addModulator(dynamic_cast<Modulator*>(newProcessor), siblingToInsertBefore);
+		addModulator(dynamic_cast<Modulator*>(newProcessor), siblingToInsertBefore);
 
-	const bool isPitchChain = chain->getMode() == Modulation::PitchMode;
-	if (isPitchChain)
-	{
-		ModulatorSynth *p = dynamic_cast<ModulatorSynth*>(chain->getParentProcessor());
+		const bool isPitchChain = chain->getMode() == Modulation::PitchMode;
+		if (isPitchChain)
+		{
+			ModulatorSynth *p = dynamic_cast<ModulatorSynth*>(chain->getParentProcessor());
 
-		if(p != nullptr) p->enablePitchModulation(true);
+			if(p != nullptr) p->enablePitchModulation(true);
+		}
 	}
 
-	dynamic_cast<AudioProcessor*>(chain->getMainController())->suspendProcessing(false);
-
 	sendChangeMessage();
 }
 
@@ -386,6 +391,7 @@ ProcessorEditorBody *ModulatorChain::createEditor(ProcessorEditor *parentEditor)
 void ModulatorChain::renderVoice(int voiceIndex, int startSample, int numSamples)
 {
     ADD_GLITCH_DETECTOR(parentProcessor, DebugLogger::Location::ModulatorChainVoiceRendering);
+	ADD_CPU_COUNTER(this);
     
 	// Use the internal buffer from timeModulation as working buffer.
 
@@ -425,6 +431,8 @@ void ModulatorChain::renderVoice(int voiceIndex, int startSample, int numSamples
 		
 			if(m->isBypassed() ) continue;
 
+			ADD_CPU_COUNTER(m);
+
 			m->polyManager.setCurrentVoice(voiceIndex);
 
 			FloatVectorOperations::fill(envelopeTempBuffer.getWritePointer(0, startSample), 1.0f, numSamples);
@@ -463,6 +471,7 @@ void ModulatorChain::renderNextBlock(AudioSampleBuffer& buffer, int startSample,
 
 	{
 		ADD_GLITCH_DETECTOR(parentProcessor, DebugLogger::Location::ModulatorChainTimeVariantRendering);
+		ADD_CPU_COUNTER(this);
 
 		jassert(getSampleRate() > 0);
 
@@ -475,6 +484,8 @@ void ModulatorChain::renderNextBlock(AudioSampleBuffer& buffer, int startSample,
 			for (int i = 0; i < variantModulators.size(); i++)
 			{
 				if (variantModulators[i]->isBypassed()) continue;
+
+				ADD_CPU_COUNTER(variantModulators[i]);
 				variantModulators[i]->renderNextBlock(internalBuffer, startSample, numSamples);
 			}
 		}
@@ -142,6 +142,9 @@ public:
 	*/
 	void handleHiseEvent(const HiseEvent& m) override;
 
+	/** Sends the NoteExpression event to all envelope modulators for the given voice. */
+	void handleNoteExpression(int voiceIndex, const HiseEvent& e) override;
+
 	/** Checks if any of the EnvelopeModulators wants to keep the voice from being killed. 
 	*
 	*	If no envelopes are active, it checks if the voice was recently started or stopped using an internal array.
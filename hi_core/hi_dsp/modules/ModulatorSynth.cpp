@@ -54,6 +54,7 @@ pitchModulationActive(false)
 	pitchBuffer = AudioSampleBuffer(1, 0);
 	internalBuffer = AudioSampleBuffer(2, 0);
 	gainBuffer = AudioSampleBuffer(1, 0);
+	latencyCompensationBuffer = AudioSampleBuffer(1, 0);
 
 	for (int i = 0; i < 4; i++)
 	{
@@ -322,6 +323,7 @@ void ModulatorSynth::renderNextBlockWithModulators(AudioSampleBuffer& outputBuff
 	jassert(isOnAir());
 
     ADD_GLITCH_DETECTOR(this, DebugLogger::Location::SynthRendering);
+	ADD_CPU_COUNTER(this);
     
 	int numSamples = getBlockSize(); //outputBuffer.getNumSamples();
 
@@ -345,6 +347,16 @@ void ModulatorSynth::renderNextBlockWithModulators(AudioSampleBuffer& outputBuff
 	HiseEvent m;
 	int midiEventPos;
 
+	// Groups render the gain chains of their child synths in postVoiceRendering, so they always split the block
+	const bool useSampleAccurateControllers = getMainController()->isUsingSampleAccurateControllers() && 
+											  !ProcessorHelpers::is<ModulatorSynthGroup>(this);
+
+	if (useSampleAccurateControllers)
+	{
+		renderWithSampleAccurateControllers(eventIterator, numSamples);
+		numSamples = 0;
+	}
+
 	while (numSamples > 0)
 	{
 		if (!eventIterator.getNextEvent(m, midiEventPos, true, false))
@@ -398,6 +410,8 @@ void ModulatorSynth::renderNextBlockWithModulators(AudioSampleBuffer& outputBuff
 
 	effectChain->renderMasterEffects(internalBuffer);
 
+	applyLatencyCompensation(numSamplesFixed);
+
 	for (int i = 0; i < internalBuffer.getNumChannels(); i++)
 	{
 		const int destinationChannel = getMatrix().getConnectionForSourceChannel(i);
@@ -438,9 +452,101 @@ void ModulatorSynth::preVoiceRendering(int startSample, int numThisTime)
 
 	CHECK_AND_LOG_BUFFER_DATA_WITH_ID(this, getIDAsIdentifier(), DebugLogger::Location::SynthPreVoiceRendering, pitchBuffer.getReadPointer(0, startSample), true, numThisTime);
 
+	// The controller events are handled between the preVoiceRendering calls, so the gain values must be calculated here too
+	if (gainValuesPrecalculated)
+		gainChain->renderNextBlock(gainBuffer, startSample, numThisTime);
+
 	if (!isChainDisabled(EffectChain)) effectChain->preRenderCallback(startSample, numThisTime);
 }
 
+bool ModulatorSynth::isBlockSplittingEvent(const HiseEvent& e) noexcept
+{
+	if (e.isController())
+	{
+		// The pedals start or stop voices
+		const int number = e.getControllerNumber();
+		return number == 0x40 || number == 0x42 || number == 0x43;
+	}
+
+	return !(e.isPitchWheel() || e.isAftertouch() || e.isNoteExpression());
+}
+
+void ModulatorSynth::renderWithSampleAccurateControllers(HiseEventBuffer::Iterator& eventIterator, int numSamples)
+{
+	gainValuesPrecalculated = true;
+
+	HiseEvent m;
+	int midiEventPos;
+
+	int startSample = 0;
+
+	// The position until the time variant modulation is calculated.
+	int modulationPosition = 0;
+
+	bool hasEventAtEndOfBlock = false;
+
+	while (eventIterator.getNextEvent(m, midiEventPos, true, false))
+	{
+		midiEventPos = jlimit<int>(startSample, numSamples, midiEventPos);
+
+		if (!isBlockSplittingEvent(m))
+		{
+			if (midiEventPos > modulationPosition)
+			{
+				preVoiceRendering(modulationPosition, midiEventPos - modulationPosition);
+				modulationPosition = midiEventPos;
+			}
+
+			handleHiseEvent(m);
+			continue;
+		}
+
+		// Use the same raster as the splitting mode for the note events
+		const int samplesToNextMidiMessage = midiEventPos - startSample;
+		const int rastered = samplesToNextMidiMessage - (samplesToNextMidiMessage % 8);
+
+		if (rastered < 32 || startSample + rastered >= numSamples)
+		{
+			if (rastered < 32)
+			{
+				handleHiseEvent(m);
+				continue;
+			}
+
+			hasEventAtEndOfBlock = true;
+			break;
+		}
+
+		const int boundary = startSample + rastered;
+
+		if (boundary > modulationPosition)
+		{
+			preVoiceRendering(modulationPosition, boundary - modulationPosition);
+			modulationPosition = boundary;
+		}
+
+		renderVoice(startSample, rastered);
+		postVoiceRendering(startSample, rastered);
+
+		handleHiseEvent(m);
+		startSample = boundary;
+	}
+
+	if (modulationPosition < numSamples)
+		preVoiceRendering(modulationPosition, numSamples - modulationPosition);
+
+	if (startSample < numSamples)
+	{
+		renderVoice(startSample, numSamples - startSample);
+		postVoiceRendering(startSample, numSamples - startSample);
+	}
+
+	if (hasEventAtEndOfBlock)
+		handleHiseEvent(m);
+
+	gainValuesPrecalculated = false;
+}
+
 void ModulatorSynth::renderVoice(int startSample, int numThisTime)
 {
     ADD_GLITCH_DETECTOR(this, DebugLogger::Location::SynthVoiceRendering);
@@ -476,7 +582,8 @@ void ModulatorSynth::renderVoice(int startSample, int numThisTime)
 void ModulatorSynth::postVoiceRendering(int startSample, int numThisTime)
 {
 	// Calculate the timeVariant modulators
-	gainChain->renderNextBlock(gainBuffer, startSample, numThisTime);
+	if (!gainValuesPrecalculated)
+		gainChain->renderNextBlock(gainBuffer, startSample, numThisTime);
 
 	CHECK_AND_LOG_BUFFER_DATA_WITH_ID(this, getIDAsIdentifier(), DebugLogger::Location::SynthPostVoiceRenderingGainMod, gainBuffer.getReadPointer(0, startSample), true, numThisTime);
 
@@ -495,15 +602,15 @@ void ModulatorSynth::handlePeakDisplay(int numSamplesInOutputBuffer)
 {
 #if ENABLE_ALL_PEAK_METERS
 	
-	currentValues.outL = gain * internalBuffer.getMagnitude(0, 0, numSamplesInOutputBuffer) * leftBalanceGain;
-	currentValues.outR = gain * internalBuffer.getMagnitude(1, 0, numSamplesInOutputBuffer) * rightBalanceGain;
+	addPeakMeterBlock(internalBuffer.getReadPointer(0), internalBuffer.getReadPointer(1), numSamplesInOutputBuffer, 
+					  gain * leftBalanceGain, gain * rightBalanceGain);
 	
 #else
 
 	if (this == getMainController()->getMainSynthChain())
 	{
-		currentValues.outL = gain * internalBuffer.getMagnitude(0, 0, numSamplesInOutputBuffer) * leftBalanceGain;
-		currentValues.outR = gain * internalBuffer.getMagnitude(1, 0, numSamplesInOutputBuffer) * rightBalanceGain;
+		addPeakMeterBlock(internalBuffer.getReadPointer(0), internalBuffer.getReadPointer(1), numSamplesInOutputBuffer,
+						  gain * leftBalanceGain, gain * rightBalanceGain);
 	}
 
 #endif
@@ -512,8 +619,7 @@ void ModulatorSynth::handlePeakDisplay(int numSamplesInOutputBuffer)
 
 void ModulatorSynth::setPeakValues(float l, float r)
 {
-	currentValues.outL = l;
-	currentValues.outR = r;
+	addPeakMeterValues(l, r, getBlockSize());
 }
 
 void ModulatorSynth::handleHiseEvent(const HiseEvent& m)
@@ -568,6 +674,10 @@ void ModulatorSynth::handleHiseEvent(const HiseEvent& m)
 	{
 		handlePitchFade(m.getEventId(), m.getFadeTime(), m.getPitchFactorForEvent());
 	}
+	else if (m.isNoteExpression())
+	{
+		handleNoteExpression(m);
+	}
 }
 
 void ModulatorSynth::handleHostInfoHiseEvents()
@@ -631,11 +741,11 @@ void ModulatorSynth::handleVolumeFade(int eventId, int fadeTimeMilliseconds, flo
 {
 	const double fadeTimeSeconds = (double)fadeTimeMilliseconds / 1000.0;
 
-	for (int i = voices.size(); --i >= 0;)
+	for (int i = eventIdVoiceMap.getFirstVoice((uint16)eventId); i != -1; i = eventIdVoiceMap.getNextVoice(i))
 	{
 		ModulatorSynthVoice *v = static_cast<ModulatorSynthVoice*>(voices[i]);
 
-		if (!v->isInactive() && v->getCurrentHiseEvent().getEventId() == eventId)
+		if (eventIdVoiceMap.getEventId(i) == eventId && !v->isInactive() && v->getCurrentHiseEvent().getEventId() == eventId)
 		{
 			v->setVolumeFade(fadeTimeSeconds, targetGain);
 		}
@@ -646,17 +756,36 @@ void ModulatorSynth::handlePitchFade(uint16 eventId, int fadeTimeMilliseconds, d
 {
 	const double fadeTimeSeconds = (double)fadeTimeMilliseconds / 1000.0;
 
-	for (int i = voices.size(); --i >= 0;)
+	for (int i = eventIdVoiceMap.getFirstVoice(eventId); i != -1; i = eventIdVoiceMap.getNextVoice(i))
 	{
 		ModulatorSynthVoice *v = static_cast<ModulatorSynthVoice*>(voices[i]);
 
-		if (!v->isInactive() && v->getCurrentHiseEvent().getEventId() == eventId)
+		if (eventIdVoiceMap.getEventId(i) == eventId && !v->isInactive() && v->getCurrentHiseEvent().getEventId() == eventId)
 		{
 			v->setPitchFade(fadeTimeSeconds, pitchFactor);
 		}
 	}
 }
 
+void ModulatorSynth::handleNoteExpression(const HiseEvent& e)
+{
+	const uint16 eventId = e.getEventId();
+	const int pitchBendRange = getMainController()->getEventHandler().getMpePitchBendRange();
+
+	for (int i = eventIdVoiceMap.getFirstVoice(eventId); i != -1; i = eventIdVoiceMap.getNextVoice(i))
+	{
+		ModulatorSynthVoice *v = static_cast<ModulatorSynthVoice*>(voices[i]);
+
+		if (eventIdVoiceMap.getEventId(i) == eventId && !v->isInactive() && v->getCurrentHiseEvent().getEventId() == eventId)
+		{
+			v->setNoteExpression(e, pitchBendRange);
+
+			gainChain->handleNoteExpression(i, e);
+			pitchChain->handleNoteExpression(i, e);
+		}
+	}
+}
+
 void ModulatorSynth::preHiseEventCallback(const HiseEvent &e)
 {
 	if (e.isAllNotesOff())
@@ -686,10 +815,14 @@ void ModulatorSynth::startVoiceWithHiseEvent(ModulatorSynthVoice* voice, Synthes
 	
 	voice->setCurrentHiseEvent(e);
 
+	eventIdVoiceMap.addVoice(e.getEventId(), voice->getVoiceIndex());
+
 	jassert(!activeVoices.contains(voice));
 
 	activeVoices.insert(voice);
 
+	getMainController()->getDebugLogger().traceVoice(true, this, voice->getVoiceIndex(), e.getNoteNumber());
+
 	Synthesiser::startVoice(static_cast<SynthesiserVoice*>(voice), sound, e.getChannel(), e.getNoteNumber(), e.getFloatVelocity());
 }
 
@@ -716,6 +849,7 @@ void ModulatorSynth::prepareToPlay(double newSampleRate, int samplesPerBlock)
 		ProcessorHelpers::increaseBufferIfNeeded(pitchBuffer, samplesPerBlock);
 		ProcessorHelpers::increaseBufferIfNeeded(gainBuffer, samplesPerBlock);
 		ProcessorHelpers::increaseBufferIfNeeded(internalBuffer, samplesPerBlock);
+		ProcessorHelpers::increaseBufferIfNeeded(latencyCompensationBuffer, samplesPerBlock);
 		
 		for(int i = 0; i < getNumVoices(); i++)
 		{
@@ -761,6 +895,9 @@ void ModulatorSynth::numSourceChannelsChanged()
 			rp->getMatrix().setNumDestinationChannels(getMatrix().getNumSourceChannels());
 		}
 	}
+
+	// Creates the delay lines for the new channel amount
+	setLatencyCompensation(latencyCompensation);
 }
 
 void ModulatorSynth::numDestinationChannelsChanged()
@@ -777,12 +914,75 @@ void ModulatorSynth::numDestinationChannelsChanged()
 	}
 }
 
+void ModulatorSynth::setLatencyCompensation(int numSamples)
+{
+	const ScopedLock sl(isOnAir() ? getSynthLock() : getDummyLockWhenNotOnAir());
+
+	numSamples = jmax<int>(0, numSamples);
+
+	if (numSamples == 0)
+	{
+		latencyCompensation = 0;
+		return;
+	}
+
+	const int numChannels = getMatrix().getNumSourceChannels();
+	bool fadeToNewDelay = latencyCompensation > 0;
+
+	if (latencyCompensationDelays.size() != numChannels || latencyCompensationDelays[0]->getMaxDelaySamples() < numSamples)
+	{
+		latencyCompensationDelays.clear();
+
+		for (int i = 0; i < numChannels; i++)
+			latencyCompensationDelays.add(new ModulatedDelayLine(numSamples * 2));
+
+		fadeToNewDelay = false;
+	}
+
+	for (int i = 0; i < latencyCompensationDelays.size(); i++)
+	{
+		latencyCompensationDelays[i]->setDelayTimeSamples(numSamples);
+
+		// A delay line that wasn't used yet starts with the new delay time instead of fading from the old one
+		if (!fadeToNewDelay)
+			latencyCompensationDelays[i]->clear();
+	}
+
+	latencyCompensation = numSamples;
+}
+
+void ModulatorSynth::applyLatencyCompensation(int numSamples)
+{
+	if (latencyCompensation == 0)
+		return;
+
+	jassert(numSamples <= latencyCompensationBuffer.getNumSamples());
+
+	float* delayed = latencyCompensationBuffer.getWritePointer(0);
+
+	const int numChannels = jmin<int>(internalBuffer.getNumChannels(), latencyCompensationDelays.size());
+
+	for (int i = 0; i < numChannels; i++)
+	{
+		float* data = internalBuffer.getWritePointer(i, 0);
+
+		latencyCompensationDelays[i]->processWithFeedback(data, delayed, numSamples, 0.0f);
+		FloatVectorOperations::copy(data, delayed, numSamples);
+	}
+}
+
 void ModulatorSynth::setBypassed(bool shouldBeBypassed, NotificationType notifyChangeHandler) noexcept
 {
 	ScopedLock sl(getSynthLock());
 
+	const bool bypassStateChanged = shouldBeBypassed != isBypassed();
+
 	Processor::setBypassed(shouldBeBypassed, notifyChangeHandler);
 
+	// The effects of this synth are no longer part of the signal path
+	if (bypassStateChanged)
+		getMainController()->updateLatency();
+
 	midiProcessorChain->sendAllNoteOffEvent();
 
 	for (int i = 0; i < getNumInternalChains(); i++)
@@ -969,10 +1169,15 @@ int ModulatorSynth::getIndexInGroup() const
 
 void ModulatorSynthVoice::resetVoice()
 {
-	clearCurrentNote();
-
 	ModulatorSynth *os = getOwnerSynth();
 
+	if (getCurrentlyPlayingNote() != -1)
+		os->getMainController()->getDebugLogger().traceVoice(false, os, voiceIndex, getCurrentlyPlayingNote());
+
+	os->removeVoiceFromEventIdMap(voiceIndex);
+
+	clearCurrentNote();
+
 	ModulatorChain *g = static_cast<ModulatorChain*>(os->getChildProcessor(ModulatorSynth::GainModulation));
 	ModulatorChain *p = static_cast<ModulatorChain*>(os->getChildProcessor(ModulatorSynth::PitchModulation));
 	EffectProcessorChain *e = static_cast<EffectProcessorChain*>(os->getChildProcessor(ModulatorSynth::EffectChain));
@@ -1194,6 +1399,13 @@ void ModulatorSynthVoice::setCurrentHiseEvent(const HiseEvent &m)
 	eventGainFactor = m.getGainFactor();
 	eventPitchFactor = m.getPitchFactorForEvent();
 	scriptPitchActive = eventPitchFactor != 1.0;
+
+	for (int i = 0; i < (int)HiseEvent::ExpressionType::numExpressionTypes; i++)
+		noteExpressionValues[i] = 0.0f;
+
+	expressionPitchFactor = 1.0;
+	expressionPitchTarget = 1.0;
+	expressionPitchActive = false;
 }
 
 void ModulatorSynthChainFactoryType::fillTypeNameList()
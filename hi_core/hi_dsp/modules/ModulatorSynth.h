@@ -184,6 +184,15 @@ public:
 	void handleVolumeFade(int eventId, int fadeTimeMilliseconds, float gain);
 	void handlePitchFade(uint16 eventId, int fadeTimeMilliseconds, double pitchFactor);
 
+	/** Sends the per-note expression to the voices that play the event and their modulation chains. */
+	void handleNoteExpression(const HiseEvent& e);
+
+	/** Checks if the event must split the audio block when the sample accurate controller mode is enabled. */
+	static bool isBlockSplittingEvent(const HiseEvent& e) noexcept;
+
+	/** Removes the voice from the event ID lookup. This is called when the voice is reset. */
+	void removeVoiceFromEventIdMap(int voiceIndex) noexcept { eventIdVoiceMap.removeVoice(voiceIndex); }
+
 	virtual void preHiseEventCallback(const HiseEvent &e);
 	virtual void preStartVoice(int voiceIndex, int noteNumber);
 
@@ -207,6 +216,16 @@ public:
 
 	// ===================================================================================================================
 
+	/** Delays the output of this synth so that it lines up with sibling synths that have a higher latency.
+	*
+	*	This is set by the MainController whenever the latency of an effect changes (see MainController::updateLatency()).
+	*/
+	void setLatencyCompensation(int numSamples);
+
+	int getLatencyCompensation() const noexcept { return latencyCompensation; }
+
+	// ===================================================================================================================
+
 	void enablePitchModulation(bool shouldBeEnabled);
 	bool isPitchModulationActive() const noexcept;
 
@@ -226,6 +245,7 @@ public:
     {
         ScopedLock sl(lock);
         activeVoices.clear();
+        eventIdVoiceMap = EventIdVoiceMap();
         clearVoices();
     }
     
@@ -389,10 +409,104 @@ protected:
 	// Used to display the playing position
 	ModulatorSynthVoice *lastStartedVoice;
 
+	/** Delays the internal buffer by the latency compensation. Call this after the master effects are rendered. */
+	void applyLatencyCompensation(int numSamples);
+
 private:
 
+	/** Renders the block and only splits it at note events. 
+	*
+	*	The controller events are handled between the calculation of the time variant modulation, 
+	*	so their changes are sample accurate without rendering the voices in small chunks.
+	*/
+	void renderWithSampleAccurateControllers(HiseEventBuffer::Iterator& eventIterator, int numSamples);
+
+	bool gainValuesPrecalculated = false;
+
+	int latencyCompensation = 0;
+	OwnedArray<ModulatedDelayLine> latencyCompensationDelays;
+	AudioSampleBuffer latencyCompensationBuffer;
+
+	/** A allocation free lookup from event IDs to the voice indexes that play them.
+	*
+	*	The event IDs are hashed into buckets and the voices of one bucket are chained, so finding the voices
+	*	for an event ID doesn't need to look at all voices.
+	*/
+	class EventIdVoiceMap
+	{
+	public:
+
+		EventIdVoiceMap()
+		{
+			for (int i = 0; i < NumBuckets; i++)
+				buckets[i] = -1;
+
+			for (int i = 0; i < NUM_POLYPHONIC_VOICES; i++)
+			{
+				nextVoice[i] = -1;
+				voiceEventIds[i] = 0;
+				registered[i] = false;
+			}
+		}
+
+		void addVoice(uint16 eventId, int voiceIndex) noexcept
+		{
+			if (!isPositiveAndBelow(voiceIndex, NUM_POLYPHONIC_VOICES))
+				return;
+
+			removeVoice(voiceIndex);
+
+			int16& head = buckets[eventId & (NumBuckets - 1)];
+
+			nextVoice[voiceIndex] = head;
+			head = (int16)voiceIndex;
+			voiceEventIds[voiceIndex] = eventId;
+			registered[voiceIndex] = true;
+		}
+
+		void removeVoice(int voiceIndex) noexcept
+		{
+			if (!isPositiveAndBelow(voiceIndex, NUM_POLYPHONIC_VOICES) || !registered[voiceIndex])
+				return;
+
+			int16* current = &buckets[voiceEventIds[voiceIndex] & (NumBuckets - 1)];
+
+			while (*current != -1)
+			{
+				if (*current == voiceIndex)
+				{
+					*current = nextVoice[voiceIndex];
+					break;
+				}
+
+				current = &nextVoice[*current];
+			}
+
+			nextVoice[voiceIndex] = -1;
+			registered[voiceIndex] = false;
+		}
+
+		/** Returns the first voice in the bucket of the event ID or -1. You have to check the event ID of the voice. */
+		int getFirstVoice(uint16 eventId) const noexcept { return buckets[eventId & (NumBuckets - 1)]; }
+
+		int getNextVoice(int voiceIndex) const noexcept { return nextVoice[voiceIndex]; }
+
+		uint16 getEventId(int voiceIndex) const noexcept { return voiceEventIds[voiceIndex]; }
+
+	private:
+
+		enum { NumBuckets = 256 };
+
+		int16 buckets[NumBuckets];
+		int16 nextVoice[NUM_POLYPHONIC_VOICES];
+		uint16 voiceEventIds[NUM_POLYPHONIC_VOICES];
+		bool registered[NUM_POLYPHONIC_VOICES];
+	};
+
 	// ===================================================================================================================
 
+	EventIdVoiceMap eventIdVoiceMap;
+
 	UnorderedStack<ModulatorSynthVoice*> activeVoices;
 
 	Colour iconColour;
@@ -454,6 +568,9 @@ public:
 		isTailing(false)
 	{
 		voiceBuffer = AudioSampleBuffer(2, 0);
+
+		for (int i = 0; i < (int)HiseEvent::ExpressionType::numExpressionTypes; i++)
+			noteExpressionValues[i] = 0.0f;
 	};
 
 	/** If not overriden, this uses a sine generator for an example usage of this voice class. */
@@ -474,7 +591,9 @@ public:
 
 			float eventPitchFactorFloat = (float)eventPitchFactor;
 
-			while (--numSamples >= 0)
+			int numToFade = numSamples;
+
+			while (--numToFade >= 0)
 			{
 				eventPitchFactor = pitchFader.getNextValue();
 				*pitchValues++ *= eventPitchFactorFloat;
@@ -486,6 +605,25 @@ public:
 
 			FloatVectorOperations::multiply(pitchValues, (float)eventPitchFactor, numSamples);
 		}
+
+		if (expressionPitchActive)
+		{
+			float* pitchValues = getVoicePitchValues() + startSample;
+
+			// Ramp to the new per-note bend over the block to avoid zipper noise
+			float factor = (float)expressionPitchFactor;
+			const float delta = numSamples > 0 ? (float)(expressionPitchTarget - expressionPitchFactor) / (float)numSamples : 0.0f;
+
+			int numToRamp = numSamples;
+
+			while (--numToRamp >= 0)
+			{
+				*pitchValues++ *= factor;
+				factor += delta;
+			}
+
+			expressionPitchFactor = expressionPitchTarget;
+		}
 	}
 
 	
@@ -511,6 +649,34 @@ public:
 
 	const HiseEvent &getCurrentHiseEvent() const { return currentHiseEvent; }
 
+	/** Stores the per-note expression value of the NoteExpression event. A pitch bend is applied to the voice pitch. */
+	void setNoteExpression(const HiseEvent& e, int pitchBendRangeSemitones)
+	{
+		jassert(e.isNoteExpression());
+
+		const int index = (int)e.getExpressionType();
+
+		if (!isPositiveAndBelow(index, (int)HiseEvent::ExpressionType::numExpressionTypes))
+			return;
+
+		noteExpressionValues[index] = e.getNormalisedExpressionValue();
+
+		if (e.getExpressionType() == HiseEvent::ExpressionType::PitchBend)
+		{
+			const double semitones = (double)noteExpressionValues[index] * (double)pitchBendRangeSemitones;
+
+			expressionPitchTarget = pow(2.0, semitones / 12.0);
+			expressionPitchActive = true;
+		}
+	}
+
+	/** Returns the last value of the per-note expression (-1...1 for the pitch bend, 0...1 for the others). */
+	float getNoteExpressionValue(HiseEvent::ExpressionType type) const noexcept
+	{
+		const int index = (int)type;
+		return isPositiveAndBelow(index, (int)HiseEvent::ExpressionType::numExpressionTypes) ? noteExpressionValues[index] : 0.0f;
+	}
+
 	/** This calculates the angle delta. For this synth, it detects the sine frequency, but you can override it to make something else. */
 	virtual void startNote (int /*midiNoteNumber*/, float /*velocity*/, SynthesiserSound* , int /*currentPitchWheelPosition*/)
 	{
@@ -643,7 +809,7 @@ public:
 
 	void enablePitchModulation(bool shouldBeEnabled) noexcept{ pitchModulationActive = shouldBeEnabled; }
 
-	bool isPitchModulationActive() const noexcept{ return pitchModulationActive || scriptPitchActive; }
+	bool isPitchModulationActive() const noexcept{ return pitchModulationActive || scriptPitchActive || expressionPitchActive; }
 
 	void setScriptGainValue(float newGainValue) { scriptGainValue = newGainValue; }
 	void setScriptPitchValue(float newPitchValue) { scriptPitchValue = newPitchValue; }
@@ -724,6 +890,11 @@ private:
 	bool pitchModulationActive = false;
 	bool scriptPitchActive = false;
 
+	float noteExpressionValues[(int)HiseEvent::ExpressionType::numExpressionTypes];
+	double expressionPitchFactor = 1.0;
+	double expressionPitchTarget = 1.0;
+	bool expressionPitchActive = false;
+
 	friend class ModulatorSynthGroupVoice;
 
 	bool killThisVoice;
@@ -93,6 +93,7 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 	if (isBypassed()) return;
 
 	ADD_GLITCH_DETECTOR(this, DebugLogger::Location::SynthChainRendering);
+	ADD_CPU_COUNTER(this);
 
 	ScopedLock sl(getSynthLock());
 
@@ -149,6 +150,8 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 
 	effectChain->renderMasterEffects(internalBuffer);
 
+	applyLatencyCompensation(numSamples);
+
 	if (internalBuffer.getNumChannels() != 2)
 	{
 		jassert(internalBuffer.getNumChannels() == getMatrix().getNumSourceChannels());
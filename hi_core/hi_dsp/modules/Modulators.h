@@ -748,6 +748,13 @@ public:
 		}
 	}
 
+	/** Overwrite this to react on per-note expression. 
+	*
+	*	The synth calls this for every voice that plays the note of the NoteExpression event, so unlike
+	*	handleHiseEvent() you can use the voice index here.
+	*/
+	virtual void handleNoteExpression(int /*voiceIndex*/, const HiseEvent& /*e*/) {}
+
 	Processor *getProcessor() override { return this; };
 
 	virtual void prepareToPlay(double sampleRate, int samplesPerBlock) override
@@ -41,8 +41,10 @@
 
 #include "sampler/ModulatorSamplerData.cpp"
 #include "sampler/ModulatorSamplerSound.cpp"
+#include "sampler/FlatSampleMap.cpp"
 #include "sampler/ModulatorSamplerVoice.cpp"
 #include "sampler/ModulatorSampler.cpp"
+#include "sampler/WaveformPeakCache.cpp"
 
 #if USE_BACKEND
 
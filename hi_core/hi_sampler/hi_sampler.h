@@ -41,8 +41,10 @@
 
 #include "sampler/ModulatorSamplerData.h"
 #include "sampler/ModulatorSamplerSound.h"
+#include "sampler/FlatSampleMap.h"
 #include "sampler/ModulatorSamplerVoice.h"
 #include "sampler/ModulatorSampler.h"
+#include "sampler/WaveformPeakCache.h"
 
 #if USE_BACKEND
 
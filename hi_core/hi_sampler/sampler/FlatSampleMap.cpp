@@ -0,0 +1,446 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+FlatSampleMap::FlatSampleMap(const void* data_, size_t numBytes) :
+	data(static_cast<const char*>(data_))
+{
+	validate(numBytes);
+}
+
+FlatSampleMap::FlatSampleMap(const File& f) :
+	mappedFile(new MemoryMappedFile(f, MemoryMappedFile::readOnly))
+{
+	data = static_cast<const char*>(mappedFile->getData());
+
+	validate(mappedFile->getSize());
+}
+
+int FlatSampleMap::getVersion() const noexcept
+{
+	return valid ? readInt(VersionOffset) : 0;
+}
+
+String FlatSampleMap::getId() const
+{
+	return getString(readInt(IdStringOffset));
+}
+
+String FlatSampleMap::getMicPositions() const
+{
+	return getString(readInt(MicPositionsStringOffset));
+}
+
+int FlatSampleMap::getSaveMode() const noexcept
+{
+	return readInt(SaveModeOffset);
+}
+
+int FlatSampleMap::getRRGroupAmount() const noexcept
+{
+	return readInt(RRGroupAmountOffset);
+}
+
+bool FlatSampleMap::usesGlobalFolder() const noexcept
+{
+	return (readInt(FlagsOffset) & UseGlobalFolder) != 0;
+}
+
+bool FlatSampleMap::hasMultiMicSounds() const noexcept
+{
+	return (readInt(FlagsOffset) & MultiMicSounds) != 0;
+}
+
+bool FlatSampleMap::hasProperty(int soundIndex, ModulatorSamplerSound::Property p) const noexcept
+{
+	const int slot = (int)p - (int)ModulatorSamplerSound::RootNote;
+
+	if (!isPositiveAndBelow(slot, numProperties)) return false;
+
+	const uint32 mask = ByteOrder::littleEndianInt(getRecord(soundIndex) + PropertyMaskOffset);
+
+	return (mask & (1u << slot)) != 0;
+}
+
+int FlatSampleMap::getProperty(int soundIndex, ModulatorSamplerSound::Property p) const noexcept
+{
+	if (!hasProperty(soundIndex, p)) return 0;
+
+	const int slot = (int)p - (int)ModulatorSamplerSound::RootNote;
+
+	return (int)ByteOrder::littleEndianInt(getRecord(soundIndex) + PropertiesOffset + slot * sizeof(int32));
+}
+
+float FlatSampleMap::getNormalizedPeak(int soundIndex) const noexcept
+{
+	union { uint32 asInt; float asFloat; } n;
+	n.asInt = ByteOrder::littleEndianInt(getRecord(soundIndex) + PropertiesOffset + numProperties * sizeof(int32));
+	return n.asFloat;
+}
+
+bool FlatSampleMap::isDuplicate(int soundIndex) const noexcept
+{
+	return (ByteOrder::littleEndianInt(getRecord(soundIndex) + SoundFlagsOffset) & Duplicate) != 0;
+}
+
+bool FlatSampleMap::hasMonolithInfo(int soundIndex) const noexcept
+{
+	return (ByteOrder::littleEndianInt(getRecord(soundIndex) + SoundFlagsOffset) & HasMonolithInfo) != 0;
+}
+
+int64 FlatSampleMap::getMonolithOffset(int soundIndex) const noexcept
+{
+	return (int64)ByteOrder::littleEndianInt64(getRecord(soundIndex) + recordSize - 24);
+}
+
+int64 FlatSampleMap::getMonolithLength(int soundIndex) const noexcept
+{
+	return (int64)ByteOrder::littleEndianInt64(getRecord(soundIndex) + recordSize - 16);
+}
+
+double FlatSampleMap::getMonolithSampleRate(int soundIndex) const noexcept
+{
+	union { uint64 asInt; double asDouble; } n;
+	n.asInt = ByteOrder::littleEndianInt64(getRecord(soundIndex) + recordSize - 8);
+	return n.asDouble;
+}
+
+String FlatSampleMap::getFileName(int soundIndex, int micIndex) const
+{
+	jassert(isPositiveAndBelow(soundIndex, numSounds) && isPositiveAndBelow(micIndex, numMics));
+
+	const int stringIndex = (int)ByteOrder::littleEndianInt(fileNameTable + (soundIndex * numMics + micIndex) * sizeof(int32));
+
+	return getString(stringIndex);
+}
+
+ValueTree FlatSampleMap::createValueTree() const
+{
+	if (!valid) return ValueTree();
+
+	ValueTree v("samplemap");
+
+	v.setProperty("ID", getId(), nullptr);
+	v.setProperty("SaveMode", getSaveMode(), nullptr);
+	v.setProperty("RRGroupAmount", getRRGroupAmount(), nullptr);
+	v.setProperty("MicPositions", getMicPositions(), nullptr);
+
+	if (usesGlobalFolder()) v.setProperty("UseGlobalFolder", true, nullptr);
+
+	const bool multiMic = hasMultiMicSounds();
+
+	for (int i = 0; i < numSounds; i++)
+	{
+		ValueTree sample("sample");
+
+		sample.setProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::ID), i, nullptr);
+
+		if (!multiMic)
+		{
+			sample.setProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::FileName), getFileName(i, 0), nullptr);
+		}
+
+		for (int p = ModulatorSamplerSound::RootNote; p < ModulatorSamplerSound::numProperties; p++)
+		{
+			const ModulatorSamplerSound::Property prop = (ModulatorSamplerSound::Property)p;
+
+			if (hasProperty(i, prop))
+				sample.setProperty(ModulatorSamplerSound::getPropertyName(prop), getProperty(i, prop), nullptr);
+		}
+
+		if (multiMic)
+		{
+			for (int j = 0; j < numMics; j++)
+			{
+				ValueTree fileChild("file");
+				fileChild.setProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::FileName), getFileName(i, j), nullptr);
+				sample.addChild(fileChild, -1, nullptr);
+			}
+		}
+
+		sample.setProperty("NormalizedPeak", getNormalizedPeak(i), nullptr);
+
+		if (hasMonolithInfo(i))
+		{
+			sample.setProperty("MonolithOffset", getMonolithOffset(i), nullptr);
+			sample.setProperty("MonolithLength", getMonolithLength(i), nullptr);
+			sample.setProperty("SampleRate", getMonolithSampleRate(i), nullptr);
+		}
+
+		sample.setProperty("Duplicate", isDuplicate(i), nullptr);
+
+		v.addChild(sample, -1, nullptr);
+	}
+
+	return v;
+}
+
+bool FlatSampleMap::isFlatSampleMap(const void* data, size_t numBytes)
+{
+	return data != nullptr && numBytes >= HeaderSize && ByteOrder::littleEndianInt(data) == magicNumber;
+}
+
+MemoryBlock FlatSampleMap::createFromValueTree(const ValueTree& sampleMap)
+{
+	static const Identifier monolithOffset("MonolithOffset");
+	static const Identifier monolithLength("MonolithLength");
+	static const Identifier sampleRate("SampleRate");
+	static const Identifier normalizedPeak("NormalizedPeak");
+	static const Identifier duplicate("Duplicate");
+
+	const Identifier fileName = ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::FileName);
+
+	StringArray strings;
+	HashMap<String, int> stringIndexes;
+
+	auto internString = [&](const String& s) -> int
+	{
+		if (s.isEmpty()) return -1;
+
+		if (stringIndexes.contains(s)) return stringIndexes[s];
+
+		const int index = strings.size();
+		strings.add(s);
+		stringIndexes.set(s, index);
+		return index;
+	};
+
+	const int numSounds = sampleMap.getNumChildren();
+	const int numProperties = getNumStoredProperties();
+
+	bool multiMic = false;
+	int numMics = 1;
+
+	for (int i = 0; i < numSounds; i++)
+	{
+		const int numChildren = sampleMap.getChild(i).getNumChildren();
+
+		if (numChildren != 0)
+		{
+			multiMic = true;
+			numMics = jmax<int>(numMics, numChildren);
+		}
+	}
+
+	int mapFlags = multiMic ? MultiMicSounds : 0;
+
+	if ((bool)sampleMap.getProperty("UseGlobalFolder", false)) mapFlags |= UseGlobalFolder;
+
+	MemoryOutputStream recordData;
+	MemoryOutputStream fileNameData;
+
+	for (int i = 0; i < numSounds; i++)
+	{
+		const ValueTree sample = sampleMap.getChild(i);
+
+		uint32 mask = 0;
+
+		for (int j = 0; j < numProperties; j++)
+		{
+			if (sample.hasProperty(ModulatorSamplerSound::getPropertyName((ModulatorSamplerSound::Property)(ModulatorSamplerSound::RootNote + j))))
+				mask |= (1u << j);
+		}
+
+		int soundFlags = (bool)sample.getProperty(duplicate, true) ? Duplicate : 0;
+
+		if (sample.hasProperty(monolithOffset)) soundFlags |= HasMonolithInfo;
+
+		recordData.writeInt((int)mask);
+		recordData.writeInt(soundFlags);
+
+		for (int j = 0; j < numProperties; j++)
+		{
+			const Identifier id = ModulatorSamplerSound::getPropertyName((ModulatorSamplerSound::Property)(ModulatorSamplerSound::RootNote + j));
+
+			recordData.writeInt((int)sample.getProperty(id, 0));
+		}
+
+		recordData.writeFloat((float)sample.getProperty(normalizedPeak, -1.0f));
+		recordData.writeInt(0);
+		recordData.writeInt64((int64)sample.getProperty(monolithOffset, 0));
+		recordData.writeInt64((int64)sample.getProperty(monolithLength, 0));
+		recordData.writeDouble((double)sample.getProperty(sampleRate, 0.0));
+
+		for (int j = 0; j < numMics; j++)
+		{
+			const String thisFileName = multiMic ? sample.getChild(j).getProperty(fileName).toString() :
+												   sample.getProperty(fileName).toString();
+
+			fileNameData.writeInt(internString(thisFileName));
+		}
+	}
+
+	const int idString = internString(sampleMap.getProperty("ID").toString());
+	const int micPositionsString = internString(sampleMap.getProperty("MicPositions").toString());
+
+	MemoryOutputStream stringData;
+	MemoryOutputStream stringOffsetData;
+
+	for (int i = 0; i < strings.size(); i++)
+	{
+		stringOffsetData.writeInt((int)stringData.getDataSize());
+		stringData.write(strings[i].toRawUTF8(), strings[i].getNumBytesAsUTF8() + 1);
+	}
+
+	MemoryOutputStream output;
+
+	output.writeInt((int)magicNumber);
+	output.writeInt(currentVersion);
+	output.writeInt(numSounds);
+	output.writeInt(numMics);
+	output.writeInt(mapFlags);
+	output.writeInt((int)sampleMap.getProperty("SaveMode", 0));
+	output.writeInt((int)sampleMap.getProperty("RRGroupAmount", 1));
+	output.writeInt(idString);
+	output.writeInt(micPositionsString);
+	output.writeInt(strings.size());
+	output.writeInt((int)stringData.getDataSize());
+	output.writeInt(numProperties);
+
+	jassert(output.getDataSize() == HeaderSize);
+	jassert(recordData.getDataSize() == (size_t)numSounds * getRecordSize(numProperties));
+
+	output << recordData.getMemoryBlock();
+	output << fileNameData.getMemoryBlock();
+	output << stringOffsetData.getMemoryBlock();
+	output << stringData.getMemoryBlock();
+
+	return output.getMemoryBlock();
+}
+
+ValueTree FlatSampleMap::createEmbeddedSampleMap(const ValueTree& sampleMap)
+{
+	ValueTree v("samplemap");
+
+	v.setProperty("ID", sampleMap.getProperty("ID"), nullptr);
+	v.setProperty("SaveMode", sampleMap.getProperty("SaveMode"), nullptr);
+	v.setProperty("RRGroupAmount", sampleMap.getProperty("RRGroupAmount", 1), nullptr);
+	v.setProperty("MicPositions", sampleMap.getProperty("MicPositions"), nullptr);
+	v.setProperty("FlatData", var(createFromValueTree(sampleMap)), nullptr);
+
+	return v;
+}
+
+const MemoryBlock* FlatSampleMap::getEmbeddedData(const ValueTree& sampleMap)
+{
+	static const Identifier flatData("FlatData");
+
+	return sampleMap.getProperty(flatData).getBinaryData();
+}
+
+int FlatSampleMap::getNumStoredProperties() noexcept
+{
+	return (int)ModulatorSamplerSound::numProperties - (int)ModulatorSamplerSound::RootNote;
+}
+
+size_t FlatSampleMap::getRecordSize(int numProperties) noexcept
+{
+	// mask, flags, properties, normalized peak, padding, monolith offset & length, sample rate
+	return 2 * sizeof(int32) + numProperties * sizeof(int32) + 2 * sizeof(int32) + 3 * sizeof(int64);
+}
+
+void FlatSampleMap::validate(size_t numBytes)
+{
+	valid = false;
+
+	if (!isFlatSampleMap(data, numBytes)) return;
+
+	const int version = readInt(VersionOffset);
+
+	if (version < 1 || version > currentVersion) return;
+
+	numSounds = readInt(NumSoundsOffset);
+	numMics = readInt(NumMicsOffset);
+	numStrings = readInt(NumStringsOffset);
+	numProperties = readInt(NumPropertiesOffset);
+	stringDataSize = (size_t)(uint32)readInt(StringDataSizeOffset);
+
+	if (numSounds < 0 || numMics < 1 || numStrings < 0 || !isPositiveAndNotGreaterThan(numProperties, 32))
+		return;
+
+	recordSize = getRecordSize(numProperties);
+
+	const uint64 recordBytes = (uint64)numSounds * recordSize;
+	const uint64 fileNameBytes = (uint64)numSounds * (uint64)numMics * sizeof(int32);
+	const uint64 offsetBytes = (uint64)numStrings * sizeof(int32);
+
+	if ((uint64)HeaderSize + recordBytes + fileNameBytes + offsetBytes + stringDataSize > (uint64)numBytes)
+		return;
+
+	records = data + HeaderSize;
+	fileNameTable = records + recordBytes;
+	stringOffsets = fileNameTable + fileNameBytes;
+	stringData = stringOffsets + offsetBytes;
+
+	// Every string must be terminated inside the string pool
+	if (numStrings > 0 && (stringDataSize == 0 || stringData[stringDataSize - 1] != 0))
+		return;
+
+	for (int i = 0; i < numStrings; i++)
+	{
+		if ((size_t)ByteOrder::littleEndianInt(stringOffsets + i * sizeof(int32)) >= stringDataSize)
+			return;
+	}
+
+	auto isValidStringIndex = [this](int index) { return index == -1 || isPositiveAndBelow(index, numStrings); };
+
+	if (!isValidStringIndex(readInt(IdStringOffset)) || !isValidStringIndex(readInt(MicPositionsStringOffset)))
+		return;
+
+	for (int i = 0; i < numSounds * numMics; i++)
+	{
+		if (!isValidStringIndex((int)ByteOrder::littleEndianInt(fileNameTable + i * sizeof(int32))))
+			return;
+	}
+
+	valid = true;
+}
+
+const char* FlatSampleMap::getRecord(int soundIndex) const noexcept
+{
+	jassert(valid && isPositiveAndBelow(soundIndex, numSounds));
+
+	return records + soundIndex * recordSize;
+}
+
+String FlatSampleMap::getString(int stringIndex) const
+{
+	if (!isPositiveAndBelow(stringIndex, numStrings)) return String();
+
+	const uint32 offset = ByteOrder::littleEndianInt(stringOffsets + stringIndex * sizeof(int32));
+
+	return String::fromUTF8(stringData + offset);
+}
+
+int FlatSampleMap::readInt(size_t offset) const noexcept
+{
+	return (int)ByteOrder::littleEndianInt(data + offset);
+}
@@ -0,0 +1,192 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef FLATSAMPLEMAP_H_INCLUDED
+#define FLATSAMPLEMAP_H_INCLUDED
+
+/** A flat binary representation of a sample map that can be used without creating a ValueTree.
+*
+*	The data consists of a fixed size header, one fixed size record per sound, a table with the file name
+*	indexes of every sound (one per mic position) and a pool of interned, null terminated UTF-8 strings.
+*	All numbers are little endian.
+*
+*	The object does not copy the data: it either memory maps a file or reads from a block that must 
+*	stay valid while it is used. The data is validated once in the constructor, so the accessors can read 
+*	the records without any further checks.
+*
+*	SampleMap::restoreFromFlatData() creates the sounds directly from the records. Use createFromValueTree() 
+*	and createValueTree() to convert from and to the XML sample map format.
+*/
+class FlatSampleMap
+{
+public:
+
+	/** Uses the given data. It must stay valid for the lifetime of this object. */
+	FlatSampleMap(const void* data, size_t numBytes);
+
+	/** Memory maps the given file. */
+	FlatSampleMap(const File& f);
+
+	/** Returns false if the data is not a flat sample map or if it is corrupted. */
+	bool isValid() const noexcept { return valid; }
+
+	/** Returns the version of the format that wrote the data. */
+	int getVersion() const noexcept;
+
+	String getId() const;
+	String getMicPositions() const;
+	int getSaveMode() const noexcept;
+	int getRRGroupAmount() const noexcept;
+
+	/** Returns true if the samples were saved with references to the global sample folder. */
+	bool usesGlobalFolder() const noexcept;
+
+	int getNumSounds() const noexcept { return numSounds; }
+
+	/** Returns the number of file names per sound. */
+	int getNumMics() const noexcept { return numMics; }
+
+	/** Returns true if every sound stores its files as child nodes (like a multi mic sample). */
+	bool hasMultiMicSounds() const noexcept;
+
+	/** Returns false if the sound description didn't contain the property. */
+	bool hasProperty(int soundIndex, ModulatorSamplerSound::Property p) const noexcept;
+
+	/** Returns the value of one of the mapping properties (RootNote to SampleState). */
+	int getProperty(int soundIndex, ModulatorSamplerSound::Property p) const noexcept;
+
+	float getNormalizedPeak(int soundIndex) const noexcept;
+
+	/** Returns the "Duplicate" flag of the sound description. */
+	bool isDuplicate(int soundIndex) const noexcept;
+
+	bool hasMonolithInfo(int soundIndex) const noexcept;
+	int64 getMonolithOffset(int soundIndex) const noexcept;
+	int64 getMonolithLength(int soundIndex) const noexcept;
+	double getMonolithSampleRate(int soundIndex) const noexcept;
+
+	/** Returns the file reference of the given mic position or an empty string. */
+	String getFileName(int soundIndex, int micIndex) const;
+
+	/** Creates the sample map ValueTree from the flat data. */
+	ValueTree createValueTree() const;
+
+	// ================================================================================================================
+
+	/** Checks the magic number. */
+	static bool isFlatSampleMap(const void* data, size_t numBytes);
+
+	/** Converts a sample map ValueTree (as created by SampleMap::exportAsValueTree()) to the flat format. */
+	static MemoryBlock createFromValueTree(const ValueTree& sampleMap);
+
+	/** Creates a sample map node that only contains the global properties and the flat data.
+	*
+	*	This is used for the sample maps that are embedded into a compiled plugin. The other code that scans 
+	*	the sample map list only needs the ID property.
+	*/
+	static ValueTree createEmbeddedSampleMap(const ValueTree& sampleMap);
+
+	/** Returns the flat data of a sample map node created with createEmbeddedSampleMap() or nullptr. */
+	static const MemoryBlock* getEmbeddedData(const ValueTree& sampleMap);
+
+	static const int currentVersion = 1;
+
+private:
+
+	enum HeaderOffsets
+	{
+		MagicOffset = 0,
+		VersionOffset = 4,
+		NumSoundsOffset = 8,
+		NumMicsOffset = 12,
+		FlagsOffset = 16,
+		SaveModeOffset = 20,
+		RRGroupAmountOffset = 24,
+		IdStringOffset = 28,
+		MicPositionsStringOffset = 32,
+		NumStringsOffset = 36,
+		StringDataSizeOffset = 40,
+		NumPropertiesOffset = 44,
+		HeaderSize = 48
+	};
+
+	enum RecordOffsets
+	{
+		PropertyMaskOffset = 0,
+		SoundFlagsOffset = 4,
+		PropertiesOffset = 8
+	};
+
+	enum MapFlags
+	{
+		MultiMicSounds = 1,
+		UseGlobalFolder = 2
+	};
+
+	enum SoundFlags
+	{
+		Duplicate = 1,
+		HasMonolithInfo = 2
+	};
+
+	static const uint32 magicNumber = 0x4d534648; // "HFSM"
+
+	static int getNumStoredProperties() noexcept;
+	static size_t getRecordSize(int numProperties) noexcept;
+
+	void validate(size_t numBytes);
+
+	const char* getRecord(int soundIndex) const noexcept;
+	String getString(int stringIndex) const;
+	int readInt(size_t offset) const noexcept;
+
+	ScopedPointer<MemoryMappedFile> mappedFile;
+
+	const char* data = nullptr;
+	bool valid = false;
+
+	int numSounds = 0;
+	int numMics = 0;
+	int numStrings = 0;
+	int numProperties = 0;
+	size_t recordSize = 0;
+
+	const char* records = nullptr;
+	const char* fileNameTable = nullptr;
+	const char* stringOffsets = nullptr;
+	const char* stringData = nullptr;
+	size_t stringDataSize = 0;
+
+	JUCE_DECLARE_NON_COPYABLE(FlatSampleMap);
+};
+
+#endif  // FLATSAMPLEMAP_H_INCLUDED
@@ -0,0 +1,317 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#include "JuceHeader.h"
+
+class FlatSampleMapTest : public UnitTest
+{
+public:
+
+	FlatSampleMapTest() :
+		UnitTest("Testing flat sample maps")
+	{
+
+	}
+
+	void runTest() override
+	{
+		beginTest("Testing single mic round trip");
+
+		testRoundTrip(false);
+
+		beginTest("Testing multi mic round trip");
+
+		testRoundTrip(true);
+
+		beginTest("Testing corrupted data");
+
+		testCorruptedData();
+
+		beginTest("Testing embedded sample maps");
+
+		testEmbeddedSampleMap();
+
+		beginTest("Benchmarking sample map parsing");
+
+		benchmark(30000);
+	}
+
+private:
+
+	static Identifier getId(ModulatorSamplerSound::Property p)
+	{
+		return ModulatorSamplerSound::getPropertyName(p);
+	}
+
+	/** Like ValueTree::isEquivalentTo(), but ignores the order of the properties. */
+	static bool isEquivalent(const ValueTree& a, const ValueTree& b)
+	{
+		if (a.getType() != b.getType() || a.getNumProperties() != b.getNumProperties() || a.getNumChildren() != b.getNumChildren())
+			return false;
+
+		for (int i = 0; i < a.getNumProperties(); i++)
+		{
+			const Identifier id = a.getPropertyName(i);
+
+			if (!b.hasProperty(id) || a.getProperty(id) != b.getProperty(id))
+				return false;
+		}
+
+		for (int i = 0; i < a.getNumChildren(); i++)
+		{
+			if (!isEquivalent(a.getChild(i), b.getChild(i)))
+				return false;
+		}
+
+		return true;
+	}
+
+	static ValueTree createSampleMap(int numSounds, int numMics, bool isMonolith)
+	{
+		ValueTree v("samplemap");
+
+		v.setProperty("ID", "TestMap", nullptr);
+		v.setProperty("SaveMode", isMonolith ? (int)SampleMap::Monolith : (int)SampleMap::MultipleFiles, nullptr);
+		v.setProperty("RRGroupAmount", 3, nullptr);
+		v.setProperty("MicPositions", numMics > 1 ? "Close;Room;" : "", nullptr);
+
+		for (int i = 0; i < numSounds; i++)
+		{
+			ValueTree sample("sample");
+
+			sample.setProperty(getId(ModulatorSamplerSound::ID), i, nullptr);
+
+			if (numMics > 1)
+			{
+				for (int j = 0; j < numMics; j++)
+				{
+					ValueTree fileChild("file");
+					fileChild.setProperty(getId(ModulatorSamplerSound::FileName), "{PROJECT_FOLDER}Mic" + String(j) + "/Sample" + String(i) + ".wav", nullptr);
+					sample.addChild(fileChild, -1, nullptr);
+				}
+			}
+			else
+			{
+				// Every second sound shares the file to check the string interning
+				sample.setProperty(getId(ModulatorSamplerSound::FileName), "{PROJECT_FOLDER}Sample" + String(i / 2) + ".wav", nullptr);
+			}
+
+			sample.setProperty(getId(ModulatorSamplerSound::RootNote), i % 128, nullptr);
+			sample.setProperty(getId(ModulatorSamplerSound::KeyLow), i % 128, nullptr);
+			sample.setProperty(getId(ModulatorSamplerSound::KeyHigh), (i + 1) % 128, nullptr);
+			sample.setProperty(getId(ModulatorSamplerSound::Volume), -(i % 24), nullptr);
+			sample.setProperty(getId(ModulatorSamplerSound::SampleEnd), 44100 + i, nullptr);
+
+			// Left out on purpose to check the property mask
+			if (i % 3 != 0) sample.setProperty(getId(ModulatorSamplerSound::LoopStart), 1000 + i, nullptr);
+
+			sample.setProperty("NormalizedPeak", 0.5f + (float)(i % 10) * 0.01f, nullptr);
+			sample.setProperty("Duplicate", i % 2 == 0, nullptr);
+
+			if (isMonolith)
+			{
+				sample.setProperty("MonolithOffset", (int64)i * 100000 + ((int64)1 << 33), nullptr);
+				sample.setProperty("MonolithLength", 44100 + i, nullptr);
+				sample.setProperty("SampleRate", 48000.0, nullptr);
+			}
+
+			v.addChild(sample, -1, nullptr);
+		}
+
+		return v;
+	}
+
+	void testRoundTrip(bool multiMic)
+	{
+		const int numMics = multiMic ? 2 : 1;
+
+		ValueTree v = createSampleMap(100, numMics, true);
+
+		MemoryBlock mb = FlatSampleMap::createFromValueTree(v);
+
+		expect(FlatSampleMap::isFlatSampleMap(mb.getData(), mb.getSize()), "Magic number not found");
+
+		FlatSampleMap flatMap(mb.getData(), mb.getSize());
+
+		expect(flatMap.isValid(), "Data is not valid");
+		expectEquals(flatMap.getVersion(), FlatSampleMap::currentVersion);
+		expectEquals(flatMap.getId(), String("TestMap"));
+		expectEquals(flatMap.getSaveMode(), (int)SampleMap::Monolith);
+		expectEquals(flatMap.getRRGroupAmount(), 3);
+		expectEquals(flatMap.getNumSounds(), 100);
+		expectEquals(flatMap.getNumMics(), numMics);
+		expect(flatMap.hasMultiMicSounds() == multiMic, "Wrong multi mic flag");
+
+		for (int i = 0; i < flatMap.getNumSounds(); i++)
+		{
+			const ValueTree sample = v.getChild(i);
+
+			for (int p = ModulatorSamplerSound::RootNote; p < ModulatorSamplerSound::numProperties; p++)
+			{
+				const ModulatorSamplerSound::Property prop = (ModulatorSamplerSound::Property)p;
+
+				expect(flatMap.hasProperty(i, prop) == sample.hasProperty(getId(prop)), "Property mask mismatch for " + getId(prop).toString());
+
+				if (sample.hasProperty(getId(prop)))
+					expectEquals(flatMap.getProperty(i, prop), (int)sample.getProperty(getId(prop)));
+			}
+
+			for (int j = 0; j < numMics; j++)
+			{
+				const ValueTree fileTree = multiMic ? sample.getChild(j) : sample;
+
+				expectEquals(flatMap.getFileName(i, j), fileTree.getProperty(getId(ModulatorSamplerSound::FileName)).toString());
+			}
+
+			expectEquals(flatMap.getNormalizedPeak(i), (float)sample.getProperty("NormalizedPeak"));
+			expect(flatMap.isDuplicate(i) == (bool)sample.getProperty("Duplicate"), "Wrong duplicate flag");
+			expect(flatMap.hasMonolithInfo(i), "Monolith info missing");
+			expectEquals(flatMap.getMonolithOffset(i), (int64)sample.getProperty("MonolithOffset"));
+			expectEquals(flatMap.getMonolithLength(i), (int64)sample.getProperty("MonolithLength"));
+			expectEquals(flatMap.getMonolithSampleRate(i), 48000.0);
+		}
+
+		ValueTree restored = flatMap.createValueTree();
+
+		expect(isEquivalent(restored, v), "The converted ValueTree is not equivalent");
+	}
+
+	void testCorruptedData()
+	{
+		MemoryBlock mb = FlatSampleMap::createFromValueTree(createSampleMap(10, 1, false));
+
+		{
+			FlatSampleMap truncated(mb.getData(), mb.getSize() - 1);
+			expect(!truncated.isValid(), "Truncated data was accepted");
+		}
+
+		{
+			MemoryBlock wrongMagic(mb);
+			wrongMagic[0] = 'X';
+
+			FlatSampleMap flatMap(wrongMagic.getData(), wrongMagic.getSize());
+			expect(!flatMap.isValid(), "Wrong magic number was accepted");
+		}
+
+		{
+			MemoryBlock unterminated(mb);
+			unterminated[unterminated.getSize() - 1] = 'X';
+
+			FlatSampleMap flatMap(unterminated.getData(), unterminated.getSize());
+			expect(!flatMap.isValid(), "Unterminated string was accepted");
+		}
+
+		{
+			MemoryBlock wrongVersion(mb);
+			wrongVersion[4] = (char)(FlatSampleMap::currentVersion + 1);
+
+			FlatSampleMap flatMap(wrongVersion.getData(), wrongVersion.getSize());
+			expect(!flatMap.isValid(), "Newer version was accepted");
+		}
+
+		FlatSampleMap empty(nullptr, 0);
+		expect(!empty.isValid(), "Empty data was accepted");
+	}
+
+	void testEmbeddedSampleMap()
+	{
+		ValueTree v = createSampleMap(10, 1, false);
+
+		ValueTree embedded = FlatSampleMap::createEmbeddedSampleMap(v);
+
+		expectEquals(embedded.getNumChildren(), 0);
+		expectEquals(embedded.getProperty("ID").toString(), String("TestMap"));
+		expect(FlatSampleMap::getEmbeddedData(v) == nullptr, "Normal sample map detected as flat data");
+
+		// The sample map list of a compiled plugin is stored as binary ValueTree
+		MemoryOutputStream mos;
+		embedded.writeToStream(mos);
+
+		MemoryInputStream mis(mos.getData(), mos.getDataSize(), false);
+		ValueTree restored = ValueTree::readFromStream(mis);
+
+		const MemoryBlock* data = FlatSampleMap::getEmbeddedData(restored);
+
+		expect(data != nullptr, "Flat data wasn't restored");
+
+		if (data != nullptr)
+		{
+			FlatSampleMap flatMap(data->getData(), data->getSize());
+
+			expect(flatMap.isValid(), "Embedded data is not valid");
+			expect(isEquivalent(flatMap.createValueTree(), v), "Embedded data is not equivalent");
+		}
+	}
+
+	void benchmark(int numSounds)
+	{
+		ValueTree v = createSampleMap(numSounds, 1, false);
+
+		MemoryOutputStream treeData;
+		v.writeToStream(treeData);
+
+		MemoryBlock flatData = FlatSampleMap::createFromValueTree(v);
+
+		int64 checksum = 0;
+
+		const int64 startTree = Time::getHighResolutionTicks();
+
+		{
+			MemoryInputStream mis(treeData.getData(), treeData.getDataSize(), false);
+			ValueTree restored = ValueTree::readFromStream(mis);
+
+			for (int i = 0; i < restored.getNumChildren(); i++)
+				checksum += (int)restored.getChild(i).getProperty(getId(ModulatorSamplerSound::SampleEnd));
+		}
+
+		const double treeSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startTree);
+
+		const int64 startFlat = Time::getHighResolutionTicks();
+
+		{
+			FlatSampleMap flatMap(flatData.getData(), flatData.getSize());
+
+			for (int i = 0; i < flatMap.getNumSounds(); i++)
+				checksum -= flatMap.getProperty(i, ModulatorSamplerSound::SampleEnd);
+		}
+
+		const double flatSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startFlat);
+
+		expectEquals(checksum, (int64)0, "Different property values");
+
+		logMessage(String(numSounds) + " sounds: ValueTree " + String(treeSeconds * 1000.0, 1) + "ms (" + String(treeData.getDataSize() / 1024) + "kB), flat " + 
+				   String(flatSeconds * 1000.0, 1) + "ms (" + String((int)flatData.getSize() / 1024) + "kB)");
+	}
+};
+
+static FlatSampleMapTest flatSampleMapTestInstance;
@@ -869,6 +869,14 @@ void ModulatorSampler::loadSampleMap(const ValueTree &valueTreeData)
 
 void ModulatorSampler::loadSampleMapFromIdAsync(const String& sampleMapId)
 {
+	const bool loadIsPending = asyncSampleMapLoader.isTimerRunning() || asyncSampleMapLoader.isUpdatePending();
+
+	if (!loadIsPending && getSampleMap()->getId().toString() == sampleMapId)
+	{
+		// The sample map is already loaded, so there's no need to kill the voices and reload it.
+		return;
+	}
+
     getMainController()->getDebugLogger().logMessage("**Loading samplemap** " + sampleMapId);
     
 	getMainController()->allNotesOff();
@@ -47,6 +47,81 @@ soundsToPreload(soundsToPreload_)
 	getAlertWindow()->setLookAndFeel(&laf);
 }
 
+class SoundPreloadThread::PreloadJob : public ThreadPoolJob
+{
+public:
+
+	PreloadJob(SoundPreloadThread& parent_, const Array<ModulatorSamplerSound*>& sounds_, int preloadSize_, Atomic<int>& nextIndex_, Atomic<int>& numPreloaded_) :
+		ThreadPoolJob("Preload samples"),
+		parent(parent_),
+		sounds(sounds_),
+		preloadSize(preloadSize_),
+		nextIndex(nextIndex_),
+		numPreloaded(numPreloaded_)
+	{}
+
+	JobStatus runJob() override
+	{
+		while (!shouldExit() && !parent.threadShouldExit() && parent.loadingErrorOccured.get() == 0)
+		{
+			const int index = ++nextIndex;
+
+			if (index >= sounds.size())
+				break;
+
+			parent.preloadSound(sounds[index], preloadSize);
+
+			++numPreloaded;
+		}
+
+		return jobHasFinished;
+	}
+
+private:
+
+	SoundPreloadThread& parent;
+	const Array<ModulatorSamplerSound*>& sounds;
+	const int preloadSize;
+
+	Atomic<int>& nextIndex;
+	Atomic<int>& numPreloaded;
+};
+
+int SoundPreloadThread::getNumPreloadThreads()
+{
+	// The preloading is mostly waiting for the disk, so it doesn't need to leave a core for the audio thread
+	return jlimit<int>(1, 16, SystemStats::getNumCpus());
+}
+
+void SoundPreloadThread::preloadSound(ModulatorSamplerSound* sound, int preloadSize)
+{
+	sound->checkFileReference();
+
+	if (sampler->getNumMicPositions() == 1)
+	{
+		preloadSample(sound->getReferenceToSound(), preloadSize);
+	}
+	else
+	{
+		for (int j = 0; j < sampler->getNumMicPositions(); j++)
+		{
+			StreamingSamplerSound *s = sound->getReferenceToSound(j);
+
+			if (s == nullptr)
+				continue;
+
+			if (sampler->getChannelData(j).enabled)
+			{
+				preloadSample(s, preloadSize);
+			}
+			else
+			{
+				s->setPurged(true);
+			}
+		}
+	}
+}
+
 void SoundPreloadThread::run()
 {
     if(sampler == nullptr)
@@ -58,7 +133,7 @@ void SoundPreloadThread::run()
     
 	ModulatorSamplerSoundPool *pool = sampler->getMainController()->getSampleManager().getModulatorSamplerSoundPool();
 
-	dynamic_cast<AudioProcessor*>(sampler->getMainController())->suspendProcessing(true);
+	MainController::ScopedSuspender ss(sampler->getMainController());
 
 	jassert(!pool->getPreloadLockFlag());
 
@@ -79,68 +154,53 @@ void SoundPreloadThread::run()
 
 	debugToConsole(sampler, "Changing preload size to " + String(preloadSize) + " samples");
 
-	for(int i = 0; i < numSoundsToPreload; ++i)
+	Array<ModulatorSamplerSound*> sounds;
+
+	sounds.ensureStorageAllocated(numSoundsToPreload);
+
+	for (int i = 0; i < numSoundsToPreload; i++)
 	{
-        if(threadShouldExit()) break;
+		if (ModulatorSamplerSound* sound = sampler->getSound(i))
+			sounds.add(sound);
+	}
 
-		setProgress(i / (double)numSoundsToPreload);
+	Atomic<int> nextIndex(-1);
+	Atomic<int> numPreloaded(0);
 
-		if (sampler->getSound(i) == nullptr) continue;
+	{
+		const int numThreads = jmin<int>(getNumPreloadThreads(), sounds.size());
 
-		sampler->getSound(i)->checkFileReference();
+		ThreadPool workers(jmax<int>(1, numThreads));
 
-		if (sampler->getNumMicPositions() == 1)
+		for (int i = 0; i < numThreads; i++)
 		{
-			StreamingSamplerSound *s = sampler->getSound(i)->getReferenceToSound();
-			preloadSample(s, preloadSize, i);
-
+			workers.addJob(new PreloadJob(*this, sounds, preloadSize, nextIndex, numPreloaded), true);
 		}
-		else
+
+		while (workers.getNumJobs() != 0)
 		{
-			for (int j = 0; j < sampler->getNumMicPositions(); j++)
-			{
-                const bool isEnabled = sampler->getChannelData(j).enabled;
-                
-                ModulatorSamplerSound *sound = sampler->getSound(i);
-                
-                if(sound != nullptr)
-                {
-                    StreamingSamplerSound *s = sound->getReferenceToSound(j);
-                    
-                    if(s != nullptr)
-                    {
-                        if(isEnabled)
-                        {
-                            preloadSample(s, preloadSize, i);
-                        }
-                        else
-                        {
-                            s->setPurged(true);
-                        }
-                     
-                    }
-                }
-			}
-		}
+			const int numDone = numPreloaded.get();
 
+			setProgress(numDone / (double)numSoundsToPreload);
+			setStatusMessage("Loading sample " + String(numDone) + "/" + String(numSoundsToPreload));
+
+			wait(30);
+		}
 	}
 
+	reportLoadingErrors();
+
 	sampler->setBypassed(wasBypassed);
 	sampler->setShouldUpdateUI(true);
 	sampler->sendChangeMessage();
 	sampler->getMainController()->getSampleManager().getModulatorSamplerSoundPool()->setUpdatePool(true);
 	sampler->getMainController()->getSampleManager().getModulatorSamplerSoundPool()->sendChangeMessage();
-	dynamic_cast<AudioProcessor*>(sampler->getMainController())->suspendProcessing(false);
 };
 
-void SoundPreloadThread::preloadSample(StreamingSamplerSound * s, const int preloadSize, int soundIndex)
+void SoundPreloadThread::preloadSample(StreamingSamplerSound * s, const int preloadSize)
 {
 	jassert(s != nullptr);
 
-	String fileName = s->getFileName(false);
-
-	setStatusMessage("Loading sample " + String(soundIndex) + "/" + String(sampler->getNumSounds()));
-
 	try
 	{
 		s->setPreloadSize(s->hasActiveState() ? preloadSize : 0, true);
@@ -148,20 +208,36 @@ void SoundPreloadThread::preloadSample(StreamingSamplerSound * s, const int prel
 	}
 	catch (StreamingSamplerSound::LoadingError l)
 	{
+		// This is called from the worker threads, so the error is reported by the loading thread after the workers are finished
 		String x;
 		x << "Error at preloading sample " << l.fileName << ": " << l.errorDescription;
-		sampler->getMainController()->getDebugLogger().logMessage(x);
+
+		ScopedLock sl(loadingErrorLock);
+
+		loadingErrors.add(x);
+		loadingErrorOccured.set(1);
+	}
+}
+
+void SoundPreloadThread::reportLoadingErrors()
+{
+	if (loadingErrors.isEmpty())
+		return;
+
+	for (int i = 0; i < loadingErrors.size(); i++)
+	{
+		sampler->getMainController()->getDebugLogger().logMessage(loadingErrors[i]);
 
 #if USE_FRONTEND
-		sampler->getMainController()->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage, x);
+		sampler->getMainController()->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage, loadingErrors[i]);
 #else
-		debugError(sampler, x);
+		debugError(sampler, loadingErrors[i]);
 #endif
-
-		sampler->setBypassed(false);
-        
-		signalThreadShouldExit();
 	}
+
+	sampler->setBypassed(false);
+
+	signalThreadShouldExit();
 }
 
 ThumbnailHandler::ThumbnailHandler(const File &directoryToLoad, const StringArray &fileNames, ModulatorSampler *s) :
@@ -352,6 +428,29 @@ void SampleMap::clear()
 
 void SampleMap::restoreFromValueTree(const ValueTree &v)
 {
+	if (const MemoryBlock* flatData = FlatSampleMap::getEmbeddedData(v))
+	{
+		FlatSampleMap flatMap(flatData->getData(), flatData->getSize());
+
+		if (flatMap.isValid())
+		{
+			restoreFromFlatData(flatMap);
+		}
+		else
+		{
+			const String x = "Corrupted sample map data: " + v.getProperty("ID").toString();
+			sampler->getMainController()->getDebugLogger().logMessage(x);
+
+#if USE_FRONTEND
+			sampler->getMainController()->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage, x);
+#else
+			debugError(sampler, x);
+#endif
+		}
+
+		return;
+	}
+
 	mode = (SaveMode)(int)v.getProperty("SaveMode");
 
 	const String sampleMapName = v.getProperty("ID");
@@ -377,6 +476,31 @@ void SampleMap::restoreFromValueTree(const ValueTree &v)
 	
 };
 
+void SampleMap::restoreFromFlatData(const FlatSampleMap& flatMap)
+{
+	jassert(flatMap.isValid());
+
+	mode = (SaveMode)flatMap.getSaveMode();
+
+	const String sampleMapName = flatMap.getId();
+	sampleMapId = sampleMapName.isEmpty() ? Identifier::null : Identifier(sampleMapName);
+
+	sampler->setRRGroupAmount(jmax<int>(1, flatMap.getRRGroupAmount()));
+
+	if (mode == Monolith)
+	{
+		loadSamplesFromMonolith(flatMap);
+	}
+	else
+	{
+		loadSamplesFromDirectory(flatMap);
+	}
+
+	if (!sampler->isRoundRobinEnabled()) sampler->refreshRRMap();
+	sampler->refreshPreloadSizes();
+	sampler->refreshMemoryUsage();
+}
+
 void SampleMap::saveIfNeeded()
 {
 	const bool unsavedChanges = sampler->getNumSounds() != 0 && hasUnsavedChanges();
@@ -542,11 +666,23 @@ void SampleMap::loadSamplesFromDirectory(const ValueTree &v)
     ModulatorSamplerSoundPool *pool = sampler->getMainController()->getSampleManager().getModulatorSamplerSoundPool();
     pool->setUpdatePool(false);
     
+	// Create all sounds without holding the audio lock and add them in one go.
+	// The file handles and preload buffers are handled by the (parallel) SoundPreloadThread afterwards.
+	OwnedArray<ModulatorSamplerSound> newSounds;
+
 	for(int i = 0; i < treeToUse->getNumChildren(); i++)
 	{
 		try
 		{
-			sampler->addSamplerSound(treeToUse->getChild(i), i);
+			ValueTree description = treeToUse->getChild(i);
+
+			const bool forceReuse = description.hasProperty("mono_sample_start");
+
+			if (ModulatorSamplerSound* newSound = pool->addSound(description, i, forceReuse))
+			{
+				newSound->restoreFromValueTree(description);
+				newSounds.add(newSound);
+			}
 		}
 		catch(StreamingSamplerSound::LoadingError l)
 		{
@@ -560,11 +696,16 @@ void SampleMap::loadSamplesFromDirectory(const ValueTree &v)
 			debugError(sampler, x);
 #endif
 
+			pool->setUpdatePool(true);
+			sampler->setShouldUpdateUI(true);
+
 			return;
 		}
 		
 	}
 
+	sampler->addSamplerSounds(newSounds);
+
     pool->setUpdatePool(true);
     pool->sendChangeMessage();
 	sampler->setShouldUpdateUI(true);
@@ -582,7 +723,7 @@ void SampleMap::loadSamplesFromDirectory(const ValueTree &v)
 	}
 }
 
-void SampleMap::loadSamplesFromMonolith(const ValueTree &v)
+bool SampleMap::getMonolithFiles(int numChannels, Array<File>& monolithFiles)
 {
 #if USE_BACKEND
 	File monolithDirectory = GET_PROJECT_HANDLER(sampler).getSubDirectory(ProjectHandler::SubDirectories::Samples);
@@ -591,10 +732,6 @@ void SampleMap::loadSamplesFromMonolith(const ValueTree &v)
 	File monolithDirectory = dynamic_cast<FrontendDataHolder*>(sampler->getMainController())->getSampleLocation();
 #endif
 
-	Array<File> monolithFiles;
-	
-    int numChannels = jmax<int>(1, v.getChild(0).getNumChildren());
-    
 	for (int i = 0; i < numChannels; i++)
 	{
 		File f = monolithDirectory.getChildFile(sampleMapId.toString() + ".ch" + String(i+1));
@@ -610,11 +747,22 @@ void SampleMap::loadSamplesFromMonolith(const ValueTree &v)
             
             sampler->deleteAllSounds();
             
-            return;
+            return false;
 #endif
         }
 	}
 
+	return true;
+}
+
+void SampleMap::loadSamplesFromMonolith(const ValueTree &v)
+{
+	Array<File> monolithFiles;
+	
+    int numChannels = jmax<int>(1, v.getChild(0).getNumChildren());
+    
+	if (!getMonolithFiles(numChannels, monolithFiles)) return;
+
 	if (!monolithFiles.isEmpty())
 	{
 
@@ -650,6 +798,138 @@ void SampleMap::loadSamplesFromMonolith(const ValueTree &v)
     
 }
 
+void SampleMap::loadSamplesFromDirectory(const FlatSampleMap& flatMap)
+{
+	sampler->deleteAllSounds();
+
+	const int numChannels = flatMap.getNumMics();
+
+	StringArray micPositions = StringArray::fromTokens(flatMap.getMicPositions(), ";", "");
+
+	micPositions.removeEmptyStrings(true);
+
+	if (micPositions.size() != 0)
+	{
+		sampler->setNumMicPositions(micPositions);
+	}
+	else
+	{
+		sampler->setNumChannels(numChannels);
+	}
+
+	sampler->setShouldUpdateUI(false);
+	ModulatorSamplerSoundPool *pool = sampler->getMainController()->getSampleManager().getModulatorSamplerSoundPool();
+	pool->setUpdatePool(false);
+
+	const bool useGlobalFolder = flatMap.usesGlobalFolder();
+
+	OwnedArray<ModulatorSamplerSound> newSounds;
+	StringArray fileReferences;
+
+	for (int i = 0; i < flatMap.getNumSounds(); i++)
+	{
+		try
+		{
+			fileReferences.clearQuick();
+
+			for (int j = 0; j < numChannels; j++)
+			{
+				const String fileReference = flatMap.getFileName(i, j);
+
+				if (fileReference.isEmpty()) continue;
+
+				if (useGlobalFolder)
+				{
+					jassert(sampler->isReference(fileReference));
+					fileReferences.add(sampler->getFile(fileReference, PresetPlayerHandler::StreamedSampleFolder).getFullPathName());
+				}
+				else
+				{
+					fileReferences.add(fileReference);
+				}
+			}
+
+			if (fileReferences.isEmpty()) continue;
+
+			if (ModulatorSamplerSound* newSound = pool->addSound(fileReferences, i, flatMap.isDuplicate(i)))
+			{
+				newSound->restoreFromFlatData(flatMap, i);
+				newSounds.add(newSound);
+			}
+		}
+		catch (StreamingSamplerSound::LoadingError l)
+		{
+			String x;
+			x << "Error at preloading sample " << l.fileName << ": " << l.errorDescription;
+			sampler->getMainController()->getDebugLogger().logMessage(x);
+
+#if USE_FRONTEND
+			sampler->getMainController()->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage, x);
+#else
+			debugError(sampler, x);
+#endif
+
+			pool->setUpdatePool(true);
+			sampler->setShouldUpdateUI(true);
+
+			return;
+		}
+	}
+
+	sampler->addSamplerSounds(newSounds);
+
+	pool->setUpdatePool(true);
+	pool->sendChangeMessage();
+	sampler->setShouldUpdateUI(true);
+	sampler->sendChangeMessage();
+
+	if (fileOnDisk != File() && flatMap.getNumSounds() != 0 && !useGlobalFolder)
+	{
+		File sampleDirectory = File(GET_PROJECT_HANDLER(sampler).getFilePath(flatMap.getFileName(0, 0), ProjectHandler::SubDirectories::Samples)).getParentDirectory();
+
+		jassert(sampleDirectory.isDirectory());
+
+		ThumbnailHandler::loadThumbnails(sampler, sampleDirectory);
+	}
+}
+
+void SampleMap::loadSamplesFromMonolith(const FlatSampleMap& flatMap)
+{
+	Array<File> monolithFiles;
+
+	const int numChannels = flatMap.getNumMics();
+
+	if (!getMonolithFiles(numChannels, monolithFiles) || monolithFiles.isEmpty()) return;
+
+	sampler->deleteAllSounds();
+
+	StringArray micPositions = StringArray::fromTokens(flatMap.getMicPositions(), ";", "");
+
+	micPositions.removeEmptyStrings(true);
+
+	if (micPositions.size() == numChannels)
+	{
+		sampler->setNumMicPositions(micPositions);
+	}
+	else
+	{
+		sampler->setNumChannels(1);
+	}
+
+	ModulatorSamplerSoundPool* pool = sampler->getMainController()->getSampleManager().getModulatorSamplerSoundPool();
+
+	OwnedArray<ModulatorSamplerSound> newSounds;
+
+	pool->loadMonolithicData(flatMap, monolithFiles, newSounds);
+
+	for (int i = 0; i < newSounds.size(); i++)
+	{
+		newSounds[i]->restoreFromFlatData(flatMap, i);
+	}
+
+	sampler->addSamplerSounds(newSounds);
+}
+
 void SampleMap::replaceReferencesWithGlobalFolder()
 {
 	
@@ -657,6 +937,15 @@ void SampleMap::replaceReferencesWithGlobalFolder()
 
 String SampleMap::checkReferences(ValueTree& v, const File& sampleRootFolder, Array<File>& sampleList)
 {
+	if (const MemoryBlock* flatData = FlatSampleMap::getEmbeddedData(v))
+	{
+		FlatSampleMap flatMap(flatData->getData(), flatData->getSize());
+
+		if (!flatMap.isValid()) return v.getProperty("ID").toString();
+
+		return checkReferences(flatMap, sampleRootFolder, sampleList);
+	}
+
 	const bool isMonolith = (int)v.getProperty("SaveMode") == (int)SaveMode::Monolith;
 
 	const std::string channelNames = v.getProperty("MicPositions").toString().toStdString();
@@ -738,6 +1027,51 @@ String SampleMap::checkReferences(ValueTree& v, const File& sampleRootFolder, Ar
 	return String();
 }
 
+String SampleMap::checkReferences(const FlatSampleMap& flatMap, const File& sampleRootFolder, Array<File>& sampleList)
+{
+	if (flatMap.getSaveMode() == (int)SaveMode::Monolith)
+	{
+		for (int i = 0; i < flatMap.getNumMics(); i++)
+		{
+			File f = sampleRootFolder.getChildFile(flatMap.getId() + ".ch" + String(i + 1));
+
+			if (!f.existsAsFile())
+			{
+				return f.getFullPathName();
+			}
+		}
+
+		return String();
+	}
+
+	static const String wc("{PROJECT_FOLDER}");
+
+	for (int i = 0; i < flatMap.getNumSounds(); i++)
+	{
+		for (int j = 0; j < flatMap.getNumMics(); j++)
+		{
+			const String fileReference = flatMap.getFileName(i, j);
+
+			if (fileReference.isEmpty()) continue;
+
+			if (!fileReference.startsWith(wc))
+			{
+				PresetHandler::showMessageWindow("Absolute File path detected", "The sample " + fileReference + " is a absolute path which will not be resolved when using the library on another system", PresetHandler::IconType::Error);
+				return fileReference;
+			}
+
+			File sampleLocation = sampleRootFolder.getChildFile(fileReference.fromFirstOccurrenceOf(wc, false, false));
+
+			if (!sampleList.contains(sampleLocation))
+			{
+				return sampleLocation.getFullPathName();
+			}
+		}
+	}
+
+	return String();
+}
+
 void SampleMap::load(const File &f)
 {
 #if USE_BACKEND
@@ -759,6 +1093,16 @@ void SampleMap::load(const File &f)
 	}
 #endif
 
+	FlatSampleMap flatMap(f);
+
+	if (flatMap.isValid())
+	{
+		fileOnDisk = f;
+		restoreFromFlatData(flatMap);
+		changed = false;
+		return;
+	}
+
 	ScopedPointer<XmlElement> xml = XmlDocument::parse(f);
 
 	File fileToUse = f;
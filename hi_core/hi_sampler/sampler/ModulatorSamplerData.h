@@ -35,11 +35,15 @@
 
 class ModulatorSampler;
 class ModulatorSamplerSound;
+class FlatSampleMap;
 
 /** A background thread which loads sample data into the preload buffer of a StreamingSamplerSound
 *	@ingroup sampler
 *
-*	Whenever you need to change the preloadSize, create an instance of this
+*	Whenever you need to change the preloadSize, create an instance of this.
+*
+*	The sounds are preloaded in parallel by a pool of worker threads (opening the file handles,
+*	parsing the headers and filling the preload buffers) while this thread reports the progress.
 */
 class SoundPreloadThread: public ThreadWithQuasiModalProgressWindow
 {
@@ -57,14 +61,28 @@ public:
 	/** preloads either all sounds from the sampler or the list of sounds that was passed in the constructor. */
 	void run() override;
 
-	void preloadSample(StreamingSamplerSound * s, const int preloadSize, int soundIndex);
+	void preloadSample(StreamingSamplerSound * s, const int preloadSize);
 
 private:
 
+	class PreloadJob;
+
+	/** Checks the file references and preloads all enabled mic positions of the sound. */
+	void preloadSound(ModulatorSamplerSound* sound, int preloadSize);
+
+	static int getNumPreloadThreads();
+
+	/** Reports the errors that occured in the worker threads. Call this from the loading thread after the workers are finished. */
+	void reportLoadingErrors();
+
 	AlertWindowLookAndFeel laf;
 
 	Array<ModulatorSamplerSound*> soundsToPreload;
 
+	CriticalSection loadingErrorLock;
+	StringArray loadingErrors;
+	Atomic<int> loadingErrorOccured;
+
 	ModulatorSampler *sampler;
 };
 
@@ -245,6 +263,12 @@ public:
 	*	If the files are saved as monolith, it assumes the files are already loaded and simply adds references to this samplemap.
 	*/
 	void restoreFromValueTree(const ValueTree &v) override;
+
+	/** Restores the samplemap from a flat sample map.
+	*
+	*	This creates the sounds directly from the sound records without building a ValueTree.
+	*/
+	void restoreFromFlatData(const FlatSampleMap& flatMap);
 	
 	/** Exports the SampleMap as ValueTree.
 	*
@@ -286,6 +310,8 @@ public:
     
 	static String checkReferences(ValueTree& v, const File& sampleRootFolder, Array<File>& sampleList);
 
+	static String checkReferences(const FlatSampleMap& flatMap, const File& sampleRootFolder, Array<File>& sampleList);
+
 private:
 
 	void resolveMissingFiles(ValueTree &treeToUse);
@@ -294,6 +320,13 @@ private:
 
 	void loadSamplesFromMonolith(const ValueTree &v);
 
+	void loadSamplesFromDirectory(const FlatSampleMap& flatMap);
+
+	void loadSamplesFromMonolith(const FlatSampleMap& flatMap);
+
+	/** Collects the monolith files for the current ID. Returns false if loading must be aborted. */
+	bool getMonolithFiles(int numChannels, Array<File>& monolithFiles);
+
 	ModulatorSampler *sampler;
 
 	SaveMode mode;
@@ -372,6 +372,20 @@ void ModulatorSamplerSound::restoreFromValueTree(const ValueTree &v)
 
 }
 
+void ModulatorSamplerSound::restoreFromFlatData(const FlatSampleMap& flatMap, int soundIndex)
+{
+	const ScopedLock sl(getLock());
+
+	normalizedPeak = flatMap.getNormalizedPeak(soundIndex);
+
+	for (int i = RootNote; i < numProperties; i++) // ID and filename must be passed to the constructor!
+	{
+		Property p = (Property)i;
+
+		if (flatMap.hasProperty(soundIndex, p)) setProperty(p, flatMap.getProperty(soundIndex, p), dontSendNotification);
+	}
+}
+
 void ModulatorSamplerSound::startPropertyChange(Property p, int newValue)
 {
 	String x;
@@ -665,6 +679,7 @@ void ModulatorSamplerSoundPool::deleteSound(ModulatorSamplerSound *soundToDelete
 		if (sound->getReferenceCount() == 2) // one for the array and two for the Synthesiser::Ptr from &delete()
 		{
 			pool.removeObject(sound);
+			poolIndexDirty = true;
 		}
 	}
 
@@ -679,59 +694,113 @@ bool ModulatorSamplerSoundPool::loadMonolithicData(const ValueTree &sampleMap, c
 {
 	clearUnreferencedMonoliths();
 
+	const int64 monolithKey = getMonolithKey(sampleMap, monolithicFiles);
+	const int numSamples = sampleMap.getNumChildren();
+	const int numMics = sampleMap.getChild(0).getNumChildren();
+
+	if (reuseLoadedMonolith(monolithKey, numSamples, numMics, sounds))
+	{
+		sendChangeMessage();
+		return true;
+	}
+
 	loadedMonoliths.add(new MonolithInfoToUse(monolithicFiles));
 
 	MonolithInfoToUse* hmaf = loadedMonoliths.getLast();
 
+	MonolithIndex* index = monolithIndexes.add(new MonolithIndex(hmaf, monolithKey, numSamples, jmax<int>(1, numMics)));
+
 	try
 	{
 		hmaf->fillMetadataInfo(sampleMap);
 	}
 	catch (StreamingSamplerSound::LoadingError l)
 	{
-		String x;
-		x << "Error at loading sample " << l.fileName << ": " << l.errorDescription;
-		mc->getDebugLogger().logMessage(x);
+		logMonolithError(l);
+	}
 
-#if USE_FRONTEND
-		mc->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage, x);
-#else
-		debugError(mc->getMainSynthChain(), x);
-#endif
+	createMonolithSounds(hmaf, index, numSamples, numMics, sounds);
+
+	sendChangeMessage();
+
+	return true;
+}
+
+bool ModulatorSamplerSoundPool::loadMonolithicData(const FlatSampleMap &flatMap, const Array<File>& monolithicFiles, OwnedArray<ModulatorSamplerSound> &sounds)
+{
+	clearUnreferencedMonoliths();
+
+	const int64 monolithKey = getMonolithKey(flatMap, monolithicFiles);
+	const int numSamples = flatMap.getNumSounds();
+	const int numMics = flatMap.hasMultiMicSounds() ? flatMap.getNumMics() : 0;
+
+	if (reuseLoadedMonolith(monolithKey, numSamples, numMics, sounds))
+	{
+		sendChangeMessage();
+		return true;
 	}
 
-	for (int i = 0; i < sampleMap.getNumChildren(); i++)
+	loadedMonoliths.add(new MonolithInfoToUse(monolithicFiles));
+
+	MonolithInfoToUse* hmaf = loadedMonoliths.getLast();
+
+	MonolithIndex* index = monolithIndexes.add(new MonolithIndex(hmaf, monolithKey, numSamples, flatMap.getNumMics()));
+
+	try
 	{
-		ValueTree sample = sampleMap.getChild(i);
+		hmaf->fillMetadataInfo(flatMap);
+	}
+	catch (StreamingSamplerSound::LoadingError l)
+	{
+		logMonolithError(l);
+	}
+
+	createMonolithSounds(hmaf, index, numSamples, numMics, sounds);
+
+	sendChangeMessage();
 
-		if (sample.getNumChildren() == 0)
+	return true;
+}
+
+void ModulatorSamplerSoundPool::createMonolithSounds(MonolithInfoToUse* hmaf, MonolithIndex* index, int numSamples, int numMics, OwnedArray<ModulatorSamplerSound> &sounds)
+{
+	for (int i = 0; i < numSamples; i++)
+	{
+		if (numMics == 0)
 		{
-			String fileName = sample.getProperty("FileName").toString().fromFirstOccurrenceOf("{PROJECT_FOLDER}", false, false);
 			StreamingSamplerSound* sound = new StreamingSamplerSound(hmaf, 0, i);
-			pool.add(sound);
+			addSoundToPool(sound);
+			index->setSound(sound, i, 0);
 			sounds.add(new ModulatorSamplerSound(sound, i));
 		}
 		else
 		{
 			StreamingSamplerSoundArray multiMicArray;
 
-			for (int j = 0; j < sample.getNumChildren(); j++)
+			for (int j = 0; j < numMics; j++)
 			{
 				StreamingSamplerSound* sound = new StreamingSamplerSound(hmaf, j, i);
-				pool.add(sound);
+				addSoundToPool(sound);
+				index->setSound(sound, i, j);
 				multiMicArray.add(sound);
 			}
 
 			sounds.add(new ModulatorSamplerSound(multiMicArray, i));
 		}
-
-		
 	}
+}
 
+void ModulatorSamplerSoundPool::logMonolithError(const StreamingSamplerSound::LoadingError& l)
+{
+	String x;
+	x << "Error at loading sample " << l.fileName << ": " << l.errorDescription;
+	mc->getDebugLogger().logMessage(x);
 
-	sendChangeMessage();
-
-	return true;
+#if USE_FRONTEND
+	mc->sendOverlayMessage(DeactiveOverlay::State::CustomErrorMessage, x);
+#else
+	debugError(mc->getMainSynthChain(), x);
+#endif
 }
 
 void ModulatorSamplerSoundPool::clearUnreferencedSamples()
@@ -741,6 +810,7 @@ void ModulatorSamplerSoundPool::clearUnreferencedSamples()
 		if (pool[i]->getReferenceCount() == 2)
 		{
 			pool.remove(i--);
+			poolIndexDirty = true;
 		}
 	}
 
@@ -868,6 +938,7 @@ public:
 				if (File(newFileNameSanitized).existsAsFile())
 				{
 					sound->replaceFileReference(newFileNameSanitized);
+					pool->invalidatePoolIndex();
 
 					foundThisTime++;
 					missingSounds.remove(i);
@@ -1054,16 +1125,21 @@ String ModulatorSamplerSoundPool::getTextForPoolTable(int columnId, int indexInP
 
 void ModulatorSamplerSoundPool::increaseNumOpenFileHandles()
 {
-	numOpenFileHandles++;
+	++numOpenFileHandles;
 
 	if(updatePool) sendChangeMessage();
 }
 
 void ModulatorSamplerSoundPool::decreaseNumOpenFileHandles()
 {
-	numOpenFileHandles--; 
-	
-	if (numOpenFileHandles < 0) numOpenFileHandles = 0;
+	// The file handles are opened and closed by the preload worker threads too, so this must not go below zero atomically
+	for (;;)
+	{
+		const int oldValue = numOpenFileHandles.get();
+
+		if (oldValue <= 0 || numOpenFileHandles.compareAndSetBool(oldValue - 1, oldValue))
+			break;
+	}
 
 	if(updatePool) sendChangeMessage();
 }
@@ -1078,16 +1154,205 @@ bool ModulatorSamplerSoundPool::isFileBeingUsed(int poolIndex)
 	return false;
 }
 
-int ModulatorSamplerSoundPool::getSoundIndexFromPool(int64 hashCode)
+StreamingSamplerSound* ModulatorSamplerSoundPool::getSoundFromPool(int64 hashCode)
+{
+	if (!searchPool) return nullptr;
+
+	if (poolIndexDirty) rebuildPoolIndex();
+
+	return poolIndex[hashCode];
+}
+
+void ModulatorSamplerSoundPool::addSoundToPool(StreamingSamplerSound* s)
+{
+	pool.add(s);
+
+	if (!poolIndexDirty)
+	{
+		const int64 hash = s->getHashCode();
+
+		// Missing files and monolith samples have no hash code
+		if (hash != 0 && !poolIndex.contains(hash)) poolIndex.set(hash, s);
+	}
+}
+
+void ModulatorSamplerSoundPool::rebuildPoolIndex()
 {
-	if (!searchPool) return -1;
+	poolIndex.clear();
+
+	for (int i = 0; i < monolithIndexes.size(); i++)
+	{
+		MonolithIndex* index = monolithIndexes[i];
+
+		index->sounds.clearQuick();
+		index->sounds.insertMultiple(0, nullptr, index->numSamples * index->numChannels);
+	}
 
 	for (int i = 0; i < pool.size(); i++)
 	{
-		if (pool[i]->getHashCode() == hashCode) return i;
+		StreamingSamplerSound* s = pool.getUnchecked(i);
+
+		if (s->isMonolithic())
+		{
+			for (int j = 0; j < monolithIndexes.size(); j++)
+			{
+				if (monolithIndexes[j]->info == s->getMonolithicInfo())
+				{
+					monolithIndexes[j]->setSound(s, s->getMonolithicSampleIndex(), s->getMonolithicChannelIndex());
+					break;
+				}
+			}
+		}
+		else
+		{
+			const int64 hash = s->getHashCode();
+
+			if (hash != 0 && !poolIndex.contains(hash)) poolIndex.set(hash, s);
+		}
+	}
+
+	poolIndexDirty = false;
+}
+
+ModulatorSamplerSoundPool::MonolithIndex::MonolithIndex(MonolithInfoToUse* info_, int64 key_, int numSamples_, int numChannels_) :
+	info(info_),
+	key(key_),
+	numSamples(numSamples_),
+	numChannels(numChannels_)
+{
+	sounds.insertMultiple(0, nullptr, numSamples * numChannels);
+}
+
+StreamingSamplerSound* ModulatorSamplerSoundPool::MonolithIndex::getSound(int sampleIndex, int channelIndex) const
+{
+	if (channelIndex >= numChannels) return nullptr;
+
+	return sounds[sampleIndex * numChannels + channelIndex];
+}
+
+void ModulatorSamplerSoundPool::MonolithIndex::setSound(StreamingSamplerSound* s, int sampleIndex, int channelIndex)
+{
+	if (isPositiveAndBelow(sampleIndex, numSamples) && isPositiveAndBelow(channelIndex, numChannels))
+	{
+		sounds.set(sampleIndex * numChannels + channelIndex, s);
+	}
+}
+
+int64 ModulatorSamplerSoundPool::getMonolithKey(const ValueTree &sampleMap, const Array<File>& monolithicFiles)
+{
+	static const Identifier monolithOffset("MonolithOffset");
+	static const Identifier monolithLength("MonolithLength");
+	static const Identifier sampleRate("SampleRate");
+	static const Identifier fileName("FileName");
+
+	// Hashes everything the monolith info reads from the sample map
+	int64 key = 0;
+
+	for (int i = 0; i < monolithicFiles.size(); i++)
+	{
+		key = key * 31 + monolithicFiles[i].hashCode64();
 	}
 
-	return -1;
+	for (int i = 0; i < sampleMap.getNumChildren(); i++)
+	{
+		const ValueTree sample = sampleMap.getChild(i);
+
+		key = key * 31 + (int64)sample.getProperty(monolithOffset);
+		key = key * 31 + (int64)sample.getProperty(monolithLength);
+		key = key * 31 + (int64)(double)sample.getProperty(sampleRate);
+		key = key * 31 + sample.getProperty(fileName).toString().hashCode64();
+
+		for (int j = 0; j < sample.getNumChildren(); j++)
+		{
+			key = key * 31 + sample.getChild(j).getProperty(fileName).toString().hashCode64();
+		}
+	}
+
+	return key;
+}
+
+int64 ModulatorSamplerSoundPool::getMonolithKey(const FlatSampleMap &flatMap, const Array<File>& monolithicFiles)
+{
+	// Must create the same key as the ValueTree version for the same sample map
+	int64 key = 0;
+
+	for (int i = 0; i < monolithicFiles.size(); i++)
+	{
+		key = key * 31 + monolithicFiles[i].hashCode64();
+	}
+
+	const bool multiMic = flatMap.hasMultiMicSounds();
+
+	for (int i = 0; i < flatMap.getNumSounds(); i++)
+	{
+		key = key * 31 + flatMap.getMonolithOffset(i);
+		key = key * 31 + flatMap.getMonolithLength(i);
+		key = key * 31 + (int64)flatMap.getMonolithSampleRate(i);
+		key = key * 31 + (multiMic ? String() : flatMap.getFileName(i, 0)).hashCode64();
+
+		if (multiMic)
+		{
+			for (int j = 0; j < flatMap.getNumMics(); j++)
+			{
+				key = key * 31 + flatMap.getFileName(i, j).hashCode64();
+			}
+		}
+	}
+
+	return key;
+}
+
+bool ModulatorSamplerSoundPool::reuseLoadedMonolith(int64 key, int numSamples, int numMics, OwnedArray<ModulatorSamplerSound> &sounds)
+{
+	if (!searchPool) return false;
+
+	if (poolIndexDirty) rebuildPoolIndex();
+
+	for (int i = 0; i < monolithIndexes.size(); i++)
+	{
+		const MonolithIndex* index = monolithIndexes[i];
+
+		if (index->key != key || index->numSamples != numSamples) continue;
+
+		bool allSoundsInPool = true;
+
+		for (int j = 0; j < numSamples && allSoundsInPool; j++)
+		{
+			for (int k = 0; k < jmax<int>(1, numMics); k++)
+			{
+				if (index->getSound(j, k) == nullptr)
+				{
+					allSoundsInPool = false;
+					break;
+				}
+			}
+		}
+
+		if (!allSoundsInPool) continue;
+
+		for (int j = 0; j < numSamples; j++)
+		{
+			if (numMics == 0)
+			{
+				sounds.add(new ModulatorSamplerSound(index->getSound(j, 0), j));
+			}
+			else
+			{
+				StreamingSamplerSoundArray multiMicArray;
+
+				for (int k = 0; k < numMics; k++)
+				{
+					multiMicArray.add(index->getSound(j, k));
+				}
+
+				sounds.add(new ModulatorSamplerSound(multiMicArray, j));
+			}
+		}
+
+		return true;
+	}
+
+	return false;
 }
 
 ModulatorSamplerSound * ModulatorSamplerSoundPool::addSoundWithSingleMic(const ValueTree &soundDescription, int index, bool forceReuse /*= false*/)
@@ -1097,12 +1362,12 @@ ModulatorSamplerSound * ModulatorSamplerSoundPool::addSoundWithSingleMic(const V
 	if (forceReuse)
 	{
         int64 hash = fileName.hashCode64();
-		int i = getSoundIndexFromPool(hash);
+		StreamingSamplerSound* existingSound = getSoundFromPool(hash);
 
-		if (i != -1)
+		if (existingSound != nullptr)
 		{
 			if(updatePool) sendChangeMessage();
-			return new ModulatorSamplerSound(pool[i], index);
+			return new ModulatorSamplerSound(existingSound, index);
 		}
 		else
 		{
@@ -1121,11 +1386,11 @@ ModulatorSamplerSound * ModulatorSamplerSoundPool::addSoundWithSingleMic(const V
         if(searchThisSampleInPool)
         {
             int64 hash = fileName.hashCode64();
-            int i = getSoundIndexFromPool(hash);
+            StreamingSamplerSound* existingSound = getSoundFromPool(hash);
             
-            if (i != -1)
+            if (existingSound != nullptr)
             {
-                ModulatorSamplerSound *sound = new ModulatorSamplerSound(pool[i], index);
+                ModulatorSamplerSound *sound = new ModulatorSamplerSound(existingSound, index);
                 if(updatePool) sendChangeMessage();
                 return sound;
             }
@@ -1133,7 +1398,7 @@ ModulatorSamplerSound * ModulatorSamplerSoundPool::addSoundWithSingleMic(const V
         
 		StreamingSamplerSound *s = new StreamingSamplerSound(fileName, this);
 
-		pool.add(s);
+		addSoundToPool(s);
 
 		if(updatePool) sendChangeMessage();
 
@@ -1153,11 +1418,11 @@ ModulatorSamplerSound * ModulatorSamplerSoundPool::addSoundWithMultiMic(const Va
 		if (forceReuse)
 		{
             int64 hash = fileName.hashCode64();
-			int j = getSoundIndexFromPool(hash);
+			StreamingSamplerSound* existingSound = getSoundFromPool(hash);
 
-			jassert(j != -1);
+			jassert(existingSound != nullptr);
 
-			multiMicArray.add(pool[j]);
+			multiMicArray.add(existingSound);
 			if(updatePool) sendChangeMessage();
 		}
 		else
@@ -1171,11 +1436,11 @@ ModulatorSamplerSound * ModulatorSamplerSoundPool::addSoundWithMultiMic(const Va
 			if (searchThisSampleInPool)
             {
                 int64 hash = fileName.hashCode64();
-                int j = getSoundIndexFromPool(hash);
+                StreamingSamplerSound* existingSound = getSoundFromPool(hash);
                 
-                if (j != -1)
+                if (existingSound != nullptr)
                 {
-                    multiMicArray.add(pool[j]);
+                    multiMicArray.add(existingSound);
                     continue;
                 }
 				else
@@ -1183,7 +1448,7 @@ ModulatorSamplerSound * ModulatorSamplerSoundPool::addSoundWithMultiMic(const Va
 					StreamingSamplerSound *s = new StreamingSamplerSound(fileName, this);
 
 					multiMicArray.add(s);
-					pool.add(s);
+					addSoundToPool(s);
 					continue;
 				}
             }
@@ -1192,7 +1457,7 @@ ModulatorSamplerSound * ModulatorSamplerSoundPool::addSoundWithMultiMic(const Va
 				StreamingSamplerSound *s = new StreamingSamplerSound(fileName, this);
 
 				multiMicArray.add(s);
-				pool.add(s);
+				addSoundToPool(s);
 			}
 		}
 	}
@@ -1202,6 +1467,50 @@ ModulatorSamplerSound * ModulatorSamplerSoundPool::addSoundWithMultiMic(const Va
 	return new ModulatorSamplerSound(multiMicArray, index);
 }
 
+ModulatorSamplerSound * ModulatorSamplerSoundPool::addSound(const StringArray &fileReferences, int index, bool isDuplicate)
+{
+	const bool searchInPool = forcePoolSearch || isDuplicate;
+
+	ModulatorSamplerSound* sound = nullptr;
+
+	if (fileReferences.size() == 1)
+	{
+		sound = new ModulatorSamplerSound(getOrCreateSound(fileReferences[0], searchInPool), index);
+	}
+	else
+	{
+		StreamingSamplerSoundArray multiMicArray;
+
+		for (int i = 0; i < fileReferences.size(); i++)
+		{
+			multiMicArray.add(getOrCreateSound(fileReferences[i], searchInPool));
+		}
+
+		sound = new ModulatorSamplerSound(multiMicArray, index);
+	}
+
+	if (updatePool) sendChangeMessage();
+
+	return sound;
+}
+
+StreamingSamplerSound* ModulatorSamplerSoundPool::getOrCreateSound(const String& fileReference, bool searchInPool)
+{
+	const String fileName = GET_PROJECT_HANDLER(mc->getMainSynthChain()).getFilePath(fileReference, ProjectHandler::SubDirectories::Samples);
+
+	if (searchInPool)
+	{
+		if (StreamingSamplerSound* existingSound = getSoundFromPool(fileName.hashCode64()))
+			return existingSound;
+	}
+
+	StreamingSamplerSound *s = new StreamingSamplerSound(fileName, this);
+
+	addSoundToPool(s);
+
+	return s;
+}
+
 bool ModulatorSamplerSoundPool::isPoolSearchForced() const
 {
 	return forcePoolSearch;
@@ -1213,9 +1522,32 @@ void ModulatorSamplerSoundPool::clearUnreferencedMonoliths()
 	{
 		if (loadedMonoliths[i]->getReferenceCount() == 2)
 		{
+			for (int j = 0; j < monolithIndexes.size(); j++)
+			{
+				if (monolithIndexes[j]->info == loadedMonoliths[i].get()) monolithIndexes.remove(j--);
+			}
+
 			loadedMonoliths.remove(i--);
 		}
 	}
 
 	sendChangeMessage();
 }
+
+bool ModulatorSamplerSoundPool::getCachedImportAnalysis(int64 fileHash, ImportAnalysis& analysis) const
+{
+	ScopedLock sl(importAnalysisLock);
+
+	if (!importAnalysisCache.contains(fileHash))
+		return false;
+
+	analysis = importAnalysisCache[fileHash];
+	return true;
+}
+
+void ModulatorSamplerSoundPool::cacheImportAnalysis(int64 fileHash, const ImportAnalysis& analysis)
+{
+	ScopedLock sl(importAnalysisLock);
+
+	importAnalysisCache.set(fileHash, analysis);
+}
@@ -33,6 +33,8 @@
 #ifndef MODULATORSAMPLERSOUND_H_INCLUDED
 #define MODULATORSAMPLERSOUND_H_INCLUDED
 
+class FlatSampleMap;
+
 typedef ReferenceCountedArray<StreamingSamplerSound> StreamingSamplerSoundArray;
 
 #define FOR_EVERY_SOUND(x) {for (int i = 0; i < soundList.size(); i++) if(soundList[i].get() != nullptr) soundList[i]->x;}
@@ -181,6 +183,9 @@ public:
 	/** restores all properties (excluding filename and ID) from the value tree. */
 	void restoreFromValueTree(const ValueTree &v) override;
 
+	/** Restores the properties from the sound record of a flat sample map. */
+	void restoreFromFlatData(const FlatSampleMap& flatMap, int soundIndex);
+
 	// ====================================================================================================================
 
 	/** set the UndoManager that is used to save calls to setPropertyWithUndo(). */
@@ -445,11 +450,19 @@ public:
 	*/
 	ModulatorSamplerSound *addSound(const ValueTree &soundDescription, int index, bool forceReuse = false);;
 
+	/** Creates a sound from the file references of a flat sample map (one per mic position).
+	*
+	*	If isDuplicate is true (or the pool search is forced), existing sounds in the pool will be reused.
+	*/
+	ModulatorSamplerSound *addSound(const StringArray &fileReferences, int index, bool isDuplicate);
+
 	/** Decreases the reference count of the wrapped sound in the pool and deletes it if no references are left. */
 	void deleteSound(ModulatorSamplerSound *soundToDelete);;
 
 	bool loadMonolithicData(const ValueTree &sampleMap, const Array<File>& monolithicFiles, OwnedArray<ModulatorSamplerSound> &sounds);
 
+	bool loadMonolithicData(const FlatSampleMap &flatMap, const Array<File>& monolithicFiles, OwnedArray<ModulatorSamplerSound> &sounds);
+
     void setUpdatePool(bool shouldBeUpdated)
     {
         updatePool = shouldBeUpdated;
@@ -507,16 +520,78 @@ public:
 
 	void clearUnreferencedMonoliths();
 
+	/** Call this whenever the file reference of a sound in the pool was changed. 
+	*
+	*	The hash index will be rebuilt before the next lookup.
+	*/
+	void invalidatePoolIndex() { poolIndexDirty = true; }
+
+	// ================================================================================================================
+
+	/** The data of an audio file that is calculated during the import. @see SampleImportAnalyser */
+	struct ImportAnalysis
+	{
+		double pitch = 0.0;
+		float peak = -1.0f;
+		bool pitchDetected = false;
+		MemoryBlock thumbnailData;
+	};
+
+	/** Looks up the analysis of a previously imported file. Returns false if the file wasn't analysed yet. */
+	bool getCachedImportAnalysis(int64 fileHash, ImportAnalysis& analysis) const;
+
+	/** Stores the analysis of an imported file so that importing the same file again skips the scanning. */
+	void cacheImportAnalysis(int64 fileHash, const ImportAnalysis& analysis);
+
 private:
 
+	friend class ModulatorSamplerSoundPoolTest;
+
 	// ================================================================================================================
 
+	/** The sounds of a loaded monolith ordered by sample and channel index. */
+	struct MonolithIndex
+	{
+		MonolithIndex(MonolithInfoToUse* info_, int64 key_, int numSamples_, int numChannels_);
+
+		StreamingSamplerSound* getSound(int sampleIndex, int channelIndex) const;
+		void setSound(StreamingSamplerSound* s, int sampleIndex, int channelIndex);
+
+		MonolithInfoToUse* info;
+		const int64 key;
+		const int numSamples;
+		const int numChannels;
+
+		Array<StreamingSamplerSound*> sounds;
+	};
+
+	static int64 getMonolithKey(const ValueTree &sampleMap, const Array<File>& monolithicFiles);
+	static int64 getMonolithKey(const FlatSampleMap &flatMap, const Array<File>& monolithicFiles);
+
+	/** numMics is zero if the samples have no mic position child nodes. */
+	bool reuseLoadedMonolith(int64 key, int numSamples, int numMics, OwnedArray<ModulatorSamplerSound> &sounds);
+
+	void createMonolithSounds(MonolithInfoToUse* hmaf, MonolithIndex* index, int numSamples, int numMics, OwnedArray<ModulatorSamplerSound> &sounds);
+
+	void logMonolithError(const StreamingSamplerSound::LoadingError& l);
+
 	ReferenceCountedArray<MonolithInfoToUse> loadedMonoliths;
 
-	int getSoundIndexFromPool(int64 hashCode);
+	OwnedArray<MonolithIndex> monolithIndexes;
+
+	/** Returns the first sound in the pool with the given file hash or nullptr. */
+	StreamingSamplerSound* getSoundFromPool(int64 hashCode);
+
+	/** Adds the sound to the pool and the hash index. */
+	void addSoundToPool(StreamingSamplerSound* s);
+
+	void rebuildPoolIndex();
 
 	ModulatorSamplerSound *addSoundWithSingleMic(const ValueTree &soundDescription, int index, bool forceReuse = false);
 	ModulatorSamplerSound *addSoundWithMultiMic(const ValueTree &soundDescription, int index, bool forceReuse = false);
+
+	/** Resolves the file reference and returns the sound from the pool or a new one. */
+	StreamingSamplerSound* getOrCreateSound(const String& fileReference, bool searchInPool);
 	
 	// ================================================================================================================
 
@@ -527,12 +602,24 @@ private:
 
 	ReferenceCountedArray<StreamingSamplerSound> pool;
 
+	/** Uses all 64 bits of the file hash (the default hash function truncates it to a signed int). */
+	struct FileHashFunction
+	{
+		int generateHash(int64 key, int upperLimit) const noexcept { return (int)(((uint64)key ^ ((uint64)key >> 32)) % (uint64)upperLimit); }
+	};
+
+	HashMap<int64, StreamingSamplerSound*, FileHashFunction> poolIndex;
+	bool poolIndexDirty = false;
+
+	CriticalSection importAnalysisLock;
+	HashMap<int64, ImportAnalysis, FileHashFunction> importAnalysisCache;
+
 	bool isCurrentlyLoading;
 	bool forcePoolSearch;
     bool updatePool;
 	bool searchPool;
     
-	int numOpenFileHandles;
+	Atomic<int> numOpenFileHandles;
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModulatorSamplerSoundPool)
 };
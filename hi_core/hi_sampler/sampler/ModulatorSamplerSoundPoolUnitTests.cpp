@@ -0,0 +1,136 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#include "JuceHeader.h"
+
+class ModulatorSamplerSoundPoolTest : public UnitTest
+{
+public:
+
+	ModulatorSamplerSoundPoolTest() :
+		UnitTest("Testing sample pool lookup")
+	{
+
+	}
+
+	void runTest() override
+	{
+		beginTest("Testing hash index");
+
+		testIndex();
+
+		beginTest("Benchmarking sample map loading");
+
+		benchmark(1000);
+		benchmark(10000);
+		benchmark(50000);
+	}
+
+private:
+
+	static String getSyntheticFileName(int index)
+	{
+		return File::getSpecialLocation(File::tempDirectory).getChildFile("PoolTest/Sample" + String(index) + ".wav").getFullPathName();
+	}
+
+	/** Mimics the pool search of a sample map with the Duplicate flag set. */
+	static void loadSyntheticMap(ModulatorSamplerSoundPool& pool, int numSounds)
+	{
+		for (int i = 0; i < numSounds; i++)
+		{
+			const String fileName = getSyntheticFileName(i);
+
+			if (pool.getSoundFromPool(fileName.hashCode64()) == nullptr)
+			{
+				pool.addSoundToPool(new StreamingSamplerSound(fileName, &pool));
+			}
+		}
+	}
+
+	void testIndex()
+	{
+		ModulatorSamplerSoundPool pool(nullptr);
+
+		loadSyntheticMap(pool, 100);
+		loadSyntheticMap(pool, 100);
+
+		expectEquals(pool.getNumSoundsInPool(), 100, "Duplicate sounds were added");
+
+		for (int i = 0; i < 100; i++)
+		{
+			StreamingSamplerSound* s = pool.getSoundFromPool(getSyntheticFileName(i).hashCode64());
+
+			expect(s == pool.pool[i], "Wrong sound for index " + String(i));
+		}
+
+		const int64 removedHash = pool.pool[0]->getHashCode();
+
+		pool.pool.remove(0);
+		pool.invalidatePoolIndex();
+
+		expect(pool.getSoundFromPool(removedHash) == nullptr, "Removed sound is still indexed");
+		expect(pool.getSoundFromPool(getSyntheticFileName(1).hashCode64()) == pool.pool[0], "Index wasn't rebuilt");
+
+		pool.setDeactivatePoolSearch(true);
+
+		expect(pool.getSoundFromPool(getSyntheticFileName(1).hashCode64()) == nullptr, "Search wasn't deactivated");
+	}
+
+	void benchmark(int numSounds)
+	{
+		ModulatorSamplerSoundPool pool(nullptr);
+
+		const int64 startLoad = Time::getHighResolutionTicks();
+
+		loadSyntheticMap(pool, numSounds);
+
+		const double loadSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startLoad);
+
+		// Loading the same map again into a full pool was the quadratic case
+		const int64 startReload = Time::getHighResolutionTicks();
+
+		int numFound = 0;
+
+		for (int i = 0; i < numSounds; i++)
+		{
+			if (pool.getSoundFromPool(getSyntheticFileName(i).hashCode64()) != nullptr) numFound++;
+		}
+
+		const double reloadSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startReload);
+
+		expectEquals(numFound, numSounds, "Not all sounds were found");
+
+		logMessage(String(numSounds) + " sounds: load " + String(loadSeconds * 1000.0, 1) + "ms, reload " + String(reloadSeconds * 1000.0, 1) + "ms");
+	}
+};
+
+static ModulatorSamplerSoundPoolTest samplerSoundPoolTestInstance;
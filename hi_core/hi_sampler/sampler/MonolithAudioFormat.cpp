@@ -78,6 +78,41 @@ void HiseMonolithAudioFormat::fillMetadataInfo(const ValueTree &sampleMap)
 		}
 	}
 
+	createMemoryReaders(numChannels);
+}
+
+void HiseMonolithAudioFormat::fillMetadataInfo(const FlatSampleMap& flatMap)
+{
+	const int numChannels = flatMap.getNumMics();
+	const int numSamples = flatMap.getNumSounds();
+
+	multiChannelSampleInformation.reserve(numChannels);
+
+	for (int channel = 0; channel < numChannels; channel++)
+	{
+		std::vector<SampleInfo> newVector;
+		newVector.reserve(numSamples);
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			SampleInfo info;
+
+			info.start = flatMap.getMonolithOffset(i);
+			info.length = flatMap.getMonolithLength(i);
+			info.sampleRate = flatMap.getMonolithSampleRate(i);
+			info.fileName = flatMap.getFileName(i, channel);
+
+			newVector.push_back(info);
+		}
+
+		multiChannelSampleInformation.push_back(newVector);
+	}
+
+	createMemoryReaders(numChannels);
+}
+
+void HiseMonolithAudioFormat::createMemoryReaders(int numChannels)
+{
 	for (int i = 0; i < numChannels; i++)
 	{
 		dummyReader.numChannels = isMonoChannel[i] ? 1 : 2;
@@ -151,6 +186,41 @@ void HlacMonolithInfo::fillMetadataInfo(const ValueTree& sampleMap)
 		}
 	}
 
+	createMemoryReaders(numChannels);
+}
+
+void HlacMonolithInfo::fillMetadataInfo(const FlatSampleMap& flatMap)
+{
+	const int numChannels = flatMap.getNumMics();
+	const int numSamples = flatMap.getNumSounds();
+
+	multiChannelSampleInformation.reserve(numChannels);
+
+	for (int channel = 0; channel < numChannels; channel++)
+	{
+		std::vector<SampleInfo> newVector;
+		newVector.reserve(numSamples);
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			SampleInfo info;
+
+			info.start = flatMap.getMonolithOffset(i);
+			info.length = flatMap.getMonolithLength(i);
+			info.sampleRate = flatMap.getMonolithSampleRate(i);
+			info.fileName = flatMap.getFileName(i, channel);
+
+			newVector.push_back(info);
+		}
+
+		multiChannelSampleInformation.push_back(newVector);
+	}
+
+	createMemoryReaders(numChannels);
+}
+
+void HlacMonolithInfo::createMemoryReaders(int numChannels)
+{
 	for (int i = 0; i < numChannels; i++)
 	{
 		dummyReader.numChannels = isMonoChannel[i] ? 1 : 2;
@@ -34,6 +34,8 @@
 #ifndef MONOLITHAUDIOFORMAT_H_INCLUDED
 #define MONOLITHAUDIOFORMAT_H_INCLUDED
 
+class FlatSampleMap;
+
 #define USE_OLD_MONOLITH_FORMAT 0
 
 #if JUCE_64BIT && !JUCE_IOS
@@ -208,6 +210,10 @@ public:
 	}
 
 	void fillMetadataInfo(const ValueTree &sampleMap);
+	void fillMetadataInfo(const FlatSampleMap& flatMap);
+
+	/** Memory maps the monolith files after the sample information was filled. */
+	void createMemoryReaders(int numChannels);
 
 	Array<int> getPossibleSampleRates() override
 	{
@@ -315,6 +321,11 @@ public:
     {
         return multiChannelSampleInformation[0][sampleIndex].sampleRate;
     }
+
+	File getMonolithFile(int channelIndex) const
+	{
+		return monolithicFiles[channelIndex];
+	}
     
 	struct SampleInfo
 	{
@@ -384,6 +395,10 @@ public:
 	}
 
 	void fillMetadataInfo(const ValueTree& sampleMap);
+	void fillMetadataInfo(const FlatSampleMap& flatMap);
+
+	/** Memory maps the monolith files after the sample information was filled. */
+	void createMemoryReaders(int numChannels);
 
 	String getFileName(int channelIndex, int sampleIndex) const
 	{
@@ -405,6 +420,11 @@ public:
 		return multiChannelSampleInformation[0][sampleIndex].sampleRate;
 	}
 
+	File getMonolithFile(int channelIndex) const
+	{
+		return monolithicFiles[channelIndex];
+	}
+
 	AudioFormatReader* createMonolithicReader(int sampleIndex, int channelIndex)
 	{
 		const int sizeOfFirstChannelList = (int)multiChannelSampleInformation[0].size();
@@ -109,6 +109,10 @@ bool SampleImporter::createSoundAndAddToSampler(ModulatorSampler *sampler, const
 	SET(ModulatorSamplerSound::VeloHigh, basicData.hiVelocity);
 	SET(ModulatorSamplerSound::RRGroup, basicData.group);
 
+	// Skips the normalization scan if the import analysis already found the peak
+	if (basicData.normalizedPeak > 0.0f)
+		v.setProperty("NormalizedPeak", basicData.normalizedPeak, nullptr);
+
 	String allowedWildcards = sampler->getMainController()->getSampleManager().getModulatorSamplerSoundPool()->afm.getWildcardForAllFormats();
 
 	for (int i = 0; i < basicData.fileNames.size(); i++)
@@ -276,63 +280,13 @@ void SampleImporter::loadAudioFilesUsingFileName(Component *childComponentOfMain
 
 }
 
-void SampleImporter::loadAudioFilesUsingPitchDetection(Component* /*childComponentOfMainEditor*/, ModulatorSampler *sampler, const StringArray &fileNames, bool /*useVelocityAutomap*/)
+void SampleImporter::loadAudioFilesUsingPitchDetection(Component* childComponentOfMainEditor, ModulatorSampler *sampler, const StringArray &fileNames, bool /*useVelocityAutomap*/)
 {
-	Array<Range<double>> freqRanges;
-
-	freqRanges.add(Range<double>(0, MidiMessage::getMidiNoteInHertz(1)/2));
-
-	for(int i = 1; i < 126; i++)
-	{
-		const double thisPitch = MidiMessage::getMidiNoteInHertz(i);
-		const double nextPitch = MidiMessage::getMidiNoteInHertz(i+1);
-		const double prevPitch = MidiMessage::getMidiNoteInHertz(i-1);
-
-		const double lowerLimit = thisPitch - (thisPitch-prevPitch) * 0.5;
-		const double upperLimit = thisPitch + (nextPitch - thisPitch) * 0.5;
+	PitchDetectionImportWindow *window = new PitchDetectionImportWindow(sampler, fileNames);
 
-		freqRanges.add(Range<double>(lowerLimit, upperLimit));		
-	}
-
-	const int numSamplesPerDetection = PitchDetection::getNumSamplesNeeded(sampler->Processor::getSampleRate());
-	AudioSampleBuffer pitchDetectionBuffer(2, numSamplesPerDetection);
-
-	const int startIndex = sampler->getNumSounds();
-
-	for(int i = 0; i < fileNames.size(); i++)
-	{
-		const double pitch = PitchDetection::detectPitch(File(fileNames[i]), pitchDetectionBuffer, sampler->Processor::getSampleRate());
-		int rootNote = -1;
+	window->setModalBaseWindowComponent(childComponentOfMainEditor);
 
-		for(int j = 0; j <freqRanges.size(); j++)
-		{
-			if(freqRanges[j].contains(pitch))
-			{
-				debugToConsole(sampler, "Detected Root Note: " + MidiMessage::getMidiNoteName(j, true, true, 3));
-				rootNote = j;
-				break;
-			}
-		}
-
-		if(rootNote == -1) debugError(sampler, "Root note cannot be detected, skipping sample " + fileNames[i]);
-		
-		SamplerSoundBasicData data;
-
-		data.fileNames.add(fileNames[i]);
-		data.index = startIndex + i;
-		data.rootNote = rootNote;
-		data.lowKey = rootNote;
-		data.hiKey = rootNote;
-		data.lowVelocity = 0;
-		data.hiVelocity = 127;
-
-		createSoundAndAddToSampler(sampler, data);
-	}
-
-	ThumbnailHandler::saveNewThumbNails(sampler, fileNames);
-
-	sampler->refreshPreloadSizes();
-	sampler->refreshMemoryUsage();
+	window->runThread();
 }
 
 void SampleImporter::loadAudioFilesRaw(Component* /*childComponentOfMainEditor*/, ModulatorSampler* sampler, const StringArray& fileNames)
@@ -584,6 +538,29 @@ void FileImportDialogWindow::run()
 		return;
 	}
 
+	StringArray allFiles;
+
+	for (const auto& data : collection.dataList)
+		allFiles.addArray(data.fileNames);
+
+	SampleImportAnalyser analyser(sampler, allFiles, false);
+
+	if (!analyser.analyse(*this))
+	{
+		sampler->setShouldUpdateUI(true);
+		pool->setUpdatePool(true);
+		pool->setDeactivatePoolSearch(false);
+		return;
+	}
+
+	for (auto& data : collection.dataList)
+	{
+		const float peak = analyser.getHighestPeak(data.fileNames);
+
+		if (peak > 0.0f)
+			data.normalizedPeak = 1.0f / peak;
+	}
+
 	showStatusMessage("Prepare sampler for multimics");
 
 	sampler->setNumMicPositions(collection.multiMicTokens);
@@ -638,4 +615,298 @@ void FileImportDialogWindow::threadFinished()
 		}
 	}
 
-}
\ No newline at end of file
+}
+
+
+PitchDetectionImportWindow::PitchDetectionImportWindow(ModulatorSampler *sampler_, const StringArray &files_) :
+	ThreadWithAsyncProgressWindow("Detecting the pitch of " + String(files_.size()) + " files"),
+	sampler(sampler_),
+	files(files_)
+{
+	addBasicComponents(false);
+}
+
+void PitchDetectionImportWindow::run()
+{
+	ModulatorSamplerSoundPool *pool = sampler->getMainController()->getSampleManager().getModulatorSamplerSoundPool();
+
+	SampleImportAnalyser analyser(sampler, files, true);
+
+	if (!analyser.analyse(*this))
+		return;
+
+	sampler->setShouldUpdateUI(false);
+	pool->setUpdatePool(false);
+
+	int index = sampler->getNumSounds();
+
+	for (int i = 0; i < files.size(); i++)
+	{
+		showStatusMessage("Loading sample " + File(files[i]).getFileName());
+		setProgress((double)i / (double)files.size());
+
+		const SampleImportAnalyser::Analysis &analysis = analyser.getAnalysis(files[i]);
+		const int rootNote = SampleImportAnalyser::getRootNoteForPitch(analysis.pitch);
+
+		if (rootNote == -1)
+		{
+			debugError(sampler, "Root note cannot be detected, skipping sample " + files[i]);
+			continue;
+		}
+
+		debugToConsole(sampler, "Detected Root Note: " + MidiMessage::getMidiNoteName(rootNote, true, true, 3));
+
+		SampleImporter::SamplerSoundBasicData data;
+
+		data.fileNames.add(files[i]);
+		data.index = index++;
+		data.rootNote = rootNote;
+		data.lowKey = rootNote;
+		data.hiKey = rootNote;
+		data.lowVelocity = 0;
+		data.hiVelocity = 127;
+		data.normalizedPeak = analysis.peak > 0.0f ? 1.0f / analysis.peak : -1.0f;
+
+		SampleImporter::createSoundAndAddToSampler(sampler, data);
+
+		if (threadShouldExit())
+			break;
+	}
+
+	sampler->setShouldUpdateUI(true);
+	pool->setUpdatePool(true);
+
+	pool->sendChangeMessage();
+	sampler->sendChangeMessage();
+}
+
+void PitchDetectionImportWindow::threadFinished()
+{
+	sampler->refreshPreloadSizes();
+	sampler->refreshMemoryUsage();
+}
+
+class SampleImportAnalyser::AnalysisJob : public ThreadPoolJob
+{
+public:
+
+	AnalysisJob(SampleImportAnalyser &parent_, ThreadWithAsyncProgressWindow &progressWindow_) :
+		ThreadPoolJob("Analyse samples"),
+		parent(parent_),
+		progressWindow(progressWindow_)
+	{}
+
+	JobStatus runJob() override
+	{
+		while (!shouldExit() && !progressWindow.threadShouldExit())
+		{
+			const int index = ++parent.nextIndex;
+
+			if (index >= parent.fileNames.size())
+				break;
+
+			parent.analyseFile(index);
+
+			++parent.numAnalysed;
+		}
+
+		return jobHasFinished;
+	}
+
+private:
+
+	SampleImportAnalyser &parent;
+	ThreadWithAsyncProgressWindow &progressWindow;
+};
+
+SampleImportAnalyser::SampleImportAnalyser(ModulatorSampler *sampler_, const StringArray &fileNames_, bool detectPitch_) :
+	sampler(sampler_),
+	pool(sampler_->getMainController()->getSampleManager().getModulatorSamplerSoundPool()),
+	fileNames(fileNames_),
+	detectPitch(detectPitch_),
+	nextIndex(-1),
+	numAnalysed(0)
+{
+	results.insertMultiple(0, Analysis(), fileNames.size());
+
+	for (int i = 0; i < fileNames.size(); i++)
+		fileIndexes.set(fileNames[i], i);
+}
+
+SampleImportAnalyser::~SampleImportAnalyser()
+{
+
+}
+
+int SampleImportAnalyser::getNumAnalysisThreads()
+{
+	// Decoding and pitch detection are CPU bound, so leave one core for the audio and message thread
+	return jlimit<int>(1, 16, SystemStats::getNumCpus() - 1);
+}
+
+bool SampleImportAnalyser::analyse(ThreadWithAsyncProgressWindow &progressWindow)
+{
+	const int numFiles = fileNames.size();
+
+	if (numFiles == 0)
+		return !progressWindow.threadShouldExit();
+
+	const int numThreads = jmin<int>(getNumAnalysisThreads(), numFiles);
+
+	ThreadPool workers(numThreads);
+
+	for (int i = 0; i < numThreads; i++)
+	{
+		workers.addJob(new AnalysisJob(*this, progressWindow), true);
+	}
+
+	while (workers.getNumJobs() != 0)
+	{
+		const int numDone = numAnalysed.get();
+		const int currentIndex = jlimit<int>(0, numFiles - 1, nextIndex.get());
+
+		progressWindow.setProgress((double)numDone / (double)numFiles);
+		progressWindow.showStatusMessage("Analysing sample " + String(numDone) + "/" + String(numFiles) + ": " + File(fileNames[currentIndex]).getFileName());
+
+		Thread::sleep(30);
+	}
+
+	return !progressWindow.threadShouldExit();
+}
+
+void SampleImportAnalyser::analyseFile(int index)
+{
+	const File f(fileNames[index]);
+	const int64 fileHash = getFileHash(f);
+
+	Analysis &analysis = results.getReference(index);
+
+	const bool isCached = pool->getCachedImportAnalysis(fileHash, analysis) && (analysis.pitchDetected || !detectPitch);
+
+	if (!isCached)
+	{
+		analysis = Analysis();
+
+		createAnalysis(f, analysis);
+
+		if (analysis.peak >= 0.0f)
+			pool->cacheImportAnalysis(fileHash, analysis);
+	}
+
+	if (analysis.thumbnailData.getSize() != 0)
+	{
+		AudioThumbnail thumbnail(256, pool->afm, sampler->getCache());
+		MemoryInputStream mis(analysis.thumbnailData, false);
+
+		if (thumbnail.loadFrom(mis))
+			sampler->getCache().storeThumb(thumbnail, f.hashCode64());
+	}
+}
+
+void SampleImportAnalyser::createAnalysis(const File &f, Analysis &a) const
+{
+	ScopedPointer<AudioFormatReader> reader = pool->afm.createReaderFor(f);
+
+	if (reader == nullptr)
+		return;
+
+	const int64 length = reader->lengthInSamples;
+
+	// The chunks are a multiple of the detection window, so the windows are the same as when scanning the whole file
+	const int numSamplesPerDetection = PitchDetection::getNumSamplesNeeded(reader->sampleRate);
+	const int chunkSize = numSamplesPerDetection * jmax<int>(1, 65536 / numSamplesPerDetection);
+
+	AudioSampleBuffer chunk(2, chunkSize);
+
+	AudioThumbnailCache unusedCache(1);
+	AudioThumbnail thumbnail(256, pool->afm, unusedCache);
+
+	thumbnail.reset(reader->numChannels, reader->sampleRate, length);
+
+	float peak = 0.0f;
+	double pitch = 0.0;
+
+	for (int64 chunkStart = 0; chunkStart < length; chunkStart += chunkSize)
+	{
+		const int numSamples = (int)jmin<int64>(chunkSize, length - chunkStart);
+
+		reader->read(&chunk, 0, numSamples, chunkStart, true, true);
+
+		peak = jmax<float>(peak, chunk.getMagnitude(0, numSamples));
+
+		thumbnail.addBlock(chunkStart, chunk, 0, numSamples);
+
+		if (detectPitch && pitch == 0.0)
+		{
+			for (int i = 0; i + numSamplesPerDetection <= numSamples && chunkStart + i + numSamplesPerDetection < length; i += numSamplesPerDetection)
+			{
+				pitch = PitchDetection::detectPitch(chunk, i, numSamplesPerDetection, reader->sampleRate);
+
+				if (pitch != 0.0)
+					break;
+			}
+		}
+	}
+
+	MemoryOutputStream mos(a.thumbnailData, false);
+	thumbnail.saveTo(mos);
+
+	a.peak = peak;
+	a.pitch = pitch;
+	a.pitchDetected = detectPitch;
+}
+
+const SampleImportAnalyser::Analysis& SampleImportAnalyser::getAnalysis(const String &fileName) const
+{
+	if (!fileIndexes.contains(fileName))
+		return emptyAnalysis;
+
+	return results.getReference(fileIndexes[fileName]);
+}
+
+float SampleImportAnalyser::getHighestPeak(const StringArray &fileNamesToCheck) const
+{
+	float highestPeak = -1.0f;
+
+	for (const auto& fileName : fileNamesToCheck)
+	{
+		const float peak = getAnalysis(fileName).peak;
+
+		// Rather scan all files again than normalizing with a missing mic position
+		if (peak < 0.0f)
+			return -1.0f;
+
+		highestPeak = jmax<float>(highestPeak, peak);
+	}
+
+	return highestPeak;
+}
+
+int SampleImportAnalyser::getRootNoteForPitch(double pitch)
+{
+	if (pitch <= 0.0)
+		return -1;
+
+	if (pitch < MidiMessage::getMidiNoteInHertz(1) / 2.0)
+		return 0;
+
+	for (int i = 1; i < 126; i++)
+	{
+		const double thisPitch = MidiMessage::getMidiNoteInHertz(i);
+		const double nextPitch = MidiMessage::getMidiNoteInHertz(i + 1);
+		const double prevPitch = MidiMessage::getMidiNoteInHertz(i - 1);
+
+		const double lowerLimit = thisPitch - (thisPitch - prevPitch) * 0.5;
+		const double upperLimit = thisPitch + (nextPitch - thisPitch) * 0.5;
+
+		if (Range<double>(lowerLimit, upperLimit).contains(pitch))
+			return i;
+	}
+
+	return -1;
+}
+
+int64 SampleImportAnalyser::getFileHash(const File &f)
+{
+	return f.hashCode64() ^ (f.getSize() * 31) ^ (f.getLastModificationTime().toMilliseconds() * 17);
+}
@@ -35,6 +35,66 @@
 
 class FileNameImporterDialog;
 
+/** Analyses audio files for the import on a pool of worker threads.
+*	@ingroup sampler
+*
+*	Every file is decoded once in chunks and scanned for its peak level, its thumbnail and (optionally) its pitch.
+*	The results are cached in the ModulatorSamplerSoundPool with a hash of the file's path, size and modification
+*	date, so importing the same files again skips the scanning.
+*/
+class SampleImportAnalyser
+{
+public:
+
+	using Analysis = ModulatorSamplerSoundPool::ImportAnalysis;
+
+	SampleImportAnalyser(ModulatorSampler *sampler, const StringArray &fileNames, bool detectPitch);
+
+	~SampleImportAnalyser();
+
+	/** Analyses all files and reports the progress for each file to the window. 
+	*
+	*	Call this from the window's thread. Returns false if the thread should exit before all files were analysed.
+	*/
+	bool analyse(ThreadWithAsyncProgressWindow &progressWindow);
+
+	/** Returns the analysis of the file or an empty analysis if the file wasn't part of the list. */
+	const Analysis &getAnalysis(const String &fileName) const;
+
+	/** Returns the highest peak of all files (eg. all mic positions of a sample) or -1 if no peak was found. */
+	float getHighestPeak(const StringArray &fileNames) const;
+
+	/** Returns the MIDI note that contains the frequency or -1 if the frequency is outside the MIDI range. */
+	static int getRootNoteForPitch(double pitch);
+
+	/** Creates a hash from the path, the size and the modification date of the file. */
+	static int64 getFileHash(const File &f);
+
+private:
+
+	class AnalysisJob;
+
+	void analyseFile(int index);
+
+	void createAnalysis(const File &f, Analysis &a) const;
+
+	static int getNumAnalysisThreads();
+
+	ModulatorSampler *sampler;
+	ModulatorSamplerSoundPool *pool;
+
+	const StringArray fileNames;
+	const bool detectPitch;
+
+	Array<Analysis> results;
+	HashMap<String, int> fileIndexes;
+
+	Atomic<int> nextIndex;
+	Atomic<int> numAnalysed;
+
+	Analysis emptyAnalysis;
+};
+
 class FileImportDialogWindow : public ThreadWithAsyncProgressWindow
 {
 public:
@@ -54,6 +114,23 @@ private:
 	const StringArray &files;
 };
 
+/** Analyses the dropped files in the background and maps them to their detected root notes. */
+class PitchDetectionImportWindow : public ThreadWithAsyncProgressWindow
+{
+public:
+
+	PitchDetectionImportWindow(ModulatorSampler *sampler, const StringArray &files);
+
+	void threadFinished() override;
+
+	void run() override;
+
+private:
+
+	ModulatorSampler *sampler;
+	const StringArray files;
+};
+
 
 
 /** This class handles all import logic for different sample formats.
@@ -109,7 +186,8 @@ public:
 			lowVelocity(0),
 			hiVelocity(127),
 			group(1),
-			multiMic(1)
+			multiMic(1),
+			normalizedPeak(-1.0f)
 		{};
 
 		int index;
@@ -122,6 +200,9 @@ public:
 		int group;
 		int multiMic;
 
+		/** the normalization gain if the peak was already calculated or -1. */
+		float normalizedPeak;
+
 		String toString()
 		{
 			String s;
@@ -1199,6 +1199,17 @@ StereoChannelData SampleLoader::fillVoiceBuffer(AudioSampleBuffer &voiceBuffer,
 	}
 }
 
+void SampleLoader::waitForPendingData() const noexcept
+{
+#if NEW_THREAD_POOL_IMPLEMENTATION
+	if (backgroundPool->isWaitingForPendingJobs())
+	{
+		while (isQueued())
+			Thread::yield();
+	}
+#endif
+}
+
 bool SampleLoader::advanceReadIndex(double uptime)
 {
 	const int numSamplesInBuffer = readBuffer.get()->getNumSamples();
@@ -1269,7 +1280,13 @@ SampleThreadPoolJob::JobStatus SampleLoader::runJob()
         voiceCounterWasIncreased = true;
     }
     
+    const bool traceRead = logger->isLogging();
+
+    if (traceRead) logger->traceDiskRead(true);
+
     fillInactiveBuffer();
+
+    if (traceRead) logger->traceDiskRead(false);
     
     writeBufferIsBeingFilled = false;
     
@@ -1501,6 +1518,8 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 		jassert(tempVoiceBuffer != nullptr);
 
 		tempVoiceBuffer->clear();
+
+		loader.waitForPendingData();
         
 		// Copy the not resampled values into the voice buffer.
 		StereoChannelData data = loader.fillVoiceBuffer(*tempVoiceBuffer, pitchCounter + startAlpha);
@@ -246,6 +246,10 @@ public:
     int64 getMonolithLength() const { return fileReader.getMonolithLength(); }
     double getMonolithSampleRate() const { return fileReader.getMonolithSampleRate(); }
     
+	MonolithInfoToUse* getMonolithicInfo() const { return fileReader.getMonolithicInfo(); }
+	int getMonolithicSampleIndex() const { return fileReader.getMonolithicSampleIndex(); }
+	int getMonolithicChannelIndex() const { return fileReader.getMonolithicChannelIndex(); }
+    
 	// ==============================================================================================================================================
 
 	String getFileName(bool getFullPath = false) const;
@@ -364,6 +368,10 @@ private:
 		bool isOpened() const noexcept { return fileHandlesOpen; }
 		bool isMonolithic() const noexcept{ return monolithicInfo != nullptr; }
 
+		MonolithInfoToUse* getMonolithicInfo() const noexcept { return monolithicInfo.get(); }
+		int getMonolithicSampleIndex() const noexcept { return monolithicIndex; }
+		int getMonolithicChannelIndex() const noexcept { return monolithicChannelIndex; }
+
 		bool isMissing() const { return missing; }
 		void setMissing() { missing = true; }
 
@@ -569,6 +577,9 @@ public:
     /** Advances the read index and returns `false` if the streaming thread is blocked. */
 	bool advanceReadIndex(double uptime);
 
+	/** Blocks until the streaming thread has filled the next buffer if the thread pool waits for pending jobs (non realtime rendering). */
+	void waitForPendingData() const noexcept;
+
 	/** Call this whenever a sound was started.
 	*
 	*	This will set the read pointer to the preload buffer of the StreamingSamplerSound and start the background reading.
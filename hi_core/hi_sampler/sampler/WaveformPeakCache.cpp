@@ -0,0 +1,438 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace PeakFileHelpers
+{
+	static int16 toInt16(float value)
+	{
+		return (int16)jlimit<int>(-32768, 32767, roundToInt(value * 32767.0f));
+	}
+
+	static float toFloat(int value)
+	{
+		return (float)value / 32767.0f;
+	}
+
+	static const int maxPeaksInLastLevel = 256;
+	static const int fileVersion = 1;
+}
+
+WaveformPeakFile::WaveformPeakFile(const File &peakFile)
+{
+	mappedFile = new MemoryMappedFile(peakFile, MemoryMappedFile::readOnly);
+
+	if (mappedFile->getData() == nullptr || mappedFile->getSize() < sizeof(Header))
+		return;
+
+	const Header *header = static_cast<const Header*>(mappedFile->getData());
+
+	if (memcmp(header->magic, "HPKF", 4) != 0 || 
+		header->version != PeakFileHelpers::fileVersion || 
+		header->numChannels <= 0 || 
+		header->numLevels <= 0 || 
+		header->lengthInSamples <= 0)
+		return;
+
+	int64 offset = sizeof(Header);
+
+	for (int i = 0; i < header->numLevels; i++)
+	{
+		levelOffsets.add(offset);
+		offset += getNumPeaks(header->lengthInSamples, i) * header->numChannels * (int64)sizeof(Peak);
+	}
+
+	if (offset > (int64)mappedFile->getSize())
+	{
+		// Truncated file
+		levelOffsets.clear();
+		return;
+	}
+
+	numChannels = header->numChannels;
+	lengthInSamples = header->lengthInSamples;
+	sampleRate = header->sampleRate;
+	numLevels = header->numLevels;
+}
+
+int WaveformPeakFile::getLevelForSamplesPerPixel(double samplesPerPixel) const
+{
+	int level = 0;
+
+	while (level < numLevels - 1 && (double)((int64)baseSamplesPerPeak << (level + 1)) <= samplesPerPixel)
+		level++;
+
+	return level;
+}
+
+void WaveformPeakFile::getRange(int level, int channel, int64 startSample, int64 endSample, float &minValue, float &maxValue, float &rms) const
+{
+	const int64 samplesPerPeak = (int64)baseSamplesPerPeak << level;
+	const int64 numPeaks = getNumPeaks(lengthInSamples, level);
+
+	const int64 firstPeak = jlimit<int64>(0, numPeaks - 1, startSample / samplesPerPeak);
+	const int64 lastPeak = jlimit<int64>(firstPeak, numPeaks - 1, (endSample - 1) / samplesPerPeak);
+
+	const Peak *peaks = getPeaks(level, channel);
+
+	int minInt = 32767;
+	int maxInt = -32768;
+	double sumOfSquares = 0.0;
+
+	for (int64 i = firstPeak; i <= lastPeak; i++)
+	{
+		minInt = jmin<int>(minInt, peaks[i].minValue);
+		maxInt = jmax<int>(maxInt, peaks[i].maxValue);
+		sumOfSquares += (double)peaks[i].rms * (double)peaks[i].rms;
+	}
+
+	minValue = PeakFileHelpers::toFloat(minInt);
+	maxValue = PeakFileHelpers::toFloat(maxInt);
+	rms = PeakFileHelpers::toFloat((int)std::sqrt(sumOfSquares / (double)(lastPeak - firstPeak + 1)));
+}
+
+void WaveformPeakFile::drawChannels(Graphics &g, const Rectangle<int> &area, int64 startSample, int64 endSample, float verticalZoomFactor) const
+{
+	if (!isValid() || area.isEmpty() || endSample <= startSample) return;
+
+	const Rectangle<int> visibleArea = area.getIntersection(g.getClipBounds());
+
+	if (visibleArea.isEmpty()) return;
+
+	const double samplesPerPixel = (double)(endSample - startSample) / (double)area.getWidth();
+	const int level = getLevelForSamplesPerPixel(samplesPerPixel);
+
+	const float channelHeight = (float)area.getHeight() / (float)numChannels;
+	const float halfHeight = channelHeight * 0.5f;
+
+	RectangleList<float> peakRectangles;
+	RectangleList<float> rmsRectangles;
+
+	for (int c = 0; c < numChannels; c++)
+	{
+		const float centreY = (float)area.getY() + (float)c * channelHeight + halfHeight;
+
+		for (int x = visibleArea.getX(); x < visibleArea.getRight(); x++)
+		{
+			const int64 start = startSample + (int64)((double)(x - area.getX()) * samplesPerPixel);
+			const int64 end = jmax<int64>(start + 1, startSample + (int64)((double)(x - area.getX() + 1) * samplesPerPixel));
+
+			float minValue, maxValue, rms;
+
+			getRange(level, c, start, end, minValue, maxValue, rms);
+
+			minValue = jlimit<float>(-1.0f, 1.0f, minValue * verticalZoomFactor);
+			maxValue = jlimit<float>(-1.0f, 1.0f, maxValue * verticalZoomFactor);
+			rms = jlimit<float>(0.0f, 1.0f, rms * verticalZoomFactor);
+
+			peakRectangles.addWithoutMerging(Rectangle<float>((float)x, centreY - maxValue * halfHeight, 1.0f, jmax<float>(1.0f, (maxValue - minValue) * halfHeight)));
+
+			if (rms > 0.0f)
+				rmsRectangles.addWithoutMerging(Rectangle<float>((float)x, centreY - rms * halfHeight, 1.0f, 2.0f * rms * halfHeight));
+		}
+	}
+
+	g.fillRectList(peakRectangles);
+
+	// Drawing the RMS with the same (transparent) colour again makes it stand out
+	g.fillRectList(rmsRectangles);
+}
+
+bool WaveformPeakFile::writePeakFile(AudioFormatReader &reader, const File &targetFile, Thread *threadToCheck)
+{
+	const int numChannels = (int)reader.numChannels;
+	const int64 length = reader.lengthInSamples;
+
+	if (numChannels <= 0 || length <= 0) return false;
+
+	int numLevels = 1;
+
+	while (getNumPeaks(length, numLevels - 1) > PeakFileHelpers::maxPeaksInLastLevel)
+		numLevels++;
+
+	// levels[level][channel]
+	std::vector<std::vector<std::vector<Peak>>> levels((size_t)numLevels);
+
+	for (int l = 0; l < numLevels; l++)
+	{
+		levels[l].resize((size_t)numChannels);
+
+		for (int c = 0; c < numChannels; c++)
+			levels[l][c].reserve((size_t)getNumPeaks(length, l));
+	}
+
+	// The first level is calculated from the audio data
+
+	AudioSampleBuffer chunk(numChannels, baseSamplesPerPeak * 1024);
+
+	for (int64 chunkStart = 0; chunkStart < length; chunkStart += chunk.getNumSamples())
+	{
+		if (threadToCheck != nullptr && threadToCheck->threadShouldExit())
+			return false;
+
+		const int numSamples = (int)jmin<int64>(chunk.getNumSamples(), length - chunkStart);
+
+		reader.read(&chunk, 0, numSamples, chunkStart, true, true);
+
+		for (int c = 0; c < numChannels; c++)
+		{
+			for (int i = 0; i < numSamples; i += baseSamplesPerPeak)
+			{
+				const int numSamplesInPeak = jmin<int>(baseSamplesPerPeak, numSamples - i);
+
+				const Range<float> range = FloatVectorOperations::findMinAndMax(chunk.getReadPointer(c, i), numSamplesInPeak);
+
+				Peak p;
+
+				p.minValue = PeakFileHelpers::toInt16(range.getStart());
+				p.maxValue = PeakFileHelpers::toInt16(range.getEnd());
+				p.rms = PeakFileHelpers::toInt16(chunk.getRMSLevel(c, i, numSamplesInPeak));
+
+				levels[0][c].push_back(p);
+			}
+		}
+	}
+
+	// Every other level combines two peaks of the previous level
+
+	for (int l = 1; l < numLevels; l++)
+	{
+		for (int c = 0; c < numChannels; c++)
+		{
+			const std::vector<Peak> &source = levels[l - 1][c];
+			std::vector<Peak> &destination = levels[l][c];
+
+			for (size_t i = 0; i < source.size(); i += 2)
+			{
+				const Peak &first = source[i];
+				const Peak &second = (i + 1 < source.size()) ? source[i + 1] : source[i];
+
+				Peak p;
+
+				p.minValue = jmin<int16>(first.minValue, second.minValue);
+				p.maxValue = jmax<int16>(first.maxValue, second.maxValue);
+				p.rms = (int16)std::sqrt(((double)first.rms * (double)first.rms + (double)second.rms * (double)second.rms) * 0.5);
+
+				destination.push_back(p);
+			}
+		}
+	}
+
+	targetFile.getParentDirectory().createDirectory();
+
+	TemporaryFile tempFile(targetFile);
+
+	{
+		FileOutputStream fos(tempFile.getFile());
+
+		if (fos.failedToOpen()) return false;
+
+		Header header;
+
+		memcpy(header.magic, "HPKF", 4);
+		header.version = PeakFileHelpers::fileVersion;
+		header.numChannels = numChannels;
+		header.numLevels = numLevels;
+		header.lengthInSamples = length;
+		header.sampleRate = reader.sampleRate;
+
+		fos.write(&header, sizeof(Header));
+
+		for (int l = 0; l < numLevels; l++)
+		{
+			for (int c = 0; c < numChannels; c++)
+			{
+				jassert((int64)levels[l][c].size() == getNumPeaks(length, l));
+
+				fos.write(levels[l][c].data(), levels[l][c].size() * sizeof(Peak));
+			}
+		}
+
+		fos.flush();
+
+		if (fos.getStatus().failed()) return false;
+	}
+
+	return tempFile.overwriteTargetFileWithTemporary();
+}
+
+int64 WaveformPeakFile::getNumPeaks(int64 lengthInSamples, int level)
+{
+	const int64 samplesPerPeak = (int64)baseSamplesPerPeak << level;
+
+	return (lengthInSamples + samplesPerPeak - 1) / samplesPerPeak;
+}
+
+const WaveformPeakFile::Peak * WaveformPeakFile::getPeaks(int level, int channel) const
+{
+	const char *levelData = static_cast<const char*>(mappedFile->getData()) + levelOffsets[level];
+
+	return reinterpret_cast<const Peak*>(levelData) + getNumPeaks(lengthInSamples, level) * channel;
+}
+
+// ====================================================================================================================
+
+WaveformPeakCache::WaveformPeakCache() :
+	Thread("Waveform Peak Cache")
+{
+}
+
+WaveformPeakCache::~WaveformPeakCache()
+{
+	stopThread(3000);
+}
+
+WaveformPeakFile::Ptr WaveformPeakCache::getPeakFile(StreamingSamplerSound *sound)
+{
+	if (sound == nullptr) return WaveformPeakFile::Ptr();
+
+	const int64 key = getKey(sound);
+
+	if (key == 0) return WaveformPeakFile::Ptr();
+
+	ScopedLock sl(lock);
+
+	if (openedFiles.contains(key)) return openedFiles[key];
+
+	if (failedKeys.contains(key)) return WaveformPeakFile::Ptr();
+
+	const File peakFile = getPeakFileForKey(key);
+
+	if (peakFile.existsAsFile())
+	{
+		WaveformPeakFile::Ptr p = new WaveformPeakFile(peakFile);
+
+		if (p->isValid())
+		{
+			openedFiles.set(key, p);
+			return p;
+		}
+
+		// A peak file of an older version or a corrupt file will be recreated
+		p = nullptr;
+		peakFile.deleteFile();
+	}
+
+	for (int i = 0; i < pendingJobs.size(); i++)
+	{
+		if (pendingJobs[i].key == key) return WaveformPeakFile::Ptr();
+	}
+
+	Job newJob;
+
+	newJob.key = key;
+	newJob.sound = sound;
+
+	pendingJobs.add(newJob);
+
+	if (isThreadRunning()) notify();
+	else startThread(3);
+
+	return WaveformPeakFile::Ptr();
+}
+
+File WaveformPeakCache::getPeakFileDirectory()
+{
+	File directory = File(PresetHandler::getDataFolder()).getChildFile("PeakFiles");
+
+	if (!directory.isDirectory()) directory.createDirectory();
+
+	return directory;
+}
+
+void WaveformPeakCache::run()
+{
+	while (!threadShouldExit())
+	{
+		Job job;
+
+		{
+			ScopedLock sl(lock);
+
+			if (pendingJobs.size() != 0) job = pendingJobs.removeAndReturn(0);
+		}
+
+		if (job.sound == nullptr)
+		{
+			wait(1000);
+			continue;
+		}
+
+		ScopedPointer<AudioFormatReader> reader = createReader(job.sound);
+
+		const bool ok = reader != nullptr && WaveformPeakFile::writePeakFile(*reader, getPeakFileForKey(job.key), this);
+
+		reader = nullptr;
+		job.sound = nullptr;
+
+		if (threadShouldExit()) return;
+
+		if (!ok)
+		{
+			ScopedLock sl(lock);
+			failedKeys.add(job.key);
+		}
+		else sendChangeMessage();
+	}
+}
+
+int64 WaveformPeakCache::getKey(StreamingSamplerSound *sound)
+{
+	if (sound->isMonolithic())
+	{
+		const File monolithFile = sound->getMonolithicInfo()->getMonolithFile(0);
+
+		return (monolithFile.getFullPathName() + sound->getFileName(true)).hashCode64() ^
+			   (sound->getMonolithOffset() * 31) ^
+			   (sound->getMonolithLength() * 17) ^
+			   monolithFile.getLastModificationTime().toMilliseconds();
+	}
+
+	const File sampleFile(sound->getFileName(true));
+
+	if (!sampleFile.existsAsFile()) return 0;
+
+	return sampleFile.hashCode64() ^
+		   (sampleFile.getSize() * 31) ^
+		   (sampleFile.getLastModificationTime().toMilliseconds() * 17);
+}
+
+File WaveformPeakCache::getPeakFileForKey(int64 key)
+{
+	return getPeakFileDirectory().getChildFile(String::toHexString(key) + ".hpk");
+}
+
+AudioFormatReader * WaveformPeakCache::createReader(StreamingSamplerSound *sound)
+{
+	if (sound->isMonolithic()) return sound->createReaderForPreview();
+
+	return PresetHandler::getReaderForFile(File(sound->getFileName(true)));
+}
@@ -0,0 +1,171 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef WAVEFORMPEAKCACHE_H_INCLUDED
+#define WAVEFORMPEAKCACHE_H_INCLUDED
+
+/** A persistent multi resolution summary of the waveform of a sample.
+*	@ingroup sampler
+*
+*	The first level stores one min / max / RMS triple per 64 samples and every following level halves the
+*	resolution until a level fits on a screen. The file is memory mapped, so drawing the waveform only
+*	touches the pages of the level that matches the current zoom factor and never reads the audio file.
+*
+*	Use the WaveformPeakCache to get the peak file of a sample.
+*/
+class WaveformPeakFile : public ReferenceCountedObject
+{
+public:
+
+	typedef ReferenceCountedObjectPtr<WaveformPeakFile> Ptr;
+
+	/** One entry of a level. The values are normalised to the int16 range. */
+	struct Peak
+	{
+		int16 minValue;
+		int16 maxValue;
+		int16 rms;
+	};
+
+	/** Opens an existing peak file. Check isValid() before using it. */
+	WaveformPeakFile(const File &peakFile);
+
+	bool isValid() const noexcept { return numLevels > 0; }
+
+	int getNumChannels() const noexcept { return numChannels; }
+
+	int64 getLengthInSamples() const noexcept { return lengthInSamples; }
+
+	double getSampleRate() const noexcept { return sampleRate; }
+
+	/** Returns the level with the lowest resolution that still has one peak per pixel. */
+	int getLevelForSamplesPerPixel(double samplesPerPixel) const;
+
+	/** Calculates the min / max / RMS values of the sample range using the given level. */
+	void getRange(int level, int channel, int64 startSample, int64 endSample, float &minValue, float &maxValue, float &rms) const;
+
+	/** Draws the channels stacked on top of each other (like AudioThumbnail::drawChannels()).
+	*
+	*	Only the part within the clip bounds of the Graphics context is drawn.
+	*/
+	void drawChannels(Graphics &g, const Rectangle<int> &area, int64 startSample, int64 endSample, float verticalZoomFactor) const;
+
+	/** Reads the audio data from the reader and writes the peak file. 
+	*
+	*	The file is written to a temporary file first, so an aborted scan never leaves a broken peak file.
+	*/
+	static bool writePeakFile(AudioFormatReader &reader, const File &targetFile, Thread *threadToCheck = nullptr);
+
+	/** The amount of samples per peak in the first level. */
+	static const int baseSamplesPerPeak = 64;
+
+private:
+
+	struct Header
+	{
+		char magic[4];
+		int32 version;
+		int32 numChannels;
+		int32 numLevels;
+		int64 lengthInSamples;
+		double sampleRate;
+	};
+
+	static int64 getNumPeaks(int64 lengthInSamples, int level);
+
+	const Peak *getPeaks(int level, int channel) const;
+
+	ScopedPointer<MemoryMappedFile> mappedFile;
+
+	int numChannels = 0;
+	int numLevels = 0;
+	int64 lengthInSamples = 0;
+	double sampleRate = 0.0;
+
+	Array<int64> levelOffsets;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformPeakFile)
+};
+
+/** Creates and manages the peak files of the samples that are displayed in the sample editor.
+*	@ingroup sampler
+*
+*	The peak files are stored in the HISE data folder with a hash of the sample (the file path, size and
+*	modification date or the monolith position) as file name, so they are reused across sessions and projects.
+*	Missing peak files are created on a background thread and the listeners are notified when a file is ready.
+*
+*	Use it with a SharedResourcePointer, so all waveform components share the same instance.
+*/
+class WaveformPeakCache : public SafeChangeBroadcaster,
+						  private Thread
+{
+public:
+
+	WaveformPeakCache();
+
+	~WaveformPeakCache();
+
+	/** Returns the peak file of the sound or nullptr if it doesn't exist yet. 
+	*
+	*	In this case, it will be created in the background and a change message is sent when it is ready.
+	*/
+	WaveformPeakFile::Ptr getPeakFile(StreamingSamplerSound *sound);
+
+	/** Returns the directory where the peak files are stored. */
+	static File getPeakFileDirectory();
+
+private:
+
+	struct Job
+	{
+		int64 key = 0;
+		StreamingSamplerSound::Ptr sound;
+	};
+
+	void run() override;
+
+	static int64 getKey(StreamingSamplerSound *sound);
+
+	static File getPeakFileForKey(int64 key);
+
+	static AudioFormatReader *createReader(StreamingSamplerSound *sound);
+
+	CriticalSection lock;
+
+	HashMap<int64, WaveformPeakFile::Ptr> openedFiles;
+	Array<Job> pendingJobs;
+	Array<int64> failedKeys;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformPeakCache)
+};
+
+#endif  // WAVEFORMPEAKCACHE_H_INCLUDED
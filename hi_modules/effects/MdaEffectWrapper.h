@@ -162,22 +162,20 @@ public:
 		inputData[0] = inputBuffer.getWritePointer(0, startSample);
 		inputData[1] = inputBuffer.getWritePointer(1, startSample);
 
-		currentValues.inL = FloatVectorOperations::findMaximum(inputData[0], numSamples);
-		currentValues.inR = FloatVectorOperations::findMaximum(inputData[1], numSamples);
+		if (hasPeakMeterSubscribers())
+		{
+			currentValues.inL = FloatVectorOperations::findMaximum(inputData[0], numSamples);
+			currentValues.inR = FloatVectorOperations::findMaximum(inputData[1], numSamples);
+		}
 
 		float *outputData[2];
 
 		outputData[0] = buffer.getWritePointer(0, startSample);
 		outputData[1] = buffer.getWritePointer(1, startSample);
 
-		currentValues.outL = outputData[0][startSample];
-		currentValues.outR = outputData[1][startSample];
-
+		// the output levels are pushed to the peak meter ring by renderWholeBuffer()
 		effect->processReplacing(inputData, outputData, numSamples);
 
-		currentValues.outL = FloatVectorOperations::findMaximum(outputData[0], numSamples);
-		currentValues.outR = FloatVectorOperations::findMaximum(outputData[1], numSamples);
-
 		//sendChangeMessage();
 	};
 
@@ -58,7 +58,9 @@ rampFlag(false),
 rampIndex(0),
 processFlag(true),
 loadAfterProcessFlag(false),
-isCurrentlyProcessing(false)
+isCurrentlyProcessing(false),
+wetPeakL(0.0f),
+wetPeakR(0.0f)
 {
 	wetBuffer = AudioSampleBuffer(2, 0);
 
@@ -186,6 +188,14 @@ void ConvolutionEffect::prepareToPlay(double sampleRate, int samplesPerBlock)
 	
 }
 
+double ConvolutionEffect::getTailLengthInSeconds() const
+{
+	// The partitioned engine delays the tail by up to its biggest FFT block, so add this on top of the impulse length
+	const int maxPartitionLatency = 32768;
+
+	return (double)(getRange().getLength() + maxPartitionLatency) / getSampleRate();
+}
+
 void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample, int numSamples)
 {
 	ADD_GLITCH_DETECTOR(this, DebugLogger::Location::ConvolutionRendering);
@@ -209,8 +219,13 @@ void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample,
 		smoothedGainerDry.processBlock(channels, 2, numSamples);
 
 #if ENABLE_ALL_PEAK_METERS
-		currentValues.inL = FloatVectorOperations::findMaximum(l, numSamples);
-		currentValues.inR = FloatVectorOperations::findMaximum(l, numSamples);
+		if (hasPeakMeterSubscribers())
+		{
+			currentValues.inL = FloatVectorOperations::findMaximum(l, numSamples);
+			currentValues.inR = FloatVectorOperations::findMaximum(r, numSamples);
+			wetPeakL = 0.0f;
+			wetPeakR = 0.0f;
+		}
 #endif
 
 		isCurrentlyProcessing.store(false);
@@ -222,8 +237,11 @@ void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample,
 	smoothedGainerDry.processBlock(channels, 2, numSamples);
 
 #if ENABLE_ALL_PEAK_METERS
-	currentValues.inL = FloatVectorOperations::findMaximum(l, numSamples);
-	currentValues.inR = FloatVectorOperations::findMaximum(l, numSamples);
+	if (hasPeakMeterSubscribers())
+	{
+		currentValues.inL = FloatVectorOperations::findMaximum(l, numSamples);
+		currentValues.inR = FloatVectorOperations::findMaximum(r, numSamples);
+	}
 #endif
 
 	const int availableSamples = jmin(convolutionEngine.Avail(numSamples), numSamples);
@@ -234,8 +252,11 @@ void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample,
 		const float *convolutedR = convolutionEngine.Get()[1];
 
 #if ENABLE_ALL_PEAK_METERS
-		currentValues.outL = wetGain * FloatVectorOperations::findMaximum(convolutedL, availableSamples);
-		currentValues.outR = wetGain * FloatVectorOperations::findMaximum(convolutedR, availableSamples);
+		if (hasPeakMeterSubscribers())
+		{
+			wetPeakL = wetGain * FloatVectorOperations::findMaximum(convolutedL, availableSamples);
+			wetPeakR = wetGain * FloatVectorOperations::findMaximum(convolutedR, availableSamples);
+		}
 #endif
 
 		if (rampFlag)
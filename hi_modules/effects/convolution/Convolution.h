@@ -229,6 +229,7 @@ public:
 	void prepareToPlay(double sampleRate, int samplesPerBlock) override;;
 	void applyEffect(AudioSampleBuffer &buffer, int startSample, int numSamples) override;;
 	bool hasTail() const override {return false; };
+	double getTailLengthInSeconds() const override;
 
 	int getNumChildProcessors() const override { return 0; };
 	Processor *getChildProcessor(int /*processorIndex*/) override { return nullptr; };
@@ -238,6 +239,9 @@ public:
 
 	const CriticalSection& getFileLock() const override { return unusedFileLock; }
 
+	/** Returns the peak level of the wet signal. The display values of the processor contain the levels of the whole output. */
+	float getWetPeakLevel(bool leftChannel) const noexcept { return leftChannel ? wetPeakL : wetPeakR; }
+
 private:
 
 	CriticalSection unusedFileLock;
@@ -273,6 +277,9 @@ private:
 	wdl::WDL_ConvolutionEngine_Div convolutionEngine;
 
 	double lastSampleRate = 0.0;
+
+	float wetPeakL;
+	float wetPeakR;
 };
 
 
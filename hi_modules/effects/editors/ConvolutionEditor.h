@@ -83,10 +83,12 @@ public:
 
 	void timerCallback()
 	{
-		EffectProcessor::DisplayValues d = dynamic_cast<EffectProcessor*>(getProcessor())->getDisplayValues();
+		ConvolutionEffect *convolution = dynamic_cast<ConvolutionEffect*>(getProcessor());
+
+		EffectProcessor::DisplayValues d = convolution->getDisplayValues();
 
 		dryMeter->setPeak(d.inL, d.inR);
-		wetMeter->setPeak(d.outL, d.outR);
+		wetMeter->setPeak(convolution->getWetPeakLevel(true), convolution->getWetPeakLevel(false));
 	}
 
 	int getBodyHeight() const override
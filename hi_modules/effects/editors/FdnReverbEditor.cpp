@@ -0,0 +1,290 @@
+/*
+  ==============================================================================
+
+  This is an automatically generated GUI class created by the Introjucer!
+
+  Be careful when adding custom code to these files, as only the code within
+  the "//[xyz]" and "//[/xyz]" sections will be retained when the file is loaded
+  and re-saved.
+
+  Created with Introjucer version: 4.1.0
+
+  ------------------------------------------------------------------------------
+
+  The Introjucer is part of the JUCE library - "Jules' Utility Class Extensions"
+  Copyright (c) 2015 - ROLI Ltd.
+
+  ==============================================================================
+*/
+
+//[Headers] You can add your own extra header files here...
+//[/Headers]
+
+#include "FdnReverbEditor.h"
+
+
+//[MiscUserDefs] You can add your own user definitions and misc code here...
+//[/MiscUserDefs]
+
+//==============================================================================
+FdnReverbEditor::FdnReverbEditor (ProcessorEditor *p)
+    : ProcessorEditorBody(p)
+{
+    //[Constructor_pre] You can add your own custom stuff here..
+    //[/Constructor_pre]
+
+    addAndMakeVisible (roomSlider = new HiSlider ("Room Size"));
+    roomSlider->setRange (0, 1, 0.01);
+    roomSlider->setSliderStyle (Slider::RotaryHorizontalVerticalDrag);
+    roomSlider->setTextBoxStyle (Slider::TextBoxRight, false, 80, 20);
+    roomSlider->addListener (this);
+
+    addAndMakeVisible (decaySlider = new HiSlider ("Decay"));
+    decaySlider->setRange (0.3, 20, 0.1);
+    decaySlider->setSliderStyle (Slider::RotaryHorizontalVerticalDrag);
+    decaySlider->setTextBoxStyle (Slider::TextBoxRight, false, 80, 20);
+    decaySlider->addListener (this);
+
+    addAndMakeVisible (preDelaySlider = new HiSlider ("PreDelay"));
+    preDelaySlider->setRange (0, 200, 1);
+    preDelaySlider->setSliderStyle (Slider::RotaryHorizontalVerticalDrag);
+    preDelaySlider->setTextBoxStyle (Slider::TextBoxRight, false, 80, 20);
+    preDelaySlider->addListener (this);
+
+    addAndMakeVisible (dampingSlider = new HiSlider ("Damping"));
+    dampingSlider->setRange (0, 1, 0.01);
+    dampingSlider->setSliderStyle (Slider::RotaryHorizontalVerticalDrag);
+    dampingSlider->setTextBoxStyle (Slider::TextBoxRight, false, 80, 20);
+    dampingSlider->addListener (this);
+
+    addAndMakeVisible (widthSlider = new HiSlider ("Width"));
+    widthSlider->setRange (0, 1, 0.01);
+    widthSlider->setSliderStyle (Slider::RotaryHorizontalVerticalDrag);
+    widthSlider->setTextBoxStyle (Slider::TextBoxRight, false, 80, 20);
+    widthSlider->addListener (this);
+
+    addAndMakeVisible (wetSlider = new HiSlider ("Wet"));
+    wetSlider->setRange (0, 1, 0.01);
+    wetSlider->setSliderStyle (Slider::RotaryHorizontalVerticalDrag);
+    wetSlider->setTextBoxStyle (Slider::TextBoxRight, false, 80, 20);
+    wetSlider->addListener (this);
+
+    addAndMakeVisible (qualitySelector = new HiComboBox ("new combo box"));
+    qualitySelector->setEditableText (false);
+    qualitySelector->setJustificationType (Justification::centredLeft);
+    qualitySelector->setTextWhenNothingSelected (TRANS("Quality"));
+    qualitySelector->setTextWhenNoChoicesAvailable (TRANS("(no choices)"));
+    qualitySelector->addItem (TRANS("Low Quality"), 1);
+    qualitySelector->addItem (TRANS("Medium Quality"), 2);
+    qualitySelector->addItem (TRANS("High Quality"), 3);
+    qualitySelector->addItem (TRANS("Ultra Quality"), 4);
+    qualitySelector->addListener (this);
+
+
+    //[UserPreSize]
+
+	roomSlider->setup(getProcessor(), FdnReverbEffect::RoomSize, "Room Size");
+	roomSlider->setMode(HiSlider::NormalizedPercentage);
+
+	decaySlider->setup(getProcessor(), FdnReverbEffect::DecayTime, "Decay Time");
+	decaySlider->setMode(HiSlider::Linear, 0.3, 20.0, 2.5);
+	decaySlider->setTextValueSuffix(" s");
+
+	preDelaySlider->setup(getProcessor(), FdnReverbEffect::PreDelay, "Pre Delay");
+	preDelaySlider->setMode(HiSlider::Time, 0.0, 200.0, 30.0);
+
+	dampingSlider->setup(getProcessor(), FdnReverbEffect::Damping, "Damping");
+	dampingSlider->setMode(HiSlider::NormalizedPercentage);
+
+	widthSlider->setup(getProcessor(), FdnReverbEffect::Width, "Stereo Width");
+	widthSlider->setMode(HiSlider::NormalizedPercentage);
+
+	wetSlider->setup(getProcessor(), FdnReverbEffect::WetLevel, "Wet Level");
+	wetSlider->setMode(HiSlider::NormalizedPercentage);
+
+	qualitySelector->setup(getProcessor(), FdnReverbEffect::Quality, "Quality");
+
+    //[/UserPreSize]
+
+    setSize (900, 136);
+
+
+    //[Constructor] You can add your own custom stuff here..
+	h = getHeight();
+    //[/Constructor]
+}
+
+FdnReverbEditor::~FdnReverbEditor()
+{
+    //[Destructor_pre]. You can add your own custom destruction code here..
+    //[/Destructor_pre]
+
+    roomSlider = nullptr;
+    decaySlider = nullptr;
+    preDelaySlider = nullptr;
+    dampingSlider = nullptr;
+    widthSlider = nullptr;
+    wetSlider = nullptr;
+    qualitySelector = nullptr;
+
+
+    //[Destructor]. You can add your own custom destruction code here..
+    //[/Destructor]
+}
+
+//==============================================================================
+void FdnReverbEditor::paint (Graphics& g)
+{
+    //[UserPrePaint] Add your own custom painting code here..
+    //[/UserPrePaint]
+
+    g.setColour (Colour (0x30000000));
+    g.fillRoundedRectangle (static_cast<float> ((getWidth() / 2) - ((getWidth() - 84) / 2)), 6.0f, static_cast<float> (getWidth() - 84), static_cast<float> (getHeight() - 12), 6.000f);
+
+    g.setColour (Colour (0x25ffffff));
+    g.drawRoundedRectangle (static_cast<float> ((getWidth() / 2) - ((getWidth() - 84) / 2)), 6.0f, static_cast<float> (getWidth() - 84), static_cast<float> (getHeight() - 12), 6.000f, 2.000f);
+
+    g.setColour (Colour (0x52ffffff));
+    g.setFont (Font ("Arial", 24.00f, Font::bold));
+    g.drawText (TRANS("fdn reverb"),
+                getWidth() - 53 - 200, 6, 200, 40,
+                Justification::centredRight, true);
+
+    //[UserPaint] Add your own custom painting code here..
+    //[/UserPaint]
+}
+
+void FdnReverbEditor::resized()
+{
+    //[UserPreResize] Add your own custom resize code here..
+    //[/UserPreResize]
+
+    qualitySelector->setBounds ((getWidth() / 2) + -330, 24, 128, 24);
+    roomSlider->setBounds ((getWidth() / 2) + -170, 16, 128, 48);
+    decaySlider->setBounds ((getWidth() / 2) + -10, 16, 128, 48);
+    preDelaySlider->setBounds ((getWidth() / 2) + 150, 16, 128, 48);
+    dampingSlider->setBounds ((getWidth() / 2) + -170, 72, 128, 48);
+    widthSlider->setBounds ((getWidth() / 2) + -10, 72, 128, 48);
+    wetSlider->setBounds ((getWidth() / 2) + 150, 72, 128, 48);
+    //[UserResized] Add your own custom resize handling here..
+    //[/UserResized]
+}
+
+void FdnReverbEditor::sliderValueChanged (Slider* sliderThatWasMoved)
+{
+    //[UsersliderValueChanged_Pre]
+    //[/UsersliderValueChanged_Pre]
+
+    if (sliderThatWasMoved == roomSlider)
+    {
+        //[UserSliderCode_roomSlider] -- add your slider handling code here..
+        //[/UserSliderCode_roomSlider]
+    }
+    else if (sliderThatWasMoved == decaySlider)
+    {
+        //[UserSliderCode_decaySlider] -- add your slider handling code here..
+        //[/UserSliderCode_decaySlider]
+    }
+    else if (sliderThatWasMoved == preDelaySlider)
+    {
+        //[UserSliderCode_preDelaySlider] -- add your slider handling code here..
+        //[/UserSliderCode_preDelaySlider]
+    }
+    else if (sliderThatWasMoved == dampingSlider)
+    {
+        //[UserSliderCode_dampingSlider] -- add your slider handling code here..
+        //[/UserSliderCode_dampingSlider]
+    }
+    else if (sliderThatWasMoved == widthSlider)
+    {
+        //[UserSliderCode_widthSlider] -- add your slider handling code here..
+        //[/UserSliderCode_widthSlider]
+    }
+    else if (sliderThatWasMoved == wetSlider)
+    {
+        //[UserSliderCode_wetSlider] -- add your slider handling code here..
+        //[/UserSliderCode_wetSlider]
+    }
+
+    //[UsersliderValueChanged_Post]
+    //[/UsersliderValueChanged_Post]
+}
+
+void FdnReverbEditor::comboBoxChanged (ComboBox* comboBoxThatHasChanged)
+{
+    //[UsercomboBoxChanged_Pre]
+    //[/UsercomboBoxChanged_Pre]
+
+    if (comboBoxThatHasChanged == qualitySelector)
+    {
+        //[UserComboBoxCode_qualitySelector] -- add your combo box handling code here..
+        //[/UserComboBoxCode_qualitySelector]
+    }
+
+    //[UsercomboBoxChanged_Post]
+    //[/UsercomboBoxChanged_Post]
+}
+
+
+
+//[MiscUserCode] You can add your own definitions of your custom methods or any other code here...
+//[/MiscUserCode]
+
+
+//==============================================================================
+#if 0
+/*  -- Introjucer information section --
+
+    This is where the Introjucer stores the metadata that describe this GUI layout, so
+    make changes in here at your peril!
+
+BEGIN_JUCER_METADATA
+
+<JUCER_COMPONENT documentType="Component" className="FdnReverbEditor" componentName=""
+                 parentClasses="public ProcessorEditorBody" constructorParams="ProcessorEditor *p"
+                 variableInitialisers="ProcessorEditorBody(p)&#10;" snapPixels="8"
+                 snapActive="1" snapShown="1" overlayOpacity="0.330" fixedSize="1"
+                 initialWidth="900" initialHeight="136">
+  <BACKGROUND backgroundColour="ffffff">
+    <ROUNDRECT pos="-0.5Cc 6 84M 12M" cornerSize="6" fill="solid: 30000000"
+               hasStroke="1" stroke="2, mitered, butt" strokeColour="solid: 25ffffff"/>
+    <TEXT pos="53Rr 6 200 40" fill="solid: 52ffffff" hasStroke="0" text="fdn reverb"
+          fontname="Arial" fontsize="24" bold="1" italic="0" justification="34"/>
+  </BACKGROUND>
+  <COMBOBOX name="new combo box" id="4a2c6e1f0b3d5a78" memberName="qualitySelector"
+            virtualName="HiComboBox" explicitFocusOrder="0" pos="-330C 24 128 24"
+            editable="0" layout="33" items="Low Quality&#10;Medium Quality&#10;High Quality&#10;Ultra Quality"
+            textWhenNonSelected="Quality" textWhenNoItems="(no choices)"/>
+  <SLIDER name="Room Size" id="7d31a0c4e52b9f06" memberName="roomSlider" virtualName="HiSlider"
+          explicitFocusOrder="0" pos="-170C 16 128 48" min="0" max="1" int="0.01"
+          style="RotaryHorizontalVerticalDrag" textBoxPos="TextBoxRight"
+          textBoxEditable="1" textBoxWidth="80" textBoxHeight="20" skewFactor="1"/>
+  <SLIDER name="Decay" id="2e84c7b1f9a05d3c" memberName="decaySlider" virtualName="HiSlider"
+          explicitFocusOrder="0" pos="-10C 16 128 48" min="0.3" max="20" int="0.1"
+          style="RotaryHorizontalVerticalDrag" textBoxPos="TextBoxRight"
+          textBoxEditable="1" textBoxWidth="80" textBoxHeight="20" skewFactor="1"/>
+  <SLIDER name="PreDelay" id="91b6f2d84c0e7a15" memberName="preDelaySlider" virtualName="HiSlider"
+          explicitFocusOrder="0" pos="150C 16 128 48" min="0" max="200" int="1"
+          style="RotaryHorizontalVerticalDrag" textBoxPos="TextBoxRight"
+          textBoxEditable="1" textBoxWidth="80" textBoxHeight="20" skewFactor="1"/>
+  <SLIDER name="Damping" id="c5e0a9372f1b8d64" memberName="dampingSlider" virtualName="HiSlider"
+          explicitFocusOrder="0" pos="-170C 72 128 48" min="0" max="1" int="0.01"
+          style="RotaryHorizontalVerticalDrag" textBoxPos="TextBoxRight"
+          textBoxEditable="1" textBoxWidth="80" textBoxHeight="20" skewFactor="1"/>
+  <SLIDER name="Width" id="3f7b2d9e6a4c0185" memberName="widthSlider" virtualName="HiSlider"
+          explicitFocusOrder="0" pos="-10C 72 128 48" min="0" max="1" int="0.01"
+          style="RotaryHorizontalVerticalDrag" textBoxPos="TextBoxRight"
+          textBoxEditable="1" textBoxWidth="80" textBoxHeight="20" skewFactor="1"/>
+  <SLIDER name="Wet" id="a0d4e6f1b7c3952e" memberName="wetSlider" virtualName="HiSlider"
+          explicitFocusOrder="0" pos="150C 72 128 48" min="0" max="1" int="0.01"
+          style="RotaryHorizontalVerticalDrag" textBoxPos="TextBoxRight"
+          textBoxEditable="1" textBoxWidth="80" textBoxHeight="20" skewFactor="1"/>
+</JUCER_COMPONENT>
+
+END_JUCER_METADATA
+*/
+#endif
+
+
+//[EndFile] You can add extra defines here...
+//[/EndFile]
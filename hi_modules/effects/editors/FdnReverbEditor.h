@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+  This is an automatically generated GUI class created by the Introjucer!
+
+  Be careful when adding custom code to these files, as only the code within
+  the "//[xyz]" and "//[/xyz]" sections will be retained when the file is loaded
+  and re-saved.
+
+  Created with Introjucer version: 4.1.0
+
+  ------------------------------------------------------------------------------
+
+  The Introjucer is part of the JUCE library - "Jules' Utility Class Extensions"
+  Copyright (c) 2015 - ROLI Ltd.
+
+  ==============================================================================
+*/
+
+#ifndef __JUCE_HEADER_6B1F0D2C8A4E3F71__
+#define __JUCE_HEADER_6B1F0D2C8A4E3F71__
+
+//[Headers]     -- You can add your own extra header files here --
+
+//[/Headers]
+
+
+
+//==============================================================================
+/**
+                                                                    //[Comments]
+    \cond HIDDEN_SYMBOLS
+	An auto-generated component, created by the Introjucer.
+
+    Describe your class and how it works here!
+                                                                    //[/Comments]
+*/
+class FdnReverbEditor  : public ProcessorEditorBody,
+                         public SliderListener,
+                         public ComboBoxListener
+{
+public:
+    //==============================================================================
+    FdnReverbEditor (ProcessorEditor *p);
+    ~FdnReverbEditor();
+
+    //==============================================================================
+    //[UserMethods]     -- You can add your own custom methods in this section.
+
+	void updateGui()
+	{
+		roomSlider->updateValue();
+		decaySlider->updateValue();
+		preDelaySlider->updateValue();
+		dampingSlider->updateValue();
+		widthSlider->updateValue();
+		wetSlider->updateValue();
+		qualitySelector->updateValue();
+	};
+
+	int getBodyHeight() const override
+	{
+		return h;
+	}
+
+    //[/UserMethods]
+
+    void paint (Graphics& g);
+    void resized();
+    void sliderValueChanged (Slider* sliderThatWasMoved);
+    void comboBoxChanged (ComboBox* comboBoxThatHasChanged);
+
+
+
+private:
+    //[UserVariables]   -- You can add your own custom variables in this section.
+	int h;
+    //[/UserVariables]
+
+    //==============================================================================
+    ScopedPointer<HiSlider> roomSlider;
+    ScopedPointer<HiSlider> decaySlider;
+    ScopedPointer<HiSlider> preDelaySlider;
+    ScopedPointer<HiSlider> dampingSlider;
+    ScopedPointer<HiSlider> widthSlider;
+    ScopedPointer<HiSlider> wetSlider;
+    ScopedPointer<HiComboBox> qualitySelector;
+
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FdnReverbEditor)
+};
+
+//[EndFile] You can add extra defines here...
+/** \endcond */
+//[/EndFile]
+
+#endif   // __JUCE_HEADER_6B1F0D2C8A4E3F71__
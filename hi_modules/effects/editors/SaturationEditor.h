@@ -36,7 +36,8 @@
 */
 class SaturationEditor  : public ProcessorEditorBody,
                           public Timer,
-                          public SliderListener
+                          public SliderListener,
+                          public ComboBoxListener
 {
 public:
     //==============================================================================
@@ -59,12 +60,15 @@ public:
 		wetSlider->updateValue();
         pregainSlider->updateValue();
         postGainSlider->updateValue();
+		oversamplingSelector->updateValue();
+		filterSelector->setSelectedId(roundFloatToInt(getProcessor()->getAttribute(SaturatorEffect::OversamplingFilter)) + 1, dontSendNotification);
 	}
     //[/UserMethods]
 
     void paint (Graphics& g);
     void resized();
     void sliderValueChanged (Slider* sliderThatWasMoved);
+    void comboBoxChanged (ComboBox* comboBoxThatHasChanged);
 
 
 
@@ -78,6 +82,8 @@ private:
     ScopedPointer<HiSlider> wetSlider;
     ScopedPointer<HiSlider> pregainSlider;
     ScopedPointer<HiSlider> postGainSlider;
+    ScopedPointer<HiComboBox> oversamplingSelector;
+    ScopedPointer<ComboBox> filterSelector;
 
 
     //==============================================================================
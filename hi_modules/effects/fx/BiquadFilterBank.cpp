@@ -0,0 +1,243 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#if JUCE_INTEL && !JUCE_IOS
+#define HI_BIQUAD_BANK_USE_SSE 1
+#include <xmmintrin.h>
+#else
+#define HI_BIQUAD_BANK_USE_SSE 0
+#endif
+
+void BiquadFilterBank::process(Stage* const* stages, int numStages, AudioSampleBuffer& b, int startSample, int numSamples)
+{
+	if (numStages == 0 || numSamples <= 0)
+		return;
+
+	if (b.getNumChannels() >= 2)
+	{
+		processStereo(stages, numStages, b.getWritePointer(0, startSample), b.getWritePointer(1, startSample), numSamples);
+	}
+	else if (b.getNumChannels() == 1)
+	{
+		processMono(stages, numStages, b.getWritePointer(0, startSample), numSamples);
+	}
+}
+
+void BiquadFilterBank::processStereo(Stage* const* stages, int numStages, float* l, float* r, int numSamples)
+{
+	if (numSamples <= 0)
+		return;
+
+	int i = 0;
+
+#if HI_BIQUAD_BANK_USE_SSE
+	for (; i + 1 < numStages; i += 2)
+	{
+		processStagePairStereo(*stages[i], *stages[i + 1], l, r, numSamples);
+	}
+#endif
+
+	for (; i < numStages; i++)
+	{
+		processStageStereo(*stages[i], l, r, numSamples);
+	}
+}
+
+void BiquadFilterBank::processMono(Stage* const* stages, int numStages, float* d, int numSamples)
+{
+	for (int i = 0; i < numStages; i++)
+	{
+		processStageMono(*stages[i], d, numSamples);
+	}
+}
+
+void BiquadFilterBank::processStageStereo(Stage& s, float* l, float* r, int numSamples)
+{
+	const float c0 = s.c[0];
+	const float c1 = s.c[1];
+	const float c2 = s.c[2];
+	const float c3 = s.c[3];
+	const float c4 = s.c[4];
+
+	float l1 = s.s1[0], l2 = s.s2[0];
+	float r1 = s.s1[1], r2 = s.s2[1];
+
+	// The two channels are independent dependency chains, so interleaving them hides the latency of the feedback
+	for (int i = 0; i < numSamples; i++)
+	{
+		const float inL = l[i];
+		const float inR = r[i];
+
+		const float outL = c0 * inL + l1;
+		const float outR = c0 * inR + r1;
+
+		l[i] = outL;
+		r[i] = outR;
+
+		l1 = c1 * inL - c3 * outL + l2;
+		r1 = c1 * inR - c3 * outR + r2;
+
+		l2 = c2 * inL - c4 * outL;
+		r2 = c2 * inR - c4 * outR;
+	}
+
+	s.s1[0] = l1; s.s2[0] = l2;
+	s.s1[1] = r1; s.s2[1] = r2;
+
+	snapToZero(s);
+}
+
+void BiquadFilterBank::processStageMono(Stage& s, float* d, int numSamples)
+{
+	const float c0 = s.c[0];
+	const float c1 = s.c[1];
+	const float c2 = s.c[2];
+	const float c3 = s.c[3];
+	const float c4 = s.c[4];
+
+	float v1 = s.s1[0], v2 = s.s2[0];
+
+	for (int i = 0; i < numSamples; i++)
+	{
+		const float in = d[i];
+		const float out = c0 * in + v1;
+
+		d[i] = out;
+
+		v1 = c1 * in - c3 * out + v2;
+		v2 = c2 * in - c4 * out;
+	}
+
+	s.s1[0] = v1; s.s2[0] = v2;
+
+	snapToZero(s);
+}
+
+void BiquadFilterBank::processStagePairStereo(Stage& a, Stage& b, float* l, float* r, int numSamples)
+{
+#if HI_BIQUAD_BANK_USE_SSE
+
+	// The register layout is [aL, aR, bL, bR]. Stage b is fed with the output of stage a from the last
+	// iteration, so the first sample only runs through a and the last sample only runs through b.
+
+	float yL, yR;
+
+	{
+		const float inL = l[0];
+		const float inR = r[0];
+
+		yL = a.c[0] * inL + a.s1[0];
+		yR = a.c[0] * inR + a.s1[1];
+
+		a.s1[0] = a.c[1] * inL - a.c[3] * yL + a.s2[0];
+		a.s1[1] = a.c[1] * inR - a.c[3] * yR + a.s2[1];
+
+		a.s2[0] = a.c[2] * inL - a.c[4] * yL;
+		a.s2[1] = a.c[2] * inR - a.c[4] * yR;
+	}
+
+	if (numSamples > 1)
+	{
+		const __m128 c0 = _mm_setr_ps(a.c[0], a.c[0], b.c[0], b.c[0]);
+		const __m128 c1 = _mm_setr_ps(a.c[1], a.c[1], b.c[1], b.c[1]);
+		const __m128 c2 = _mm_setr_ps(a.c[2], a.c[2], b.c[2], b.c[2]);
+		const __m128 c3 = _mm_setr_ps(a.c[3], a.c[3], b.c[3], b.c[3]);
+		const __m128 c4 = _mm_setr_ps(a.c[4], a.c[4], b.c[4], b.c[4]);
+
+		__m128 s1 = _mm_setr_ps(a.s1[0], a.s1[1], b.s1[0], b.s1[1]);
+		__m128 s2 = _mm_setr_ps(a.s2[0], a.s2[1], b.s2[0], b.s2[1]);
+
+		__m128 y = _mm_setr_ps(yL, yR, 0.0f, 0.0f);
+
+		for (int i = 1; i < numSamples; i++)
+		{
+			const __m128 in = _mm_unpacklo_ps(_mm_load_ss(l + i), _mm_load_ss(r + i));
+			const __m128 x = _mm_movelh_ps(in, y);
+
+			y = _mm_add_ps(_mm_mul_ps(c0, x), s1);
+			s1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(c1, x), _mm_mul_ps(c3, y)), s2);
+			s2 = _mm_sub_ps(_mm_mul_ps(c2, x), _mm_mul_ps(c4, y));
+
+			const __m128 out = _mm_movehl_ps(y, y);
+
+			_mm_store_ss(l + i - 1, out);
+			_mm_store_ss(r + i - 1, _mm_shuffle_ps(out, out, _MM_SHUFFLE(1, 1, 1, 1)));
+		}
+
+		float tmp[4];
+
+		_mm_storeu_ps(tmp, s1);
+		a.s1[0] = tmp[0]; a.s1[1] = tmp[1]; b.s1[0] = tmp[2]; b.s1[1] = tmp[3];
+
+		_mm_storeu_ps(tmp, s2);
+		a.s2[0] = tmp[0]; a.s2[1] = tmp[1]; b.s2[0] = tmp[2]; b.s2[1] = tmp[3];
+
+		_mm_storeu_ps(tmp, y);
+		yL = tmp[0];
+		yR = tmp[1];
+	}
+
+	{
+		const float outL = b.c[0] * yL + b.s1[0];
+		const float outR = b.c[0] * yR + b.s1[1];
+
+		l[numSamples - 1] = outL;
+		r[numSamples - 1] = outR;
+
+		b.s1[0] = b.c[1] * yL - b.c[3] * outL + b.s2[0];
+		b.s1[1] = b.c[1] * yR - b.c[3] * outR + b.s2[1];
+
+		b.s2[0] = b.c[2] * yL - b.c[4] * outL;
+		b.s2[1] = b.c[2] * yR - b.c[4] * outR;
+	}
+
+	snapToZero(a);
+	snapToZero(b);
+
+#else
+
+	processStageStereo(a, l, r, numSamples);
+	processStageStereo(b, l, r, numSamples);
+
+#endif
+}
+
+void BiquadFilterBank::snapToZero(Stage& s)
+{
+	for (int i = 0; i < 2; i++)
+	{
+		if (!(s.s1[i] < -1.0e-8f || s.s1[i] > 1.0e-8f)) s.s1[i] = 0.0f;
+		if (!(s.s2[i] < -1.0e-8f || s.s2[i] > 1.0e-8f)) s.s2[i] = 0.0f;
+	}
+}
+
+#undef HI_BIQUAD_BANK_USE_SSE
@@ -0,0 +1,105 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef BIQUADFILTERBANK_H_INCLUDED
+#define BIQUADFILTERBANK_H_INCLUDED
+
+/** A processing engine for cascades of stereo biquad filters.
+*
+*	This is used by every effect that runs a static biquad (CurveEq, MonoFilterEffect and the harmonic filters).
+*	Each Stage contains the normalised coefficients and the transposed direct form II state for two channels.
+*
+*	The cascade is processed with both channels in one loop. On SSE capable systems two adjacent stages are 
+*	pipelined in one register (the second stage runs one sample behind the first), so an EQ with eight bands 
+*	needs four passes over the buffer instead of sixteen.
+*/
+class BiquadFilterBank
+{
+public:
+
+	struct Stage
+	{
+		Stage()
+		{
+			setPassThrough();
+			reset();
+		}
+
+		/** Copies the (already normalised) coefficients. */
+		void setCoefficients(const IIRCoefficients& newCoefficients)
+		{
+			memcpy(c, newCoefficients.coefficients, sizeof(float) * 5);
+		}
+
+		/** Sets the coefficients to a unity gain filter. */
+		void setPassThrough()
+		{
+			c[0] = 1.0f;
+			c[1] = 0.0f;
+			c[2] = 0.0f;
+			c[3] = 0.0f;
+			c[4] = 0.0f;
+		}
+
+		/** Clears the filter state. */
+		void reset()
+		{
+			s1[0] = 0.0f; s1[1] = 0.0f;
+			s2[0] = 0.0f; s2[1] = 0.0f;
+		}
+
+		/** b0, b1, b2, a1, a2. */
+		float c[5];
+
+		float s1[2];
+		float s2[2];
+	};
+
+	/** Processes the first two channels of the buffer (or the first channel if it is a mono buffer). */
+	static void process(Stage* const* stages, int numStages, AudioSampleBuffer& b, int startSample, int numSamples);
+
+	/** Processes two channels through the cascade. */
+	static void processStereo(Stage* const* stages, int numStages, float* l, float* r, int numSamples);
+
+	/** Processes one channel through the cascade using the left channel state of every stage. */
+	static void processMono(Stage* const* stages, int numStages, float* d, int numSamples);
+
+private:
+
+	static void processStageStereo(Stage& s, float* l, float* r, int numSamples);
+	static void processStagePairStereo(Stage& a, Stage& b, float* l, float* r, int numSamples);
+	static void processStageMono(Stage& s, float* d, int numSamples);
+
+	static void snapToZero(Stage& s);
+};
+
+#endif  // BIQUADFILTERBANK_H_INCLUDED
@@ -0,0 +1,171 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#include "JuceHeader.h"
+
+class BiquadFilterBankTest : public UnitTest
+{
+public:
+
+	BiquadFilterBankTest() :
+		UnitTest("Testing BiquadFilterBank")
+	{
+
+	}
+
+	void runTest() override
+	{
+		Random r = getRandom();
+
+		beginTest("Comparing stereo cascades with single biquads");
+
+		for (int i = 0; i < 50; i++)
+			compareWithSingleBiquads(r, 2);
+
+		beginTest("Comparing mono cascades with single biquads");
+
+		for (int i = 0; i < 20; i++)
+			compareWithSingleBiquads(r, 1);
+
+		beginTest("Testing block sizes of one and two samples");
+
+		for (int i = 0; i < 20; i++)
+			compareWithSingleBiquads(r, 2, 2);
+	}
+
+private:
+
+	enum
+	{
+		SampleRate = 44100,
+		MaxNumStages = 10
+	};
+
+	static IIRCoefficients createRandomCoefficients(Random& r)
+	{
+		const double frequency = 20.0 * std::pow(2.0, r.nextDouble() * 9.9);
+		const double q = 0.3 + r.nextDouble() * 8.0;
+		const float gain = Decibels::decibelsToGain((float)(r.nextDouble() * 36.0 - 18.0));
+
+		switch (r.nextInt(5))
+		{
+		case 0:  return IIRCoefficients::makeLowPass(SampleRate, frequency, q);
+		case 1:  return IIRCoefficients::makeHighPass(SampleRate, frequency, q);
+		case 2:  return IIRCoefficients::makePeakFilter(SampleRate, frequency, q, gain);
+		case 3:  return IIRCoefficients::makeLowShelf(SampleRate, frequency, q, gain);
+		default: return IIRCoefficients::makeHighShelf(SampleRate, frequency, q, gain);
+		}
+	}
+
+	/** Runs random input through the bank and through a chain of IIRFilters (one per stage and channel).
+	*
+	*	The signal is processed in random block sizes and the coefficients of one stage are changed between
+	*	the blocks, so the state handling of the pipelined stage pairs is tested as well.
+	*/
+	void compareWithSingleBiquads(Random& r, int numChannels, int maxBlockSize = 512)
+	{
+		const int numStages = 1 + r.nextInt(MaxNumStages);
+		const int numSamples = 4096;
+
+		OwnedArray<BiquadFilterBank::Stage> stages;
+		Array<BiquadFilterBank::Stage*> stagePointers;
+		OwnedArray<IIRFilter> referenceFilters;
+
+		for (int i = 0; i < numStages; i++)
+		{
+			const IIRCoefficients c = createRandomCoefficients(r);
+
+			stagePointers.add(stages.add(new BiquadFilterBank::Stage()));
+			stages.getLast()->setCoefficients(c);
+
+			for (int channel = 0; channel < numChannels; channel++)
+			{
+				referenceFilters.add(new IIRFilter());
+				referenceFilters.getLast()->setCoefficients(c);
+			}
+		}
+
+		AudioSampleBuffer bankBuffer(numChannels, numSamples);
+		AudioSampleBuffer referenceBuffer(numChannels, numSamples);
+
+		for (int channel = 0; channel < numChannels; channel++)
+		{
+			for (int i = 0; i < numSamples; i++)
+				bankBuffer.setSample(channel, i, r.nextFloat() * 2.0f - 1.0f);
+
+			referenceBuffer.copyFrom(channel, 0, bankBuffer, channel, 0, numSamples);
+		}
+
+		int startSample = 0;
+
+		while (startSample < numSamples)
+		{
+			const int numThisTime = jmin<int>(numSamples - startSample, 1 + r.nextInt(maxBlockSize));
+
+			BiquadFilterBank::process(stagePointers.getRawDataPointer(), numStages, bankBuffer, startSample, numThisTime);
+
+			for (int i = 0; i < numStages; i++)
+			{
+				for (int channel = 0; channel < numChannels; channel++)
+					referenceFilters[i * numChannels + channel]->processSamples(referenceBuffer.getWritePointer(channel, startSample), numThisTime);
+			}
+
+			startSample += numThisTime;
+
+			if (r.nextInt(4) == 0)
+			{
+				const int stageIndex = r.nextInt(numStages);
+				const IIRCoefficients c = createRandomCoefficients(r);
+
+				stages[stageIndex]->setCoefficients(c);
+
+				for (int channel = 0; channel < numChannels; channel++)
+					referenceFilters[stageIndex * numChannels + channel]->setCoefficients(c);
+			}
+		}
+
+		for (int channel = 0; channel < numChannels; channel++)
+		{
+			const float peak = jmax<float>(1.0f, referenceBuffer.getMagnitude(channel, 0, numSamples));
+
+			float maxError = 0.0f;
+
+			for (int i = 0; i < numSamples; i++)
+				maxError = jmax<float>(maxError, std::abs(bankBuffer.getSample(channel, i) - referenceBuffer.getSample(channel, i)));
+
+			expect(maxError <= peak * 1.0e-4f, String(numStages) + " stages, channel " + String(channel) + ": error " + String(maxError) + " (peak " + String(peak) + ")");
+		}
+	}
+};
+
+static BiquadFilterBankTest biquadFilterBankTestInstance;
@@ -31,7 +31,9 @@
 */
 
 ChorusEffect::ChorusEffect(MainController *mc, const String &id) :
-MasterEffectProcessor(mc, id)
+MasterEffectProcessor(mc, id),
+leftDelay(BUFMAX),
+rightDelay(BUFMAX)
 {
 	tempBuffer = AudioSampleBuffer(2, 0);
 
@@ -40,9 +42,6 @@ MasterEffectProcessor(mc, id)
 	parameterNames.add("Feedback");
 	parameterNames.add("Delay");
 
-	bufpos = 0;
-	buffer = new float[BUFMAX];
-	buffer2 = new float[BUFMAX];
 	phi = fb = fb1 = fb2 = deps = 0.0f;
 
 	parameterRate = 0.30f; 
@@ -50,10 +49,6 @@ MasterEffectProcessor(mc, id)
 	parameterMix = 0.47f;  
 	parameterFeedback = 0.30f;
 	parameterDelay = 1.00f;
-
-	if (buffer) memset(buffer, 0, BUFMAX * sizeof(float));
-	if (buffer2) memset(buffer2, 0, BUFMAX * sizeof(float));
-
 }
 
 float ChorusEffect::getAttribute(int parameterIndex) const
@@ -143,50 +138,57 @@ void ChorusEffect::processReplacing(const float** inputs, float** outputs, int s
 	const float *in2 = inputs[1];
 	float *out1 = outputs[0];
 	float *out2 = outputs[1];
-	float a, b, f = fb, f1 = fb1, f2 = fb2, ph = phi;
-	float ra = rat, de = dep, we = wet, dr = dry, ds = deps, dm = dem;
-	int  tmp, tmpi, bp = bufpos;
-	float tmpf, dpt;
-
-	--in1;
-	--in2;
-	--out1;
-	--out2;
-	while (--sampleFrames >= 0)
+	float ph = phi;
+	const float ra = rat, de = dep, dm = dem;
+
+	// The taps must be older than the sub block, so the modulated delay starts after one sub block (0.4ms)
+	const float minDelay = (float)(SubBlockSize + 2);
+
+	float delayTimes[SubBlockSize];
+
+	// The first element is the last tap of the previous sub block (the feedback is delayed by one sample)
+	float tapsL[SubBlockSize + 1];
+	float tapsR[SubBlockSize + 1];
+
+	tapsL[0] = fb1;
+	tapsR[0] = fb2;
+
+	while (sampleFrames > 0)
 	{
-		a = *++in1;
-		b = *++in2;
+		const int numThisTime = jmin<int>(sampleFrames, SubBlockSize);
 
-		ph += ra;
-		if (ph > 1.0f) ph -= 2.0f;
+		for (int i = 0; i < numThisTime; i++)
+		{
+			ph += ra;
+			if (ph > 1.0f) ph -= 2.0f;
 
-		bp--; bp &= 0x7FF;
-		*(buffer + bp) = a + f * f1;
-		*(buffer2 + bp) = b + f * f2;
+			delayTimes[i] = minDelay + dm + de * (1.0f - ph * ph); //delay mod shape
+		}
 
-		//ds = 0.995f * (ds - de) + de;          //smoothed depth change ...try inc not mult
-		dpt = tmpf = dm + de * (1.0f - ph * ph); //delay mod shape
-		tmp = int(tmpf);
-		tmpf -= tmp;
-		tmp = (tmp + bp) & 0x7FF;
-		tmpi = (tmp + 1) & 0x7FF;
+		leftDelay.readFractional(tapsL + 1, delayTimes, numThisTime);
+		rightDelay.readFractional(tapsR + 1, delayTimes, numThisTime);
 
-		f1 = *(buffer + tmp);  //try adding a constant to reduce denormalling
-		f2 = *(buffer2 + tmp);
-		f1 = tmpf * (*(buffer + tmpi) - f1) + f1; //linear interpolation
-		f2 = tmpf * (*(buffer2 + tmpi) - f2) + f2;
+		leftDelay.write(in1, numThisTime, tapsL, fb);
+		rightDelay.write(in2, numThisTime, tapsR, fb);
 
-		a = a * dr - f1 * we;
-		b = b * dr - f2 * we;
+		FloatVectorOperations::copyWithMultiply(out1, in1, dry, numThisTime);
+		FloatVectorOperations::copyWithMultiply(out2, in2, dry, numThisTime);
+		FloatVectorOperations::addWithMultiply(out1, tapsL + 1, -wet, numThisTime);
+		FloatVectorOperations::addWithMultiply(out2, tapsR + 1, -wet, numThisTime);
 
-		*++out1 = a;
-		*++out2 = b;
+		tapsL[0] = tapsL[numThisTime];
+		tapsR[0] = tapsR[numThisTime];
+
+		in1 += numThisTime;
+		in2 += numThisTime;
+		out1 += numThisTime;
+		out2 += numThisTime;
+		sampleFrames -= numThisTime;
 	}
-	if (fabs(f1) > 1.0e-10) { fb1 = f1; fb2 = f2; }
+
+	if (fabs(tapsL[0]) > 1.0e-10) { fb1 = tapsL[0]; fb2 = tapsR[0]; }
 	else fb1 = fb2 = 0.0f; //catch denormals
 	phi = ph;
-	deps = ds;
-	bufpos = bp;
 }
 
 
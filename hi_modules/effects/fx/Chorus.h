@@ -43,6 +43,11 @@ public:
 
 	SET_PROCESSOR_NAME("Chorus", "Chorus");
 
+	enum
+	{
+		SubBlockSize = 16 ///< the LFO taps of a sub block are read before the sub block is written into the delay line
+	};
+
 	/** The parameters */
 	enum Parameters
 	{
@@ -65,6 +70,11 @@ public:
 	void applyEffect(AudioSampleBuffer &buffer, int startSample, int numSamples) override;;
 
 	bool hasTail() const override { return false; };
+	double getTailLengthInSeconds() const override
+	{
+		// The feedback recirculates the longest possible tap of the delay lines
+		return getFeedbackTailLength((double)BUFMAX / getSampleRate(), 1.9 * parameterFeedback - 0.95);
+	};
 	int getNumChildProcessors() const override { return 0; };
 	Processor *getChildProcessor(int /*processorIndex*/) override { return nullptr; };
 	const Processor *getChildProcessor(int /*processorIndex*/) const override { return nullptr; };
@@ -81,8 +91,9 @@ private:
 	///global internal variables
 	float rat, dep, wet, dry, fb, dem; //rate, depth, wet & dry mix, feedback, mindepth
 	float phi, fb1, fb2, deps;         //lfo & feedback buffers, depth change smoothing 
-	float *buffer, *buffer2;           //maybe use 2D buffer?
-	uint32 size, bufpos;
+	
+	ModulatedDelayLine leftDelay;
+	ModulatedDelayLine rightDelay;
 
 	float parameterRate;
 	float parameterDepth;
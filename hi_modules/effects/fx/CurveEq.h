@@ -146,18 +146,30 @@ public:
 
 			sampleRate = newSampleRate;
 			updateCoefficients();
-			leftFilter.reset();
-			rightFilter.reset();
+			resetFlag = true;
 		}
 
-		void process(AudioSampleBuffer &b, int startSample, int numSamples)
+		/** Applies pending coefficient changes and returns the stage that is processed by the filter bank. 
+		*
+		*	Call this from the audio thread only.
+		*/
+		BiquadFilterBank::Stage* getStageForProcessing()
 		{
-			if(!enabled) return;
-
 			SpinLock::ScopedLockType sl(processLock);
 
-			leftFilter.processSamples(b.getWritePointer(0, startSample), numSamples);
-			rightFilter.processSamples(b.getWritePointer(1, startSample), numSamples);
+			if (resetFlag)
+			{
+				stage.reset();
+				resetFlag = false;
+			}
+
+			if (coefficientsChanged)
+			{
+				stage.setCoefficients(currentCoefficients);
+				coefficientsChanged = false;
+			}
+
+			return &stage;
 		}
 
 		IIRCoefficients getCoefficients() const
@@ -186,8 +198,7 @@ public:
                 case numFilterTypes: break;
 			}
 
-			leftFilter.setCoefficients(currentCoefficients);
-			rightFilter.setCoefficients(currentCoefficients);
+			coefficientsChanged = true;
 		};
 
 		IIRCoefficients currentCoefficients;
@@ -199,8 +210,10 @@ public:
 		bool enabled;
 		FilterType type;
 
-		IIRFilter leftFilter;
-		IIRFilter rightFilter;
+		bool coefficientsChanged = true;
+		bool resetFlag = false;
+
+		BiquadFilterBank::Stage stage;
 	};
 
 	CurveEq(MainController *mc, const String &id):
@@ -228,11 +241,18 @@ public:
 
 	void applyEffect(AudioSampleBuffer &buffer, int startSample, int numSamples) override
 	{
+		activeStages.clearQuick();
+
 		for(int i = 0; i < filterBands.size(); i++)
 		{
-			filterBands[i]->process(buffer, startSample, numSamples);
+			if (filterBands[i]->isEnabled())
+			{
+				activeStages.add(filterBands[i]->getStageForProcessing());
+			}
 		}
 
+		BiquadFilterBank::process(activeStages.getRawDataPointer(), activeStages.size(), buffer, startSample, numSamples);
+
 		if(fftBufferIndex < FFT_SIZE_FOR_EQ)
 		{
 			const int numSamplesToCopy = jmin<int>(numSamples, FFT_SIZE_FOR_EQ - fftBufferIndex);
@@ -276,6 +296,8 @@ public:
 
 		filterBands.add(f);
 
+		activeStages.ensureStorageAllocated(filterBands.size());
+
 		sendChangeMessage();
 	}
 
@@ -334,6 +356,8 @@ public:
 			filterBands.add(new StereoFilter());
 		}
 
+		activeStages.ensureStorageAllocated(numFilters);
+
 		for(int i = 0; i < numFilters * numBandParameters; i++)
 		{
 #if HI_USE_BACKWARD_COMPATIBILITY
@@ -378,6 +402,25 @@ public:
 
 	bool hasTail() const override {return false;};
 
+	double getTailLengthInSeconds() const override
+	{
+		// The impulse response of a band decays by 1/e in q / (pi * frequency) seconds (the 1-pole filters are faster than q = 1).
+		double tailLength = 0.0;
+
+		for (int i = 0; i < filterBands.size(); i++)
+		{
+			const StereoFilter* band = filterBands[i];
+
+			if (!band->isEnabled()) continue;
+
+			const double timeConstant = jmax<double>(1.0, band->getQ()) / (double_Pi * jmax<double>(1.0, band->getFrequency()));
+
+			tailLength = jmax<double>(tailLength, -std::log((double)EFFECT_SLEEP_THRESHOLD) * timeConstant);
+		}
+
+		return tailLength;
+	};
+
 	int getNumChildProcessors() const override { return 0; };
 
 	Processor *getChildProcessor(int /*processorIndex*/) override { return nullptr; };
@@ -398,6 +441,9 @@ private:
 
 	OwnedArray<StereoFilter> filterBands;
 
+	/** The enabled bands of the current block (preallocated so the audio thread doesn't allocate). */
+	Array<BiquadFilterBank::Stage*> activeStages;
+
 	double lastSampleRate = 0.0;
 
 };
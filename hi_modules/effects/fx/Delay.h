@@ -99,7 +99,7 @@ public:
 		if(tempoSync)
 		{
 			delayTimeLeft = TempoSyncer::getTempoInMilliSeconds(newTempo, syncTimeLeft);
-			delayTimeRight = TempoSyncer::getTempoInMilliSeconds(newTempo, syncTimeLeft);
+			delayTimeRight = TempoSyncer::getTempoInMilliSeconds(newTempo, syncTimeRight);
 
 			calcDelayTimes();
 
@@ -231,16 +231,8 @@ public:
 		const int sampleIndex = startSample;
 		const int samplesToCopy = numSamples;
 
-		float *inputL = buffer.getWritePointer(0, 0);
-		float *inputR = buffer.getWritePointer(1, 0);
-        
-        while(--numSamples >= 0)
-        {
-            leftDelayFrames.setSample(0, startSample, (float)leftDelay.getDelayedValue(inputL[startSample] + feedbackLeft * leftDelayFrames.getSample(0, startSample)));
-            rightDelayFrames.setSample(0, startSample, (float)rightDelay.getDelayedValue(inputR[startSample] + feedbackRight * rightDelayFrames.getSample(0, startSample)));
-            
-            ++startSample;
-        }
+		leftDelay.processWithFeedback(buffer.getReadPointer(0, sampleIndex), leftDelayFrames.getWritePointer(0, sampleIndex), samplesToCopy, feedbackLeft);
+		rightDelay.processWithFeedback(buffer.getReadPointer(1, sampleIndex), rightDelayFrames.getWritePointer(0, sampleIndex), samplesToCopy, feedbackRight);
 
         const float dryMix = (mix < 0.5f) ? 1.0f : (2.0f - 2.0f * mix);
         const float wetMix = (mix > 0.5f) ? 1.0f : (2.0f * mix);
@@ -254,6 +246,18 @@ public:
 
 	bool hasTail() const override {return false; };
 
+	double getTailLengthInSeconds() const override
+	{
+		const double maxDelaySeconds = (double)DELAY_BUFFER_SIZE / getSampleRate();
+
+		const float leftTime = tempoSync ? TempoSyncer::getTempoInMilliSeconds(getMainController()->getBpm(), syncTimeLeft) : delayTimeLeft;
+		const float rightTime = tempoSync ? TempoSyncer::getTempoInMilliSeconds(getMainController()->getBpm(), syncTimeRight) : delayTimeRight;
+
+		const double loopTime = jmin<double>(maxDelaySeconds, 0.001 * (double)jmax<float>(leftTime, rightTime));
+
+		return getFeedbackTailLength(loopTime, jmax<float>(feedbackLeft, feedbackRight));
+	}
+
 	int getNumChildProcessors() const override { return 0; };
 
 	Processor *getChildProcessor(int /*processorIndex*/) override { return nullptr; };
@@ -284,8 +288,8 @@ private:
 	AudioSampleBuffer leftDelayFrames;
 	AudioSampleBuffer rightDelayFrames;
     
-    DelayLine leftDelay;
-    DelayLine rightDelay;
+    ModulatedDelayLine leftDelay;
+    ModulatedDelayLine rightDelay;
 
 	bool skipFirstBuffer;
 };
@@ -0,0 +1,691 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#if JUCE_INTEL && !JUCE_IOS
+#define HI_FDN_USE_SSE 1
+#include <xmmintrin.h>
+#else
+#define HI_FDN_USE_SSE 0
+#endif
+
+namespace FdnReverbHelpers
+{
+
+/** The delay line lengths in milliseconds at the biggest room size. The quality levels with less delay lines use an evenly spread subset. */
+static const float delayTimesMs[FdnReverb::MaxNumDelayLines] =
+{
+	31.3f, 35.9f, 39.7f, 43.1f, 47.9f, 51.1f, 55.7f, 59.3f,
+	63.1f, 67.9f, 71.3f, 75.7f, 79.1f, 83.9f, 89.3f, 97.1f
+};
+
+static const float diffuserTimesMs[FdnReverb::NumDiffusers] = { 4.77f, 3.59f, 12.73f, 9.31f };
+static const float diffuserCoefficients[FdnReverb::NumDiffusers] = { 0.75f, 0.75f, 0.625f, 0.625f };
+
+static const float maxRoomSizeFactor = 2.0f;
+static const float maxModulationDepthMs = 0.3f;
+
+static float getRoomSizeFactor(float roomSize) { return 0.3f + 1.7f * roomSize; }
+
+#if HI_FDN_USE_SSE
+
+/** The Hadamard transform of the four values in the register. */
+static inline __m128 hadamard4(__m128 v)
+{
+	const __m128 signs1 = _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f);
+	const __m128 signs2 = _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f);
+
+	v = _mm_add_ps(_mm_mul_ps(v, signs1), _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+	v = _mm_add_ps(_mm_mul_ps(v, signs2), _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+
+	return v;
+}
+
+static inline float sum4(__m128 v)
+{
+	float d[4];
+	_mm_storeu_ps(d, v);
+	return (d[0] + d[1]) + (d[2] + d[3]);
+}
+
+#endif
+
+} // namespace FdnReverbHelpers
+
+FdnReverb::FdnReverb() :
+	quality(Medium),
+	sampleRate(44100.0),
+	roomSize(0.6f),
+	decayTime(2.5),
+	damping(0.4f),
+	numLines(8),
+	lineSize(0),
+	lineMask(0),
+	writeIndex(0),
+	dampingCoefficient(0.0f),
+	modulationDepth(0.0f),
+	inputGain(1.0f),
+	outputGain(1.0f)
+{
+	for (int i = 0; i < MaxNumDelayLines; i++)
+	{
+		// Two orthogonal rows of the Hadamard matrix (the first row is used for the input)
+		outputSignsL[i] = (i & 1) ? -1.0f : 1.0f;
+		outputSignsR[i] = (i & 2) ? -1.0f : 1.0f;
+	}
+
+	prepareToPlay(sampleRate);
+}
+
+void FdnReverb::prepareToPlay(double newSampleRate)
+{
+	using namespace FdnReverbHelpers;
+
+	sampleRate = newSampleRate;
+
+	const double maxDelaySeconds = (double)(delayTimesMs[MaxNumDelayLines - 1] * maxRoomSizeFactor + 2.0f * maxModulationDepthMs) * 0.001;
+
+	lineSize = nextPowerOfTwo((int)(maxDelaySeconds * sampleRate) + 4);
+	lineMask = lineSize - 1;
+
+	lineBuffer.allocate(lineSize * MaxNumDelayLines, true);
+
+	int diffuserSize = 0;
+
+	for (int i = 0; i < NumDiffusers; i++)
+	{
+		diffuserSize += (int)(diffuserTimesMs[i] * 0.001 * sampleRate) + 1;
+	}
+
+	diffuserBuffer.allocate(diffuserSize, true);
+
+	updateDelayTimes();
+	updateGains();
+	reset();
+}
+
+void FdnReverb::setQuality(Quality newQuality)
+{
+	newQuality = (Quality)jlimit<int>(Low, Ultra, newQuality);
+
+	if (quality != newQuality)
+	{
+		quality = newQuality;
+
+		updateDelayTimes();
+		updateGains();
+		reset();
+	}
+}
+
+void FdnReverb::setRoomSize(float newRoomSize)
+{
+	roomSize = jlimit<float>(0.0f, 1.0f, newRoomSize);
+
+	updateDelayTimes();
+	updateGains();
+}
+
+void FdnReverb::setDecayTime(double newDecayTimeSeconds)
+{
+	decayTime = jmax<double>(0.05, newDecayTimeSeconds);
+
+	updateGains();
+}
+
+void FdnReverb::setDamping(float newDamping)
+{
+	damping = jlimit<float>(0.0f, 1.0f, newDamping);
+
+	updateGains();
+}
+
+void FdnReverb::reset()
+{
+	FloatVectorOperations::clear(lineBuffer, lineSize * MaxNumDelayLines);
+
+	for (int i = 0; i < NumDiffusers; i++)
+	{
+		FloatVectorOperations::clear(diffusers[i].buffer, diffusers[i].size);
+		diffusers[i].index = 0;
+	}
+
+	FloatVectorOperations::clear(lowPassStates, MaxNumDelayLines);
+
+	for (int i = 0; i < MaxNumDelayLines; i++)
+	{
+		const double phase = 2.0 * double_Pi * (double)i / (double)MaxNumDelayLines;
+
+		lfoSin[i] = (float)std::sin(phase);
+		lfoCos[i] = (float)std::cos(phase);
+	}
+
+	writeIndex = 0;
+
+	lastHalfRateInput = 0.0f;
+	lastOutputL = lastOutputR = 0.0f;
+	previousOutputL = previousOutputR = 0.0f;
+	oddSample = false;
+}
+
+int FdnReverb::getNumDelayLines(Quality q)
+{
+	switch (q)
+	{
+	case Low:		return 4;
+	case Medium:	return 8;
+	case High:		return 8;
+	case Ultra:		return 16;
+	default:		jassertfalse; return 8;
+	}
+}
+
+double FdnReverb::getMaxDelayTimeSeconds() const
+{
+	return (double)(FdnReverbHelpers::delayTimesMs[MaxNumDelayLines - 1] * FdnReverbHelpers::getRoomSizeFactor(roomSize)) * 0.001;
+}
+
+double FdnReverb::getTailLengthSeconds() const
+{
+	// The decay time is specified for 60dB
+	const double thresholdDecibels = -20.0 * std::log10((double)EFFECT_SLEEP_THRESHOLD);
+
+	return decayTime * thresholdDecibels / 60.0 + getMaxDelayTimeSeconds();
+}
+
+void FdnReverb::updateDelayTimes()
+{
+	using namespace FdnReverbHelpers;
+
+	numLines = getNumDelayLines(quality);
+
+	const double tankRate = getTankSampleRate();
+	const int stride = MaxNumDelayLines / numLines;
+	const float factor = getRoomSizeFactor(roomSize);
+
+	for (int i = 0; i < numLines; i++)
+	{
+		const int index = i * stride + stride / 2;
+
+		delayTimes[i] = jmax<int>(1, (int)(delayTimesMs[index] * factor * 0.001 * tankRate));
+	}
+
+	modulationDepth = isModulated(quality) ? (float)(maxModulationDepthMs * 0.001 * tankRate) : 0.0f;
+
+	for (int i = 0; i < numLines; i++)
+	{
+		// Slightly detuned LFOs between 0.3Hz and 1.1Hz
+		const double lfoFrequency = 0.3 + 0.8 * (double)i / (double)numLines;
+		const double delta = 2.0 * double_Pi * lfoFrequency / tankRate;
+
+		lfoRotationSin[i] = (float)std::sin(delta);
+		lfoRotationCos[i] = (float)std::cos(delta);
+	}
+
+	float* d = diffuserBuffer;
+
+	for (int i = 0; i < NumDiffusers; i++)
+	{
+		diffusers[i].buffer = d;
+		diffusers[i].size = jmax<int>(1, (int)(diffuserTimesMs[i] * 0.001 * tankRate));
+		diffusers[i].index = jmin<int>(diffusers[i].index, diffusers[i].size - 1);
+		diffusers[i].coefficient = diffuserCoefficients[i];
+
+		d += diffusers[i].size;
+	}
+
+	// Every delay line gets the full input, and the output sums are normalised so that the level doesn't depend on the quality
+	inputGain = 1.0f;
+	outputGain = 1.0f / std::sqrt((float)numLines);
+}
+
+void FdnReverb::updateGains()
+{
+	const double tankRate = getTankSampleRate();
+
+	// The normalisation of the Hadamard matrix is applied together with the decay gain
+	const double matrixGain = 1.0 / std::sqrt((double)numLines);
+
+	for (int i = 0; i < numLines; i++)
+	{
+		const double delaySeconds = (double)delayTimes[i] / tankRate;
+
+		gains[i] = (float)(matrixGain * std::pow(10.0, -3.0 * delaySeconds / decayTime));
+	}
+
+	const double cutoff = 20000.0 * std::pow(0.05, (double)damping);
+
+	dampingCoefficient = (float)std::exp(-2.0 * double_Pi * cutoff / tankRate);
+}
+
+void FdnReverb::Allpass::process(float* data, int numSamples)
+{
+	const float g = coefficient;
+
+	for (int i = 0; i < numSamples; i++)
+	{
+		const float delayed = buffer[index];
+		const float x = data[i];
+		const float y = delayed - g * x;
+
+		buffer[index] = x + g * y;
+		data[i] = y;
+
+		if (++index >= size)
+			index = 0;
+	}
+}
+
+void FdnReverb::process(const float* input, float* outL, float* outR, int numSamples)
+{
+	while (numSamples > 0)
+	{
+		const int numThisTime = jmin<int>(numSamples, BlockSize);
+
+		if (usesHalfRate(quality))
+		{
+			bool odd = oddSample;
+			int numTankSamples = 0;
+
+			for (int i = 0; i < numThisTime; i++)
+			{
+				if (odd)
+					scratchInput[numTankSamples++] = 0.5f * (lastHalfRateInput + input[i]);
+				else
+					lastHalfRateInput = input[i];
+
+				odd = !odd;
+			}
+
+			processTank(scratchInput, scratchL, scratchR, numTankSamples);
+
+			// Linear interpolation with two samples latency
+			int tankIndex = 0;
+
+			for (int i = 0; i < numThisTime; i++)
+			{
+				if (oddSample)
+				{
+					outL[i] = lastOutputL;
+					outR[i] = lastOutputR;
+
+					previousOutputL = lastOutputL;
+					previousOutputR = lastOutputR;
+					lastOutputL = scratchL[tankIndex];
+					lastOutputR = scratchR[tankIndex++];
+				}
+				else
+				{
+					outL[i] = 0.5f * (previousOutputL + lastOutputL);
+					outR[i] = 0.5f * (previousOutputR + lastOutputR);
+				}
+
+				oddSample = !oddSample;
+			}
+		}
+		else
+		{
+			FloatVectorOperations::copy(scratchInput, input, numThisTime);
+
+			processTank(scratchInput, outL, outR, numThisTime);
+		}
+
+		input += numThisTime;
+		outL += numThisTime;
+		outR += numThisTime;
+		numSamples -= numThisTime;
+	}
+}
+
+void FdnReverb::applyMatrix(float* values) const
+{
+#if HI_FDN_USE_SSE
+
+	__m128 v[MaxNumDelayLines / 4];
+
+	const int numVectors = numLines / 4;
+
+	for (int i = 0; i < numVectors; i++)
+		v[i] = FdnReverbHelpers::hadamard4(_mm_loadu_ps(values + 4 * i));
+
+	for (int h = 1; h < numVectors; h *= 2)
+	{
+		for (int i = 0; i < numVectors; i += 2 * h)
+		{
+			for (int j = i; j < i + h; j++)
+			{
+				const __m128 a = v[j];
+				const __m128 b = v[j + h];
+
+				v[j] = _mm_add_ps(a, b);
+				v[j + h] = _mm_sub_ps(a, b);
+			}
+		}
+	}
+
+	for (int i = 0; i < numVectors; i++)
+		_mm_storeu_ps(values + 4 * i, v[i]);
+
+#else
+
+	for (int h = 1; h < numLines; h *= 2)
+	{
+		for (int i = 0; i < numLines; i += 2 * h)
+		{
+			for (int j = i; j < i + h; j++)
+			{
+				const float a = values[j];
+				const float b = values[j + h];
+
+				values[j] = a + b;
+				values[j + h] = a - b;
+			}
+		}
+	}
+
+#endif
+}
+
+void FdnReverb::processTank(float* data, float* outL, float* outR, int numSamples)
+{
+	for (int i = 0; i < NumDiffusers; i++)
+		diffusers[i].process(data, numSamples);
+
+	const bool modulated = modulationDepth > 0.0f;
+
+	float taps[MaxNumDelayLines];
+
+	for (int s = 0; s < numSamples; s++)
+	{
+		const int w = writeIndex;
+
+		if (modulated)
+		{
+			for (int i = 0; i < numLines; i++)
+			{
+				const float sinValue = lfoSin[i];
+				const float cosValue = lfoCos[i];
+
+				lfoSin[i] = sinValue * lfoRotationCos[i] + cosValue * lfoRotationSin[i];
+				lfoCos[i] = cosValue * lfoRotationCos[i] - sinValue * lfoRotationSin[i];
+
+				const float delay = (float)delayTimes[i] + modulationDepth * (1.0f + sinValue);
+				const int delayInt = (int)delay;
+				const float alpha = delay - (float)delayInt;
+
+				const float* line = lineBuffer + i * lineSize;
+
+				const float a = line[(w - delayInt) & lineMask];
+				const float b = line[(w - delayInt - 1) & lineMask];
+
+				taps[i] = a + alpha * (b - a);
+			}
+		}
+		else
+		{
+			for (int i = 0; i < numLines; i++)
+				taps[i] = lineBuffer[i * lineSize + ((w - delayTimes[i]) & lineMask)];
+		}
+
+		float l, r;
+
+#if HI_FDN_USE_SSE
+
+		const __m128 d = _mm_set1_ps(dampingCoefficient);
+		__m128 accL = _mm_setzero_ps();
+		__m128 accR = _mm_setzero_ps();
+
+		for (int i = 0; i < numLines; i += 4)
+		{
+			const __m128 t = _mm_loadu_ps(taps + i);
+
+			accL = _mm_add_ps(accL, _mm_mul_ps(t, _mm_loadu_ps(outputSignsL + i)));
+			accR = _mm_add_ps(accR, _mm_mul_ps(t, _mm_loadu_ps(outputSignsR + i)));
+
+			__m128 lp = _mm_loadu_ps(lowPassStates + i);
+			lp = _mm_add_ps(t, _mm_mul_ps(d, _mm_sub_ps(lp, t)));
+			_mm_storeu_ps(lowPassStates + i, lp);
+
+			_mm_storeu_ps(taps + i, _mm_mul_ps(lp, _mm_loadu_ps(gains + i)));
+		}
+
+		l = FdnReverbHelpers::sum4(accL);
+		r = FdnReverbHelpers::sum4(accR);
+
+#else
+
+		l = 0.0f;
+		r = 0.0f;
+
+		for (int i = 0; i < numLines; i++)
+		{
+			const float t = taps[i];
+
+			l += t * outputSignsL[i];
+			r += t * outputSignsR[i];
+
+			lowPassStates[i] = t + dampingCoefficient * (lowPassStates[i] - t);
+			taps[i] = lowPassStates[i] * gains[i];
+		}
+
+#endif
+
+		applyMatrix(taps);
+
+		const float x = data[s] * inputGain;
+
+		for (int i = 0; i < numLines; i++)
+			lineBuffer[i * lineSize + w] = taps[i] + x;
+
+		writeIndex = (w + 1) & lineMask;
+
+		outL[s] = l * outputGain;
+		outR[s] = r * outputGain;
+	}
+
+	if (modulated)
+	{
+		// Keep the amplitude of the LFOs from drifting
+		for (int i = 0; i < numLines; i++)
+		{
+			const float correction = 1.5f - 0.5f * (lfoSin[i] * lfoSin[i] + lfoCos[i] * lfoCos[i]);
+
+			lfoSin[i] *= correction;
+			lfoCos[i] *= correction;
+		}
+	}
+
+	for (int i = 0; i < numLines; i++)
+	{
+		if (std::abs(lowPassStates[i]) < 1.0e-8f)
+			lowPassStates[i] = 0.0f;
+	}
+}
+
+#undef HI_FDN_USE_SSE
+
+// ====================================================================================================================================================
+
+FdnReverbEffect::FdnReverbEffect(MainController *mc, const String &id) :
+	MasterEffectProcessor(mc, id),
+	roomSize(0.6f),
+	decayTime(2.5),
+	damping(0.4f),
+	preDelay(10.0f),
+	width(1.0f),
+	wetLevel(0.25f),
+	quality(FdnReverb::Medium)
+{
+	tempBuffer = AudioSampleBuffer(3, 0);
+
+	parameterNames.add("RoomSize");
+	parameterNames.add("DecayTime");
+	parameterNames.add("Damping");
+	parameterNames.add("PreDelay");
+	parameterNames.add("Width");
+	parameterNames.add("WetLevel");
+	parameterNames.add("Quality");
+
+	reverb.setQuality(quality);
+	reverb.setRoomSize(roomSize);
+	reverb.setDecayTime(decayTime);
+	reverb.setDamping(damping);
+}
+
+float FdnReverbEffect::getAttribute(int parameterIndex) const
+{
+	switch (parameterIndex)
+	{
+	case RoomSize:		return roomSize;
+	case DecayTime:		return (float)decayTime;
+	case Damping:		return damping;
+	case PreDelay:		return preDelay;
+	case Width:			return width;
+	case WetLevel:		return wetLevel;
+	case Quality:		return (float)quality;
+	default:			jassertfalse; return 1.0f;
+	}
+}
+
+void FdnReverbEffect::setInternalAttribute(int parameterIndex, float newValue)
+{
+	SpinLock::ScopedLockType sl(processLock);
+
+	switch (parameterIndex)
+	{
+	case RoomSize:		roomSize = newValue; reverb.setRoomSize(newValue); break;
+	case DecayTime:		decayTime = (double)newValue; reverb.setDecayTime(decayTime); break;
+	case Damping:		damping = newValue; reverb.setDamping(newValue); break;
+	case PreDelay:		preDelay = newValue; preDelayLine.setDelayTimeSeconds(preDelay * 0.001); break;
+	case Width:			width = newValue; break;
+	case WetLevel:		wetLevel = newValue; break;
+	case Quality:		quality = (FdnReverb::Quality)jlimit<int>(FdnReverb::Low, FdnReverb::Ultra, (int)newValue);
+						reverb.setQuality(quality); 
+						break;
+	default:			jassertfalse; break;
+	}
+}
+
+void FdnReverbEffect::restoreFromValueTree(const ValueTree &v)
+{
+	MasterEffectProcessor::restoreFromValueTree(v);
+
+	loadAttribute(Quality, "Quality");
+	loadAttribute(RoomSize, "RoomSize");
+	loadAttribute(DecayTime, "DecayTime");
+	loadAttribute(Damping, "Damping");
+	loadAttribute(PreDelay, "PreDelay");
+	loadAttribute(Width, "Width");
+	loadAttribute(WetLevel, "WetLevel");
+}
+
+ValueTree FdnReverbEffect::exportAsValueTree() const
+{
+	ValueTree v = MasterEffectProcessor::exportAsValueTree();
+
+	saveAttribute(Quality, "Quality");
+	saveAttribute(RoomSize, "RoomSize");
+	saveAttribute(DecayTime, "DecayTime");
+	saveAttribute(Damping, "Damping");
+	saveAttribute(PreDelay, "PreDelay");
+	saveAttribute(Width, "Width");
+	saveAttribute(WetLevel, "WetLevel");
+
+	return v;
+}
+
+void FdnReverbEffect::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+	EffectProcessor::prepareToPlay(sampleRate, samplesPerBlock);
+
+	ProcessorHelpers::increaseBufferIfNeeded(tempBuffer, samplesPerBlock);
+
+	SpinLock::ScopedLockType sl(processLock);
+
+	reverb.prepareToPlay(sampleRate);
+
+	preDelayLine.prepareToPlay(sampleRate);
+	preDelayLine.clear();
+	preDelayLine.setDelayTimeSeconds(preDelay * 0.001);
+}
+
+void FdnReverbEffect::applyEffect(AudioSampleBuffer &buffer, int startSample, int numSamples)
+{
+	float* l = buffer.getWritePointer(0, startSample);
+	float* r = buffer.getWritePointer(1, startSample);
+
+	float* mono = tempBuffer.getWritePointer(0, 0);
+	float* wetL = tempBuffer.getWritePointer(1, 0);
+	float* wetR = tempBuffer.getWritePointer(2, 0);
+
+	FloatVectorOperations::copyWithMultiply(mono, l, 0.5f, numSamples);
+	FloatVectorOperations::addWithMultiply(mono, r, 0.5f, numSamples);
+
+	{
+		SpinLock::ScopedLockType sl(processLock);
+
+		// wetL is used as temporary buffer for the pre delay output
+		preDelayLine.processWithFeedback(mono, wetL, numSamples, 0.0f);
+		FloatVectorOperations::copy(mono, wetL, numSamples);
+
+		reverb.process(mono, wetL, wetR, numSamples);
+	}
+
+	// Stereo width (mid / side)
+	const float wet = wetLevel;
+	const float dry = 1.0f - wetLevel;
+
+	const float sameSide = wet * (0.5f + 0.5f * width);
+	const float otherSide = wet * (0.5f - 0.5f * width);
+
+	FloatVectorOperations::multiply(l, dry, numSamples);
+	FloatVectorOperations::multiply(r, dry, numSamples);
+
+	FloatVectorOperations::addWithMultiply(l, wetL, sameSide, numSamples);
+	FloatVectorOperations::addWithMultiply(l, wetR, otherSide, numSamples);
+	FloatVectorOperations::addWithMultiply(r, wetR, sameSide, numSamples);
+	FloatVectorOperations::addWithMultiply(r, wetL, otherSide, numSamples);
+}
+
+ProcessorEditorBody *FdnReverbEffect::createEditor(ProcessorEditor *parentEditor)
+{
+#if USE_BACKEND
+
+	return new FdnReverbEditor(parentEditor);
+
+#else 
+
+	ignoreUnused(parentEditor);
+	jassertfalse;
+	return nullptr;
+
+#endif
+}
@@ -0,0 +1,240 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef FDNREVERB_H_INCLUDED
+#define FDNREVERB_H_INCLUDED
+
+/** A feedback delay network reverb tank.
+*
+*	The mono input is diffused by four allpass filters and fed into up to 16 delay lines. The outputs of the delay
+*	lines are damped with a one pole lowpass, attenuated according to the decay time and mixed back into the delay
+*	lines with a normalised Hadamard matrix. The matrix is applied as a fast Walsh-Hadamard transform with four delay lines 
+*	per SSE register.
+*
+*	The quality level defines the CPU usage:
+*
+*	- Low: 4 delay lines and the tank runs at half the sample rate
+*	- Medium: 8 delay lines
+*	- High: 8 delay lines with modulated delay times
+*	- Ultra: 16 delay lines with modulated delay times
+*/
+class FdnReverb
+{
+public:
+
+	/** The quality levels. They start at 1 so they can be used as ComboBox IDs. */
+	enum Quality
+	{
+		Low = 1,
+		Medium,
+		High,
+		Ultra,
+		numQualityLevels
+	};
+
+	enum
+	{
+		MaxNumDelayLines = 16,
+		NumDiffusers = 4,
+		BlockSize = 256
+	};
+
+	FdnReverb();
+
+	/** Allocates the delay lines for the longest room size. Don't call this from the audio thread. */
+	void prepareToPlay(double newSampleRate);
+
+	/** Sets the quality level and clears the tank. */
+	void setQuality(Quality newQuality);
+
+	/** Scales the delay line lengths (0.0 to 1.0). */
+	void setRoomSize(float newRoomSize);
+
+	/** Sets the time in seconds until the tail has decayed by 60dB. */
+	void setDecayTime(double newDecayTimeSeconds);
+
+	/** Sets the high frequency damping (0.0 to 1.0). */
+	void setDamping(float newDamping);
+
+	/** Clears the delay lines and filter states. */
+	void reset();
+
+	/** Renders the reverb tail of the mono input into the two output channels. */
+	void process(const float* input, float* outL, float* outR, int numSamples);
+
+	/** Returns the length of the longest delay line in seconds. */
+	double getMaxDelayTimeSeconds() const;
+
+	/** Returns the time in seconds until the tail of a full scale input has decayed below EFFECT_SLEEP_THRESHOLD. */
+	double getTailLengthSeconds() const;
+
+	static int getNumDelayLines(Quality q);
+
+	static bool isModulated(Quality q) { return q >= High; }
+
+	static bool usesHalfRate(Quality q) { return q == Low; }
+
+private:
+
+	struct Allpass
+	{
+		void process(float* data, int numSamples);
+
+		float* buffer = nullptr;
+		int size = 1;
+		int index = 0;
+		float coefficient = 0.5f;
+	};
+
+	void updateDelayTimes();
+	void updateGains();
+
+	double getTankSampleRate() const { return usesHalfRate(quality) ? sampleRate * 0.5 : sampleRate; }
+
+	void processTank(float* data, float* outL, float* outR, int numSamples);
+
+	void applyMatrix(float* values) const;
+
+	Quality quality;
+
+	double sampleRate;
+	float roomSize;
+	double decayTime;
+	float damping;
+
+	int numLines;
+
+	HeapBlock<float> lineBuffer;
+	int lineSize;
+	int lineMask;
+	int writeIndex;
+
+	int delayTimes[MaxNumDelayLines];
+	float gains[MaxNumDelayLines];
+	float lowPassStates[MaxNumDelayLines];
+	float dampingCoefficient;
+
+	float outputSignsL[MaxNumDelayLines];
+	float outputSignsR[MaxNumDelayLines];
+
+	float modulationDepth;
+	float lfoSin[MaxNumDelayLines];
+	float lfoCos[MaxNumDelayLines];
+	float lfoRotationSin[MaxNumDelayLines];
+	float lfoRotationCos[MaxNumDelayLines];
+
+	HeapBlock<float> diffuserBuffer;
+	Allpass diffusers[NumDiffusers];
+
+	/** The input of the tank and the outputs of the half rate tank. */
+	float scratchInput[BlockSize];
+	float scratchL[BlockSize];
+	float scratchR[BlockSize];
+
+	float inputGain;
+	float outputGain;
+
+	float lastHalfRateInput;
+	float lastOutputL, lastOutputR;
+	float previousOutputL, previousOutputR;
+	bool oddSample;
+};
+
+
+/** An algorithmic reverb based on a feedback delay network.
+*	@ingroup effectTypes
+*
+*	It sounds much denser than the SimpleReverb and uses only a fraction of the CPU of the ConvolutionEffect.
+*	The Quality parameter trades the density against the CPU usage (see FdnReverb::Quality).
+*/
+class FdnReverbEffect : public MasterEffectProcessor
+{
+public:
+
+	SET_PROCESSOR_NAME("FdnReverb", "FDN Reverb");
+
+	/** The parameters */
+	enum Parameters
+	{
+		RoomSize = 0, ///< the size of the room (scales the delay line lengths)
+		DecayTime, ///< the time in seconds until the tail has decayed by 60dB
+		Damping, ///< the high frequency damping
+		PreDelay, ///< the pre delay in milliseconds
+		Width, ///< the stereo width of the tail
+		WetLevel, ///< the wet level (the dry level is 1 - wet level)
+		Quality, ///< the quality level (1 - 4, see FdnReverb::Quality)
+		numEffectParameters
+	};
+
+	FdnReverbEffect(MainController *mc, const String &id);
+
+	float getAttribute(int parameterIndex) const override;
+	void setInternalAttribute(int parameterIndex, float newValue) override;
+
+	void restoreFromValueTree(const ValueTree &v) override;
+	ValueTree exportAsValueTree() const override;
+
+	void prepareToPlay(double sampleRate, int samplesPerBlock) override;
+	void applyEffect(AudioSampleBuffer &buffer, int startSample, int numSamples) override;
+
+	bool hasTail() const override { return false; };
+
+	double getTailLengthInSeconds() const override
+	{
+		return reverb.getTailLengthSeconds() + preDelay * 0.001;
+	}
+
+	int getNumChildProcessors() const override { return 0; };
+	Processor *getChildProcessor(int /*processorIndex*/) override { return nullptr; };
+	const Processor *getChildProcessor(int /*processorIndex*/) const override { return nullptr; };
+
+	ProcessorEditorBody *createEditor(ProcessorEditor *parentEditor)  override;
+
+private:
+
+	float roomSize;
+	double decayTime;
+	float damping;
+	float preDelay;
+	float width;
+	float wetLevel;
+	FdnReverb::Quality quality;
+
+	SpinLock processLock;
+
+	FdnReverb reverb;
+	ModulatedDelayLine preDelayLine;
+
+	AudioSampleBuffer tempBuffer;
+};
+
+#endif  // FDNREVERB_H_INCLUDED
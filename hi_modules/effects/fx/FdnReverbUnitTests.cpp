@@ -0,0 +1,220 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#include "JuceHeader.h"
+
+class FdnReverbTest : public UnitTest
+{
+public:
+
+	FdnReverbTest() :
+		UnitTest("Testing FdnReverb")
+	{
+
+	}
+
+	void runTest() override
+	{
+		for (int q = FdnReverb::Low; q < FdnReverb::numQualityLevels; q++)
+		{
+			const FdnReverb::Quality quality = (FdnReverb::Quality)q;
+
+			beginTest("Measuring the decay time with quality " + getQualityName(quality));
+
+			testDecayTime(quality, 0.5);
+			testDecayTime(quality, 2.0);
+
+			beginTest("Testing the sleep state with quality " + getQualityName(quality));
+
+			testSleepAfterTail(quality, 0.3);
+			testSleepAfterTail(quality, 1.5);
+		}
+	}
+
+private:
+
+	enum
+	{
+		SampleRate = 44100,
+		SleepBlockSize = 512
+	};
+
+	static String getQualityName(FdnReverb::Quality q)
+	{
+		switch (q)
+		{
+		case FdnReverb::Low:	return "Low";
+		case FdnReverb::Medium:	return "Medium";
+		case FdnReverb::High:	return "High";
+		case FdnReverb::Ultra:	return "Ultra";
+		default:				return "Unknown";
+		}
+	}
+
+	static void initialise(FdnReverb& reverb, FdnReverb::Quality quality, double decayTime)
+	{
+		reverb.prepareToPlay(SampleRate);
+		reverb.setQuality(quality);
+		reverb.setRoomSize(0.6f);
+		reverb.setDamping(0.0f);
+		reverb.setDecayTime(decayTime);
+		reverb.reset();
+	}
+
+	/** Renders the impulse response and returns the summed energy of both channels per sample. */
+	static void renderImpulseResponse(FdnReverb& reverb, int numSamples, HeapBlock<double>& energy)
+	{
+		HeapBlock<float> input(numSamples, true);
+		HeapBlock<float> outL(numSamples, true);
+		HeapBlock<float> outR(numSamples, true);
+
+		input[0] = 1.0f;
+
+		reverb.process(input, outL, outR, numSamples);
+
+		energy.allocate(numSamples, true);
+
+		for (int i = 0; i < numSamples; i++)
+			energy[i] = (double)outL[i] * (double)outL[i] + (double)outR[i] * (double)outR[i];
+	}
+
+	/** Measures the RT60 with a T30 fit (-5dB to -35dB) of the Schroeder energy decay curve. */
+	void testDecayTime(FdnReverb::Quality quality, double decayTime)
+	{
+		FdnReverb reverb;
+		initialise(reverb, quality, decayTime);
+
+		const int numSamples = (int)(decayTime * 1.5 * SampleRate);
+
+		HeapBlock<double> energy;
+		renderImpulseResponse(reverb, numSamples, energy);
+
+		for (int i = numSamples - 2; i >= 0; i--)
+			energy[i] += energy[i + 1];
+
+		const double total = energy[0];
+
+		int start = -1;
+		int end = -1;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const double db = 10.0 * std::log10(energy[i] / total);
+
+			if (start == -1 && db <= -5.0)
+				start = i;
+
+			if (db <= -35.0)
+			{
+				end = i;
+				break;
+			}
+		}
+
+		expect(start != -1 && end > start, "The energy decay curve doesn't reach -35dB");
+
+		if (start == -1 || end <= start)
+			return;
+
+		const double measuredDecayTime = 2.0 * (double)(end - start) / (double)SampleRate;
+		const double deviation = std::abs(measuredDecayTime - decayTime) / decayTime;
+
+		expect(deviation < 0.15, "Decay time " + String(decayTime) + "s, measured RT60: " + String(measuredDecayTime) + "s");
+	}
+
+	/** Feeds an impulse and counts the silent samples the same way as EffectProcessor::updateSleepState().
+	*
+	*	The reverb must not be sent to sleep while its output is still above the threshold, but it must fall
+	*	asleep shortly after the tail has actually decayed.
+	*/
+	void testSleepAfterTail(FdnReverb::Quality quality, double decayTime)
+	{
+		FdnReverb reverb;
+		initialise(reverb, quality, decayTime);
+
+		const double tailLength = reverb.getTailLengthSeconds();
+		const int samplesUntilSleep = jmax<int>(SleepBlockSize, (int)(tailLength * SampleRate));
+		const int numSamples = samplesUntilSleep + 2 * SampleRate;
+
+		float input[SleepBlockSize];
+		float outL[SleepBlockSize];
+		float outR[SleepBlockSize];
+
+		int numSilentSamples = 0;
+		int sleepPosition = -1;
+		int lastLoudPosition = -1;
+
+		for (int pos = 0; pos < numSamples; pos += SleepBlockSize)
+		{
+			FloatVectorOperations::clear(input, SleepBlockSize);
+
+			if (pos == 0)
+				input[0] = 1.0f;
+
+			reverb.process(input, outL, outR, SleepBlockSize);
+
+			const float inputLevel = FloatVectorOperations::findMaximum(input, SleepBlockSize);
+			const float outputLevel = jmax<float>(FloatVectorOperations::findMaximum(outL, SleepBlockSize), -FloatVectorOperations::findMinimum(outL, SleepBlockSize),
+												  FloatVectorOperations::findMaximum(outR, SleepBlockSize), -FloatVectorOperations::findMinimum(outR, SleepBlockSize));
+
+			if (inputLevel >= EFFECT_SLEEP_THRESHOLD || outputLevel >= EFFECT_SLEEP_THRESHOLD)
+			{
+				lastLoudPosition = pos + SleepBlockSize;
+				numSilentSamples = 0;
+			}
+			else
+				numSilentSamples = jmin<int>(numSilentSamples + SleepBlockSize, samplesUntilSleep);
+
+			if (sleepPosition == -1 && numSilentSamples >= samplesUntilSleep)
+				sleepPosition = pos + SleepBlockSize;
+		}
+
+		const String message = "Decay time " + String(decayTime) + "s, tail length " + String(tailLength) + "s";
+
+		expect(lastLoudPosition != -1, message + ": no output");
+		expect(sleepPosition != -1, message + ": the reverb doesn't go to sleep");
+
+		if (sleepPosition == -1)
+			return;
+
+		expect(lastLoudPosition < sleepPosition, message + ": the tail is still audible after the reverb went to sleep");
+
+		// The tail length must cover the decay of the impulse but it shouldn't keep the reverb awake much longer
+		const double audibleTail = (double)lastLoudPosition / (double)SampleRate;
+
+		expect(audibleTail <= tailLength, message + ": audible for " + String(audibleTail) + "s");
+		expect(tailLength < audibleTail * 1.5 + 0.1, message + ": audible for only " + String(audibleTail) + "s");
+	}
+};
+
+static FdnReverbTest fdnReverbTestInstance;
@@ -308,7 +308,12 @@ gainChain(new ModulatorChain(mc, "Gain Modulation", numVoices, Modulation::GainM
 	{
 		voiceFilters.add(new MonoFilterEffect(mc, uid + String(i)));
 		voiceFilters[i]->setUseInternalChains(false);
+
+		interpolatedFilters.add(new InterpolatedStereoFilter());
 	}
+
+	// The interpolated filters don't need the block to be split up
+	useStepSizeCalculation(!isInterpolatedMode(mode));
 }
 
 float PolyFilterEffect::getAttribute(int parameterIndex) const
@@ -333,6 +338,13 @@ void PolyFilterEffect::setInternalAttribute(int parameterIndex, float newValue)
 	case MonoFilterEffect::Q:			q = newValue; break;
 	case MonoFilterEffect::Mode:		mode = (MonoFilterEffect::FilterMode)(int)newValue;
 		for (int i = 0; i < voiceFilters.size(); i++) voiceFilters[i]->setMode((int)newValue);
+
+		if (isInterpolatedMode(mode))
+		{
+			for (int i = 0; i < interpolatedFilters.size(); i++) interpolatedFilters[i]->setType((InterpolatedStereoFilter::Type)(int)mode);
+		}
+
+		useStepSizeCalculation(!isInterpolatedMode(mode));
 		break;
         case MonoFilterEffect::Quality: setRenderQuality((int)newValue); break;
 	default:							jassertfalse; return;
@@ -373,6 +385,14 @@ void PolyFilterEffect::prepareToPlay(double sampleRate, int samplesPerBlock)
 	{
 		voiceFilters[i]->prepareToPlay(sampleRate, samplesPerBlock);
 	}
+
+	if (sampleRate > 0.0)
+	{
+		warpTable.setSampleRate(sampleRate);
+
+		for (int i = 0; i < interpolatedFilters.size(); i++)
+			interpolatedFilters[i]->reset();
+	}
 }
 
 ProcessorEditorBody *PolyFilterEffect::createEditor(ProcessorEditor *parentEditor)
@@ -402,6 +422,21 @@ void PolyFilterEffect::preVoiceRendering(int voiceIndex, int startSample, int nu
 
 void PolyFilterEffect::applyEffect(int voiceIndex, AudioSampleBuffer &b, int startSample, int numSamples)
 {
+	if (isInterpolatedMode(mode) && b.getNumChannels() == 2)
+	{
+		const float* freqModValues = freqChain->getVoiceValues(voiceIndex) + startSample;
+
+		const bool useGainModulation = voiceFilters[voiceIndex]->calculateGainModValue && gainChain->getNumChildProcessors() > 0;
+		const float* gainModValues = useGainModulation ? gainChain->getVoiceValues(voiceIndex) + startSample : nullptr;
+
+		interpolatedFilters[voiceIndex]->processSamples(b, startSample, numSamples, warpTable, freqModValues, freq, gainModValues, gain, q);
+
+		// Only used for the filter graph
+		voiceFilters[voiceIndex]->freq = jmax<double>(70.0, std::abs((double)freqModValues[numSamples - 1] * freq));
+
+		return;
+	}
+
 	if (voiceFilters[voiceIndex]->calculateGainModValue)
 	{
 		if (gainChain->getNumChildProcessors() > 0)
@@ -432,6 +467,7 @@ void PolyFilterEffect::startVoice(int voiceIndex, int noteNumber)
 	VoiceEffectProcessor::startVoice(voiceIndex, noteNumber);
 
 	voiceFilters[voiceIndex]->currentFilter->reset();
+	interpolatedFilters[voiceIndex]->reset();
 }
 
 void StaticBiquad::updateCoefficients()
@@ -449,8 +485,310 @@ void StaticBiquad::updateCoefficients()
 	default:							jassertfalse; break;
 	}
 
-	for (int i = 0; i < numChannels; i++)
+	for (int i = 0; i < NUM_MAX_CHANNELS / 2; i++)
+	{
+		stages[i].setCoefficients(currentCoefficients);
+	}
+}
+
+FilterWarpTable::FilterWarpTable()
+{
+	setSampleRate(44100.0);
+}
+
+void FilterWarpTable::setSampleRate(double newSampleRate)
+{
+	// The table ends slightly below the nyquist frequency where the function goes to infinity
+	const double maxNormalisedFrequency = 0.49;
+
+	indexFactor = (double)TableSize / (maxNormalisedFrequency * newSampleRate);
+
+	for (int i = 0; i <= TableSize; i++)
+	{
+		const double normalisedFrequency = maxNormalisedFrequency * (double)i / (double)TableSize;
+
+		table[i] = (float)tan(double_Pi * normalisedFrequency);
+	}
+}
+
+InterpolatedStereoFilter::InterpolatedStereoFilter() :
+	type(Type::LowPass)
+{
+	reset();
+}
+
+void InterpolatedStereoFilter::setType(Type newType)
+{
+	if (type != newType)
+	{
+		type = newType;
+		reset();
+	}
+}
+
+void InterpolatedStereoFilter::reset()
+{
+	firstBlock = true;
+
+	memset(coefficients, 0, sizeof(float) * 5);
+	memset(state1, 0, sizeof(float) * 2);
+	memset(state2, 0, sizeof(float) * 2);
+	memset(state3, 0, sizeof(float) * 2);
+}
+
+void InterpolatedStereoFilter::calculateCoefficients(float* c, float g, double q, float gainFactor) const
+{
+	const double sqrt2 = 1.4142135623730951;
+
+	q = jmax<double>(0.001, q);
+
+	switch (type)
 	{
-		filters[i].setCoefficients(currentCoefficients);
+	case Type::LowPass:
+	{
+		const double n = 1.0 / (double)g;
+		const double c1 = 1.0 / (1.0 + sqrt2 * n + n * n);
+
+		c[0] = (float)c1;
+		c[1] = (float)(2.0 * c1);
+		c[2] = (float)c1;
+		c[3] = (float)(2.0 * c1 * (1.0 - n * n));
+		c[4] = (float)(c1 * (1.0 - sqrt2 * n + n * n));
+		break;
+	}
+	case Type::HighPass:
+	{
+		const double n = (double)g;
+		const double c1 = 1.0 / (1.0 + sqrt2 * n + n * n);
+
+		c[0] = (float)c1;
+		c[1] = (float)(-2.0 * c1);
+		c[2] = (float)c1;
+		c[3] = (float)(2.0 * c1 * (n * n - 1.0));
+		c[4] = (float)(c1 * (1.0 - sqrt2 * n + n * n));
+		break;
+	}
+	case Type::ResoLow:
+	{
+		const double n = 1.0 / (double)g;
+		const double scaledQ = 1.0 / (3.0 * q);
+		const double c1 = 1.0 / (1.0 + scaledQ * n + n * n);
+
+		c[0] = (float)c1;
+		c[1] = (float)(2.0 * c1);
+		c[2] = (float)c1;
+		c[3] = (float)(2.0 * c1 * (1.0 - n * n));
+		c[4] = (float)(c1 * (1.0 - scaledQ * n + n * n));
+		break;
+	}
+	case Type::LowShelf:
+	case Type::HighShelf:
+	case Type::Peak:
+	{
+		// sin and cos of the angular frequency can be derived from the warped frequency tan(omega / 2)
+		const double t = (double)g;
+		const double d = 1.0 / (1.0 + t * t);
+		const double coso = (1.0 - t * t) * d;
+		const double sino = 2.0 * t * d;
+
+		const double A = jmax<double>(0.0, sqrt((double)gainFactor));
+
+		double b0, b1, b2, a0, a1, a2;
+
+		if (type == Type::Peak)
+		{
+			const double alpha = 0.5 * sino / q;
+			const double alphaTimesA = alpha * A;
+			const double alphaOverA = alpha / jmax<double>(A, 0.0001);
+
+			b0 = 1.0 + alphaTimesA;
+			b1 = -2.0 * coso;
+			b2 = 1.0 - alphaTimesA;
+			a0 = 1.0 + alphaOverA;
+			a1 = -2.0 * coso;
+			a2 = 1.0 - alphaOverA;
+		}
+		else
+		{
+			const double aminus1 = A - 1.0;
+			const double aplus1 = A + 1.0;
+			const double beta = sino * sqrt(A) / q;
+			const double aminus1TimesCoso = aminus1 * coso;
+
+			if (type == Type::LowShelf)
+			{
+				b0 = A * (aplus1 - aminus1TimesCoso + beta);
+				b1 = A * 2.0 * (aminus1 - aplus1 * coso);
+				b2 = A * (aplus1 - aminus1TimesCoso - beta);
+				a0 = aplus1 + aminus1TimesCoso + beta;
+				a1 = -2.0 * (aminus1 + aplus1 * coso);
+				a2 = aplus1 + aminus1TimesCoso - beta;
+			}
+			else
+			{
+				b0 = A * (aplus1 + aminus1TimesCoso + beta);
+				b1 = A * -2.0 * (aminus1 + aplus1 * coso);
+				b2 = A * (aplus1 + aminus1TimesCoso - beta);
+				a0 = aplus1 - aminus1TimesCoso + beta;
+				a1 = 2.0 * (aminus1 - aplus1 * coso);
+				a2 = aplus1 - aminus1TimesCoso - beta;
+			}
+		}
+
+		const double a0Inv = 1.0 / a0;
+
+		c[0] = (float)(b0 * a0Inv);
+		c[1] = (float)(b1 * a0Inv);
+		c[2] = (float)(b2 * a0Inv);
+		c[3] = (float)(a1 * a0Inv);
+		c[4] = (float)(a2 * a0Inv);
+		break;
+	}
+	case Type::StateVariableLP:
+	case Type::StateVariableHP:
+	{
+		const float k = 1.0f - 0.99f * (float)q * 0.1f;
+		const float ginv = g / (1.0f + g * (g + k));
+
+		c[0] = ginv;
+		c[1] = 2.0f * (g + k) * ginv;
+		c[2] = g * ginv;
+		c[3] = 2.0f * ginv;
+		c[4] = k;
+		break;
+	}
+	default:
+		jassertfalse;
+		break;
+	}
+}
+
+template <bool isStateVariable>
+void InterpolatedStereoFilter::processSubBlock(float* l, float* r, int numSamples, const float* target)
+{
+	const float factor = 1.0f / (float)numSamples;
+
+	const float delta0 = (target[0] - coefficients[0]) * factor;
+	const float delta1 = (target[1] - coefficients[1]) * factor;
+	const float delta2 = (target[2] - coefficients[2]) * factor;
+	const float delta3 = (target[3] - coefficients[3]) * factor;
+	const float delta4 = (target[4] - coefficients[4]) * factor;
+
+	float c0 = coefficients[0];
+	float c1 = coefficients[1];
+	float c2 = coefficients[2];
+	float c3 = coefficients[3];
+	float c4 = coefficients[4];
+
+	if (isStateVariable)
+	{
+		const bool highPass = type == Type::StateVariableHP;
+
+		float v0zL = state1[0], v0zR = state1[1];
+		float v1L = state2[0], v1R = state2[1];
+		float v2L = state3[0], v2R = state3[1];
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			c0 += delta0; c1 += delta1; c2 += delta2; c3 += delta3; c4 += delta4;
+
+			const float inL = l[i];
+			const float inR = r[i];
+
+			const float v3L = inL + v0zL - 2.0f * v2L;
+			const float v3R = inR + v0zR - 2.0f * v2R;
+
+			const float v1zL = v1L;
+			const float v1zR = v1R;
+
+			v1L += c0 * v3L - c1 * v1zL;
+			v1R += c0 * v3R - c1 * v1zR;
+			v2L += c2 * v3L + c3 * v1zL;
+			v2R += c2 * v3R + c3 * v1zR;
+
+			v0zL = inL;
+			v0zR = inR;
+
+			l[i] = highPass ? (inL - c4 * v1L - v2L) : v2L;
+			r[i] = highPass ? (inR - c4 * v1R - v2R) : v2R;
+		}
+
+		state1[0] = v0zL; state1[1] = v0zR;
+		state2[0] = v1L; state2[1] = v1R;
+		state3[0] = v2L; state3[1] = v2R;
+	}
+	else
+	{
+		// Transposed direct form II with both channels in the same loop
+		float s1L = state1[0], s1R = state1[1];
+		float s2L = state2[0], s2R = state2[1];
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			c0 += delta0; c1 += delta1; c2 += delta2; c3 += delta3; c4 += delta4;
+
+			const float inL = l[i];
+			const float inR = r[i];
+
+			const float outL = c0 * inL + s1L;
+			const float outR = c0 * inR + s1R;
+
+			s1L = c1 * inL - c3 * outL + s2L;
+			s1R = c1 * inR - c3 * outR + s2R;
+			s2L = c2 * inL - c4 * outL;
+			s2R = c2 * inR - c4 * outR;
+
+			l[i] = outL;
+			r[i] = outR;
+		}
+
+		state1[0] = s1L; state1[1] = s1R;
+		state2[0] = s2L; state2[1] = s2R;
+	}
+
+	memcpy(coefficients, target, sizeof(float) * 5);
+}
+
+void InterpolatedStereoFilter::processSamples(AudioSampleBuffer& b, int startSample, int numSamples, const FilterWarpTable& table, 
+											  const float* freqModValues, double frequency, const float* gainModValues, float gainFactor, double q)
+{
+	jassert(b.getNumChannels() == 2);
+
+	const bool isStateVariable = type == Type::StateVariableLP || type == Type::StateVariableHP;
+	const bool usesGain = type == Type::LowShelf || type == Type::HighShelf || type == Type::Peak;
+	const float gainDecibels = Decibels::gainToDecibels(gainFactor);
+
+	float* l = b.getWritePointer(0, startSample);
+	float* r = b.getWritePointer(1, startSample);
+
+	int offset = 0;
+
+	while (offset < numSamples)
+	{
+		const int numThisTime = jmin<int>(SubBlockSize, numSamples - offset);
+		const int lastIndex = offset + numThisTime - 1;
+
+		const double thisFrequency = jmax<double>(70.0, std::abs((double)freqModValues[lastIndex] * frequency));
+
+		float thisGain = gainFactor;
+
+		if (usesGain && gainModValues != nullptr)
+			thisGain = Decibels::decibelsToGain(gainModValues[lastIndex] * gainDecibels);
+
+		float target[5];
+		calculateCoefficients(target, table.getWarpedFrequency(thisFrequency), q, thisGain);
+
+		if (firstBlock)
+		{
+			memcpy(coefficients, target, sizeof(float) * 5);
+			firstBlock = false;
+		}
+
+		if (isStateVariable)
+			processSubBlock<true>(l + offset, r + offset, numThisTime, target);
+		else
+			processSubBlock<false>(l + offset, r + offset, numThisTime, target);
+
+		offset += numThisTime;
 	}
 }
@@ -330,9 +330,9 @@ public:
 
 	void reset() override
 	{
-		for (int i = 0; i < numChannels; i++)
+		for (int i = 0; i < NUM_MAX_CHANNELS / 2; i++)
 		{
-			filters[i].reset();
+			stages[i].reset();
 		}
 	}
 
@@ -343,10 +343,14 @@ public:
 			setNumChannels(b.getNumChannels());
 		}
 
-		for (int i = 0; i < numChannels; i++)
+		for (int i = 0; i < numChannels; i += 2)
 		{
-			float* d = b.getWritePointer(i, startSample);
-			filters[i].processSamples(d, numSamples);
+			BiquadFilterBank::Stage* s = stages + i / 2;
+
+			if (i + 1 < numChannels)
+				BiquadFilterBank::processStereo(&s, 1, b.getWritePointer(i, startSample), b.getWritePointer(i + 1, startSample), numSamples);
+			else
+				BiquadFilterBank::processMono(&s, 1, b.getWritePointer(i, startSample), numSamples);
 		}
 	}
 
@@ -356,7 +360,8 @@ public:
 
 	double gain = 1.0;
 
-	IIRFilter filters[NUM_MAX_CHANNELS];
+	/** One stereo stage for every channel pair. */
+	BiquadFilterBank::Stage stages[NUM_MAX_CHANNELS / 2];
 };
 
 
@@ -515,6 +520,104 @@ private:
 
 #endif
 
+/** A lookup table for the frequency warping tan(pi * f / sampleRate) that is used by the biquad and state variable filter designs.
+*
+*	The table is indexed linearly with the normalised frequency, which is accurate enough because the function is almost linear in 
+*	the audible range. This allows modulated filters to calculate their coefficients without trigonometric functions.
+*/
+class FilterWarpTable
+{
+public:
+
+	FilterWarpTable();
+
+	void setSampleRate(double newSampleRate);
+
+	/** Returns tan(pi * frequency / sampleRate). The frequency is limited to the range that can be represented at the current sample rate. */
+	float getWarpedFrequency(double frequency) const noexcept
+	{
+		const float index = jlimit<float>(0.0f, (float)TableSize - 1.0f, (float)(frequency * indexFactor));
+		const int i = (int)index;
+		const float alpha = index - (float)i;
+
+		return table[i] + alpha * (table[i + 1] - table[i]);
+	}
+
+private:
+
+	enum
+	{
+		TableSize = 4096
+	};
+
+	double indexFactor = 0.0;
+
+	float table[TableSize + 1];
+};
+
+/** A stereo filter with modulated coefficients.
+*
+*	The coefficients are calculated from the FilterWarpTable at every SubBlockSize samples and linearly interpolated in between,
+*	so modulated frequency sweeps are smooth without having to calculate the coefficients for every sample.
+*
+*	Both channels are processed in the same scalar loop, so they share the coefficient ramp. The processing itself is not vectorised.
+*/
+class InterpolatedStereoFilter
+{
+public:
+
+	enum class Type
+	{
+		LowPass = 0,
+		HighPass,
+		LowShelf,
+		HighShelf,
+		Peak,
+		ResoLow,
+		StateVariableLP,
+		StateVariableHP,
+		numTypes
+	};
+
+	enum
+	{
+		SubBlockSize = 16
+	};
+
+	InterpolatedStereoFilter();
+
+	void setType(Type newType);
+
+	/** Clears the filter state. The next call to processSamples() will not interpolate the coefficients. */
+	void reset();
+
+	/** Filters the first two channels of the buffer.
+	*
+	*	@param freqModValues	the frequency modulation values that are multiplied with the frequency (starting at startSample).
+	*	@param gainModValues	the gain modulation values that are multiplied with the gain in decibels (can be nullptr).
+	*	@param gainFactor		the gain of the shelf and peak filters.
+	*/
+	void processSamples(AudioSampleBuffer& b, int startSample, int numSamples, const FilterWarpTable& table, 
+						const float* freqModValues, double frequency, const float* gainModValues, float gainFactor, double q);
+
+private:
+
+	void calculateCoefficients(float* c, float g, double q, float gainFactor) const;
+
+	template <bool isStateVariable> void processSubBlock(float* l, float* r, int numSamples, const float* target);
+
+	Type type;
+
+	bool firstBlock;
+
+	/** The biquad coefficients (b0, b1, b2, a1, a2) or the state variable coefficients (g1, g2, g3, g4, k) */
+	float coefficients[5];
+
+	float state1[2];
+	float state2[2];
+	float state3[2];
+};
+
 class FilterEffect
 {
 public:
@@ -732,6 +835,9 @@ public:
 
 private:
 
+	/** Returns true if the mode can be rendered with the InterpolatedStereoFilter. */
+	static bool isInterpolatedMode(MonoFilterEffect::FilterMode m) { return m <= MonoFilterEffect::StateVariableHP; }
+
 	friend class HarmonicFilter;
 
 	bool changeFlag;
@@ -746,6 +852,9 @@ private:
 
 	OwnedArray<MonoFilterEffect> voiceFilters;
 
+	OwnedArray<InterpolatedStereoFilter> interpolatedFilters;
+	FilterWarpTable warpTable;
+
 	ScopedPointer<ModulatorChain> freqChain;
 	ScopedPointer<ModulatorChain> gainChain;
 
@@ -92,6 +92,8 @@ public:
 	
 	bool hasTail() const override { return false; };
 
+	double getTailLengthInSeconds() const override { return (double)delay * 0.001; };
+
 	Processor *getChildProcessor(int processorIndex) override
     {
         switch(processorIndex)
@@ -30,6 +30,114 @@
 *   ===========================================================================
 */
 
+HarmonicFilterBank::HarmonicFilterBank() :
+	numBands(1),
+	sampleRate(44100.0),
+	fundamental(0.0),
+	q(12.0f)
+{
+}
+
+void HarmonicFilterBank::setNumBands(int newNumBands)
+{
+	const int lastNumBands = numBands;
+
+	numBands = jlimit<int>(0, (int)MaxNumBands, newNumBands);
+
+	for (int i = lastNumBands; i < numBands; i++)
+	{
+		updateBand(i, true);
+	}
+}
+
+void HarmonicFilterBank::setSampleRate(double newSampleRate)
+{
+	sampleRate = newSampleRate;
+
+	for (int i = 0; i < MaxNumBands; i++)
+	{
+		updateBand(i, true);
+	}
+}
+
+void HarmonicFilterBank::setFundamental(double newFundamental)
+{
+	fundamental = newFundamental;
+
+	for (int i = 0; i < numBands; i++)
+	{
+		updateBand(i, true);
+	}
+}
+
+void HarmonicFilterBank::updateBand(int bandIndex, bool resetState)
+{
+	Band& band = bands[bandIndex];
+
+	const double freqForThisHarmonic = fundamental * (double)(bandIndex + 1);
+
+	band.active = fundamental > 0.0 && freqForThisHarmonic <= (sampleRate * 0.4); // Spare frequencies above Nyquist
+
+	if (band.active)
+	{
+		const double omega = 2.0 * double_Pi * jmax<double>(freqForThisHarmonic, 2.0) / sampleRate;
+
+		band.sinOmega = std::sin(omega);
+		band.cosOmega = std::cos(omega);
+	}
+
+	if (resetState)
+	{
+		band.stage.reset();
+	}
+}
+
+void HarmonicFilterBank::updateCoefficients(Band& band) const
+{
+	// Same as IIRCoefficients::makePeakFilter() with the precalculated sine & cosine
+	const double A = std::sqrt(jmax<double>(0.0, (double)band.currentGain));
+	const double alpha = 0.5 * band.sinOmega / jmax<double>(0.001, (double)q);
+	const double c2 = -2.0 * band.cosOmega;
+	const double a0 = 1.0 / (1.0 + alpha / A);
+
+	band.stage.c[0] = (float)((1.0 + alpha * A) * a0);
+	band.stage.c[1] = (float)(c2 * a0);
+	band.stage.c[2] = (float)((1.0 - alpha * A) * a0);
+	band.stage.c[3] = (float)(c2 * a0);
+	band.stage.c[4] = (float)((1.0 - alpha / A) * a0);
+}
+
+void HarmonicFilterBank::process(const float* gainValues, AudioSampleBuffer& b, int startSample, int numSamples)
+{
+	while (numSamples > 0)
+	{
+		const int numThisTime = jmin<int>(numSamples, SubBlockSize);
+
+		int numStages = 0;
+
+		for (int i = 0; i < numBands; i++)
+		{
+			Band& band = bands[i];
+
+			if (!band.active || gainValues[i] == 0.0f)
+				continue;
+
+			band.currentGain = band.currentGain * 0.7f + Decibels::decibelsToGain(gainValues[i]) * 0.3f;
+
+			updateCoefficients(band);
+
+			processedStages[numStages++] = &band.stage;
+		}
+
+		BiquadFilterBank::process(processedStages, numStages, b, startSample, numThisTime);
+
+		startSample += numThisTime;
+		numSamples -= numThisTime;
+	}
+}
+
+// ====================================================================================================================================================
+
 HarmonicFilter::HarmonicFilter(MainController *mc, const String &uid, int numVoices_) :
 VoiceEffectProcessor(mc, uid, numVoices_),
 q(12.0f),
@@ -51,6 +159,11 @@ semiToneTranspose(0)
 	dataB->setRange(-24.0, 24.0, 0.1);
 	dataMix->setRange(-24.0, 24.0, 0.1);
 
+	for (int i = 0; i < numVoices; i++)
+	{
+		filterBanks.add(new HarmonicFilterBank());
+	}
+
 	setNumFilterBands(filterBandIndex);
 
 	setQ(q);
@@ -114,13 +227,9 @@ void HarmonicFilter::setQ(float newQ)
 {
 	q = newQ;
 
-	for (int i = 0; i < harmonicFilters.size(); i++)
+	for (int i = 0; i < filterBanks.size(); i++)
 	{
-		for (int j = 0; j < harmonicFilters[i]->voiceFilters.size(); j++)
-		{
-			harmonicFilters[i]->voiceFilters[j]->setAttribute(MonoFilterEffect::Q, newQ, dontSendNotification);
-			if(getSampleRate() > 0.0) harmonicFilters[i]->voiceFilters[j]->calcCoefficients();
-		}
+		filterBanks[i]->setQ(newQ);
 	}
 }
 
@@ -130,31 +239,13 @@ void HarmonicFilter::setNumFilterBands(int newFilterBandIndex)
 
 	filterBandIndex = newFilterBandIndex;
 
-	harmonicFilters.clear();
-
 	dataA->setNumSliders(numBands);
 	dataB->setNumSliders(numBands);
 	dataMix->setNumSliders(numBands);
 
-	for (int i = 0; i < numBands; i++)
+	for (int i = 0; i < filterBanks.size(); i++)
 	{
-		PolyFilterEffect *poly = new PolyFilterEffect(getMainController(), String(i), numVoices);
-
-		poly->setAttribute(MonoFilterEffect::Q, q, dontSendNotification);
-		poly->setAttribute(MonoFilterEffect::Mode, MonoFilterEffect::FilterMode::Peak, dontSendNotification);
-		poly->setAttribute(MonoFilterEffect::Gain, 0.0f, dontSendNotification);
-
-		if (getSampleRate() > 0)
-		{
-			poly->prepareToPlay(getSampleRate(), getBlockSize());
-		}
-
-		for (int j = 0; j < numVoices; j++)
-		{
-			poly->voiceFilters[j]->setUseFixedFrequency(true);
-		}
-
-		harmonicFilters.add(poly);
+		filterBanks[i]->setNumBands(numBands);
 	}
 }
 
@@ -169,9 +260,9 @@ void HarmonicFilter::prepareToPlay(double sampleRate, int samplesPerBlock)
 
 	ProcessorHelpers::increaseBufferIfNeeded(timeVariantFreqModulatorBuffer, samplesPerBlock);
 
-	for (int i = 0; i < harmonicFilters.size(); i++)
+	for (int i = 0; i < filterBanks.size(); i++)
 	{
-		harmonicFilters[i]->prepareToPlay(sampleRate, samplesPerBlock);
+		filterBanks[i]->setSampleRate(sampleRate);
 	}
 }
 
@@ -186,31 +277,7 @@ void HarmonicFilter::startVoice(int voiceIndex, int noteNumber)
 
 	const float freq = (float)MidiMessage::getMidiNoteInHertz(noteNumber + semiToneTranspose);
 
-	for (int i = 0; i < harmonicFilters.size(); i++)
-	{
-		const float freqForThisHarmonic = freq * (float)(i + 1);
-
-		if (freqForThisHarmonic >(getSampleRate() * 0.4)) // Spare frequencies above Nyquist
-		{
-			MonoFilterEffect *filter = harmonicFilters[i]->voiceFilters[voiceIndex];
-
-			filter->currentFilter->reset();
-			
-			harmonicFilters[i]->voiceFilters[voiceIndex]->setBypassed(true);
-		}
-		else
-		{
-			harmonicFilters[i]->voiceFilters[voiceIndex]->setBypassed(false);
-
-			harmonicFilters[i]->voiceFilters[voiceIndex]->setAttribute(MonoFilterEffect::Frequency, freqForThisHarmonic, dontSendNotification);
-
-			// harmonicFilters[i]->startVoice(voiceIndex, noteNumber); // Don't need the modulator chains
-			
-			MonoFilterEffect *filter = harmonicFilters[i]->voiceFilters[voiceIndex];
-
-			filter->currentFilter->reset();
-		}
-	}
+	filterBanks[voiceIndex]->setFundamental(freq);
 }
 
 void HarmonicFilter::applyEffect(int voiceIndex, AudioSampleBuffer &b, int startSample, int numSamples)
@@ -232,25 +299,16 @@ void HarmonicFilter::applyEffect(int voiceIndex, AudioSampleBuffer &b, int start
 		xModValue = currentCrossfadeValue;
 	}
 
-	for (int i = 0; i < harmonicFilters.size(); i++)
-	{
-		//const float gainValue = dataMix->getValue(i);
-
-		const float gainValue = Interpolator::interpolateLinear(dataA->getValue(i), dataB->getValue(i), (float)xModValue);
-
-		if (gainValue == 0.0f || harmonicFilters[i]->voiceFilters[voiceIndex]->isBypassed())
-		{
-			continue;
-		}
-		else
-		{
-			harmonicFilters[i]->voiceFilters[voiceIndex]->setAttribute(MonoFilterEffect::Gain, gainValue, dontSendNotification);
-			//harmonicFilters[i]->voiceFilters[voiceIndex]->calcCoefficients();
-			harmonicFilters[i]->voiceFilters[voiceIndex]->applyEffect(b, startSample, numSamples);
-		}
+	float gainValues[HarmonicFilterBank::MaxNumBands];
 
+	const int numSliders = dataA->getNumSliders();
 
+	for (int i = 0; i < HarmonicFilterBank::MaxNumBands; i++)
+	{
+		gainValues[i] = i < numSliders ? Interpolator::interpolateLinear(dataA->getValue(i), dataB->getValue(i), (float)xModValue) : 0.0f;
 	}
+
+	filterBanks[voiceIndex]->process(gainValues, b, startSample, numSamples);
 }
 
 ProcessorEditorBody * HarmonicFilter::createEditor(ProcessorEditor *parentEditor)
@@ -403,12 +461,7 @@ void HarmonicMonophonicFilter::setQ(float newQ)
 {
 	q = newQ;
 
-	for (int i = 0; i < harmonicFilters.size(); i++)
-	{
-		harmonicFilters[i]->setAttribute(MonoFilterEffect::Q, newQ, dontSendNotification);
-
-		if (getSampleRate() > 0.0) harmonicFilters[i]->calcCoefficients();
-	}
+	filterBank.setQ(newQ);
 }
 
 void HarmonicMonophonicFilter::setNumFilterBands(int newFilterBandIndex)
@@ -417,30 +470,11 @@ void HarmonicMonophonicFilter::setNumFilterBands(int newFilterBandIndex)
 
 	filterBandIndex = newFilterBandIndex;
 
-	harmonicFilters.clear();
-
 	dataA->setNumSliders(numBands);
 	dataB->setNumSliders(numBands);
 	dataMix->setNumSliders(numBands);
 
-	for (int i = 0; i < numBands; i++)
-	{
-		MonoFilterEffect *mono = new MonoFilterEffect(getMainController(), String(i));
-
-		mono->setAttribute(MonoFilterEffect::Q, q, dontSendNotification);
-		mono->setAttribute(MonoFilterEffect::Mode, MonoFilterEffect::FilterMode::Peak, dontSendNotification);
-		mono->setAttribute(MonoFilterEffect::Gain, 0.0f, dontSendNotification);
-
-		if (getSampleRate() > 0)
-		{
-			mono->prepareToPlay(getSampleRate(), getBlockSize());
-		}
-
-		mono->setUseFixedFrequency(true);
-		mono->setUseInternalChains(false);
-		
-		harmonicFilters.add(mono);
-	}
+	filterBank.setNumBands(numBands);
 }
 
 void HarmonicMonophonicFilter::setSemitoneTranspose(float newValue)
@@ -452,10 +486,7 @@ void HarmonicMonophonicFilter::prepareToPlay(double sampleRate, int samplesPerBl
 {
 	MonophonicEffectProcessor::prepareToPlay(sampleRate, samplesPerBlock);
 
-	for (int i = 0; i < harmonicFilters.size(); i++)
-	{
-		harmonicFilters[i]->prepareToPlay(sampleRate, samplesPerBlock);
-	}
+	filterBank.setSampleRate(sampleRate);
 }
 void HarmonicMonophonicFilter::startMonophonicVoice(int noteNumber)
 {
@@ -463,30 +494,7 @@ void HarmonicMonophonicFilter::startMonophonicVoice(int noteNumber)
 
 	const float freq = (float)MidiMessage::getMidiNoteInHertz(noteNumber + semiToneTranspose);
 
-	for (int i = 0; i < harmonicFilters.size(); i++)
-	{
-		const float freqForThisHarmonic = freq * (float)(i + 1);
-
-		if (freqForThisHarmonic >(getSampleRate() * 0.4)) // Spare frequencies above Nyquist
-		{
-			MonoFilterEffect *filter = harmonicFilters[i];
-
-			filter->currentFilter->reset();
-
-			filter->setBypassed(true);
-		}
-		else
-		{
-			MonoFilterEffect *filter = harmonicFilters[i];
-
-			filter->setBypassed(false);
-
-			filter->setAttribute(MonoFilterEffect::Frequency, freqForThisHarmonic, dontSendNotification);
-
-			filter->currentFilter->reset();
-		}
-
-	}
+	filterBank.setFundamental(freq);
 }
 
 void HarmonicMonophonicFilter::applyEffect(AudioSampleBuffer &b, int startSample, int numSamples)
@@ -510,20 +518,16 @@ void HarmonicMonophonicFilter::applyEffect(AudioSampleBuffer &b, int startSample
 		xModValue = currentCrossfadeValue;
 	}
 
-	for (int i = 0; i < harmonicFilters.size(); i++)
-	{
-		const float gainValue = Interpolator::interpolateLinear(dataA->getValue(i), dataB->getValue(i), (float)xModValue);
+	float gainValues[HarmonicFilterBank::MaxNumBands];
 
-		if (gainValue == 0.0f || harmonicFilters[i]->isBypassed())
-		{
-			continue;
-		}
-		else
-		{
-			harmonicFilters[i]->setAttribute(MonoFilterEffect::Gain, gainValue, dontSendNotification);
-			harmonicFilters[i]->applyEffect(b, startSample, numSamples);
-		}
+	const int numSliders = dataA->getNumSliders();
+
+	for (int i = 0; i < HarmonicFilterBank::MaxNumBands; i++)
+	{
+		gainValues[i] = i < numSliders ? Interpolator::interpolateLinear(dataA->getValue(i), dataB->getValue(i), (float)xModValue) : 0.0f;
 	}
+
+	filterBank.process(gainValues, b, startSample, numSamples);
 }
 
 ProcessorEditorBody * HarmonicMonophonicFilter::createEditor(ProcessorEditor *parentEditor)
@@ -46,6 +46,63 @@ public:
 
 };
 
+/** The peak filters for the harmonics of one voice.
+*
+*	The sine and cosine of every harmonic are calculated once when the voice starts, so updating the gain
+*	only needs a square root per band. All active bands are processed as one cascade with the BiquadFilterBank.
+*/
+class HarmonicFilterBank
+{
+public:
+
+	enum
+	{
+		MaxNumBands = 16,
+		SubBlockSize = 256 ///< the interval of the gain smoothing and coefficient updates
+	};
+
+	HarmonicFilterBank();
+
+	void setNumBands(int newNumBands);
+
+	void setSampleRate(double newSampleRate);
+
+	void setQ(float newQ) { q = newQ; };
+
+	/** Sets the band frequencies to the harmonics of the given frequency and clears the filter state. 
+	*
+	*	Harmonics above 0.4 * samplerate are deactivated.
+	*/
+	void setFundamental(double newFundamental);
+
+	/** Filters the buffer. gainValues contains the target gain in decibels for every band. A band with 0 dB is skipped. */
+	void process(const float* gainValues, AudioSampleBuffer& b, int startSample, int numSamples);
+
+private:
+
+	struct Band
+	{
+		BiquadFilterBank::Stage stage;
+
+		double sinOmega = 0.0;
+		double cosOmega = 1.0;
+		float currentGain = 1.0f;
+		bool active = false;
+	};
+
+	void updateBand(int bandIndex, bool resetState);
+
+	void updateCoefficients(Band& band) const;
+
+	Band bands[MaxNumBands];
+	BiquadFilterBank::Stage* processedStages[MaxNumBands];
+
+	int numBands;
+	double sampleRate;
+	double fundamental;
+	float q;
+};
+
  
 
 class HarmonicFilter : public VoiceEffectProcessor,
@@ -141,7 +198,7 @@ private:
 	ScopedPointer<SliderPackData> dataB;
 	ScopedPointer<SliderPackData> dataMix;
 
-	OwnedArray<PolyFilterEffect> harmonicFilters;
+	OwnedArray<HarmonicFilterBank> filterBanks;
 	ScopedPointer<ModulatorChain> xFadeChain;
 	AudioSampleBuffer timeVariantFreqModulatorBuffer;
 };
@@ -238,7 +295,7 @@ private:
 	ScopedPointer<SliderPackData> dataB;
 	ScopedPointer<SliderPackData> dataMix;
 
-	OwnedArray<MonoFilterEffect> harmonicFilters;
+	HarmonicFilterBank filterBank;
 	ScopedPointer<ModulatorChain> xFadeChain;
 	AudioSampleBuffer timeVariantFreqModulatorBuffer;
 };
@@ -40,6 +40,7 @@ mix(1.0f),
 phaseModulationChain(new ModulatorChain(mc, "Phase Modulation", 1, Modulation::GainMode, this))
 {
 	phaseModulationBuffer = AudioSampleBuffer(1, 0);
+	coefficientBuffer = AudioSampleBuffer(1, 0);
 
     parameterNames.add("Frequency1");
     parameterNames.add("Frequency2");
@@ -106,6 +107,7 @@ void PhaseFX::prepareToPlay(double sampleRate, int samplesPerBlock)
     MasterEffectProcessor::prepareToPlay(sampleRate, samplesPerBlock);
 
 	ProcessorHelpers::increaseBufferIfNeeded(phaseModulationBuffer, samplesPerBlock);
+	ProcessorHelpers::increaseBufferIfNeeded(coefficientBuffer, samplesPerBlock);
 
 	phaseModulationChain->prepareToPlay(sampleRate, samplesPerBlock);
 
@@ -124,20 +126,12 @@ void PhaseFX::applyEffect(AudioSampleBuffer &buffer, int startSample, int numSam
 {
 	const float *modValues = phaseModulationBuffer.getReadPointer(0, startSample);
 
-	float *l = buffer.getWritePointer(0, startSample);
-	float *r = buffer.getWritePointer(1, startSample);
+	float *coefficients = coefficientBuffer.getWritePointer(0, startSample);
 
-	while (--numSamples >= 0)
-	{
-		
-
-		*l = *l * (1.0f - mix) + mix * phaserLeft.getNextSample(*l, *modValues);
-		*r = *r * (1.0f-mix) + mix * phaserRight.getNextSample(*r, *modValues);
-		
-		l++;
-		r++;
-		modValues++;
-	}
+	phaserLeft.calculateCoefficients(coefficients, modValues, numSamples);
+
+	phaserLeft.processBlock(buffer.getWritePointer(0, startSample), coefficients, numSamples, mix);
+	phaserRight.processBlock(buffer.getWritePointer(1, startSample), coefficients, numSamples, mix);
 }
 
 ProcessorEditorBody *PhaseFX::createEditor(ProcessorEditor *parentEditor)
@@ -182,27 +176,56 @@ void PhaseFX::PhaseModulator::setSampleRate(double newSampleRate)
 	setRange(fMin, fMax);
 }
 
-float PhaseFX::PhaseModulator::getNextSample(float input, float modValue)
+void PhaseFX::PhaseModulator::calculateCoefficients(float* coefficients, const float* modValues, int numSamples) const
 {
-	float delayThisSample = minDelay + (maxDelay - minDelay) * (modValue);
+	FloatVectorOperations::copyWithMultiply(coefficients, modValues, maxDelay - minDelay, numSamples);
+	FloatVectorOperations::add(coefficients, minDelay, numSamples);
+
+	for (int i = 0; i < numSamples; i++)
+	{
+		coefficients[i] = AllpassDelay::getDelayCoefficient(coefficients[i]);
+	}
+}
 
-	const float delayCoefficient = AllpassDelay::getDelayCoefficient(delayThisSample);
+void PhaseFX::PhaseModulator::processBlock(float* data, const float* coefficients, int numSamples, float mix)
+{
+	float s0 = allpassFilters[0].currentValue;
+	float s1 = allpassFilters[1].currentValue;
+	float s2 = allpassFilters[2].currentValue;
+	float s3 = allpassFilters[3].currentValue;
+	float s4 = allpassFilters[4].currentValue;
+	float s5 = allpassFilters[5].currentValue;
 
-	allpassFilters[0].setDelay(delayCoefficient);
-	allpassFilters[1].setDelay(delayCoefficient);
-	allpassFilters[2].setDelay(delayCoefficient);
-	allpassFilters[3].setDelay(delayCoefficient);
-	allpassFilters[4].setDelay(delayCoefficient);
-	allpassFilters[5].setDelay(delayCoefficient);
+	float lastOutput = currentValue;
 
-	float output = allpassFilters[0].getNextSample(
-		allpassFilters[1].getNextSample(
-		allpassFilters[2].getNextSample(
-		allpassFilters[3].getNextSample(
-		allpassFilters[4].getNextSample(
-		allpassFilters[5].getNextSample(input + currentValue * feedback))))));
+	const float dryMix = 1.0f - mix;
+
+	for (int i = 0; i < numSamples; i++)
+	{
+		const float c = coefficients[i];
+		const float input = data[i];
+
+		float x = input + lastOutput * feedback;
+		float y;
+
+		y = x * -c + s5; s5 = y * c + x; x = y;
+		y = x * -c + s4; s4 = y * c + x; x = y;
+		y = x * -c + s3; s3 = y * c + x; x = y;
+		y = x * -c + s2; s2 = y * c + x; x = y;
+		y = x * -c + s1; s1 = y * c + x; x = y;
+		y = x * -c + s0; s0 = y * c + x;
+
+		lastOutput = y;
+
+		data[i] = input * dryMix + mix * (input + y);
+	}
 
-	currentValue = output;
+	allpassFilters[0].currentValue = s0;
+	allpassFilters[1].currentValue = s1;
+	allpassFilters[2].currentValue = s2;
+	allpassFilters[3].currentValue = s3;
+	allpassFilters[4].currentValue = s4;
+	allpassFilters[5].currentValue = s5;
 
-	return input + output;
+	currentValue = lastOutput;
 }
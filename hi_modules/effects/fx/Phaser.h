@@ -93,7 +93,11 @@ private:
 		void setFeedback(float newFeedback) noexcept { feedback = 0.99f * newFeedback; }
 		void setSampleRate(double newSampleRate);
 
-		float getNextSample(float input, float modValue);;
+		/** Calculates the allpass coefficient for every modulation value. */
+		void calculateCoefficients(float* coefficients, const float* modValues, int numSamples) const;
+
+		/** Processes the block in place using the coefficients from calculateCoefficients() and mixes the dry signal. */
+		void processBlock(float* data, const float* coefficients, int numSamples, float mix);
 
 	private:
 
@@ -120,6 +124,8 @@ private:
 				return y;
 			}
 
+			friend class PhaseModulator;
+
 		private:
 			float delay, currentValue;
 		};
@@ -150,6 +156,9 @@ private:
 
 	AudioSampleBuffer phaseModulationBuffer;
 
+	/** The allpass coefficients of the current block (they are the same for both channels). */
+	AudioSampleBuffer coefficientBuffer;
+
 	PhaseModulator phaserLeft;
 	PhaseModulator phaserRight;
 
@@ -37,7 +37,8 @@ SaturatorEffect::SaturatorEffect(MainController *mc, const String &uid) :
 	wet(1.0f),
 	dry(0.0f),
 	preGain(1.0f),
-    postGain(1.0f)
+    postGain(1.0f),
+	oversamplingFactor(1)
 {
 	saturationBuffer = AudioSampleBuffer(1, 0);
 
@@ -45,6 +46,8 @@ SaturatorEffect::SaturatorEffect(MainController *mc, const String &uid) :
 	parameterNames.add("WetAmount");
 	parameterNames.add("PreGain");
 	parameterNames.add("PostGain");
+	parameterNames.add("Oversampling");
+	parameterNames.add("OversamplingFilter");
 
 	editorStateIdentifiers.add("SaturationChainShown");
 
@@ -71,6 +74,15 @@ void SaturatorEffect::setInternalAttribute(int parameterIndex, float newValue)
 	case PostGain:
 		postGain = Decibels::decibelsToGain(newValue);
 		break;
+	case Oversampling:
+		oversamplingFactor = Oversampler::getValidFactor((int)newValue);
+		oversampler.setFactor(oversamplingFactor);
+		getMainController()->updateLatency();
+		break;
+	case OversamplingFilter:
+		oversampler.setFilterType((Oversampler::FilterType)jlimit<int>(0, Oversampler::numFilterTypes - 1, (int)newValue));
+		getMainController()->updateLatency();
+		break;
 	default:
 		break;
 	}
@@ -91,6 +103,10 @@ float SaturatorEffect::getAttribute(int parameterIndex) const
 		return Decibels::gainToDecibels(preGain);
 	case PostGain:
 		return Decibels::gainToDecibels(postGain);
+	case Oversampling:
+		return (float)oversamplingFactor;
+	case OversamplingFilter:
+		return (float)oversampler.getFilterType();
 	default:
 		break;
 	}
@@ -113,6 +129,10 @@ float SaturatorEffect::getDefaultValue(int parameterIndex) const
 		return 0.0;
 	case PostGain:
 		return 0.0;
+	case Oversampling:
+		return 1.0;
+	case OversamplingFilter:
+		return (float)Oversampler::LinearPhase;
 	default:
 		break;
 	}
@@ -129,6 +149,8 @@ void SaturatorEffect::restoreFromValueTree(const ValueTree &v)
 	loadAttribute(WetAmount, "WetAmount");
 	loadAttribute(PreGain, "PreGain");
 	loadAttribute(PostGain, "PostGain");
+	loadAttribute(Oversampling, "Oversampling");
+	loadAttribute(OversamplingFilter, "OversamplingFilter");
 }
 
 ValueTree SaturatorEffect::exportAsValueTree() const
@@ -139,6 +161,8 @@ ValueTree SaturatorEffect::exportAsValueTree() const
 	saveAttribute(WetAmount, "WetAmount");
 	saveAttribute(PreGain, "PreGain");
 	saveAttribute(PostGain, "PostGain");
+	saveAttribute(Oversampling, "Oversampling");
+	saveAttribute(OversamplingFilter, "OversamplingFilter");
 
 	return v;
 }
@@ -161,9 +185,6 @@ ProcessorEditorBody * SaturatorEffect::createEditor(ProcessorEditor *parentEdito
 
 void SaturatorEffect::applyEffect(AudioSampleBuffer &buffer, int startSample, int numSamples)
 {
-    float *l = buffer.getWritePointer(0, startSample);
-	float *r = buffer.getWritePointer(1, startSample);
-
 	float const *modValues = nullptr;
 
 	if (!saturationChain->isBypassed() && saturationChain->getNumChildProcessors() != 0)
@@ -171,11 +192,30 @@ void SaturatorEffect::applyEffect(AudioSampleBuffer &buffer, int startSample, in
 		modValues = saturationBuffer.getReadPointer(0, startSample);
 	}
 
+	if (oversamplingFactor > 1)
+	{
+		AudioSampleBuffer& oversampledBuffer = oversampler.upsample(buffer, startSample, numSamples);
+
+		const int factor = oversampler.getFactor();
+
+		processSaturation(oversampledBuffer.getWritePointer(0), oversampledBuffer.getWritePointer(1), modValues, numSamples * factor, factor);
+
+		oversampler.downsample(buffer, startSample, numSamples);
+	}
+	else
+	{
+		processSaturation(buffer.getWritePointer(0, startSample), buffer.getWritePointer(1, startSample), modValues, numSamples, 1);
+	}
+}
+
+void SaturatorEffect::processSaturation(float* l, float* r, const float* modValues, int numSamples, int factor)
+{
 	for (int i = 0; i < numSamples; i++)
 	{
 		if (modValues != nullptr && (i & 7))
 		{
-			saturator.setSaturationAmount(modValues[i] * saturation);
+			// The modulation values are calculated with the original sample rate
+			saturator.setSaturationAmount(modValues[i / factor] * saturation);
 		}
 
 		l[i] = dry * l[i] + wet * (postGain * saturator.getSaturatedSample(preGain*l[i]));
@@ -190,5 +230,7 @@ void SaturatorEffect::prepareToPlay(double sampleRate, int samplesPerBlock)
 	if (sampleRate > 0)
 	{
 		ProcessorHelpers::increaseBufferIfNeeded(saturationBuffer, samplesPerBlock);
+
+		oversampler.prepareToPlay(sampleRate, samplesPerBlock);
 	}
 }
@@ -58,6 +58,8 @@ public:
 		WetAmount,
 		PreGain,
 		PostGain,
+		Oversampling, ///< the oversampling factor (1, 2, 4 or 8)
+		OversamplingFilter, ///< the filter type of the oversampler (see Oversampler::FilterType)
 		numParameters
 	};
 
@@ -80,6 +82,8 @@ public:
 
 	bool hasTail() const override { return false; };
 
+	int getLatencySamples() const override { return oversamplingFactor > 1 ? oversampler.getLatencySamples() : 0; }
+
 	Processor *getChildProcessor(int /*processorIndex*/) override { return saturationChain; };
 	const Processor *getChildProcessor(int /*processorIndex*/) const override { return saturationChain; };
 	int getNumInternalChains() const override { return numInternalChains; };
@@ -92,6 +96,8 @@ public:
 
 private:
 
+	void processSaturation(float* l, float* r, const float* modValues, int numSamples, int factor);
+
 	float dry;
 	float wet;
 	float saturation;
@@ -100,6 +106,9 @@ private:
 
 	Saturator saturator;
 
+	int oversamplingFactor;
+	Oversampler oversampler;
+
 	ScopedPointer<ModulatorChain> saturationChain;
 
 	AudioSampleBuffer saturationBuffer;
@@ -146,20 +146,23 @@ public:
 
 	void applyEffect(AudioSampleBuffer &buffer, int startSample, int numSamples) override
 	{
-		const bool inputSilent = buffer.getMagnitude(startSample, numSamples) == 0.0f;
+		reverb.processStereo(buffer.getWritePointer(0, startSample), buffer.getWritePointer(1, startSample), numSamples);
+	};
 
-		if(!inputSilent || tailActive)
-		{
-			reverb.processStereo(buffer.getWritePointer(0, startSample), buffer.getWritePointer(1, startSample), numSamples);
+	bool hasTail() const override {return false; };
 
-			const float outputLevel = buffer.getMagnitude(startSample, numSamples);
-			const bool outputSilent = outputLevel <= 0.0001f;
-			tailActive = !outputSilent;
-		}
+	double getTailLengthInSeconds() const override
+	{
+		// A frozen reverb keeps on ringing
+		if (parameters.freezeMode >= 0.5f) return -1.0;
 
-	};
+		// The comb and allpass lengths and the feedback calculation of juce::Reverb (the lengths are scaled with the samplerate)
+		const double longestComb = (1617.0 + 23.0) / 44100.0;
+		const double longestAllpass = (556.0 + 23.0) / 44100.0;
+		const double combFeedback = (double)parameters.roomSize * 0.28 + 0.7;
 
-	bool hasTail() const override {return false; };
+		return getFeedbackTailLength(longestComb, combFeedback) + 4.0 * getFeedbackTailLength(longestAllpass, 0.5);
+	}
 
 
 	int getNumChildProcessors() const override { return 0; };
@@ -173,8 +176,6 @@ public:
 	
 private:
 
-	bool tailActive;
-
 	Reverb reverb;
 	Reverb::Parameters parameters;
 };
@@ -76,11 +76,13 @@
 #include "effects/MdaEffectWrapper.cpp"
 
 #include "effects/fx/RouteFX.cpp"
+#include "effects/fx/BiquadFilterBank.cpp"
 #include "effects/fx/Filters.cpp"
 #include "effects/fx/HarmonicFilter.cpp"
 #include "effects/fx/CurveEq.cpp"
 #include "effects/fx/StereoFX.cpp"
 #include "effects/fx/SimpleReverb.cpp"
+#include "effects/fx/FdnReverb.cpp"
 #include "effects/fx/Delay.cpp"
 #include "effects/fx/GainEffect.cpp"
 #include "effects/fx/Chorus.cpp"
@@ -100,6 +102,7 @@
 #include "effects/editors/CurveEqEditor.cpp"
 #include "effects/editors/StereoEditor.cpp"
 #include "effects/editors/ReverbEditor.cpp"
+#include "effects/editors/FdnReverbEditor.cpp"
 #include "effects/editors/DelayEditor.cpp"
 #include "effects/editors/GainEditor.cpp"
 #include "effects/editors/ChorusEditor.cpp"
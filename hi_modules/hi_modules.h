@@ -133,11 +133,13 @@ END_JUCE_MODULE_DECLARATION
 #include "effects/MdaEffectWrapper.h"
 
 #include "effects/fx/RouteFX.h"
+#include "effects/fx/BiquadFilterBank.h"
 #include "effects/fx/Filters.h"
 #include "effects/fx/HarmonicFilter.h"
 #include "effects/fx/CurveEq.h"
 #include "effects/fx/StereoFX.h"
 #include "effects/fx/SimpleReverb.h"
+#include "effects/fx/FdnReverb.h"
 #include "effects/fx/Delay.h"
 #include "effects/fx/GainEffect.h"
 #include "effects/fx/Chorus.h"
@@ -158,6 +160,7 @@ END_JUCE_MODULE_DECLARATION
 #include "effects/editors/CurveEqEditor.h"
 #include "effects/editors/StereoEditor.h"
 #include "effects/editors/ReverbEditor.h"
+#include "effects/editors/FdnReverbEditor.h"
 #include "effects/editors/DelayEditor.h"
 #include "effects/editors/GainEditor.h"
 #include "effects/editors/ChorusEditor.h"
@@ -32,6 +32,95 @@
 
 #include "ClarinetData.cpp"
 
+#if JUCE_INTEL && !JUCE_IOS
+#define HI_WAVETABLE_USE_SSE 1
+#include <emmintrin.h>
+#else
+#define HI_WAVETABLE_USE_SSE 0
+#endif
+
+void WavetableSound::createMipmaps()
+{
+	mipmaps.clear();
+	numMipLevels = 0;
+
+	if (wavetableSize <= 0 || wavetableAmount <= 0) return;
+
+	// Twice the size of the original table keeps the error of the linear interpolation low for the highest harmonics
+	mipmapSize = jlimit<int>(MinMipmapSize, MaxMipmapSize, nextPowerOfTwo(wavetableSize) * 2);
+	highestHarmonic = jmax<int>(1, jmin<int>(wavetableSize / 2, mipmapSize / 4));
+
+	for (int h = highestHarmonic; h >= 1 && numMipLevels < MaxMipLevels; h /= 2)
+		numMipLevels++;
+
+	for (int level = 0; level < numMipLevels; level++)
+		mipmaps.add(new AudioSampleBuffer(1, getMipmapSize(level) * wavetableAmount));
+
+	int order = 0;
+
+	while ((1 << order) < mipmapSize)
+		order++;
+
+	IppFFT fft(IppFFT::DataType::RealFloat, order + 1);
+
+	HeapBlock<float> spectrum(mipmapSize, true);
+	HeapBlock<float> levelData(mipmapSize, true);
+
+	const double sizeRatio = (double)wavetableSize / (double)mipmapSize;
+
+	for (int tableIndex = 0; tableIndex < wavetableAmount; tableIndex++)
+	{
+		const float* source = wavetables.getReadPointer(0, tableIndex * wavetableSize);
+
+		// Resample the cycle with a periodic cubic interpolation. The images above the original nyquist frequency are removed below
+		for (int i = 0; i < mipmapSize; i++)
+		{
+			const double position = (double)i * sizeRatio;
+			const int index = (int)position;
+			const float alpha = (float)(position - (double)index);
+
+			const float y0 = source[(index + wavetableSize - 1) % wavetableSize];
+			const float y1 = source[index % wavetableSize];
+			const float y2 = source[(index + 1) % wavetableSize];
+			const float y3 = source[(index + 2) % wavetableSize];
+
+			const float c1 = 0.5f * (y2 - y0);
+			const float c2 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+			const float c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+
+			spectrum[i] = ((c3 * alpha + c2) * alpha + c1) * alpha + y1;
+		}
+
+		fft.realFFTInplace(spectrum, mipmapSize);
+
+		for (int level = 0; level < numMipLevels; level++)
+		{
+			const int size = getMipmapSize(level);
+			const int numHarmonics = highestHarmonic >> level;
+
+			jassert(numHarmonics < size / 2);
+
+			levelData.clear(size);
+
+			// Perm format: re[0], re[N/2], re[1], im[1], ...
+			levelData[0] = spectrum[0];
+
+			for (int h = 1; h <= numHarmonics; h++)
+			{
+				levelData[2 * h] = spectrum[2 * h];
+				levelData[2 * h + 1] = spectrum[2 * h + 1];
+			}
+
+			fft.realFFTInverseInplace(levelData, size);
+
+			float* destination = mipmaps[level]->getWritePointer(0, tableIndex * size);
+
+			// The forward transform had the full size, so this is also the scale factor of the smaller levels
+			FloatVectorOperations::copyWithMultiply(destination, levelData, 1.0f / (float)mipmapSize, size);
+		}
+	}
+}
+
 ProcessorEditorBody* WavetableSynth::createEditor(ProcessorEditor *parentEditor)
 {
 #if USE_BACKEND
@@ -74,6 +163,161 @@ const float *WavetableSynthVoice::getTableModulationValues(int startSample, int
 	return dynamic_cast<WavetableSynth*>(getOwnerSynth())->getTableModValues(voiceIndex);
 }
 
+void WavetableSynthVoice::calculateMipmappedBlock(int startSample, int numSamples, const float* voicePitchValues, const float* tableValues)
+{
+	float* output = voiceBuffer.getWritePointer(0);
+
+	const double tableLength = (double)tableSize;
+	const float maximumGain = 1.0f / currentSound->getUnnormalizedMaximum();
+
+	float uptimes[MipmapSubBlockSize];
+	float fadeBuffer[MipmapSubBlockSize];
+
+	while (numSamples > 0)
+	{
+		const int numThisTime = jmin<int>(numSamples, MipmapSubBlockSize);
+
+		// Wrap the uptime once per sub block so that the float positions keep their precision
+		voiceUptime = std::fmod(voiceUptime, tableLength);
+
+		double maxDelta = 0.0;
+
+		for (int i = 0; i < numThisTime; i++)
+		{
+			jassert(voicePitchValues == nullptr || voicePitchValues[startSample + i] > 0.0f);
+
+			const double delta = voicePitchValues == nullptr ? uptimeDelta : uptimeDelta * (double)voicePitchValues[startSample + i];
+
+			uptimes[i] = (float)voiceUptime;
+			maxDelta = jmax<double>(maxDelta, delta);
+			voiceUptime += delta;
+		}
+
+		const int mipLevel = currentSound->getMipLevelForDelta(maxDelta);
+
+		// The table position at the end of the sub block decides which two tables are used
+		const float tableModValue = jlimit<float>(0.0f, 1.0f, tableValues[startSample + numThisTime - 1]);
+		const float tablePosition = tableModValue * 63.0f;
+
+		const int lowerTableIndex = jmin<int>(62, (int)tablePosition);
+		const int upperTableIndex = lowerTableIndex + 1;
+
+		const float endAlpha = tablePosition - (float)lowerTableIndex;
+		const float startAlpha = lastTablePosition < 0.0f ? endAlpha : jlimit<float>(0.0f, 1.0f, lastTablePosition - (float)lowerTableIndex);
+
+		lastTablePosition = tablePosition;
+
+		float* destination = output + startSample;
+
+		renderMipLevel(mipLevel, lowerTableIndex, upperTableIndex, uptimes, destination, numThisTime, startAlpha, endAlpha);
+
+		if (lastMipLevel != -1 && lastMipLevel != mipLevel)
+		{
+			renderMipLevel(lastMipLevel, lowerTableIndex, upperTableIndex, uptimes, fadeBuffer, numThisTime, startAlpha, endAlpha);
+
+			const float fadeDelta = 1.0f / (float)numThisTime;
+
+			for (int i = 0; i < numThisTime; i++)
+			{
+				const float fadeValue = (float)i * fadeDelta;
+				destination[i] = fadeBuffer[i] + fadeValue * (destination[i] - fadeBuffer[i]);
+			}
+		}
+
+		lastMipLevel = mipLevel;
+
+		const float tableGain = Interpolator::interpolateLinear(currentSound->getUnnormalizedGainValue(lowerTableIndex), 
+																 currentSound->getUnnormalizedGainValue(upperTableIndex), endAlpha) * getGainValue(tableModValue) * maximumGain;
+
+		const float startGain = lastTableGain < 0.0f ? tableGain : lastTableGain;
+		const float gainDelta = (tableGain - startGain) / (float)numThisTime;
+
+		lastTableGain = tableGain;
+
+		if (gainDelta == 0.0f)
+		{
+			FloatVectorOperations::multiply(destination, tableGain, numThisTime);
+		}
+		else
+		{
+			for (int i = 0; i < numThisTime; i++)
+				destination[i] *= startGain + (float)i * gainDelta;
+		}
+
+		startSample += numThisTime;
+		numSamples -= numThisTime;
+	}
+}
+
+void WavetableSynthVoice::renderMipLevel(int level, int lowerTableIndex, int upperTableIndex, const float* uptimes, float* output, int numSamples, float startAlpha, float endAlpha) const
+{
+	const float* lowerTable = currentSound->getMipmapData(level, lowerTableIndex);
+	const float* upperTable = currentSound->getMipmapData(level, upperTableIndex);
+
+	const int mask = currentSound->getMipmapSize(level) - 1;
+	const float scale = currentSound->getMipmapScale(level);
+
+	const float alphaDelta = (endAlpha - startAlpha) / (float)numSamples;
+
+	int i = 0;
+
+#if HI_WAVETABLE_USE_SSE
+
+	// Four samples at once. The table reads are scalar loads, the interpolation uses the same operations as the loop below
+	const __m128 scaleVector = _mm_set1_ps(scale);
+	const __m128 startAlphaVector = _mm_set1_ps(startAlpha);
+	const __m128 alphaDeltaVector = _mm_set1_ps(alphaDelta);
+	const __m128i maskVector = _mm_set1_epi32(mask);
+	const __m128i offsets = _mm_setr_epi32(0, 1, 2, 3);
+
+	int readIndex1[4];
+	int readIndex2[4];
+
+	for (; i + 4 <= numSamples; i += 4)
+	{
+		const __m128 position = _mm_mul_ps(_mm_loadu_ps(uptimes + i), scaleVector);
+		const __m128i index = _mm_cvttps_epi32(position);
+		const __m128 alpha = _mm_sub_ps(position, _mm_cvtepi32_ps(index));
+
+		_mm_storeu_si128((__m128i*)readIndex1, _mm_and_si128(index, maskVector));
+		_mm_storeu_si128((__m128i*)readIndex2, _mm_and_si128(_mm_add_epi32(index, _mm_set1_epi32(1)), maskVector));
+
+		const __m128 lower1 = _mm_setr_ps(lowerTable[readIndex1[0]], lowerTable[readIndex1[1]], lowerTable[readIndex1[2]], lowerTable[readIndex1[3]]);
+		const __m128 lower2 = _mm_setr_ps(lowerTable[readIndex2[0]], lowerTable[readIndex2[1]], lowerTable[readIndex2[2]], lowerTable[readIndex2[3]]);
+		const __m128 upper1 = _mm_setr_ps(upperTable[readIndex1[0]], upperTable[readIndex1[1]], upperTable[readIndex1[2]], upperTable[readIndex1[3]]);
+		const __m128 upper2 = _mm_setr_ps(upperTable[readIndex2[0]], upperTable[readIndex2[1]], upperTable[readIndex2[2]], upperTable[readIndex2[3]]);
+
+		const __m128 lowerSample = _mm_add_ps(lower1, _mm_mul_ps(alpha, _mm_sub_ps(lower2, lower1)));
+		const __m128 upperSample = _mm_add_ps(upper1, _mm_mul_ps(alpha, _mm_sub_ps(upper2, upper1)));
+
+		const __m128 sampleIndex = _mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(i), offsets));
+		const __m128 tableAlpha = _mm_add_ps(startAlphaVector, _mm_mul_ps(sampleIndex, alphaDeltaVector));
+
+		_mm_storeu_ps(output + i, _mm_add_ps(lowerSample, _mm_mul_ps(tableAlpha, _mm_sub_ps(upperSample, lowerSample))));
+	}
+
+#endif
+
+	for (; i < numSamples; i++)
+	{
+		const float position = uptimes[i] * scale;
+		const int index = (int)position;
+		const float alpha = position - (float)index;
+
+		const int i1 = index & mask;
+		const int i2 = (i1 + 1) & mask;
+
+		const float lowerSample = lowerTable[i1] + alpha * (lowerTable[i2] - lowerTable[i1]);
+		const float upperSample = upperTable[i1] + alpha * (upperTable[i2] - upperTable[i1]);
+
+		const float tableAlpha = startAlpha + (float)i * alphaDelta;
+
+		output[i] = lowerSample + tableAlpha * (upperSample - lowerSample);
+	}
+}
+
+#undef HI_WAVETABLE_USE_SSE
+
 void WavetableSynthVoice::stopNote(float velocity, bool allowTailoff)
 {
 
@@ -248,9 +248,18 @@ public:
 
 		normalizeTables();
 
+		createMipmaps();
+
 		pitchRatio = 1.0;
 	};
 
+	enum
+	{
+		MinMipmapSize = 64,
+		MaxMipmapSize = 4096,
+		MaxMipLevels = 12
+	};
+
 	bool appliesToNote (int midiNoteNumber) override   { return midiNotes[midiNoteNumber]; }
     bool appliesToChannel (int /*midiChannel*/) override   { return true; }
 	bool appliesToVelocity (int /*midiChannel*/) override  { return true; }
@@ -343,6 +352,48 @@ public:
 		return unnormalizedGainValues[tableIndex];
 	}
 
+	/** Creates the band-limited versions of every table (one level per octave).
+	*
+	*	Every table is resampled to a power of two size and transformed with a FFT. Each mip level contains half the harmonics
+	*	(and half the size) of the previous level, so that the voice can pick a level that doesn't alias for the current pitch.
+	*	The sizes are powers of two so the read index can be wrapped with a bit mask.
+	*/
+	void createMipmaps();
+
+	int getNumMipLevels() const noexcept { return numMipLevels; }
+
+	/** Returns the band-limited table with the given index for the mip level. */
+	const float* getMipmapData(int level, int wavetableIndex) const
+	{
+		jassert(isPositiveAndBelow(level, numMipLevels));
+		jassert(isPositiveAndBelow(wavetableIndex, wavetableAmount));
+
+		const int size = getMipmapSize(level);
+
+		return mipmaps[level]->getReadPointer(0, wavetableIndex * size);
+	}
+
+	/** Returns the size of each table in the mip level (always a power of two). */
+	int getMipmapSize(int level) const noexcept { return mipmapSize >> level; }
+
+	/** Returns the factor that converts a position in the original table into a position in the mip level. */
+	float getMipmapScale(int level) const noexcept { return (float)getMipmapSize(level) / (float)wavetableSize; }
+
+	/** Returns the first mip level that doesn't alias if the original table is played back with the given increment per sample. */
+	int getMipLevelForDelta(double uptimeDelta) const
+	{
+		// The level k contains the harmonics up to highestHarmonic >> k which stay below nyquist if delta * harmonics <= wavetableSize / 2
+		const double maxHarmonics = (double)wavetableSize * 0.5 / uptimeDelta;
+
+		for (int level = 0; level < numMipLevels - 1; level++)
+		{
+			if ((double)(highestHarmonic >> level) <= maxHarmonics)
+				return level;
+		}
+
+		return jmax<int>(0, numMipLevels - 1);
+	}
+
 private:
 
 	float maximum;
@@ -366,6 +417,12 @@ private:
 	int wavetableSize;
 	int wavetableAmount;
 
+	OwnedArray<AudioSampleBuffer> mipmaps;
+
+	int mipmapSize = 0;
+	int numMipLevels = 0;
+	int highestHarmonic = 0;
+
 };
 
 class WavetableSynth;
@@ -412,12 +469,29 @@ public:
 		uptimeDelta = currentSound->getPitchRatio();
         
         uptimeDelta *= getOwnerSynth()->getMainController()->getGlobalPitchFactor();
+
+		lastMipLevel = -1;
+		lastTablePosition = -1.0f;
+		lastTableGain = -1.0f;
     };
 
 	const float *getTableModulationValues(int startSample, int numSamples);
 
 	float getGainValue(float modValue);
 
+	enum
+	{
+		MipmapSubBlockSize = 32
+	};
+
+	/** Renders the block with the band-limited tables of the current sound.
+	*
+	*	The block is split into sub blocks. The mip level is chosen from the highest pitch of each sub block. 
+	*	The table position and the gain are read once per sub block and ramped linearly, so the inner loop only does
+	*	the table lookups. If the mip level changes, the old level is faded out over the sub block.
+	*/
+	void calculateMipmappedBlock(int startSample, int numSamples, const float* voicePitchValues, const float* tableValues);
+
 	void calculateBlock(int startSample, int numSamples) override
 	{
 		const int startIndex = startSample;
@@ -429,69 +503,10 @@ public:
 
 		if(hqMode)
 		{
-			while(--numSamples >= 0)
-			{
-				// Get the two indexes for the table position
-
-				int index = (int)voiceUptime;
-            
-				const int i1 = index % (tableSize);
-
-				int i2 = i1 + 1;
+			calculateMipmappedBlock(startSample, numSamples, voicePitchValues, tableValues);
 
-				if(i2 >= tableSize)
-				{
-					i2 = 0;
-				}
-
-				const float tableModValue = tableValues[startSample];
-
-				const float tableValue = jlimit<float>(0.0f, 1.0f, tableModValue) * 63.0f;
-
-				const int lowerTableIndex = (int)(tableValue);
-				const int upperTableIndex = jmin(63, lowerTableIndex + 1);
-				const float tableDelta = tableValue - (float)lowerTableIndex;
-				jassert(0.0f <= tableDelta && tableDelta <= 1.0f);
-
-				lowerTable = currentSound->getWaveTableData(lowerTableIndex);
-				upperTable = currentSound->getWaveTableData(upperTableIndex);
-
-				float tableGainValue = tableGainInterpolator.interpolateLinear(currentSound->getUnnormalizedGainValue(lowerTableIndex), currentSound->getUnnormalizedGainValue(upperTableIndex), tableDelta);
-
-				tableGainValue *= getGainValue(tableModValue);
-
-				float u1 = upperTable[i1];
-				float u2 = upperTable[i2];
-
-				float l1 = lowerTable[i1];
-				float l2 = lowerTable[i2];
-
-				const float alpha = float(voiceUptime) - (float)index;
-				//const float invAlpha = 1.0f - alpha;
-
-				const float upperSample = tableGainInterpolator.interpolateLinear(u1, u2, alpha);
-
-				const float lowerSample = tableGainInterpolator.interpolateLinear(l1, l2, alpha);
-			
-				float sample = lowerTableIndex != upperTableIndex ? tableGainInterpolator.interpolateLinear(lowerSample, upperSample ,tableDelta) : lowerSample;
-
-				sample *= tableGainValue;
-
-				sample *= 1.0f / currentSound->getUnnormalizedMaximum();
-
-				// Stereo mode assumed
-				voiceBuffer.setSample (0, startSample, sample);
-				voiceBuffer.setSample (1, startSample, sample);
-
-				jassert(voicePitchValues == nullptr || voicePitchValues[startSample] > 0.0f);
-
-				const double delta = (uptimeDelta * (voicePitchValues == nullptr ? 1.0 : voicePitchValues[startSample]));
-
-				voiceUptime += delta;
-
-				++startSample;    
-
-			}
+			// Stereo mode assumed
+			FloatVectorOperations::copy(voiceBuffer.getWritePointer(1, startIndex), voiceBuffer.getReadPointer(0, startIndex), samplesToCopy);
 		}
 		else
 		{
@@ -644,6 +659,13 @@ private:
 
 	int smoothSize;
 
+	/** Renders one mip level of the two neighbouring tables and crossfades the table position. */
+	void renderMipLevel(int level, int lowerTableIndex, int upperTableIndex, const float* uptimes, float* output, int numSamples, float startAlpha, float endAlpha) const;
+
+	int lastMipLevel = -1;
+	float lastTablePosition = -1.0f;
+	float lastTableGain = -1.0f;
+
 };
 
 
@@ -0,0 +1,204 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#include "JuceHeader.h"
+
+class WavetableSynthTest : public UnitTest
+{
+public:
+
+	WavetableSynthTest() :
+		UnitTest("Testing WavetableSynth")
+	{
+
+	}
+
+	void runTest() override
+	{
+		const int tableSizes[] = { 100, 128, 367, 1024 };
+
+		for (auto size : tableSizes)
+		{
+			ScopedPointer<WavetableSound> sound = createSawtoothSound(size);
+
+			beginTest("Testing the band limit of the mip levels with table size " + String(size));
+
+			testBandLimit(*sound);
+
+			beginTest("Testing the harmonics of the first mip level with table size " + String(size));
+
+			testFirstLevel(*sound);
+		}
+	}
+
+private:
+
+	enum
+	{
+		NumTables = 64
+	};
+
+	/** Creates a sound with naive sawtooth tables which contain every harmonic up to the nyquist frequency of the table. */
+	static WavetableSound* createSawtoothSound(int tableSize)
+	{
+		HeapBlock<float> data(tableSize * NumTables);
+
+		for (int t = 0; t < NumTables; t++)
+		{
+			// The amplitude changes with the table index so the normalisation doesn't make all tables equal
+			const float amplitude = 0.2f + 0.8f * (float)t / (float)(NumTables - 1);
+
+			for (int i = 0; i < tableSize; i++)
+				data[t * tableSize + i] = amplitude * (2.0f * (float)i / (float)tableSize - 1.0f);
+		}
+
+		ValueTree v("wavetable");
+
+		v.setProperty("data", var(MemoryBlock(data, sizeof(float) * tableSize * NumTables)), nullptr);
+		v.setProperty("amount", NumTables, nullptr);
+		v.setProperty("noteNumber", 60, nullptr);
+		v.setProperty("sampleRate", 48000.0, nullptr);
+
+		return new WavetableSound(v);
+	}
+
+	/** Returns the magnitudes of the harmonics 0 ... size / 2 of one cycle with a plain DFT. */
+	static Array<double> getHarmonics(const float* data, int size)
+	{
+		Array<double> magnitudes;
+
+		for (int k = 0; k <= size / 2; k++)
+		{
+			double re = 0.0;
+			double im = 0.0;
+
+			for (int i = 0; i < size; i++)
+			{
+				const double phase = 2.0 * double_Pi * (double)k * (double)i / (double)size;
+
+				re += (double)data[i] * std::cos(phase);
+				im -= (double)data[i] * std::sin(phase);
+			}
+
+			magnitudes.add(std::sqrt(re * re + im * im) / (double)size);
+		}
+
+		return magnitudes;
+	}
+
+	/** Returns the highest harmonic that is louder than -80dB relative to the loudest one. */
+	static int getHighestHarmonic(const float* data, int size)
+	{
+		const Array<double> magnitudes = getHarmonics(data, size);
+
+		double peak = 0.0;
+
+		for (auto m : magnitudes)
+			peak = jmax<double>(peak, m);
+
+		for (int k = magnitudes.size() - 1; k > 0; k--)
+		{
+			if (magnitudes[k] > peak * 1.0e-4)
+				return k;
+		}
+
+		return 0;
+	}
+
+	/** Plays back the sound at increasing pitches and checks that the chosen mip level has no harmonics above nyquist,
+	*	and that the next lower level would have aliased (so the level doesn't cut off more than necessary). 
+	*/
+	void testBandLimit(const WavetableSound& sound)
+	{
+		const int numLevels = sound.getNumMipLevels();
+
+		expect(numLevels > 1, "Not enough mip levels: " + String(numLevels));
+
+		Array<int> highestHarmonics;
+
+		for (int level = 0; level < numLevels; level++)
+		{
+			const int size = sound.getMipmapSize(level);
+
+			expect(isPowerOfTwo(size), "Level " + String(level) + ": size " + String(size) + " is not a power of two");
+
+			const int highest = jmax<int>(getHighestHarmonic(sound.getMipmapData(level, 0), size), 
+										  getHighestHarmonic(sound.getMipmapData(level, NumTables - 1), size));
+
+			expect(highest < size / 2, "Level " + String(level) + ": harmonic " + String(highest) + " is at the nyquist frequency of the table");
+
+			if (level > 0)
+				expect(highest < highestHarmonics.getLast(), "Level " + String(level) + " doesn't remove harmonics");
+
+			highestHarmonics.add(highest);
+		}
+
+		const double tableSize = (double)sound.getTableSize();
+
+		// From a few Hz up to a fundamental just below nyquist
+		for (double delta = 0.01; delta < tableSize * 0.5; delta *= 1.03)
+		{
+			const int level = sound.getMipLevelForDelta(delta);
+
+			// The highest harmonic in cycles per output sample
+			const double frequency = (double)highestHarmonics[level] * delta / tableSize;
+
+			expect(frequency <= 0.5, "Delta " + String(delta) + ", level " + String(level) + ": harmonic " + String(highestHarmonics[level]) + " aliases");
+
+			if (level > 0)
+			{
+				const double lowerLevelFrequency = (double)highestHarmonics[level - 1] * delta / tableSize;
+
+				expect(lowerLevelFrequency > 0.5, "Delta " + String(delta) + ": level " + String(level - 1) + " would not alias");
+			}
+		}
+	}
+
+	/** Compares the harmonics of the first level with the original table. */
+	void testFirstLevel(const WavetableSound& sound)
+	{
+		const int tableSize = sound.getTableSize();
+		const int mipmapSize = sound.getMipmapSize(0);
+
+		const Array<double> original = getHarmonics(sound.getWaveTableData(NumTables - 1), tableSize);
+		const Array<double> mipmapped = getHarmonics(sound.getMipmapData(0, NumTables - 1), mipmapSize);
+
+		// The resampling of the cycle attenuates the harmonics near the nyquist frequency of the original table
+		for (int k = 1; k <= tableSize / 8; k++)
+		{
+			expectWithinAbsoluteError<double>(mipmapped[k], original[k], original[1] * 0.01, "Harmonic " + String(k));
+		}
+	}
+};
+
+static WavetableSynthTest wavetableSynthTestInstance;
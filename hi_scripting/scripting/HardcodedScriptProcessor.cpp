@@ -107,6 +107,7 @@ void HardcodedScriptProcessor::processHiseEvent(HiseEvent &m)
     case HiseEvent::Type::MidiStop:
     case HiseEvent::Type::VolumeFade:
     case HiseEvent::Type::PitchFade:
+    case HiseEvent::Type::NoteExpression:
     case HiseEvent::Type::numTypes:
         break;
 	}
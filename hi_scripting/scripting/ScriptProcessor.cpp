@@ -403,6 +403,9 @@ JavascriptProcessor::~JavascriptProcessor()
 {
 	deleteAllPopups();
 
+	if (scriptEngine != nullptr)
+		scriptEngine->abortWorkerCalls();
+
 	scriptEngine = nullptr;
 }
 
@@ -443,6 +446,16 @@ JavascriptProcessor::SnippetResult JavascriptProcessor::compileInternal()
 
 	auto thisAsProcessor = dynamic_cast<Processor*>(this);
 
+	// A background task might still use the old engine and wait for one of the locks below
+	if (scriptEngine != nullptr)
+		scriptEngine->abortWorkerCalls();
+
+	// Suspend the audio callback during the compilation instead of letting it wait for the lock
+	ScopedPointer<MainController::ScopedSuspender> suspender;
+
+	if (thisAsProcessor->isOnAir())
+		suspender = new MainController::ScopedSuspender(mainController);
+
 	ScopedLock callbackLock(thisAsProcessor->isOnAir() ? mainController->getLock() : thisAsProcessor->getDummyLockWhenNotOnAir());
 	ScopedWriteLock sl(mainController->getCompileLock());
     
@@ -269,6 +269,7 @@ void JavascriptMidiProcessor::runScriptCallbacks()
         case HiseEvent::Type::MidiStop:
         case HiseEvent::Type::VolumeFade:
         case HiseEvent::Type::PitchFade:
+        case HiseEvent::Type::NoteExpression:
         case HiseEvent::Type::numTypes:
         break;
 	}
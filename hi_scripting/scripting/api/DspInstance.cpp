@@ -53,7 +53,9 @@ ConstScriptingObject(nullptr, NUM_API_FUNCTION_SLOTS),
 moduleName(moduleName_),
 factory(const_cast<DspFactory*>(f)),
 object(nullptr),
-bypassed(false)
+bypassed(false),
+switchBypassFlag(false),
+pendingParameterChanges(256)
 {
 	
 }
@@ -158,7 +160,11 @@ void DspInstance::processBlock(const var &data)
 
     const SpinLock::ScopedLockType sl(getLock());
     
-	bool skipProcessing = isBypassed() && !switchBypassFlag;
+	renderThread = Thread::getCurrentThreadId();
+
+	applyPendingParameterChanges();
+
+	bool skipProcessing = isBypassed() && !switchBypassFlag.load();
 
 	if (object != nullptr && !skipProcessing)
 	{
@@ -193,7 +199,7 @@ void DspInstance::processBlock(const var &data)
 				else throwError("processBlock must be called on array of buffers");
 			}
 
-			if (switchBypassFlag)
+			if (switchBypassFlag.load())
 			{
 				if (sampleData[0] == nullptr || sampleData[1] == nullptr)
 				{
@@ -239,7 +245,7 @@ void DspInstance::processBlock(const var &data)
 				CHECK_AND_LOG_BUFFER_DATA_WITH_ID(processor, debugId, DebugLogger::Location::DspInstanceRenderingPost, sampleData[0], true, numSamples);
 				CHECK_AND_LOG_BUFFER_DATA_WITH_ID(processor, debugId, DebugLogger::Location::DspInstanceRenderingPost, sampleData[1], false, numSamples);
 
-				switchBypassFlag = false;
+				switchBypassFlag.store(false);
 
 			}
 			else
@@ -286,9 +292,33 @@ void DspInstance::setParameter(int index, float newValue)
 {
 	if (object != nullptr && index < object->getNumParameters())
 	{
-		const SpinLock::ScopedLockType sl(getLock());
-        
-		object->setParameter(index, newValue);
+		// Other threads must not change the parameter while the object is rendering, so the change is 
+		// applied by the next processBlock() call instead of locking the audio thread.
+		if (!prepareToPlayWasCalled || Thread::getCurrentThreadId() == renderThread.get())
+		{
+			object->setParameter(index, newValue);
+			return;
+		}
+
+		ParameterChange change = { index, newValue };
+
+		if (!pendingParameterChanges.push(std::move(change)))
+		{
+			// The queue is full, so we need to fall back to the lock...
+			const SpinLock::ScopedLockType sl(getLock());
+			object->setParameter(index, newValue);
+		}
+	}
+}
+
+void DspInstance::applyPendingParameterChanges()
+{
+	ParameterChange change;
+
+	while (pendingParameterChanges.pop(change))
+	{
+		if (object != nullptr)
+			object->setParameter(change.index, change.value);
 	}
 }
 
@@ -382,10 +412,8 @@ String DspInstance::getStringParameter(int index)
 
 void DspInstance::setBypassed(bool shouldBeBypassed)
 {
-    const SpinLock::ScopedLockType sl(getLock());
-    
 	bypassed.store(shouldBeBypassed);
-	switchBypassFlag = true;
+	switchBypassFlag.store(true);
 }
 
 bool DspInstance::isBypassed() const
@@ -244,7 +244,22 @@ private:
 
     const SpinLock& getLock() const { return lock; };
     
+	/** This only guards the initialisation, prepareToPlay() and unload(). Parameter changes use the queue below. */
     SpinLock lock;
+
+	struct ParameterChange
+	{
+		int index;
+		float value;
+	};
+
+	/** Applies the parameter changes from other threads. Call this before processing a block. */
+	void applyPendingParameterChanges();
+
+	LockfreeQueue<ParameterChange> pendingParameterChanges;
+
+	/** The thread that calls processBlock(). It can change the parameters directly. */
+	Atomic<Thread::ThreadID> renderThread;
     
 	void throwError(const String &errorMessage)
 	{
@@ -260,7 +275,7 @@ private:
 
 	std::atomic<bool> bypassed;
 
-	bool switchBypassFlag = false;
+	std::atomic<bool> switchBypassFlag;
 
 	bool prepareToPlayWasCalled = false;
 
@@ -758,6 +758,7 @@ struct ScriptingApi::Engine::Wrapper
 	API_VOID_METHOD_WRAPPER_1(Engine, setLowestKeyToDisplay);
 	API_METHOD_WRAPPER_0(Engine, createMidiList);
 	API_METHOD_WRAPPER_0(Engine, createTimerObject);
+	API_METHOD_WRAPPER_0(Engine, createBackgroundTask);
 	API_METHOD_WRAPPER_0(Engine, createMessageHolder);
 	API_METHOD_WRAPPER_0(Engine, getPlayHead);
 	API_VOID_METHOD_WRAPPER_2(Engine, dumpAsJSON);
@@ -768,6 +769,8 @@ struct ScriptingApi::Engine::Wrapper
 	API_METHOD_WRAPPER_2(Engine, doubleToString);
 	API_METHOD_WRAPPER_0(Engine, getOS);
 	API_METHOD_WRAPPER_0(Engine, getVersion);
+	API_METHOD_WRAPPER_0(Engine, getProcessorCpuUsage);
+	API_VOID_METHOD_WRAPPER_2(Engine, setMpeMode);
 	API_VOID_METHOD_WRAPPER_1(Engine, loadFont);
 	API_VOID_METHOD_WRAPPER_0(Engine, undo);
 	API_VOID_METHOD_WRAPPER_0(Engine, redo);
@@ -805,7 +808,10 @@ ApiClass(0)
 	ADD_API_METHOD_2(doubleToString);
 	ADD_API_METHOD_0(getOS);
 	ADD_API_METHOD_0(getVersion);
+	ADD_API_METHOD_0(getProcessorCpuUsage);
+	ADD_API_METHOD_2(setMpeMode);
 	ADD_API_METHOD_0(createTimerObject);
+	ADD_API_METHOD_0(createBackgroundTask);
 	ADD_API_METHOD_0(createMessageHolder);
 	ADD_API_METHOD_1(loadFont);
 	ADD_API_METHOD_0(undo);
@@ -899,6 +905,48 @@ String ScriptingApi::Engine::getVersion()
 
 }
 
+void ScriptingApi::Engine::setMpeMode(bool shouldBeEnabled, int pitchBendRange)
+{
+	MainController::EventIdHandler& handler = getProcessor()->getMainController()->getEventHandler();
+
+	handler.setMpePitchBendRange(pitchBendRange);
+	handler.setMpeEnabled(shouldBeEnabled);
+}
+
+var ScriptingApi::Engine::getProcessorCpuUsage()
+{
+	Array<Processor::CpuUsageInfo> list;
+
+	Processor::collectCpuUsage(getProcessor()->getMainController()->getMainSynthChain(), list);
+
+	struct AverageSorter
+	{
+		static int compareElements(const Processor::CpuUsageInfo& first, const Processor::CpuUsageInfo& second)
+		{
+			return first.average > second.average ? -1 : (first.average < second.average ? 1 : 0);
+		}
+	};
+
+	AverageSorter sorter;
+	list.sort(sorter, true);
+
+	Array<var> result;
+
+	for (int i = 0; i < list.size(); i++)
+	{
+		DynamicObject::Ptr obj = new DynamicObject();
+
+		obj->setProperty("ID", list[i].id);
+		obj->setProperty("Type", list[i].type);
+		obj->setProperty("Average", list[i].average);
+		obj->setProperty("Peak", list[i].peak);
+
+		result.add(var(obj.get()));
+	}
+
+	return var(result);
+}
+
 int ScriptingApi::Engine::getMidiNoteFromName(String midiNoteName) const
 {
 	for (int i = 0; i < 127; i++)
@@ -939,6 +987,7 @@ double ScriptingApi::Engine::getMilliSecondsForTempo(int tempoIndex) const { ret
 DynamicObject * ScriptingApi::Engine::getPlayHead() { return getProcessor()->getMainController()->getHostInfoObject(); }
 ScriptingObjects::MidiList *ScriptingApi::Engine::createMidiList() { return new ScriptingObjects::MidiList(getScriptProcessor()); };
 ScriptingObjects::TimerObject* ScriptingApi::Engine::createTimerObject() { return new ScriptingObjects::TimerObject(getScriptProcessor()); }
+ScriptingObjects::BackgroundTask* ScriptingApi::Engine::createBackgroundTask() { return new ScriptingObjects::BackgroundTask(getScriptProcessor()); }
 
 ScriptingObjects::ScriptingMessageHolder* ScriptingApi::Engine::createMessageHolder()
 {
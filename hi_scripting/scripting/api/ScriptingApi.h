@@ -274,6 +274,12 @@ public:
 
         /** Returns the product version (not the HISE version!). */
         String getVersion();
+
+		/** Returns an array with the CPU usage of every module as object with the properties ID, Type, Average and Peak (sorted by average). The values are only measured if ENABLE_PROCESSOR_CPU_COUNTERS is set (the default in HISE). */
+		var getProcessorCpuUsage();
+
+		/** Enables the MPE mode: pitch bend, pressure and CC74 on the channels 2-16 become per-note expression with the given bend range in semitones. */
+		void setMpeMode(bool shouldBeEnabled, int pitchBendRange);
         
 		/** Allows access to the data of the host (playing status, timeline, etc...). */
 		DynamicObject *getPlayHead();
@@ -284,6 +290,9 @@ public:
 		/** Creates a new timer object. */
 		ScriptingObjects::TimerObject* createTimerObject();
 
+		/** Creates a task object that executes a function on a background thread. */
+		ScriptingObjects::BackgroundTask* createBackgroundTask();
+
 		/** Creates a storage object for Message events. */
 		ScriptingObjects::ScriptingMessageHolder* createMessageHolder();
 
@@ -2902,12 +2902,7 @@ void ScriptingApi::Content::restoreAllControlsFromPreset(const ValueTree &preset
 {
 	restoreFromValueTree(preset);
 
-	StringArray macroNames;
-
-	if (components.size() != 0)
-	{
-		macroNames = components[0]->getOptionsFor(components[0]->getIdFor(ScriptComponent::macroControl));
-	}
+	const StringArray macroNames = getMacroNames();
 
 	for (int i = 0; i < components.size(); i++)
 	{
@@ -2924,30 +2919,136 @@ void ScriptingApi::Content::restoreAllControlsFromPreset(const ValueTree &preset
 		}
 #endif
 
+		sendRestoredValue(i, macroNames);
+	}
+}
+
+int ScriptingApi::Content::restoreChangedControlsFromPreset(const ValueTree &preset)
+{
+	jassert(preset.getType().toString() == "Content");
 
+	Array<int> changedIndexes;
 
-		var v = components[i]->getValue();
+	for (int i = 0; i < components.size(); i++)
+	{
+		ValueTree child = getChangedControlState(i, preset);
 
-		if (v.isObject())
+		if (child.isValid())
 		{
-			getScriptProcessor()->controlCallback(components[i], v);
+			components[i]->restoreFromValueTree(child);
+			changedIndexes.add(i);
 		}
-		else
+	}
+
+	if (changedIndexes.isEmpty())
+		return 0;
+
+	const StringArray macroNames = getMacroNames();
+
+	for (int i = 0; i < changedIndexes.size(); i++)
+	{
+#if ENABLE_SCRIPTING_BREAKPOINTS
+		if (auto jsp = dynamic_cast<JavascriptProcessor*>(getScriptProcessor()))
 		{
-			getProcessor()->setAttribute(i, components[i]->getValue(), sendNotification);
+			if (jsp->getLastErrorMessage().getErrorMessage().startsWith("Breakpoint"))
+			{
+				break;
+			}
 		}
+#endif
 
-		const String macroName = components[i]->getScriptObjectProperty(ScriptComponent::macroControl).toString();
+		sendRestoredValue(changedIndexes[i], macroNames);
+	}
 
-		const int macroIndex = macroNames.indexOf(macroName) - 1;
+	return changedIndexes.size();
+}
 
-		if (macroIndex >= 0)
-		{
-			NormalisableRange<float> range(components[i]->getScriptObjectProperty(ScriptComponent::min), components[i]->getScriptObjectProperty(ScriptComponent::max));
+ValueTree ScriptingApi::Content::getChangedControlState(int componentIndex, const ValueTree &preset) const
+{
+	ScriptComponent* c = components[componentIndex];
+
+	if (!c->getScriptObjectProperty(ScriptComponent::Properties::saveInPreset))
+		return ValueTree();
+
+	ValueTree child = preset.getChildWithProperty("id", c->name.toString());
+
+	if (!child.isValid() || child.getProperty("type").toString() != c->getObjectName().toString())
+		return ValueTree();
 
-			getProcessor()->getMainController()->getMacroManager().getMacroChain()->setMacroControl(macroIndex, range.convertTo0to1(components[i]->getValue()) * 127.0f, sendNotification);
+	// Compare every stored value (not only the "value" property), so that table / slider pack data and ranges are diffed too
+	ValueTree current = c->exportAsValueTree();
+
+	for (int i = 0; i < current.getNumProperties(); i++)
+	{
+		const Identifier id = current.getPropertyName(i);
+
+		if (!storedValuesAreEqual(current.getProperty(id), child.getProperty(id)))
+			return child;
+	}
+
+	return ValueTree();
+}
+
+bool ScriptingApi::Content::storedValuesAreEqual(const var& currentValue, const var& presetValue)
+{
+	// The preset is loaded from XML, so every value will be a string there
+	if (currentValue.isString() || presetValue.isString())
+	{
+		const String a = currentValue.toString();
+		const String b = presetValue.toString();
+
+		if (a.startsWith("JSON") && b.startsWith("JSON"))
+		{
+			// Compare the parsed data to ignore the formatting
+			return JSON::toString(JSON::fromString(a.substring(4)), true) == JSON::toString(JSON::fromString(b.substring(4)), true);
 		}
+
+		if (!a.containsOnly("-+.0123456789eE") || !b.containsOnly("-+.0123456789eE") || a.isEmpty() || b.isEmpty())
+			return a == b;
+	}
+
+	// Allow for the rounding of the XML number format
+	const double a = (double)currentValue;
+	const double b = (double)presetValue;
+
+	return std::abs(a - b) <= 1e-6 * jmax<double>(1.0, std::abs(a));
+}
+
+void ScriptingApi::Content::sendRestoredValue(int componentIndex, const StringArray& macroNames)
+{
+	ScriptComponent* c = components[componentIndex];
+
+	var v = c->getValue();
+
+	if (v.isObject())
+	{
+		getScriptProcessor()->controlCallback(c, v);
 	}
+	else
+	{
+		getProcessor()->setAttribute(componentIndex, v, sendNotification);
+	}
+
+	const String macroName = c->getScriptObjectProperty(ScriptComponent::macroControl).toString();
+
+	const int macroIndex = macroNames.indexOf(macroName) - 1;
+
+	if (macroIndex >= 0)
+	{
+		NormalisableRange<float> range(c->getScriptObjectProperty(ScriptComponent::min), c->getScriptObjectProperty(ScriptComponent::max));
+
+		getProcessor()->getMainController()->getMacroManager().getMacroChain()->setMacroControl(macroIndex, range.convertTo0to1(v) * 127.0f, sendNotification);
+	}
+}
+
+StringArray ScriptingApi::Content::getMacroNames() const
+{
+	if (components.size() != 0)
+	{
+		return components[0]->getOptionsFor(components[0]->getIdFor(ScriptComponent::macroControl));
+	}
+
+	return StringArray();
 }
 
 
@@ -994,6 +994,14 @@ public:
 	// Restores the content and sets the attributes so that the macros and the control callbacks gets executed.
 	void restoreAllControlsFromPreset(const ValueTree &preset);
 
+	/** Restores only the controls whose stored state differs from the given preset.
+	*
+	*	The control callbacks and macro connections of unchanged controls are not executed, so switching
+	*	between presets that share most of their values only does the work for the differences.
+	*	Returns the number of controls that were changed.
+	*/
+	int restoreChangedControlsFromPreset(const ValueTree &preset);
+
 	Colour getColour() const { return colour; };
 	void endInitialization();
 
@@ -1016,6 +1024,17 @@ private:
 
 	template<class Subtype> Subtype *addComponent(Identifier name, int x, int y, int width = -1, int height = -1);
 
+	/** Executes the control callback and updates the macro connection for the component at the given index. */
+	void sendRestoredValue(int componentIndex, const StringArray& macroNames);
+
+	/** Returns the preset state of the component if it differs from the current state or an invalid tree. */
+	ValueTree getChangedControlState(int componentIndex, const ValueTree &preset) const;
+
+	/** Compares a value of the stored control state with the value from a preset regardless of the var type. */
+	static bool storedValuesAreEqual(const var& currentValue, const var& presetValue);
+
+	StringArray getMacroNames() const;
+
 	friend class ScriptContentComponent;
 	friend class WeakReference<ScriptingApi::Content>;
 	WeakReference<ScriptingApi::Content>::Master masterReference;
@@ -260,7 +260,7 @@ var ScriptingObjects::ScriptingModulator::getAssignedValue(int /*index*/) const
 void ScriptingObjects::ScriptingModulator::setAttribute(int index, float value)
 {
 	if (checkValidObject())
-		mod->setAttribute(index, value, sendNotification);
+		getProcessor()->getMainController()->getUserPresetHandler().setProcessorAttribute(mod, index, value);
 }
 
 float ScriptingObjects::ScriptingModulator::getAttribute(int parameterIndex)
@@ -355,16 +355,21 @@ struct ScriptingObjects::ScriptingEffect::Wrapper
 	API_VOID_METHOD_WRAPPER_1(ScriptingEffect, setBypassed);
 	API_METHOD_WRAPPER_0(ScriptingEffect, exportState);
 	API_VOID_METHOD_WRAPPER_1(ScriptingEffect, restoreState);
+	API_METHOD_WRAPPER_1(ScriptingEffect, getCurrentLevel);
 };
 
 ScriptingObjects::ScriptingEffect::ScriptingEffect(ProcessorWithScriptingContent *p, EffectProcessor *fx) :
 ConstScriptingObject(p, fx != nullptr ? fx->getNumParameters()+1 : 1),
-effect(fx)
+effect(fx),
+levelUpdater(*this)
 {
 	if (fx != nullptr)
 	{
 		setName(fx->getId());
 
+		peakMeterSubscription = new Processor::PeakMeterSubscription(fx);
+		levelUpdater.startTimer(30);
+
 		addScriptParameters(this, effect.get());
 
 		for (int i = 0; i < fx->getNumParameters(); i++)
@@ -382,6 +387,7 @@ effect(fx)
     ADD_API_METHOD_1(getAttribute);
 	ADD_API_METHOD_0(exportState);
 	ADD_API_METHOD_1(restoreState);
+	ADD_API_METHOD_1(getCurrentLevel);
 };
 
 
@@ -389,7 +395,7 @@ void ScriptingObjects::ScriptingEffect::setAttribute(int parameterIndex, float n
 {
 	if (checkValidObject())
 	{
-		effect->setAttribute(parameterIndex, newValue, sendNotification);
+		getProcessor()->getMainController()->getUserPresetHandler().setProcessorAttribute(effect, parameterIndex, newValue);
 	}
 }
 
@@ -432,6 +438,30 @@ void ScriptingObjects::ScriptingEffect::restoreState(String base64State)
 	}
 }
 
+float ScriptingObjects::ScriptingEffect::getCurrentLevel(bool leftChannel)
+{
+	if (checkValidObject())
+	{
+		const Processor::DisplayValues values = effect->getDisplayValues();
+
+		return leftChannel ? values.outL : values.outR;
+	}
+
+	return 0.0f;
+}
+
+void ScriptingObjects::ScriptingEffect::LevelUpdater::timerCallback()
+{
+	if (parent.effect.get() != nullptr)
+	{
+		parent.effect->updateAndGetDisplayValues();
+	}
+	else
+	{
+		stopTimer();
+	}
+}
+
 // ScriptingSynth ==============================================================================================================
 
 struct ScriptingObjects::ScriptingSynth::Wrapper
@@ -477,7 +507,7 @@ void ScriptingObjects::ScriptingSynth::setAttribute(int parameterIndex, float ne
 {
 	if (checkValidObject())
 	{
-		synth->setAttribute(parameterIndex, newValue, sendNotification);
+		getProcessor()->getMainController()->getUserPresetHandler().setProcessorAttribute(synth, parameterIndex, newValue);
 	}
 }
 
@@ -607,7 +637,7 @@ void ScriptingObjects::ScriptingMidiProcessor::setAttribute(int index, float val
 {
 	if (checkValidObject())
 	{
-		mp->setAttribute(index, value, sendNotification);
+		getProcessor()->getMainController()->getUserPresetHandler().setProcessorAttribute(mp, index, value);
 	}
 }
 
@@ -693,7 +723,7 @@ void ScriptingObjects::ScriptingAudioSampleProcessor::setAttribute(int parameter
 {
 	if (checkValidObject())
 	{
-		audioSampleProcessor->setAttribute(parameterIndex, newValue, sendNotification);
+		getProcessor()->getMainController()->getUserPresetHandler().setProcessorAttribute(audioSampleProcessor, parameterIndex, newValue);
 	}
 }
 
@@ -872,6 +902,155 @@ void ScriptingObjects::TimerObject::timerCallback()
 	}
 }
 
+// BackgroundTask ===========================================================================================================
+
+class ScriptingObjects::BackgroundTask::Task : public BackgroundTaskPool::Task
+{
+public:
+
+	Task(Processor* p, const var& taskFunction_, const var& argument_, const var& finishCallback_, BackgroundTaskPool::CallbackThread callbackThread, RelativeTime timeout_) :
+		BackgroundTaskPool::Task(p->getId() + " Background Task", callbackThread),
+		processor(p),
+		taskFunction(taskFunction_),
+		argument(argument_),
+		finishCallback(finishCallback_),
+		timeout(timeout_),
+		result(Result::ok())
+	{}
+
+	void runOnWorkerThread() override
+	{
+		// The function is executed in the engine of the script (so it can use the API objects) and the
+		// compile lock makes sure that the engine isn't replaced while it's running. A recompilation
+		// deletes this task's BackgroundTask object, so don't block while waiting for the lock.
+		ReadWriteLock& compileLock = processor->getMainController()->getCompileLock();
+
+		while (!compileLock.tryEnterRead())
+		{
+			if (shouldExit())
+				return;
+
+			Thread::sleep(5);
+		}
+
+		JavascriptProcessor* jp = dynamic_cast<JavascriptProcessor*>(processor.get());
+
+		if (jp != nullptr && !shouldExit())
+		{
+			var thisObject;
+			var::NativeFunctionArgs args(thisObject, &argument, 1);
+
+			returnValue = jp->getScriptEngine()->callExternalFunctionFromWorkerThread(taskFunction, args, this, timeout, &result);
+		}
+
+		compileLock.exitRead();
+	}
+
+	void handleResult() override
+	{
+		JavascriptProcessor* jp = dynamic_cast<JavascriptProcessor*>(processor.get());
+
+		if (jp == nullptr)
+			return;
+
+		if (result.failed())
+		{
+			debugError(processor.get(), result.getErrorMessage());
+			return;
+		}
+
+		ScopedReadLock sl(processor->getMainController()->getCompileLock());
+
+		var thisObject;
+		var::NativeFunctionArgs args(thisObject, &returnValue, 1);
+
+		jp->getScriptEngine()->callExternalFunction(finishCallback, args, &result);
+
+		if (result.failed())
+			debugError(processor.get(), result.getErrorMessage());
+	}
+
+private:
+
+	WeakReference<Processor> processor;
+
+	var taskFunction;
+	var argument;
+	var finishCallback;
+	const RelativeTime timeout;
+
+	var returnValue;
+	Result result;
+};
+
+struct ScriptingObjects::BackgroundTask::Wrapper
+{
+	API_METHOD_WRAPPER_3(BackgroundTask, call);
+	API_METHOD_WRAPPER_0(BackgroundTask, isBusy);
+	API_VOID_METHOD_WRAPPER_0(BackgroundTask, cancel);
+	API_VOID_METHOD_WRAPPER_1(BackgroundTask, setTimeOut);
+	API_VOID_METHOD_WRAPPER_1(BackgroundTask, setFinishCallbackOnAudioThread);
+};
+
+ScriptingObjects::BackgroundTask::BackgroundTask(ProcessorWithScriptingContent *p) :
+ConstScriptingObject(p, 0)
+{
+	ADD_API_METHOD_3(call);
+	ADD_API_METHOD_0(isBusy);
+	ADD_API_METHOD_0(cancel);
+	ADD_API_METHOD_1(setTimeOut);
+	ADD_API_METHOD_1(setFinishCallbackOnAudioThread);
+}
+
+ScriptingObjects::BackgroundTask::~BackgroundTask()
+{
+	cancel();
+
+	// The task uses the script engine, so wait until it has returned (it will abort at the next statement)
+	while (currentTask != nullptr && currentTask->isRunning())
+		Thread::sleep(1);
+}
+
+bool ScriptingObjects::BackgroundTask::call(var taskFunction, var argument, var finishCallback)
+{
+	if (isBusy())
+		return false;
+
+	if (!HiseJavascriptEngine::isJavascriptFunction(taskFunction))
+	{
+		reportScriptError("taskFunction is not a function");
+		return false;
+	}
+
+	const auto callbackThread = finishCallbackOnAudioThread ? BackgroundTaskPool::CallbackThread::AudioThread :
+															  BackgroundTaskPool::CallbackThread::MessageThread;
+
+	currentTask = new Task(getProcessor(), taskFunction, argument, finishCallback, callbackThread, timeout);
+
+	return getProcessor()->getMainController()->getBackgroundTaskPool().addTask(currentTask);
+}
+
+bool ScriptingObjects::BackgroundTask::isBusy() const
+{
+	return currentTask != nullptr && currentTask->isPending();
+}
+
+void ScriptingObjects::BackgroundTask::cancel()
+{
+	if (currentTask != nullptr)
+		currentTask->signalTaskShouldExit();
+}
+
+void ScriptingObjects::BackgroundTask::setTimeOut(double seconds)
+{
+	timeout = RelativeTime(jmax<double>(0.0, seconds));
+}
+
+void ScriptingObjects::BackgroundTask::setFinishCallbackOnAudioThread(bool shouldBeCalledOnAudioThread)
+{
+	finishCallbackOnAudioThread = shouldBeCalledOnAudioThread;
+}
+
 class PathPreviewComponent: public Component
 {
 public:
@@ -325,6 +325,9 @@ public:
 		/** Restores the state from a base64 string. */
 		void restoreState(String base64State);
 
+		/** Returns the current peak level of the output (the levels are updated on the message thread, so this can be called from any callback). */
+		float getCurrentLevel(bool leftChannel);
+
 		// ============================================================================================================
 
 		struct Wrapper;
@@ -333,8 +336,22 @@ public:
 
 	private:
 
+		/** Drains the levels of the effect on the message thread. */
+		struct LevelUpdater : public Timer
+		{
+			LevelUpdater(ScriptingEffect& parent_) : parent(parent_) {};
+
+			void timerCallback() override;
+
+			ScriptingEffect& parent;
+		};
+
 		WeakReference<Processor> effect;
 
+		ScopedPointer<Processor::PeakMeterSubscription> peakMeterSubscription;
+
+		LevelUpdater levelUpdater;
+
 		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScriptingEffect);
 
 		// ============================================================================================================
@@ -577,6 +594,61 @@ public:
 		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TimerObject)
 	};
 
+	class BackgroundTask : public ConstScriptingObject
+	{
+	public:
+
+		// ============================================================================================================
+
+		BackgroundTask(ProcessorWithScriptingContent *p);
+		~BackgroundTask();
+
+		// ============================================================================================================
+
+		Identifier getObjectName() const override { RETURN_STATIC_IDENTIFIER("BackgroundTask"); }
+		bool objectDeleted() const override { return false; }
+		bool objectExists() const override { return true; }
+
+		// ============================================================================================================ API Methods
+
+		/** Calls taskFunction(argument) on a worker thread and finishCallback(result) afterwards. Returns false if the task is still busy. 
+		*
+		*	The task function runs in this script's engine at the same time as the audio and UI callbacks, so it can use 
+		*	the API objects (eg. Sampler.selectSounds()), but it must not change variables that are used by the other callbacks.
+		*/
+		bool call(var taskFunction, var argument, var finishCallback);
+
+		/** Checks if the task is still busy. */
+		bool isBusy() const;
+
+		/** Cancels the task (the finish callback will not be executed). */
+		void cancel();
+
+		/** Sets the maximum execution time of the task function in seconds. The default is 0.0 (no limit). */
+		void setTimeOut(double seconds);
+
+		/** If true, the finish callback will be executed at the start of the next audio block instead of the message thread. 
+		*
+		*	Use this if the result must be in sync with the audio rendering and keep the callback as short as a MIDI callback.
+		*/
+		void setFinishCallbackOnAudioThread(bool shouldBeCalledOnAudioThread);
+
+		// ============================================================================================================
+
+		struct Wrapper;
+
+	private:
+
+		class Task;
+
+		BackgroundTaskPool::Task::Ptr currentTask;
+
+		RelativeTime timeout;
+		bool finishCallbackOnAudioThread = false;
+
+		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BackgroundTask)
+	};
+
 
 	class PathObject : public ConstScriptingObject,
 					   public DebugableObject
@@ -224,7 +224,15 @@ struct HiseJavascriptEngine::RootObject::Scope
 
 	void checkTimeOut(const CodeLocation& location) const
 	{
-		if (Time::getCurrentTime() > root->timeout)
+		if (root->workerCall.threadId.get() == Thread::getCurrentThreadId())
+		{
+			if (root->workerCall.aborted.get() != 0 || root->workerCall.task->shouldExit())
+				location.throwError("Background task was cancelled");
+
+			if (root->workerCall.timeout != Time() && Time::getCurrentTime() > root->workerCall.timeout)
+				location.throwError("Background task timed-out");
+		}
+		else if (Time::getCurrentTime() > root->timeout)
 			location.throwError("Execution timed-out");
 	}
 };
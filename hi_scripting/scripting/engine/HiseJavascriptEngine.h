@@ -198,6 +198,27 @@ public:
                              const var::NativeFunctionArgs& args,
                              Result* errorMessage = nullptr);
 
+	/** Calls a function from a worker thread of the BackgroundTaskPool.
+	*
+	*	The call has its own timeout (pass RelativeTime() for no limit) that doesn't interfere with the callbacks
+	*	of the audio and message thread and it will be aborted as soon as the task should exit. 
+	*	Only one worker call per engine is executed at the same time.
+	*/
+	var callExternalFunctionFromWorkerThread(var function,
+		const var::NativeFunctionArgs& args,
+		const BackgroundTaskPool::Task* task,
+		RelativeTime timeout,
+		Result* errorMessage = nullptr);
+
+	/** Aborts the current worker call and waits until it has returned. 
+	*
+	*	Call this before the engine is replaced. Every worker call after this will fail immediately.
+	*/
+	void abortWorkerCalls();
+
+	/** Checks if the var is a function that was defined in a script. */
+	static bool isJavascriptFunction(const var& v);
+
     
 	var executeWithoutAllocation(const Identifier &function,
 		const var::NativeFunctionArgs& args,
@@ -313,6 +334,17 @@ public:
 
 		Time timeout;
 
+		/** The state of the function call from a worker thread (see callExternalFunctionFromWorkerThread()). */
+		struct WorkerCall
+		{
+			Atomic<Thread::ThreadID> threadId;
+			const BackgroundTaskPool::Task* task = nullptr;
+			Time timeout;
+			Atomic<int> aborted;
+		};
+
+		WorkerCall workerCall;
+
 		Array<Breakpoint> breakpoints;
 
 		typedef const var::NativeFunctionArgs& Args;
@@ -689,6 +721,8 @@ private:
 
 	DynamicObject::Ptr unneededScope;
 
+	CriticalSection workerCallLock;
+
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HiseJavascriptEngine)
 };
 
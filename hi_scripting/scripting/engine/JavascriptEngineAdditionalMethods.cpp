@@ -305,6 +305,62 @@ var HiseJavascriptEngine::callExternalFunction(var function, const var::NativeFu
 	return returnVal;
 }
 
+var HiseJavascriptEngine::callExternalFunctionFromWorkerThread(var function, const var::NativeFunctionArgs& args, const BackgroundTaskPool::Task* task, RelativeTime timeout, Result* errorMessage /*= nullptr*/)
+{
+	jassert(task != nullptr);
+
+	ScopedLock sl(workerCallLock);
+
+	if (errorMessage != nullptr) *errorMessage = Result::ok();
+
+	RootObject::FunctionObject *fo = dynamic_cast<RootObject::FunctionObject*>(function.getObject());
+
+	if (fo == nullptr)
+		return var::undefined();
+
+	if (root->workerCall.aborted.get() != 0)
+	{
+		if (errorMessage != nullptr) *errorMessage = Result::fail("Background task was cancelled");
+		return var::undefined();
+	}
+
+	var returnVal(var::undefined());
+
+	root->workerCall.task = task;
+	root->workerCall.timeout = timeout > RelativeTime() ? Time::getCurrentTime() + timeout : Time();
+	root->workerCall.threadId = Thread::getCurrentThreadId();
+
+	try
+	{
+		returnVal = fo->invoke(RootObject::Scope(nullptr, root, root), args);
+	}
+	catch (String& error)
+	{
+		if (errorMessage != nullptr) *errorMessage = Result::fail(error);
+	}
+	catch (Breakpoint)
+	{
+		if (errorMessage != nullptr) *errorMessage = Result::fail("Breakpoints can't be used in a background task");
+	}
+
+	root->workerCall.threadId = nullptr;
+	root->workerCall.task = nullptr;
+
+	return returnVal;
+}
+
+void HiseJavascriptEngine::abortWorkerCalls()
+{
+	root->workerCall.aborted = 1;
+
+	ScopedLock sl(workerCallLock);
+}
+
+bool HiseJavascriptEngine::isJavascriptFunction(const var& v)
+{
+	return RootObject::isFunction(v);
+}
+
 Array<Identifier> HiseJavascriptEngine::RootObject::HiseSpecialData::hiddenProperties;
 
 bool HiseJavascriptEngine::RootObject::HiseSpecialData::initHiddenProperties = true;
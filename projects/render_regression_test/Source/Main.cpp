@@ -0,0 +1,54 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+/** Runs the render regression test (and the unit tests of the HISE modules) without starting the HISE application.
+*
+*	Returns 1 if a test failed so that it can be used in a build script.
+*/
+int main (int /*argc*/, char* /*argv*/[])
+{
+	ScopedJuceInitialiser_GUI juceInitialiser;
+
+	UnitTestRunner runner;
+	runner.setAssertOnFailure(false);
+	runner.runAllTests();
+
+	int numFailures = 0;
+
+	for (int i = 0; i < runner.getNumResults(); i++)
+		numFailures += runner.getResult(i)->failures;
+
+	return numFailures > 0 ? 1 : 0;
+}
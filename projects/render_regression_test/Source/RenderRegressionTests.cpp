@@ -0,0 +1,353 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licences for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#include "JuceHeader.h"
+
+// Set this to 1 to write the golden files and render times of the current build into the source tree.
+#ifndef HI_RECORD_RENDER_REFERENCES
+#define HI_RECORD_RENDER_REFERENCES 0
+#endif
+
+/** Renders a set of reference patches from the demo project and compares them against golden files.
+*
+*	Every patch is rendered with a fixed MIDI sequence at all combinations of sample rates and block sizes. 
+*	The golden files and the render times are stored in `extras/demo_project/RegressionTests/`. The test is
+*	skipped if no references were recorded on this machine, but a single missing golden file fails the test.
+*	Build with HI_RECORD_RENDER_REFERENCES on a known good build to record the references (the render times
+*	are only comparable on the machine that recorded them).
+*/
+class RenderRegressionTest : public UnitTest
+{
+public:
+
+	RenderRegressionTest() :
+		UnitTest("Testing render output of the reference patches")
+	{
+
+	}
+
+	void runTest() override
+	{
+		// Every BackendProcessor runs the unit tests again if HI_RUN_UNIT_TESTS is enabled
+		if (isRendering)
+			return;
+
+		const ScopedValueSetter<bool> svs(isRendering, true);
+
+		demoProject = File(__FILE__).getParentDirectory().getParentDirectory().getParentDirectory().getParentDirectory().getChildFile("extras/demo_project");
+
+		if (!demoProject.isDirectory())
+		{
+			logMessage("Skipping render regression test: " + demoProject.getFullPathName() + " not found");
+			return;
+		}
+
+		goldenDirectory = demoProject.getChildFile("RegressionTests");
+
+		const File renderTimeFile = goldenDirectory.getChildFile("RenderTimes.xml");
+
+#if !HI_RECORD_RENDER_REFERENCES
+		if (!renderTimeFile.existsAsFile())
+		{
+			logMessage("Skipping render regression test: no references in " + goldenDirectory.getFullPathName() + ". Build with HI_RECORD_RENDER_REFERENCES=1 to record them.");
+			return;
+		}
+#endif
+
+		ScopedPointer<XmlElement> renderTimeXml = XmlDocument::parse(renderTimeFile);
+		renderTimes = renderTimeXml != nullptr ? ValueTree::fromXml(*renderTimeXml) : ValueTree("RenderTimes");
+
+		createMidiSequence();
+
+		const double sampleRates[3] = { 44100.0, 48000.0, 96000.0 };
+		const int blockSizes[3] = { 64, 512, 1024 };
+
+		for (int patch = 0; patch < numPatches; patch++)
+		{
+			for (auto sampleRate : sampleRates)
+			{
+				for (auto blockSize : blockSizes)
+				{
+					testPatch((Patch)patch, sampleRate, blockSize);
+				}
+			}
+		}
+
+#if HI_RECORD_RENDER_REFERENCES
+		ScopedPointer<XmlElement> newRenderTimeXml = renderTimes.createXml();
+		newRenderTimeXml->writeToFile(renderTimeFile, String());
+#endif
+	}
+
+private:
+
+	enum Patch
+	{
+		Sampler = 0,
+		Wavetable,
+		Convolution,
+		ScriptFX,
+		numPatches
+	};
+
+	static String getPatchName(Patch p)
+	{
+		switch (p)
+		{
+		case Sampler:		return "Sampler";
+		case Wavetable:		return "Wavetable";
+		case Convolution:	return "Convolution";
+		case ScriptFX:		return "ScriptFX";
+		case numPatches:	break;
+		}
+
+		return String();
+	}
+
+	void createMidiSequence()
+	{
+		sequence.clear();
+
+		const int notes[4] = { 60, 64, 67, 72 };
+
+		for (int i = 0; i < 4; i++)
+		{
+			const double start = 0.25 * (double)i;
+
+			sequence.addEvent(MidiMessage::noteOn(1, notes[i], (uint8)(40 + 25 * i)), start);
+			sequence.addEvent(MidiMessage::noteOff(1, notes[i]), start + 0.6);
+		}
+
+		sequence.addEvent(MidiMessage::controllerEvent(1, 1, 100), 0.3);
+		sequence.addEvent(MidiMessage::pitchWheel(1, 12000), 0.5);
+		sequence.addEvent(MidiMessage::pitchWheel(1, 8192), 1.0);
+
+		sequence.updateMatchedPairs();
+	}
+
+	void testPatch(Patch patch, double sampleRate, int blockSize)
+	{
+		const String name = getPatchName(patch) + "_" + String((int)sampleRate) + "_" + String(blockSize);
+
+		beginTest("Rendering " + name);
+
+		OfflineRenderer::Settings settings;
+		settings.sampleRate = sampleRate;
+		settings.blockSize = blockSize;
+		settings.tailSeconds = 0.5;
+
+		AudioSampleBuffer output;
+
+		double renderSeconds = 0.0;
+
+		{
+			ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+
+			OfflineRenderer::ScopedWorkingProject swp(bp->getMainSynthChain(), demoProject);
+
+			bp->setNonRealtime(true);
+			bp->prepareToPlay(sampleRate, blockSize);
+
+			if (!createPatch(bp, patch))
+			{
+				expect(false, "Can't create patch " + name);
+				return;
+			}
+
+			// Only the rendering is timed, not the loading of the patch
+			const int64 startTime = Time::getHighResolutionTicks();
+
+			OfflineRenderer::renderSequence(bp, sequence, settings, output);
+
+			renderSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startTime);
+		}
+
+		const double audioSeconds = (double)output.getNumSamples() / sampleRate;
+
+		logMessage(name + ": " + String(renderSeconds * 1000.0, 1) + " ms (" + String(audioSeconds / renderSeconds, 1) + "x realtime)");
+
+		expect(output.getMagnitude(0, output.getNumSamples()) > 0.0f, "Patch renders silence");
+
+		const File goldenFile = goldenDirectory.getChildFile(name + ".wav");
+		const Identifier timeId(name);
+
+#if HI_RECORD_RENDER_REFERENCES
+		goldenDirectory.createDirectory();
+		writeGoldenFile(goldenFile, output, sampleRate);
+		renderTimes.setProperty(timeId, renderSeconds * 1000.0, nullptr);
+
+		logMessage("Recorded golden file " + goldenFile.getFileName());
+#else
+		if (renderTimes.hasProperty(timeId))
+		{
+			const double baselineMilliseconds = (double)renderTimes.getProperty(timeId);
+			const double renderMilliseconds = renderSeconds * 1000.0;
+
+			expect(renderMilliseconds <= baselineMilliseconds * maxSlowdown, name + " renders slower than the baseline (" + String(renderMilliseconds, 1) + " ms vs. " + String(baselineMilliseconds, 1) + " ms)");
+		}
+		else
+		{
+			expect(false, "No render time baseline for " + name);
+		}
+
+		if (!goldenFile.existsAsFile())
+		{
+			expect(false, "Missing golden file " + goldenFile.getFullPathName());
+			return;
+		}
+
+		AudioSampleBuffer golden;
+
+		if (!readGoldenFile(goldenFile, golden))
+		{
+			expect(false, "Can't read golden file " + goldenFile.getFileName());
+			return;
+		}
+
+		expectEquals<int>(output.getNumSamples(), golden.getNumSamples(), "Length of " + name);
+
+		const int numToCompare = jmin<int>(output.getNumSamples(), golden.getNumSamples());
+
+		float maxDifference = 0.0f;
+
+		for (int c = 0; c < 2; c++)
+		{
+			const float* o = output.getReadPointer(c);
+			const float* g = golden.getReadPointer(c);
+
+			for (int i = 0; i < numToCompare; i++)
+				maxDifference = jmax<float>(maxDifference, std::abs(o[i] - g[i]));
+		}
+
+		expect(maxDifference <= tolerance, name + " deviates from the golden file by " + String(Decibels::gainToDecibels(maxDifference), 1) + " dB");
+#endif
+	}
+
+	bool createPatch(BackendProcessor* bp, Patch patch)
+	{
+		ModulatorSynthChain* chain = bp->getMainSynthChain();
+
+		if (patch == Sampler || patch == Convolution)
+		{
+			ScopedPointer<XmlElement> xml = XmlDocument::parse(demoProject.getChildFile("XmlPresetBackups/Demo.xml"));
+
+			if (xml == nullptr)
+				return false;
+
+			ValueTree v = ValueTree::fromXml(*xml);
+			bp->loadPreset(v);
+		}
+		else
+		{
+			Processor* p = MainController::createProcessor(chain->getFactoryType(), WavetableSynth::getClassType(), "Wavetable");
+
+			if (p == nullptr)
+				return false;
+
+			chain->getHandler()->add(p, nullptr);
+		}
+
+		EffectProcessorChain* fxChain = dynamic_cast<EffectProcessorChain*>(chain->getChildProcessor(ModulatorSynth::EffectChain));
+
+		if (patch == Convolution)
+		{
+			ConvolutionEffect* reverb = dynamic_cast<ConvolutionEffect*>(MainController::createProcessor(fxChain->getFactoryType(), ConvolutionEffect::getClassType(), "Reverb"));
+
+			if (reverb == nullptr)
+				return false;
+
+			fxChain->getHandler()->add(reverb, nullptr);
+
+			reverb->setLoadedFile(demoProject.getChildFile("AudioFiles/tap_ir.wav").getFullPathName(), true);
+			reverb->setAttribute(ConvolutionEffect::ProcessInput, 1.0f, dontSendNotification);
+		}
+		else if (patch == ScriptFX)
+		{
+			JavascriptMasterEffect* fx = dynamic_cast<JavascriptMasterEffect*>(MainController::createProcessor(fxChain->getFactoryType(), JavascriptMasterEffect::getClassType(), "Script"));
+
+			if (fx == nullptr)
+				return false;
+
+			fx->getSnippet((int)JavascriptMasterEffect::Callback::processBlock)->replaceAllContent("function processBlock(channels)\n{\n\tfor(c in channels)\n\t\tc *= 0.5;\n}\n");
+
+			if (!fx->compileScript().r.wasOk())
+				return false;
+
+			fxChain->getHandler()->add(fx, nullptr);
+		}
+
+		return true;
+	}
+
+	static void writeGoldenFile(const File& f, const AudioSampleBuffer& b, double sampleRate)
+	{
+		WavAudioFormat wav;
+		StringPairArray empty;
+
+		ScopedPointer<AudioFormatWriter> writer = wav.createWriterFor(new FileOutputStream(f), sampleRate, 2, 32, empty, 0);
+
+		if (writer != nullptr)
+			writer->writeFromAudioSampleBuffer(b, 0, b.getNumSamples());
+	}
+
+	static bool readGoldenFile(const File& f, AudioSampleBuffer& b)
+	{
+		WavAudioFormat wav;
+
+		ScopedPointer<AudioFormatReader> reader = wav.createReaderFor(new FileInputStream(f), true);
+
+		if (reader == nullptr)
+			return false;
+
+		b.setSize(2, (int)reader->lengthInSamples);
+		reader->read(&b, 0, (int)reader->lengthInSamples, 0, true, true);
+
+		return true;
+	}
+
+	static bool isRendering;
+
+	/** -80dB: allows float rounding differences between compilers, but catches every audible change. */
+	const float tolerance = 0.0001f;
+
+	/** Allows scheduling jitter, but catches a real regression of the render time. */
+	const double maxSlowdown = 1.5;
+
+	File demoProject;
+	File goldenDirectory;
+	ValueTree renderTimes;
+	MidiMessageSequence sequence;
+};
+
+bool RenderRegressionTest::isRendering = false;
+
+static RenderRegressionTest renderRegressionTest;
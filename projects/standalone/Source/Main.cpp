@@ -53,6 +53,22 @@ public:
 			quit();
 			return;
 		}
+		else if (commandLine.startsWith("render"))
+		{
+			OfflineRenderer::ErrorCodes result = OfflineRenderer::renderFromCommandLine(commandLine);
+
+			if (result != OfflineRenderer::OK)
+			{
+				std::cout << std::endl << "==============================================================================" << std::endl;
+				std::cout << "RENDER ERROR: " << OfflineRenderer::getErrorMessage(result) << std::endl;
+				std::cout << "==============================================================================" << std::endl << std::endl;
+
+				exit((int)result);
+			}
+
+			quit();
+			return;
+		}
 		else if (commandLine.startsWith("--help"))
 		{
 			std::cout << std::endl;
@@ -68,6 +84,16 @@ public:
 			std::cout << "          (Leave empty for standalone export)" << std::endl;
 			std::cout << "-a:{TEXT} sets the architecture ('x86', 'x64', 'x86x64')." << std::endl;
 			std::cout << "          (Leave empty on OSX for Universal binary.)" << std::endl << std::endl;
+			std::cout << "HISE render \"File.hip\" -m:MIDIFILE -o:OUTPUTFILE [-sr:RATE -bs:SIZE -tail:SECONDS]" << std::endl;
+			std::cout << "HISE render -l:JOBLIST [-j:NUM -sr:RATE -bs:SIZE -tail:SECONDS]" << std::endl << std::endl;
+			std::cout << "Options: " << std::endl << std::endl;
+			std::cout << "-m:{TEXT} the MIDI file that is rendered with the preset" << std::endl;
+			std::cout << "-o:{TEXT} the output file (.wav or .hlac)" << std::endl;
+			std::cout << "-l:{TEXT} a text file with one 'Preset.hip;Input.mid;Output.wav' job per line" << std::endl;
+			std::cout << "-j:{NUM}  the number of jobs that are rendered in parallel processes" << std::endl;
+			std::cout << "-sr:{NUM} the sample rate (default 44100)" << std::endl;
+			std::cout << "-bs:{NUM} the block size (default 512)" << std::endl;
+			std::cout << "-tail:{NUM} the seconds that are rendered after the last MIDI event (default 2)" << std::endl << std::endl;
 
 			quit();
 			return;